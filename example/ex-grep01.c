@@ -31,15 +31,26 @@ int main(int argc, const char *argv[])
          return 1;
       }
 
-      // While it reads some word from the file
-      while (string_fget_word(word, " \t\n\r\"(),=", f)) {
-         // Get the reference to the array of this word in the dictionnary (or create it if needed)
-         array_size_t *array = map_pos_safe_get(positions, word);
+      // Read the file through a buffered reader
+      string_reader_t reader;
+      string_reader_init(reader, f);
+      string_view_t view;
+      // While it reads some word from the file (as a view on the buffer of the reader)
+      while (string_reader_get_word(&view, reader, " \t\n\r\"(),=")) {
+         // Get the reference to the array of this word in the dictionnary
+         // (without creating a string for the lookup)
+         array_size_t *array = map_pos_get_view(positions, view);
+         if (array == NULL) {
+           // New word: create it in the dictionnary
+           string_set_view(word, view);
+           array = map_pos_safe_get(positions, word);
+         }
          // Push the new offset to this word in the associated array
-         array_size_push_back(*array, (size_t)ftell(f) - string_size(word));
+         array_size_push_back(*array, string_reader_tell(reader) - string_view_size(view));
       }
 
       // Close the file
+      string_reader_clear(reader);
       fclose(f);
 
       // Print the words and where they are:
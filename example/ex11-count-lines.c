@@ -41,9 +41,6 @@ M_TUPLE_DEF2( dir, (nlines, atomic_uint), (name, m_string_t, M_OPEXTEND(M_STRING
 M_TREE_DEF(tree, dir_t)
 
 
-/* Maximum number of characters read by file */
-#define MAX_READ_BUFFER 8192
-
 /* Maximum number of directory to scan */
 #define MAX_DIRECTORY 100000
 
@@ -71,17 +68,6 @@ add_directory(tree_it_t parent, const m_string_t dirname)
   }
 }
 
-/* count the number of end of line character in the buffer */
-static unsigned
-count_eol(size_t num, const char buffer[num])
-{
-  unsigned count = 0;
-  for(size_t i = 0; i < num; i++) {
-    count += buffer[i] == '\n';
-  }
-  return count;
-}
-
 /* Test if a filename suffix ends with a C++ or C suffix */
 static bool
 is_a_c_file(const m_string_t filename)
@@ -102,14 +88,16 @@ scan_file(tree_it_t parent, m_string_t filename)
     exit(1);
   }
 
-  /* Read the FILE per bulk of MAX_READ_BUFFER */
-  char buffer[MAX_READ_BUFFER];
+  /* Read the FILE line by line through a buffered reader:
+     the lines are only views on the buffer of the reader */
+  m_string_reader_t reader;
+  m_string_view_t line;
   unsigned count = 0;
-  size_t num;
-  do {
-    num = fread (buffer, 1, MAX_READ_BUFFER, f);
-    count += count_eol(num, buffer);
-  } while (num == MAX_READ_BUFFER);
+  m_string_reader_init(reader, f);
+  while (m_string_reader_get_line(&line, reader, M_STRING_READ_LINE)) {
+    count ++;
+  }
+  m_string_reader_clear(reader);
   fclose(f);
 
   /* Adding the number of lines to the parent directory */
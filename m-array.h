@@ -61,6 +61,72 @@
   { { 0, 0, NULL } }
 
 
+/* Define a dynamic array of the given type and its associated functions,
+   storing up to N elements within the array object itself before
+   using a heap allocation (Small Buffer Optimization).
+   USAGE: ARRAY_SBO_DEF(name, type, N [, oplist_of_the_type]) */
+#define M_ARRAY_SBO_DEF(name, ...)                                            \
+  M_ARRAY_SBO_DEF_AS(name, M_F(name,_t), M_F(name,_it_t), __VA_ARGS__)
+
+
+/* Define a dynamic array with Small Buffer Optimization of the given type
+  and its associated functions as the provided type name_t
+  with the iterator named it_t.
+   USAGE: ARRAY_SBO_DEF_AS(name, name_t, it_t, type, N [, oplist_of_the_type]) */
+#define M_ARRAY_SBO_DEF_AS(name, name_t, it_t, ...)                           \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_ARRA4_SBO_DEF_P1(M_IF_NARGS_EQ2(__VA_ARGS__)                              \
+             ((name, __VA_ARGS__, M_GLOBAL_OPLIST_OR_DEF(M_RET_ARG1(__VA_ARGS__))(), name_t, it_t ), \
+              (name, __VA_ARGS__,                                                    name_t, it_t ))) \
+  M_END_PROTECTED_CODE
+
+
+/* Define the oplist of a dynamic array with Small Buffer Optimization
+   given its name and its oplist.
+   It is the same as the one of a dynamic array.
+   USAGE: ARRAY_SBO_OPLIST(name[, oplist of the type]) */
+#define M_ARRAY_SBO_OPLIST(...)                                               \
+  M_ARRAY_OPLIST(__VA_ARGS__)
+
+
+/* Define an init value to init global variables of type array
+   with Small Buffer Optimization of N elements.
+  USAGE:
+    array_t global_variable = ARRAY_SBO_INIT_VALUE(N);
+ */
+#define M_ARRAY_SBO_INIT_VALUE(N)                                             \
+  { { 0, N, { NULL } } }
+
+
+/* Define a fixed capacity array of the given type and its associated functions,
+   storing up to N elements within the array object itself.
+   It never allocates memory: the methods that would need to grow the array
+   return a failure code instead.
+   USAGE: STATIC_ARRAY_DEF(name, type, N [, oplist_of_the_type]) */
+#define M_STATIC_ARRAY_DEF(name, ...)                                         \
+  M_STATIC_ARRAY_DEF_AS(name, M_F(name,_t), M_F(name,_it_t), __VA_ARGS__)
+
+
+/* Define a fixed capacity array of the given type and its associated functions
+  as the provided type name_t with the iterator named it_t.
+   USAGE: STATIC_ARRAY_DEF_AS(name, name_t, it_t, type, N [, oplist_of_the_type]) */
+#define M_STATIC_ARRAY_DEF_AS(name, name_t, it_t, ...)                        \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_ARRA4_STATIC_DEF_P1(M_IF_NARGS_EQ2(__VA_ARGS__)                           \
+             ((name, __VA_ARGS__, M_GLOBAL_OPLIST_OR_DEF(M_RET_ARG1(__VA_ARGS__))(), name_t, it_t ), \
+              (name, __VA_ARGS__,                                                    name_t, it_t ))) \
+  M_END_PROTECTED_CODE
+
+
+/* Define the oplist of a fixed capacity array given its name and its oplist.
+   It is the same as the one of a dynamic array, except that the methods
+   which fail on a full array are disabled (generic code cannot check it).
+   USAGE: STATIC_ARRAY_OPLIST(name[, oplist of the type]) */
+#define M_STATIC_ARRAY_OPLIST(...)                                            \
+  M_OPEXTEND(M_ARRAY_OPLIST(__VA_ARGS__), PUSH(0), PUSH_MOVE(0),              \
+             INIT_WITH(0), IT_INSERT(0), SAFE_GET_KEY(0))
+
+
 /*****************************************************************************/
 /********************************** INTERNAL *********************************/
 /*****************************************************************************/
@@ -202,6 +268,10 @@
   } while (0)
 #endif
 
+/* Test if a dynamic array cannot receive any new element:
+   it can always grow (or raise a memory error) */
+#define M_ARRA4_FULL_P(a) false
+
 /* Deferred evaluation for the array definition,
    so that all arguments are fully evaluated before further expansion
    (ensuring good performance)
@@ -232,7 +302,8 @@
   M_IF_METHOD(INIT_SET, oplist)(M_ARRA4_DEF_IF_INIT_SET, M_EAT)(name, type, oplist, array_t, it_t) \
   M_IF_METHOD(INIT, oplist)(M_ARRA4_DEF_IF_INIT, M_EAT)(name, type, oplist, array_t, it_t) \
   M_ARRA4_DEF_EXTENDED(name, type, oplist, array_t, it_t)                     \
-  M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t)                           \
+  M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t, M_ARRA4_CONTRACT, M_ARRA4_FULL_P) \
+  M_IF(M_GET_PROPERTY(oplist, FLAT))(M_ARRA4_DEF_IMAGE, M_EAT)(name, type, oplist, array_t, it_t) \
   M_EMPLACE_QUEUE_DEF(name, array_t, _emplace_back, oplist, M_ARRA4_EMPLACE_DEF)
 
 /* Define the types */
@@ -869,6 +940,92 @@
   }                                                                           \
                                                                               \
   M_IF_METHOD3(SWAP, SET, CMP, oplist)(                                       \
+  M_ARRA4_DEF_SORT_NOALLOC(name, type, oplist)                                \
+                                                                              \
+  M_P(void, name, _special_stable_sort, array_t l)                            \
+  {                                                                           \
+    if (M_UNLIKELY (l->size < 2))                                             \
+      return;                                                                 \
+    /* NOTE: if size is <= 4, no need to perform an allocation */             \
+    type *temp = M_CALL_REALLOC(oplist, type, NULL, 0, l->size);              \
+    if (M_UNLIKELY_NOMEM (temp == NULL)) {                                    \
+      M_MEMORY_FULL(type, l->size);                                           \
+    }                                                                         \
+    M_C3(m_arra4_,name,_stable_sort_noalloc)(l->ptr, l->size, temp);          \
+    M_CALL_FREE(oplist, type, temp, l->size);                                 \
+  }                                                                           \
+  ,) /* IF SWAP & SET & CMP operators */                                      \
+                                                                              \
+  M_ARRA4_DEF_EQUAL(name, type, oplist, array_t, it_t, M_ARRA4_CONTRACT)      \
+                                                                              \
+  M_IF_METHOD(HASH, oplist)(                                                  \
+  M_INLINE size_t                                                             \
+  M_F(name, _hash)(const array_t array)                                       \
+  {                                                                           \
+    M_ARRA4_CONTRACT(array);                                                  \
+    M_HASH_DECL(hash);                                                        \
+    for(size_t i = 0 ; i < array->size; i++) {                                \
+      size_t hi = M_CALL_HASH(oplist, array->ptr[i]);                         \
+      M_HASH_UP(hash, hi);                                                    \
+    }                                                                         \
+    return M_HASH_FINAL (hash);                                               \
+  }                                                                           \
+  , /* no HASH */ )                                                           \
+                                                                              \
+  M_P(void, name, _splice, array_t a1, array_t a2)                            \
+  {                                                                           \
+    M_ARRA4_CONTRACT(a1);                                                     \
+    M_ARRA4_CONTRACT(a2);                                                     \
+    M_ASSERT(a1 != a2);                                                       \
+    if (M_LIKELY (a2->size > 0)) {                                            \
+      size_t newSize = a1->size + a2->size;                                   \
+      /* To overflow newSize, we need to a1 and a2 a little bit above         \
+         SIZE_MAX/2, which is not possible in the classic memory model as we  \
+         should have exhausted all memory before reaching such sizes. */      \
+      M_ASSERT_INDEX(a1->size, newSize);                                      \
+      if (newSize > a1->alloc) {                                              \
+        type *ptr = M_CALL_REALLOC(oplist, type, a1->ptr, a1->alloc, newSize); \
+        if (M_UNLIKELY_NOMEM (ptr == NULL) ) {                                \
+          M_MEMORY_FULL(type, newSize);                                       \
+        }                                                                     \
+        a1->ptr = ptr;                                                        \
+        a1->alloc = newSize;                                                  \
+      }                                                                       \
+      M_ASSERT(a1->ptr != NULL);                                              \
+      M_ASSERT(a2->ptr != NULL);                                              \
+      memcpy(&a1->ptr[a1->size], &a2->ptr[0], a2->size * sizeof (type));      \
+      /* a2 is now empty */                                                   \
+      a2->size = 0;                                                           \
+      /* a1 has been expanded with the items of a2 */                         \
+      a1->size = newSize;                                                     \
+    }                                                                         \
+  }                                                                           \
+
+/* Define the equality function of an array,
+   using only the accessor methods of the array */
+#define M_ARRA4_DEF_EQUAL(name, type, oplist, array_t, it_t, contract)        \
+  M_IF_METHOD(EQUAL, oplist)(                                                 \
+  M_INLINE bool                                                               \
+  M_F(name, _equal_p)(const array_t array1,                                   \
+                      const array_t array2)                                   \
+  {                                                                           \
+    contract(array1);                                                         \
+    contract(array2);                                                         \
+    const size_t size = M_F(name, _size)(array1);                             \
+    if (size != M_F(name, _size)(array2)) return false;                       \
+    for(size_t i = 0; i < size; i++) {                                        \
+      type const *item1 = M_F(name, _cget)(array1, i);                        \
+      type const *item2 = M_F(name, _cget)(array2, i);                        \
+      bool b = M_CALL_EQUAL(oplist, *item1, *item2);                          \
+      if (!b) return false;                                                   \
+    }                                                                         \
+    return true;                                                              \
+  }                                                                           \
+  , /* no EQUAL */ )                                                          \
+
+/* Define the stable sort of a C array of 'type' using a temporary C array
+   of the same size */
+#define M_ARRA4_DEF_SORT_NOALLOC(name, type, oplist)                          \
   M_INLINE void                                                               \
   M_C3(m_arra4_,name,_stable_sort_noalloc)(type tab[], size_t size, type tmp[]) \
   {                                                                           \
@@ -936,91 +1093,17 @@
       th += th;                                                               \
     }                                                                         \
     M_ASSERT (org_tab == tab);                                                \
-  }                                                                           \
-                                                                              \
-  M_P(void, name, _special_stable_sort, array_t l)                            \
-  {                                                                           \
-    if (M_UNLIKELY (l->size < 2))                                             \
-      return;                                                                 \
-    /* NOTE: if size is <= 4, no need to perform an allocation */             \
-    type *temp = M_CALL_REALLOC(oplist, type, NULL, 0, l->size);              \
-    if (M_UNLIKELY_NOMEM (temp == NULL)) {                                    \
-      M_MEMORY_FULL(type, l->size);                                           \
-    }                                                                         \
-    M_C3(m_arra4_,name,_stable_sort_noalloc)(l->ptr, l->size, temp);          \
-    M_CALL_FREE(oplist, type, temp, l->size);                                 \
-  }                                                                           \
-  ,) /* IF SWAP & SET & CMP operators */                                      \
-                                                                              \
-  M_IF_METHOD(EQUAL, oplist)(                                                 \
-  M_INLINE bool                                                               \
-  M_F(name, _equal_p)(const array_t array1,                                   \
-                      const array_t array2)                                   \
-  {                                                                           \
-    M_ARRA4_CONTRACT(array1);                                                 \
-    M_ARRA4_CONTRACT(array2);                                                 \
-    if (array1->size != array2->size) return false;                           \
-    size_t i;                                                                 \
-    for(i = 0; i < array1->size; i++) {                                       \
-      type const *item1 = M_F(name, _cget)(array1, i);                        \
-      type const *item2 = M_F(name, _cget)(array2, i);                        \
-      bool b = M_CALL_EQUAL(oplist, *item1, *item2);                          \
-      if (!b) return false;                                                   \
-    }                                                                         \
-    return true;                                                              \
-  }                                                                           \
-  , /* no EQUAL */ )                                                          \
-                                                                              \
-  M_IF_METHOD(HASH, oplist)(                                                  \
-  M_INLINE size_t                                                             \
-  M_F(name, _hash)(const array_t array)                                       \
-  {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
-    M_HASH_DECL(hash);                                                        \
-    for(size_t i = 0 ; i < array->size; i++) {                                \
-      size_t hi = M_CALL_HASH(oplist, array->ptr[i]);                         \
-      M_HASH_UP(hash, hi);                                                    \
-    }                                                                         \
-    return M_HASH_FINAL (hash);                                               \
-  }                                                                           \
-  , /* no HASH */ )                                                           \
-                                                                              \
-  M_P(void, name, _splice, array_t a1, array_t a2)                            \
-  {                                                                           \
-    M_ARRA4_CONTRACT(a1);                                                     \
-    M_ARRA4_CONTRACT(a2);                                                     \
-    M_ASSERT(a1 != a2);                                                       \
-    if (M_LIKELY (a2->size > 0)) {                                            \
-      size_t newSize = a1->size + a2->size;                                   \
-      /* To overflow newSize, we need to a1 and a2 a little bit above         \
-         SIZE_MAX/2, which is not possible in the classic memory model as we  \
-         should have exhausted all memory before reaching such sizes. */      \
-      M_ASSERT_INDEX(a1->size, newSize);                                      \
-      if (newSize > a1->alloc) {                                              \
-        type *ptr = M_CALL_REALLOC(oplist, type, a1->ptr, a1->alloc, newSize); \
-        if (M_UNLIKELY_NOMEM (ptr == NULL) ) {                                \
-          M_MEMORY_FULL(type, newSize);                                       \
-        }                                                                     \
-        a1->ptr = ptr;                                                        \
-        a1->alloc = newSize;                                                  \
-      }                                                                       \
-      M_ASSERT(a1->ptr != NULL);                                              \
-      M_ASSERT(a2->ptr != NULL);                                              \
-      memcpy(&a1->ptr[a1->size], &a2->ptr[0], a2->size * sizeof (type));      \
-      /* a2 is now empty */                                                   \
-      a2->size = 0;                                                           \
-      /* a1 has been expanded with the items of a2 */                         \
-      a1->size = newSize;                                                     \
-    }                                                                         \
   }                                                                           \
 
-/* Define the I/O functions */
-#define M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t)                     \
+/* Define the I/O functions
+   (contract is the macro checking the invariant of the array,
+    full_p is the macro testing if the array cannot receive any new element) */
+#define M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t, contract, full_p)   \
                                                                               \
   M_IF_METHOD(GET_STR, oplist)(                                               \
   M_P(void, name, _get_str, m_string_t str, array_t const array, bool append) \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     (append ? m_string_cat_cstr : m_string_set_cstr) M_R(str, "[");           \
     it_t it;                                                                  \
     for (M_F(name, _it)(it, array) ;                                          \
@@ -1039,7 +1122,7 @@
   M_INLINE void                                                               \
   M_F(name, _out_str)(FILE *file, const array_t array)                        \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     M_ASSERT (file != NULL);                                                  \
     fputc ('[', file);                                                        \
     for (size_t i = 0; i < array->size; i++) {                                \
@@ -1055,7 +1138,7 @@
   M_IF_METHOD2(PARSE_STR, INIT, oplist)(                                      \
   M_P(bool, name, _parse_str, array_t array, const char str[], const char**endp) \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     M_ASSERT (str != NULL);                                                   \
     M_F(name,_reset)M_R(array);                                               \
     int c = *str++;                                                           \
@@ -1068,12 +1151,12 @@
       do {                                                                    \
         bool b = M_CALL_PARSE_STR(oplist, item, str, &str);                   \
         c = m_core_str_nospace(&str);                                         \
-        if (b == false || c == 0) { c = 0; break; }                           \
+        if (b == false || c == 0 || full_p(array)) { c = 0; break; }          \
         M_F(name, _push_back) M_R(array, item);                               \
       } while (c == M_GET_SEPARATOR oplist);                                  \
     }                                                                         \
   exit:                                                                       \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     if (endp) *endp = str;                                                    \
     return c == ']';                                                          \
   }                                                                           \
@@ -1082,7 +1165,7 @@
   M_IF_METHOD2(IN_STR, INIT, oplist)(                                         \
   M_P(bool, name, _in_str, array_t array, FILE *file)                         \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     M_ASSERT (file != NULL);                                                  \
     M_F(name,_reset)M_R(array);                                               \
     int c = fgetc(file);                                                      \
@@ -1095,11 +1178,11 @@
       do {                                                                    \
         bool b = M_CALL_IN_STR(oplist, item, file);                           \
         c = m_core_fgetc_nospace(file);                                       \
-        if (b == false || c == EOF) { c = 0; break; }                         \
+        if (b == false || c == EOF || full_p(array)) { c = 0; break; }        \
         M_F(name, _push_back) M_R(array, item);                               \
       } while (c == M_GET_SEPARATOR oplist);                                  \
     }                                                                         \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     return c == ']';                                                          \
   }                                                                           \
   , /* no IN_STR & INIT */ )                                                  \
@@ -1107,10 +1190,17 @@
   M_IF_METHOD(OUT_SERIAL, oplist)(                                            \
   M_P(m_serial_return_code_t, name, _out_serial, m_serial_write_t f, const array_t array) \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     M_ASSERT (f != NULL && f->m_interface != NULL);                           \
     m_serial_return_code_t ret;                                               \
     m_serial_local_t local;                                                   \
+    const m_serial_raw_kind_t kind = M_SERIAL_RAW_KIND(oplist, type);         \
+    if (kind != M_SERIAL_RAW_NONE && f->m_interface->write_raw_array != NULL) { \
+      /* Fast path: the elements are serialized as a whole */                 \
+      const type *data = array->size == 0 ? NULL : M_F(name, _cget)(array, 0); \
+      ret = f->m_interface->write_raw_array M_R(f, data, sizeof (type), kind, array->size); \
+      return ret & M_SERIAL_FAIL;                                             \
+    }                                                                         \
     ret = f->m_interface->write_array_start M_R(local, f, array->size);       \
     for (size_t i = 0; i < array->size; i++) {                                \
       type const *item = M_F(name, _cget)(array, i);                          \
@@ -1127,7 +1217,7 @@
   M_IF_METHOD2(IN_SERIAL, INIT, oplist)(                                      \
   M_P(m_serial_return_code_t, name, _in_serial, array_t array, m_serial_read_t f) \
   {                                                                           \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     M_ASSERT (f != NULL && f->m_interface != NULL);                           \
     m_serial_return_code_t ret;                                               \
     m_serial_local_t local;                                                   \
@@ -1138,15 +1228,27 @@
        return ret;                                                            \
     }                                                                         \
     M_F(name, _reserve) M_R(array, estimated_size);                           \
+    const m_serial_raw_kind_t kind = M_SERIAL_RAW_KIND(oplist, type);         \
+    if (kind != M_SERIAL_RAW_NONE && f->m_interface->read_raw_array != NULL   \
+        && estimated_size != 0 && estimated_size != (size_t) -1               \
+        && M_F(name, _capacity)(array) >= estimated_size) {                   \
+      /* Fast path: the elements are read as a whole in the array */          \
+      type *data = M_F(name, _push_back_raw) M_R(array);                      \
+      ret = f->m_interface->read_raw_array(local, f, data, sizeof (type), kind, estimated_size); \
+      array->size = (ret == M_SERIAL_OK_DONE) ? estimated_size : 0;           \
+      contract(array);                                                        \
+      return ret;                                                             \
+    }                                                                         \
     M_QLET(1, item, type, oplist) {                                           \
       do {                                                                    \
         ret = M_CALL_IN_SERIAL(oplist, item, f);                              \
         if (ret != M_SERIAL_OK_DONE) { break; }                               \
+        if (full_p(array)) { ret = M_SERIAL_FAIL; break; }                    \
         M_F(name, _push_back)M_R(array, item);                                \
         ret = f->m_interface->read_array_next(local, f);                      \
       } while (ret == M_SERIAL_OK_CONTINUE);                                  \
     }                                                                         \
-    M_ARRA4_CONTRACT(array);                                                  \
+    contract(array);                                                          \
     return ret;                                                               \
   }                                                                           \
   , /* no IN_SERIAL & INIT */ )                                               \
@@ -1163,6 +1265,1386 @@
     M_IF_EXCEPTION( v->size ++);                                              \
   }                                                                           \
 
+/* Define the flat image functions of an array of flat elements
+   (elements with the FLAT property): the image is the header
+   followed by the raw elements */
+#define M_ARRA4_DEF_IMAGE(name, type, oplist, array_t, it_t)                  \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _image_size)(const array_t v)                                     \
+  {                                                                           \
+    M_ARRA4_CONTRACT(v);                                                      \
+    return M_CORE_IMAGE_ALIGN + m_core_image_section_size(v->size, sizeof (type)); \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _to_image)(void *image, size_t len, const array_t v)              \
+  {                                                                           \
+    M_ARRA4_CONTRACT(v);                                                      \
+    const size_t size = M_F(name, _image_size)(v);                            \
+    if (M_UNLIKELY (image == NULL || len < size)) return 0;                   \
+    char *p = (char *) m_core_image_set_header(image, M_CORE_IMAGE_KIND('A','R','R','Y'), \
+                                               sizeof (type), v->size, 0, 0, 0, 0); \
+    const size_t n = v->size * sizeof (type);                                 \
+    if (n != 0) memcpy(p, v->ptr, n);                                         \
+    memset(p + n, 0, size - M_CORE_IMAGE_ALIGN - n);                          \
+    return size;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _view_from_image)(array_t view, const void *image, size_t len)    \
+  {                                                                           \
+    const m_core_image_header_t *header =                                     \
+      m_core_image_get_header(image, len, M_CORE_IMAGE_KIND('A','R','R','Y'), sizeof (type)); \
+    if (M_UNLIKELY (header == NULL)) return false;                            \
+    const size_t count = (size_t) header->count;                              \
+    if (M_UNLIKELY (m_core_image_section_size(count, sizeof (type)) > len - M_CORE_IMAGE_ALIGN)) \
+      return false;                                                           \
+    const char *p = (const char *) image + M_CORE_IMAGE_ALIGN;                \
+    if (M_UNLIKELY (!m_core_image_aligned_p(p, sizeof (type)))) return false; \
+    view->size = count;                                                       \
+    view->alloc = count;                                                      \
+    /* The view is read-only: the constness of the image is restored by the API */ \
+    view->ptr = count == 0 ? NULL : (type *) (uintptr_t) p;                   \
+    M_ARRA4_CONTRACT(view);                                                   \
+    return true;                                                              \
+  }                                                                           \
+
+/* Number of elements that can be stored within an array with Small Buffer
+   Optimization (computed from the type of its inline buffer) */
+#define M_ARRA4_SBO_SIZE(a)                                                   \
+  (sizeof (a)->u.buf / sizeof (a)->u.buf[0])
+
+/* Test if an array with Small Buffer Optimization uses its inline buffer */
+#define M_ARRA4_SBO_INLINE_P(a)                                               \
+  ((a)->alloc <= M_ARRA4_SBO_SIZE(a))
+
+/* Define the internal contract of an array with Small Buffer Optimization */
+#ifdef NDEBUG
+#define M_ARRA4_SBO_CONTRACT(a)
+#else
+#define M_ARRA4_SBO_CONTRACT(a) do {                                          \
+    M_ASSERT (a != NULL);                                                     \
+    M_ASSERT (a->size <= a->alloc);                                           \
+    M_ASSERT (a->alloc >= M_ARRA4_SBO_SIZE(a));                               \
+    M_ASSERT (M_ARRA4_SBO_INLINE_P(a) || a->u.ptr != NULL);                   \
+  } while (0)
+#endif
+
+/* Deferred evaluation for the array with Small Buffer Optimization
+   definition (see M_ARRA4_DEF_P1) */
+#define M_ARRA4_SBO_DEF_P1(arg) M_ID( M_ARRA4_SBO_DEF_P2 arg )
+
+/* Validate the oplist before going further */
+#define M_ARRA4_SBO_DEF_P2(name, type, N, oplist, array_t, it_t)              \
+  M_IF_OPLIST(oplist)(M_ARRA4_SBO_DEF_P3, M_ARRA4_SBO_DEF_FAILURE)(name, type, N, oplist, array_t, it_t)
+
+/* Stop processing with a compilation failure */
+#define M_ARRA4_SBO_DEF_FAILURE(name, type, N, oplist, array_t, it_t)         \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(ARRAY_SBO_DEF): the given argument is not a valid oplist: " #oplist)
+
+/* Internal definition:
+   - name: prefix to be used
+   - type: type of the elements of the array
+   - N: number of elements stored within the array object itself
+   - oplist: oplist of the type of the elements of the array
+   - array_t: alias for the type of the array
+   - it_t: alias for the iterator of the array
+   The methods are the same as the one of a dynamic array,
+   so that it shares the same oplist.
+*/
+#define M_ARRA4_SBO_DEF_P3(name, type, N, oplist, array_t, it_t)              \
+  M_ARRA4_SBO_DEF_TYPE(name, type, N, oplist, array_t, it_t)                  \
+  M_CHECK_COMPATIBLE_OPLIST(name, 1, type, oplist)                            \
+  M_ARRA4_SBO_DEF_CORE(name, type, N, oplist, array_t, it_t)                  \
+  M_IF_METHOD(INIT_SET, oplist)(M_ARRA4_SBO_DEF_IF_INIT_SET, M_EAT)(name, type, N, oplist, array_t, it_t) \
+  M_IF_METHOD(INIT, oplist)(M_ARRA4_SBO_DEF_IF_INIT, M_EAT)(name, type, N, oplist, array_t, it_t) \
+  M_ARRA4_SBO_DEF_EXTENDED(name, type, N, oplist, array_t, it_t)              \
+  M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t, M_ARRA4_SBO_CONTRACT, M_ARRA4_FULL_P) \
+  M_EMPLACE_QUEUE_DEF(name, array_t, _emplace_back, oplist, M_ARRA4_EMPLACE_DEF)
+
+/* Define the types */
+#define M_ARRA4_SBO_DEF_TYPE(name, type, N, oplist, array_t, it_t)            \
+                                                                              \
+  /* Define a dynamic array with a small inline buffer.                       \
+     If alloc is N, the elements are stored in u.buf,                         \
+     otherwise they are stored in the heap allocated u.ptr.                   \
+     As no pointer references the object itself, it remains trivially movable */ \
+  typedef struct M_F(name, _s) {                                              \
+    size_t size;            /* Number of elements in the array */             \
+    size_t alloc;           /* Allocated size for the array base */           \
+    union {                                                                   \
+      type *ptr;            /* Pointer to the heap allocated array base */    \
+      type buf[N];          /* Inline array base */                           \
+    } u;                                                                      \
+  } array_t[1];                                                               \
+                                                                              \
+  /* Define an iterator over an array */                                      \
+  typedef struct M_F(name, _it_s) {                                           \
+    size_t index;                       /* Index of the element */            \
+    const struct M_F(name, _s) *array;  /* Reference of the array */          \
+  } it_t[1];                                                                  \
+                                                                              \
+  /* Definition of the synonyms of the type */                                \
+  typedef struct M_F(name, _s) *M_F(name, _ptr);                              \
+  typedef const struct M_F(name, _s) *M_F(name, _srcptr);                     \
+  typedef array_t M_F(name, _ct);                                             \
+  typedef it_t M_F(name, _it_ct);                                             \
+  typedef type M_F(name, _subtype_ct);                                        \
+
+/* Define the core functions */
+#define M_ARRA4_SBO_DEF_CORE(name, type, N, oplist, array_t, it_t)            \
+                                                                              \
+  /* Return the base of the array (inline or heap allocated) */               \
+  M_INLINE type *                                                             \
+  M_C3(m_arra4_,name,_base)(const array_t v)                                  \
+  {                                                                           \
+    /* The array is logically const, not its elements */                      \
+    return M_ARRA4_SBO_INLINE_P(v) ? (type *) (uintptr_t) v->u.buf : v->u.ptr; \
+  }                                                                           \
+                                                                              \
+  /* Change the capacity of the array to 'alloc' elements                     \
+     (which shall be greater or equal than its size).                         \
+     Come back to the inline buffer if possible. */                           \
+  M_P(void, name, _i_realloc, array_t v, size_t alloc)                        \
+  {                                                                           \
+    M_ASSERT (v->size <= alloc);                                              \
+    if (alloc <= N) {                                                         \
+      /* Elements fit in the inline buffer */                                 \
+      if (!M_ARRA4_SBO_INLINE_P(v)) {                                         \
+        type *ptr = v->u.ptr;                                                 \
+        memcpy(v->u.buf, ptr, v->size * sizeof (type));                       \
+        M_CALL_FREE(oplist, type, ptr, v->alloc);                             \
+        v->alloc = N;                                                         \
+      }                                                                       \
+      return;                                                                 \
+    }                                                                         \
+    type *ptr;                                                                \
+    if (M_ARRA4_SBO_INLINE_P(v)) {                                            \
+      ptr = M_CALL_REALLOC(oplist, type, NULL, 0, alloc);                     \
+      if (M_UNLIKELY_NOMEM (ptr == NULL) ) {                                  \
+        M_MEMORY_FULL(type, alloc);                                           \
+      }                                                                       \
+      memcpy(ptr, v->u.buf, v->size * sizeof (type));                         \
+    } else {                                                                  \
+      ptr = M_CALL_REALLOC(oplist, type, v->u.ptr, v->alloc, alloc);          \
+      if (M_UNLIKELY_NOMEM (ptr == NULL) ) {                                  \
+        M_MEMORY_FULL(type, alloc);                                           \
+      }                                                                       \
+    }                                                                         \
+    v->u.ptr = ptr;                                                           \
+    v->alloc = alloc;                                                         \
+  }                                                                           \
+                                                                              \
+  /* Ensure that the array can store at least 'size' elements,                \
+     growing its capacity geometrically */                                    \
+  M_P(type *, name, _i_fit, array_t v, size_t size)                           \
+  {                                                                           \
+    if (M_UNLIKELY (size > v->alloc)) {                                       \
+      size_t alloc = M_CALL_INC_ALLOC(oplist, v->alloc);                      \
+      alloc = M_MAX(alloc, size);                                             \
+      if (M_UNLIKELY_NOMEM (alloc <= v->alloc)) {                             \
+        M_MEMORY_FULL(type, -(size_t)1);                                      \
+      }                                                                       \
+      M_F(name, _i_realloc) M_R(v, alloc);                                    \
+    }                                                                         \
+    return M_C3(m_arra4_,name,_base)(v);                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init)(array_t v)                                                 \
+  {                                                                           \
+    M_ASSERT (v != NULL);                                                     \
+    M_STATIC_ASSERT(N > 0, M_LIB_DIMENSION, "(ARRAY_SBO_DEF): the inline size shall be strictly positive."); \
+    /* Initially, the array is empty and uses its inline buffer */            \
+    v->size  = 0;                                                             \
+    v->alloc = N;                                                             \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reset, array_t v)                                          \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_UNUSED_CONTEXT();                                                       \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    for(size_t i = 0; i < v->size; i++)                                       \
+      M_CALL_CLEAR(oplist, base[i]);                                          \
+    v->size = 0;                                                              \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _clear, array_t v)                                          \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_F(name, _reset) M_R(v);                                                 \
+    if (!M_ARRA4_SBO_INLINE_P(v)) {                                           \
+      M_CALL_FREE(oplist, type, v->u.ptr, v->alloc);                          \
+    }                                                                         \
+    /* This is so reusing the object implies an assertion failure */          \
+    v->alloc = 0;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init_move)(array_t d, array_t s)                                 \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_ARRA4_SBO_CONTRACT(s);                                                  \
+    /* Both the inline elements and the heap pointer are trivially movable */ \
+    *d = *s;                                                                  \
+    /* Robustness */                                                          \
+    s->alloc = 0;                                                             \
+    M_ARRA4_SBO_CONTRACT(d);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _move, array_t d, array_t s)                                \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_F(name, _clear) M_R(d);                                                 \
+    M_F(name, _init_move)(d, s);                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE type  *                                                            \
+  M_F(name, _back)(array_t v)                                                 \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    return &M_C3(m_arra4_,name,_base)(v)[v->size-1];                          \
+  }                                                                           \
+                                                                              \
+  M_P(type *, name, _push_back_raw, array_t v)                                \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    type *base = M_F(name, _i_fit) M_R(v, v->size + 1);                       \
+    type *ret = &base[v->size];                                               \
+    v->size++;                                                                \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSUME(ret != NULL);                                                    \
+    return ret;                                                               \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _push_move, array_t v, type *x)                             \
+  {                                                                           \
+    M_ASSERT (x != NULL);                                                     \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return;                                                                 \
+    M_CALL_INIT_MOVE (oplist, *data, *x);                                     \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reserve, array_t v, size_t alloc)                          \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    /* NOTE: Reserve below needed size to perform a shrink to fit */          \
+    if (v->size > alloc) {                                                    \
+      alloc = v->size;                                                        \
+    }                                                                         \
+    M_F(name, _i_realloc) M_R(v, alloc);                                      \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_back, type *dest, array_t v)                           \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    v->size--;                                                                \
+    if (dest) {                                                               \
+      M_DO_MOVE (oplist, *dest, base[v->size]);                               \
+    } else {                                                                  \
+      M_CALL_CLEAR(oplist, base[v->size]);                                    \
+    }                                                                         \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _pop_move)(type *dest, array_t v)                                 \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    M_ASSERT (dest != NULL);                                                  \
+    v->size--;                                                                \
+    M_CALL_INIT_MOVE (oplist, *dest, M_C3(m_arra4_,name,_base)(v)[v->size]);  \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _empty_p)(const array_t v)                                        \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    return v->size == 0;                                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _size)(const array_t v)                                           \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    return v->size;                                                           \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _capacity)(const array_t v)                                       \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    return v->alloc;                                                          \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_at, type *dest, array_t v, size_t i)                   \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    /* Help the compiler to figure out it stays within the inline buffer */   \
+    M_ASSUME(!M_ARRA4_SBO_INLINE_P(v) || i < N);                              \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    if (dest)                                                                 \
+      M_DO_MOVE (oplist, *dest, base[i]);                                     \
+    else                                                                      \
+      M_CALL_CLEAR(oplist, base[i]);                                          \
+    memmove(&base[i], &base[i+1], sizeof(type)*(v->size-1-i));                \
+    v->size--;                                                                \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _erase, array_t a, size_t i)                                \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(a);                                                  \
+    if (i >= a->size) return false;                                           \
+    M_F(name, _pop_at) M_R(NULL, a, i);                                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _remove_v, array_t v, size_t i, size_t j)                   \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT(i < j);                                                          \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_ASSERT_INDEX(j, v->size+1);                                             \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    for(size_t k = i ; k < j; k++)                                            \
+      M_CALL_CLEAR(oplist, base[k]);                                          \
+    memmove(&base[i], &base[j], sizeof(type)*(v->size - j) );                 \
+    v->size -= (j-i);                                                         \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap)(array_t v1, array_t v2)                                    \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v1);                                                 \
+    M_ARRA4_SBO_CONTRACT(v2);                                                 \
+    M_SWAP(struct M_F(name, _s), *v1, *v2);                                   \
+    M_ARRA4_SBO_CONTRACT(v1);                                                 \
+    M_ARRA4_SBO_CONTRACT(v2);                                                 \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap_at)(array_t v, size_t i, size_t j)                          \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_ASSERT_INDEX(j, v->size);                                               \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    type tmp;                                                                 \
+    M_CALL_INIT_MOVE(oplist, tmp, base[i]);                                   \
+    M_CALL_INIT_MOVE(oplist, base[i], base[j]);                               \
+    M_CALL_INIT_MOVE(oplist, base[j], tmp);                                   \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _get)(const array_t v, size_t i)                                  \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    return &M_C3(m_arra4_,name,_base)(v)[i];                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_F(name, _cget)(const array_t v, size_t i)                                 \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    return M_CONST_CAST(type, &M_C3(m_arra4_,name,_base)(v)[i]);              \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _front)(const array_t v)                                          \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    return M_F(name, _get)(v, 0);                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it)(it_t it, const array_t v)                                    \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = 0;                                                            \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_last)(it_t it, const array_t v)                               \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT (it != NULL);                                                    \
+    /* If size is 0, index is -1 as unsigned, so it is greater than end */    \
+    it->index = v->size - 1;                                                  \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_end)(it_t it, const array_t v)                                \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = v->size;                                                      \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_set)(it_t it, const it_t org)                                 \
+  {                                                                           \
+    M_ASSERT (it != NULL && org != NULL);                                     \
+    it->index = org->index;                                                   \
+    it->array = org->array;                                                   \
+    M_ARRA4_SBO_CONTRACT(it->array);                                          \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _end_p)(const it_t it)                                            \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    return it->index >= it->array->size;                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _last_p)(const it_t it)                                           \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    /* NOTE: Can not compute 'size-1' due to potential overflow               \
+       if size is 0 */                                                        \
+    return it->index + 1 >= it->array->size;                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _it_equal_p)(const it_t it1,                                      \
+                         const it_t it2)                                      \
+  {                                                                           \
+    M_ASSERT(it1 != NULL && it2 != NULL);                                     \
+    return it1->array == it2->array && it1->index == it2->index;              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _next)(it_t it)                                                   \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    it->index ++;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _previous)(it_t it)                                               \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    /* NOTE: In the case index=0, it will be set to (unsigned) -1             \
+       ==> it will be greater than size ==> end_p will return true */         \
+    it->index --;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _ref)(const it_t it)                                              \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_F(name, _get)(it->array, it->index);                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_F(name, _cref)(const it_t it)                                             \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_F(name, _cget)(it->array, it->index);                            \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _remove, array_t a, it_t it)                                \
+  {                                                                           \
+    M_ASSERT (it != NULL && a == it->array);                                  \
+    M_F(name, _pop_at) M_R(NULL, a, it->index);                               \
+    /* NOTE: it->index will naturally point to the next element */            \
+  }                                                                           \
+
+/* Define the functions depending on INIT_SET operator */
+#define M_ARRA4_SBO_DEF_IF_INIT_SET(name, type, N, oplist, array_t, it_t)     \
+  M_IF_METHOD(SET, oplist)(                                                   \
+  M_P(void, name, _set, array_t d, const array_t s)                           \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(d);                                                  \
+    M_ARRA4_SBO_CONTRACT(s);                                                  \
+    if (M_UNLIKELY (d == s)) return;                                          \
+    if (s->size > d->alloc) {                                                 \
+      M_F(name, _i_realloc) M_R(d, s->size);                                  \
+    }                                                                         \
+    type *dbase = M_C3(m_arra4_,name,_base)(d);                               \
+    type *sbase = M_C3(m_arra4_,name,_base)(s);                               \
+    size_t i;                                                                 \
+    size_t step1 = M_MIN(s->size, d->size);                                   \
+    for(i = 0; i < step1; i++)                                                \
+      M_CALL_SET(oplist, dbase[i], sbase[i]);                                 \
+    for( ; i < d->size; i++)                                                  \
+      M_CALL_CLEAR(oplist, dbase[i]);                                         \
+    for( ; i < s->size; i++) {                                                \
+      M_CALL_INIT_SET(oplist, dbase[i], sbase[i]);                            \
+      M_IF_EXCEPTION( d->size = i + 1 );                                      \
+    }                                                                         \
+    d->size = s->size;                                                        \
+    M_ARRA4_SBO_CONTRACT(d);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _init_set, array_t d, const array_t s)                      \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_ON_EXCEPTION(M_F(name, _clear) M_R(d) ) {                               \
+      M_F(name, _init)(d);                                                    \
+      M_F(name, _set) M_R(d, s);                                              \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _set_at, array_t v, size_t i, type const x)                 \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_CALL_SET(oplist, M_C3(m_arra4_,name,_base)(v)[i], x);                   \
+  }                                                                           \
+  , /* No SET */)                                                             \
+                                                                              \
+  M_P(void, name, _push_back, array_t v, type const x)                        \
+  {                                                                           \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return;                                                                 \
+    M_IF_EXCEPTION( v->size --);                                              \
+      M_CALL_INIT_SET(oplist, *data, x);                                      \
+    M_IF_EXCEPTION( v->size ++);                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _push_at, array_t v, size_t key, type const x)              \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(key, v->size+1);                                           \
+    type *base = M_F(name, _i_fit) M_R(v, v->size + 1);                       \
+    memmove(&base[key+1], &base[key], (v->size-key)*sizeof(type));            \
+    M_ON_EXCEPTION( memmove(&base[key], &base[key+1], (v->size-key)*sizeof(type))) { \
+      M_CALL_INIT_SET(oplist, base[key], x);                                  \
+    }                                                                         \
+    v->size++;                                                                \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _insert_n, array_t v, size_t i, size_t num, type const arr[]) \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(i, v->size+1);                                             \
+    size_t size = v->size + num;                                              \
+    /* Test for overflow of variable size */                                  \
+    if (M_UNLIKELY_NOMEM (size <= v->size)) {                                 \
+      /* Unlikely case of nothing to do */                                    \
+      if (num == 0) return;                                                   \
+      M_MEMORY_FULL(type, v->size);                                           \
+    }                                                                         \
+    type *base = M_F(name, _i_fit) M_R(v, size);                              \
+    memmove(&base[i+num], &base[i], sizeof(type)*(v->size - i) );             \
+    m_volatile size_t k;                                                      \
+    M_ON_EXCEPTION(memmove(&base[k], &base[i+num], sizeof(type)*(v->size - i) ), v->size += (k-i) ) { \
+      for(k = i ; k < i+num; k++)                                             \
+        M_CALL_INIT_SET(oplist, base[k], arr[k-i]);                           \
+    }                                                                         \
+    v->size = size;                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _insert, array_t a, it_t it, type const x)                  \
+  {                                                                           \
+    M_ASSERT (it != NULL && a == it->array);                                  \
+    size_t index = M_F(name, _end_p)(it) ? 0 : it->index+1;                   \
+    M_F(name, _push_at)M_R(a, index, x);                                      \
+    it->index = index;                                                        \
+  }                                                                           \
+
+/* Define the functions depending on INIT operator */
+#define M_ARRA4_SBO_DEF_IF_INIT(name, type, N, oplist, array_t, it_t)         \
+  M_P(type *, name, _push_new, array_t v)                                     \
+  {                                                                           \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return NULL;                                                            \
+    M_IF_EXCEPTION( v->size --);                                              \
+    M_CALL_INIT(oplist, *data);                                               \
+    M_IF_EXCEPTION( v->size ++);                                              \
+    return data;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _resize, array_t v, size_t size)                            \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    if (v->size > size) {                                                     \
+      /* Decrease size of array */                                            \
+      for(size_t i = size ; i < v->size; i++)                                 \
+        M_CALL_CLEAR(oplist, base[i]);                                        \
+      v->size = size;                                                         \
+    } else if (v->size < size) {                                              \
+      /* Increase size of array */                                            \
+      if (size > v->alloc) {                                                  \
+        M_F(name, _i_realloc) M_R(v, size);                                   \
+        base = M_C3(m_arra4_,name,_base)(v);                                  \
+      }                                                                       \
+      for(size_t i = v->size ; i < size; i++) {                               \
+        M_CALL_INIT(oplist, base[i]);                                         \
+        M_IF_EXCEPTION( v->size = i+1);                                       \
+      }                                                                       \
+      v->size = size;                                                         \
+    }                                                                         \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+                                                                              \
+  M_P(type *, name, _safe_get, array_t v, size_t idx)                         \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    const size_t size = idx + 1;                                              \
+    type *base = M_C3(m_arra4_,name,_base)(v);                                \
+    /* resize if needed */                                                    \
+    if (v->size <= size) {                                                    \
+      /* Increase size of array */                                            \
+      base = M_F(name, _i_fit) M_R(v, size);                                  \
+      for(size_t i = v->size ; i < size; i++) {                               \
+        M_CALL_INIT(oplist, base[i]);                                         \
+        M_IF_EXCEPTION( v->size = i+1);                                       \
+      }                                                                       \
+      v->size = size;                                                         \
+    }                                                                         \
+    M_ASSERT (idx < v->size);                                                 \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    return &base[idx];                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_until, array_t v, it_t pos)                            \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT (v == pos->array);                                               \
+    M_ASSERT_INDEX(pos->index, v->size+1);                                    \
+    M_F(name, _resize) M_R(v, pos->index);                                    \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _insert_v, array_t v, size_t i, size_t num)                 \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+    M_ASSERT_INDEX(i, v->size+1);                                             \
+    size_t size = v->size + num;                                              \
+    /* Test for overflow of variable size */                                  \
+    if (M_UNLIKELY_NOMEM (size <= v->size)) {                                 \
+      /* Unlikely case of nothing to do */                                    \
+      if (num == 0) return;                                                   \
+      M_MEMORY_FULL(type, v->size);                                           \
+    }                                                                         \
+    type *base = M_F(name, _i_fit) M_R(v, size);                              \
+    memmove(&base[i+num], &base[i], sizeof(type)*(v->size - i) );             \
+    m_volatile size_t k;                                                      \
+    M_ON_EXCEPTION(memmove(&base[k], &base[i+num], sizeof(type)*(v->size - i) ), v->size += (k-i) ) { \
+      for(k = i ; k < i+num; k++)                                             \
+        M_CALL_INIT(oplist, base[k]);                                         \
+    }                                                                         \
+    v->size = size;                                                           \
+    M_ARRA4_SBO_CONTRACT(v);                                                  \
+  }                                                                           \
+
+/* Define the extended functions */
+#define M_ARRA4_SBO_DEF_EXTENDED(name, type, N, oplist, array_t, it_t)        \
+  M_INLINE void M_F(name, _special_sort)(array_t l,                           \
+              int (*func_type) (type const *a, type const *b))                \
+  {                                                                           \
+    int (*func_void)(const void*, const void*);                               \
+    /* There is no way (?) to avoid the cast */                               \
+    func_void = (int (*)(const void*, const void*))func_type;                 \
+    qsort (M_C3(m_arra4_,name,_base)(l), l->size, sizeof(type), func_void);   \
+  }                                                                           \
+                                                                              \
+  M_IF_METHOD3(SWAP, SET, CMP, oplist)(                                       \
+  M_ARRA4_DEF_SORT_NOALLOC(name, type, oplist)                                \
+                                                                              \
+  M_P(void, name, _special_stable_sort, array_t l)                            \
+  {                                                                           \
+    if (M_UNLIKELY (l->size < 2))                                             \
+      return;                                                                 \
+    /* Use a temporary inline buffer if it is big enough */                   \
+    type tmp_buf[N];                                                          \
+    type *temp = tmp_buf;                                                     \
+    if (l->size > N) {                                                        \
+      temp = M_CALL_REALLOC(oplist, type, NULL, 0, l->size);                  \
+      if (M_UNLIKELY_NOMEM (temp == NULL)) {                                  \
+        M_MEMORY_FULL(type, l->size);                                         \
+      }                                                                       \
+    }                                                                         \
+    M_C3(m_arra4_,name,_stable_sort_noalloc)(M_C3(m_arra4_,name,_base)(l), l->size, temp); \
+    if (temp != tmp_buf) {                                                    \
+      M_CALL_FREE(oplist, type, temp, l->size);                               \
+    }                                                                         \
+  }                                                                           \
+  ,) /* IF SWAP & SET & CMP operators */                                      \
+                                                                              \
+  M_ARRA4_DEF_EQUAL(name, type, oplist, array_t, it_t, M_ARRA4_SBO_CONTRACT)  \
+                                                                              \
+  M_IF_METHOD(HASH, oplist)(                                                  \
+  M_INLINE size_t                                                             \
+  M_F(name, _hash)(const array_t array)                                       \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(array);                                              \
+    type *base = M_C3(m_arra4_,name,_base)(array);                            \
+    M_HASH_DECL(hash);                                                        \
+    for(size_t i = 0 ; i < array->size; i++) {                                \
+      size_t hi = M_CALL_HASH(oplist, base[i]);                               \
+      M_HASH_UP(hash, hi);                                                    \
+    }                                                                         \
+    return M_HASH_FINAL (hash);                                               \
+  }                                                                           \
+  , /* no HASH */ )                                                           \
+                                                                              \
+  M_P(void, name, _splice, array_t a1, array_t a2)                            \
+  {                                                                           \
+    M_ARRA4_SBO_CONTRACT(a1);                                                 \
+    M_ARRA4_SBO_CONTRACT(a2);                                                 \
+    M_ASSERT(a1 != a2);                                                       \
+    if (M_LIKELY (a2->size > 0)) {                                            \
+      size_t newSize = a1->size + a2->size;                                   \
+      M_ASSERT_INDEX(a1->size, newSize);                                      \
+      if (newSize > a1->alloc) {                                              \
+        M_F(name, _i_realloc) M_R(a1, newSize);                               \
+      }                                                                       \
+      memcpy(&M_C3(m_arra4_,name,_base)(a1)[a1->size],                        \
+             M_C3(m_arra4_,name,_base)(a2), a2->size * sizeof (type));        \
+      /* a2 is now empty */                                                   \
+      a2->size = 0;                                                           \
+      /* a1 has been expanded with the items of a2 */                         \
+      a1->size = newSize;                                                     \
+    }                                                                         \
+  }                                                                           \
+
+/* Number of elements that can be stored within a fixed capacity array
+   (computed from the type of its inline buffer) */
+#define M_ARRA4_STATIC_SIZE(a)                                                \
+  (sizeof (a)->data / sizeof (a)->data[0])
+
+/* Test if a fixed capacity array cannot receive any new element */
+#define M_ARRA4_STATIC_FULL_P(a)                                              \
+  ((a)->size >= M_ARRA4_STATIC_SIZE(a))
+
+/* Define the internal contract of a fixed capacity array */
+#ifdef NDEBUG
+#define M_ARRA4_STATIC_CONTRACT(a)
+#else
+#define M_ARRA4_STATIC_CONTRACT(a) do {                                       \
+    M_ASSERT (a != NULL);                                                     \
+    M_ASSERT (a->size <= M_ARRA4_STATIC_SIZE(a));                             \
+  } while (0)
+#endif
+
+/* Deferred evaluation for the fixed capacity array definition
+   (see M_ARRA4_DEF_P1) */
+#define M_ARRA4_STATIC_DEF_P1(arg) M_ID( M_ARRA4_STATIC_DEF_P2 arg )
+
+/* Validate the oplist before going further */
+#define M_ARRA4_STATIC_DEF_P2(name, type, N, oplist, array_t, it_t)           \
+  M_IF_OPLIST(oplist)(M_ARRA4_STATIC_DEF_P3, M_ARRA4_STATIC_DEF_FAILURE)(name, type, N, oplist, array_t, it_t)
+
+/* Stop processing with a compilation failure */
+#define M_ARRA4_STATIC_DEF_FAILURE(name, type, N, oplist, array_t, it_t)      \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(STATIC_ARRAY_DEF): the given argument is not a valid oplist: " #oplist)
+
+/* Internal definition:
+   - name: prefix to be used
+   - type: type of the elements of the array
+   - N: maximum number of elements of the array
+   - oplist: oplist of the type of the elements of the array
+   - array_t: alias for the type of the array
+   - it_t: alias for the iterator of the array
+   The methods have the same name as the one of a dynamic array,
+   so that it shares the same oplist.
+*/
+#define M_ARRA4_STATIC_DEF_P3(name, type, N, oplist, array_t, it_t)           \
+  M_ARRA4_STATIC_DEF_TYPE(name, type, N, oplist, array_t, it_t)               \
+  M_CHECK_COMPATIBLE_OPLIST(name, 1, type, oplist)                            \
+  M_ARRA4_STATIC_DEF_CORE(name, type, N, oplist, array_t, it_t)               \
+  M_IF_METHOD(INIT_SET, oplist)(M_ARRA4_STATIC_DEF_IF_INIT_SET, M_EAT)(name, type, N, oplist, array_t, it_t) \
+  M_IF_METHOD(INIT, oplist)(M_ARRA4_STATIC_DEF_IF_INIT, M_EAT)(name, type, N, oplist, array_t, it_t) \
+  M_ARRA4_STATIC_DEF_EXTENDED(name, type, N, oplist, array_t, it_t)           \
+  M_ARRA4_DEF_IO(name, type, oplist, array_t, it_t, M_ARRA4_STATIC_CONTRACT, M_ARRA4_STATIC_FULL_P) \
+  M_EMPLACE_QUEUE_DEF(name, array_t, _emplace_back, oplist, M_ARRA4_STATIC_EMPLACE_DEF)
+
+/* Define the types */
+#define M_ARRA4_STATIC_DEF_TYPE(name, type, N, oplist, array_t, it_t)         \
+                                                                              \
+  /* Define a fixed capacity array */                                         \
+  typedef struct M_F(name, _s) {                                              \
+    size_t size;            /* Number of elements in the array */             \
+    type data[N];           /* Inline array base */                           \
+  } array_t[1];                                                               \
+                                                                              \
+  /* Define an iterator over an array */                                      \
+  typedef struct M_F(name, _it_s) {                                           \
+    size_t index;                       /* Index of the element */            \
+    const struct M_F(name, _s) *array;  /* Reference of the array */          \
+  } it_t[1];                                                                  \
+                                                                              \
+  /* Definition of the synonyms of the type */                                \
+  typedef struct M_F(name, _s) *M_F(name, _ptr);                              \
+  typedef const struct M_F(name, _s) *M_F(name, _srcptr);                     \
+  typedef array_t M_F(name, _ct);                                             \
+  typedef it_t M_F(name, _it_ct);                                             \
+  typedef type M_F(name, _subtype_ct);                                        \
+
+/* Define the core functions */
+#define M_ARRA4_STATIC_DEF_CORE(name, type, N, oplist, array_t, it_t)         \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init)(array_t v)                                                 \
+  {                                                                           \
+    M_ASSERT (v != NULL);                                                     \
+    M_STATIC_ASSERT(N > 0, M_LIB_DIMENSION, "(STATIC_ARRAY_DEF): the capacity shall be strictly positive."); \
+    v->size = 0;                                                              \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reset, array_t v)                                          \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    for(size_t i = 0; i < v->size; i++)                                       \
+      M_CALL_CLEAR(oplist, v->data[i]);                                       \
+    v->size = 0;                                                              \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _clear, array_t v)                                          \
+  {                                                                           \
+    M_F(name, _reset) M_R(v);                                                 \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init_move)(array_t d, array_t s)                                 \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_ARRA4_STATIC_CONTRACT(s);                                               \
+    /* Only the used part of the inline buffer needs to be moved */           \
+    memcpy(d->data, s->data, s->size * sizeof (type));                        \
+    d->size = s->size;                                                        \
+    s->size = 0;                                                              \
+    M_ARRA4_STATIC_CONTRACT(d);                                               \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _move, array_t d, array_t s)                                \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_F(name, _clear) M_R(d);                                                 \
+    M_F(name, _init_move)(d, s);                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE type  *                                                            \
+  M_F(name, _back)(array_t v)                                                 \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    return &v->data[v->size-1];                                               \
+  }                                                                           \
+                                                                              \
+  M_P(type *, name, _push_back_raw, array_t v)                                \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    if (M_UNLIKELY (M_ARRA4_STATIC_FULL_P(v))) {                              \
+      return NULL;                                                            \
+    }                                                                         \
+    type *ret = &v->data[v->size];                                            \
+    v->size++;                                                                \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return ret;                                                               \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _push_move, array_t v, type *x)                             \
+  {                                                                           \
+    M_ASSERT (x != NULL);                                                     \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return false;                                                           \
+    M_CALL_INIT_MOVE (oplist, *data, *x);                                     \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _reserve, array_t v, size_t alloc)                          \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    /* The capacity is fixed: only test if it is enough */                    \
+    return alloc <= N;                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_back, type *dest, array_t v)                           \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    v->size--;                                                                \
+    if (dest) {                                                               \
+      M_DO_MOVE (oplist, *dest, v->data[v->size]);                            \
+    } else {                                                                  \
+      M_CALL_CLEAR(oplist, v->data[v->size]);                                 \
+    }                                                                         \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _pop_move)(type *dest, array_t v)                                 \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    M_ASSERT (dest != NULL);                                                  \
+    v->size--;                                                                \
+    M_CALL_INIT_MOVE (oplist, *dest, v->data[v->size]);                       \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _empty_p)(const array_t v)                                        \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return v->size == 0;                                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _full_p)(const array_t v)                                         \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return M_ARRA4_STATIC_FULL_P(v);                                          \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _size)(const array_t v)                                           \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return v->size;                                                           \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _capacity)(const array_t v)                                       \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return N;                                                                 \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_at, type *dest, array_t v, size_t i)                   \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    if (dest)                                                                 \
+      M_DO_MOVE (oplist, *dest, v->data[i]);                                  \
+    else                                                                      \
+      M_CALL_CLEAR(oplist, v->data[i]);                                       \
+    memmove(&v->data[i], &v->data[i+1], sizeof(type)*(v->size-1-i));          \
+    v->size--;                                                                \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _erase, array_t a, size_t i)                                \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(a);                                               \
+    if (i >= a->size) return false;                                           \
+    M_F(name, _pop_at) M_R(NULL, a, i);                                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _remove_v, array_t v, size_t i, size_t j)                   \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT(i < j);                                                          \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_ASSERT_INDEX(j, v->size+1);                                             \
+    for(size_t k = i ; k < j; k++)                                            \
+      M_CALL_CLEAR(oplist, v->data[k]);                                       \
+    memmove(&v->data[i], &v->data[j], sizeof(type)*(v->size - j) );           \
+    v->size -= (j-i);                                                         \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap)(array_t v1, array_t v2)                                    \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v1);                                              \
+    M_ARRA4_STATIC_CONTRACT(v2);                                              \
+    /* Only the used part of both inline buffers needs to be swapped */       \
+    const size_t size = M_MAX(v1->size, v2->size);                            \
+    for(size_t i = 0; i < size; i++) {                                        \
+      type tmp;                                                               \
+      memcpy(&tmp, &v1->data[i], sizeof (type));                              \
+      memcpy(&v1->data[i], &v2->data[i], sizeof (type));                      \
+      memcpy(&v2->data[i], &tmp, sizeof (type));                              \
+    }                                                                         \
+    M_SWAP(size_t, v1->size, v2->size);                                       \
+    M_ARRA4_STATIC_CONTRACT(v1);                                              \
+    M_ARRA4_STATIC_CONTRACT(v2);                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap_at)(array_t v, size_t i, size_t j)                          \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_ASSERT_INDEX(j, v->size);                                               \
+    type tmp;                                                                 \
+    M_CALL_INIT_MOVE(oplist, tmp, v->data[i]);                                \
+    M_CALL_INIT_MOVE(oplist, v->data[i], v->data[j]);                         \
+    M_CALL_INIT_MOVE(oplist, v->data[j], tmp);                                \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _get)(const array_t v, size_t i)                                  \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    /* The array is logically const, not its elements */                      \
+    return (type *) (uintptr_t) &v->data[i];                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_F(name, _cget)(const array_t v, size_t i)                                 \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    return M_CONST_CAST(type, M_F(name, _get)(v, i));                         \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _front)(const array_t v)                                          \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    return M_F(name, _get)(v, 0);                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it)(it_t it, const array_t v)                                    \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = 0;                                                            \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_last)(it_t it, const array_t v)                               \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT (it != NULL);                                                    \
+    /* If size is 0, index is -1 as unsigned, so it is greater than end */    \
+    it->index = v->size - 1;                                                  \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_end)(it_t it, const array_t v)                                \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = v->size;                                                      \
+    it->array = v;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_set)(it_t it, const it_t org)                                 \
+  {                                                                           \
+    M_ASSERT (it != NULL && org != NULL);                                     \
+    it->index = org->index;                                                   \
+    it->array = org->array;                                                   \
+    M_ARRA4_STATIC_CONTRACT(it->array);                                       \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _end_p)(const it_t it)                                            \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    return it->index >= it->array->size;                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _last_p)(const it_t it)                                           \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    /* NOTE: Can not compute 'size-1' due to potential overflow               \
+       if size is 0 */                                                        \
+    return it->index + 1 >= it->array->size;                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _it_equal_p)(const it_t it1,                                      \
+                         const it_t it2)                                      \
+  {                                                                           \
+    M_ASSERT(it1 != NULL && it2 != NULL);                                     \
+    return it1->array == it2->array && it1->index == it2->index;              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _next)(it_t it)                                                   \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    it->index ++;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _previous)(it_t it)                                               \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->array != NULL);                                \
+    /* NOTE: In the case index=0, it will be set to (unsigned) -1             \
+       ==> it will be greater than size ==> end_p will return true */         \
+    it->index --;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_F(name, _ref)(const it_t it)                                              \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_F(name, _get)(it->array, it->index);                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_F(name, _cref)(const it_t it)                                             \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_F(name, _cget)(it->array, it->index);                            \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _remove, array_t a, it_t it)                                \
+  {                                                                           \
+    M_ASSERT (it != NULL && a == it->array);                                  \
+    M_F(name, _pop_at) M_R(NULL, a, it->index);                               \
+    /* NOTE: it->index will naturally point to the next element */            \
+  }                                                                           \
+
+/* Define the functions depending on INIT_SET operator */
+#define M_ARRA4_STATIC_DEF_IF_INIT_SET(name, type, N, oplist, array_t, it_t)  \
+  M_IF_METHOD(SET, oplist)(                                                   \
+  M_P(void, name, _set, array_t d, const array_t s)                           \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(d);                                               \
+    M_ARRA4_STATIC_CONTRACT(s);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    if (M_UNLIKELY (d == s)) return;                                          \
+    /* Both arrays have the same capacity: it always fits */                  \
+    size_t i;                                                                 \
+    size_t step1 = M_MIN(s->size, d->size);                                   \
+    for(i = 0; i < step1; i++)                                                \
+      M_CALL_SET(oplist, d->data[i], s->data[i]);                             \
+    for( ; i < d->size; i++)                                                  \
+      M_CALL_CLEAR(oplist, d->data[i]);                                       \
+    for( ; i < s->size; i++) {                                                \
+      M_CALL_INIT_SET(oplist, d->data[i], s->data[i]);                        \
+      M_IF_EXCEPTION( d->size = i + 1 );                                      \
+    }                                                                         \
+    d->size = s->size;                                                        \
+    M_ARRA4_STATIC_CONTRACT(d);                                               \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _init_set, array_t d, const array_t s)                      \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_ON_EXCEPTION(M_F(name, _clear) M_R(d) ) {                               \
+      M_F(name, _init)(d);                                                    \
+      M_F(name, _set) M_R(d, s);                                              \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _set_at, array_t v, size_t i, type const x)                 \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_CALL_SET(oplist, v->data[i], x);                                        \
+  }                                                                           \
+  , /* No SET */)                                                             \
+                                                                              \
+  M_P(bool, name, _push_back, array_t v, type const x)                        \
+  {                                                                           \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return false;                                                           \
+    M_IF_EXCEPTION( v->size --);                                              \
+      M_CALL_INIT_SET(oplist, *data, x);                                      \
+    M_IF_EXCEPTION( v->size ++);                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _push_at, array_t v, size_t key, type const x)              \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(key, v->size+1);                                           \
+    if (M_UNLIKELY (M_ARRA4_STATIC_FULL_P(v))) {                              \
+      return false;                                                           \
+    }                                                                         \
+    memmove(&v->data[key+1], &v->data[key], (v->size-key)*sizeof(type));      \
+    M_ON_EXCEPTION( memmove(&v->data[key], &v->data[key+1], (v->size-key)*sizeof(type))) { \
+      M_CALL_INIT_SET(oplist, v->data[key], x);                               \
+    }                                                                         \
+    v->size++;                                                                \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _insert, array_t a, it_t it, type const x)                  \
+  {                                                                           \
+    M_ASSERT (it != NULL && a == it->array);                                  \
+    size_t index = M_F(name, _end_p)(it) ? 0 : it->index+1;                   \
+    if (M_UNLIKELY (!M_F(name, _push_at)M_R(a, index, x))) {                  \
+      return false;                                                           \
+    }                                                                         \
+    it->index = index;                                                        \
+    return true;                                                              \
+  }                                                                           \
+
+/* Define the functions depending on INIT operator */
+#define M_ARRA4_STATIC_DEF_IF_INIT(name, type, N, oplist, array_t, it_t)      \
+  M_P(type *, name, _push_new, array_t v)                                     \
+  {                                                                           \
+    type *data = M_F(name, _push_back_raw) M_R(v);                            \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return NULL;                                                            \
+    M_IF_EXCEPTION( v->size --);                                              \
+    M_CALL_INIT(oplist, *data);                                               \
+    M_IF_EXCEPTION( v->size ++);                                              \
+    return data;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _resize, array_t v, size_t size)                            \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_UNUSED_CONTEXT();                                                       \
+    if (M_UNLIKELY (size > N)) {                                              \
+      return false;                                                           \
+    }                                                                         \
+    if (v->size > size) {                                                     \
+      /* Decrease size of array */                                            \
+      for(size_t i = size ; i < v->size; i++)                                 \
+        M_CALL_CLEAR(oplist, v->data[i]);                                     \
+      v->size = size;                                                         \
+    } else if (v->size < size) {                                              \
+      /* Increase size of array */                                            \
+      for(size_t i = v->size ; i < size; i++) {                               \
+        M_CALL_INIT(oplist, v->data[i]);                                      \
+        M_IF_EXCEPTION( v->size = i+1);                                       \
+      }                                                                       \
+      v->size = size;                                                         \
+    }                                                                         \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(type *, name, _safe_get, array_t v, size_t idx)                         \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    /* Index out of the capacity of the array */                              \
+    if (M_UNLIKELY (idx >= N)) {                                              \
+      return NULL;                                                            \
+    }                                                                         \
+    if (v->size <= idx) {                                                     \
+      M_F(name, _resize) M_R(v, idx + 1);                                     \
+    }                                                                         \
+    M_ASSERT (idx < v->size);                                                 \
+    return &v->data[idx];                                                     \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_until, array_t v, it_t pos)                            \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(v);                                               \
+    M_ASSERT (v == pos->array);                                               \
+    M_ASSERT_INDEX(pos->index, v->size+1);                                    \
+    M_F(name, _resize) M_R(v, pos->index);                                    \
+  }                                                                           \
+
+/* Define the extended functions */
+#define M_ARRA4_STATIC_DEF_EXTENDED(name, type, N, oplist, array_t, it_t)     \
+  M_INLINE void M_F(name, _special_sort)(array_t l,                           \
+              int (*func_type) (type const *a, type const *b))                \
+  {                                                                           \
+    int (*func_void)(const void*, const void*);                               \
+    /* There is no way (?) to avoid the cast */                               \
+    func_void = (int (*)(const void*, const void*))func_type;                 \
+    qsort (l->data, l->size, sizeof(type), func_void);                        \
+  }                                                                           \
+                                                                              \
+  M_IF_METHOD3(SWAP, SET, CMP, oplist)(                                       \
+  M_ARRA4_DEF_SORT_NOALLOC(name, type, oplist)                                \
+                                                                              \
+  M_P(void, name, _special_stable_sort, array_t l)                            \
+  {                                                                           \
+    M_UNUSED_CONTEXT();                                                       \
+    if (M_UNLIKELY (l->size < 2))                                             \
+      return;                                                                 \
+    /* The temporary buffer has the same fixed capacity */                    \
+    type temp[N];                                                             \
+    M_C3(m_arra4_,name,_stable_sort_noalloc)(l->data, l->size, temp);         \
+  }                                                                           \
+  ,) /* IF SWAP & SET & CMP operators */                                      \
+                                                                              \
+  M_ARRA4_DEF_EQUAL(name, type, oplist, array_t, it_t, M_ARRA4_STATIC_CONTRACT) \
+                                                                              \
+  M_IF_METHOD(HASH, oplist)(                                                  \
+  M_INLINE size_t                                                             \
+  M_F(name, _hash)(const array_t array)                                       \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(array);                                           \
+    M_HASH_DECL(hash);                                                        \
+    for(size_t i = 0 ; i < array->size; i++) {                                \
+      size_t hi = M_CALL_HASH(oplist, array->data[i]);                        \
+      M_HASH_UP(hash, hi);                                                    \
+    }                                                                         \
+    return M_HASH_FINAL (hash);                                               \
+  }                                                                           \
+  , /* no HASH */ )                                                           \
+                                                                              \
+  M_P(bool, name, _splice, array_t a1, array_t a2)                            \
+  {                                                                           \
+    M_ARRA4_STATIC_CONTRACT(a1);                                              \
+    M_ARRA4_STATIC_CONTRACT(a2);                                              \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT(a1 != a2);                                                       \
+    size_t newSize = a1->size + a2->size;                                     \
+    if (M_UNLIKELY (newSize > N)) {                                           \
+      /* Nothing is moved if a1 cannot receive all the items of a2 */         \
+      return false;                                                           \
+    }                                                                         \
+    memcpy(&a1->data[a1->size], a2->data, a2->size * sizeof (type));          \
+    /* a2 is now empty */                                                     \
+    a2->size = 0;                                                             \
+    /* a1 has been expanded with the items of a2 */                           \
+    a1->size = newSize;                                                       \
+    return true;                                                              \
+  }                                                                           \
+
+/* Definition of the emplace_back function for fixed capacity arrays */
+#define M_ARRA4_STATIC_EMPLACE_DEF(name, name_t, function_name, oplist, init_func, exp_emplace_type) \
+  M_P(bool, name, function_name, name_t v M_EMPLACE_LIST_TYPE_VAR(a, exp_emplace_type) ) \
+  {                                                                           \
+    M_F(name, _subtype_ct) *data = M_F(name, _push_back_raw) M_R(v);          \
+    if (M_UNLIKELY (data == NULL) )                                           \
+      return false;                                                           \
+    M_IF_EXCEPTION( v->size --);                                              \
+    M_EMPLACE_CALL_FUNC(a, init_func, oplist, *data, exp_emplace_type);       \
+    M_IF_EXCEPTION( v->size ++);                                              \
+    return true;                                                              \
+  }                                                                           \
+
 /********************************** INTERNAL *********************************/
 
 #if M_USE_SMALL_NAME
@@ -1170,6 +2652,13 @@
 #define ARRAY_DEF_AS M_ARRAY_DEF_AS
 #define ARRAY_OPLIST M_ARRAY_OPLIST
 #define ARRAY_INIT_VALUE M_ARRAY_INIT_VALUE
+#define ARRAY_SBO_DEF M_ARRAY_SBO_DEF
+#define ARRAY_SBO_DEF_AS M_ARRAY_SBO_DEF_AS
+#define ARRAY_SBO_OPLIST M_ARRAY_SBO_OPLIST
+#define ARRAY_SBO_INIT_VALUE M_ARRAY_SBO_INIT_VALUE
+#define STATIC_ARRAY_DEF M_STATIC_ARRAY_DEF
+#define STATIC_ARRAY_DEF_AS M_STATIC_ARRAY_DEF_AS
+#define STATIC_ARRAY_OPLIST M_STATIC_ARRAY_OPLIST
 #endif
 
 #endif
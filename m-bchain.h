@@ -0,0 +1,611 @@
+/*
+ * M*LIB - Byte Chain module
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_BCHAIN_H
+#define MSTARLIB_BCHAIN_H
+
+#include "m-core.h"
+#include "m-atomic.h"
+
+/* Scatter / gather I/O (struct iovec for readv / writev) is only
+   available on POSIX systems. */
+#ifndef M_USE_BCHAIN_IOVEC
+# if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#  define M_USE_BCHAIN_IOVEC 1
+# else
+#  define M_USE_BCHAIN_IOVEC 0
+# endif
+#endif
+
+#if M_USE_BCHAIN_IOVEC
+#include <sys/uio.h>
+#endif
+
+M_BEGIN_PROTECTED_CODE
+
+/* Number of bytes of a chunk */
+#ifndef M_USE_BCHAIN_CHUNK_SIZE
+#define M_USE_BCHAIN_CHUNK_SIZE 4096
+#endif
+
+/* A chunk of bytes shared by one or several segments.
+   Bytes are only appended to a chunk which is not shared,
+   so the bytes referenced by a segment are never modified. */
+typedef struct m_bchain_chunk_s {
+  atomic_uint cpt;                      // Number of segments referencing the chunk
+  size_t used;                          // Number of bytes written in the chunk
+  uint8_t data[M_USE_BCHAIN_CHUNK_SIZE];
+} m_bcha1n_chunk_t;
+
+/* A segment references the bytes [begin, end[ of a chunk */
+typedef struct m_bchain_segment_s {
+  struct m_bchain_segment_s *next;      // Next segment of the chain
+  m_bcha1n_chunk_t *chunk;              // Referenced chunk
+  size_t begin;                         // Offset of the first byte in the chunk
+  size_t end;                           // Offset after the last byte in the chunk
+} m_bcha1n_segment_t;
+
+/* A byte chain is a segmented byte buffer:
+   a list of segments referencing fixed size chunks.
+   Appending and consuming bytes are done in O(1) (no realloc, no memmove),
+   and chunks can be shared between byte chains without copying them.
+   The reference counter of the chunks is atomic so that byte chains
+   sharing chunks can be used by different threads. */
+typedef struct m_bchain_s {
+  size_t size;                          // Number of bytes of the chain
+  m_bcha1n_segment_t *head;             // First segment (or NULL if no segment)
+  m_bcha1n_segment_t *tail;             // Last segment (or NULL if no segment)
+  m_bcha1n_segment_t *spare;            // List of empty segments owning a not shared chunk
+} m_bchain_t[1];
+
+/* Define a byte chain pointer (for internal use only) */
+typedef struct m_bchain_s *m_bchain_ptr;
+typedef const struct m_bchain_s *m_bchain_srcptr;
+
+/* PREFIX:
+   m_bcha1n_: private methods
+   m_bchain_: public methods
+*/
+
+/* Contract of a byte chain */
+#define M_BCHA1N_CONTRACT(b) do {                                             \
+    M_ASSERT ((b) != NULL);                                                   \
+    M_ASSERT (((b)->head == NULL) == ((b)->tail == NULL));                    \
+    M_ASSERT ((b)->head != NULL || (b)->size == 0);                           \
+    M_ASSERT ((b)->tail == NULL || (b)->tail->next == NULL);                  \
+  } while (0)
+
+/* Create a new segment referencing 'chunk' or a new empty chunk if NULL */
+M_P(m_bcha1n_segment_t *, m_bcha1n, _new_segment, m_bcha1n_chunk_t *chunk)
+{
+  m_bcha1n_segment_t *seg = M_MEMORY_ALLOC(m_context, m_bcha1n_segment_t);
+  if (M_UNLIKELY_NOMEM (seg == NULL)) {
+    M_MEMORY_FULL(m_bcha1n_segment_t, 1);
+  }
+  if (chunk == NULL) {
+    chunk = M_MEMORY_ALLOC(m_context, m_bcha1n_chunk_t);
+    if (M_UNLIKELY_NOMEM (chunk == NULL)) {
+      M_MEMORY_FULL(m_bcha1n_chunk_t, 1);
+    }
+    atomic_init(&chunk->cpt, 1U);
+    chunk->used = 0;
+  } else {
+    atomic_fetch_add(&chunk->cpt, 1U);
+  }
+  seg->next  = NULL;
+  seg->chunk = chunk;
+  seg->begin = seg->end = 0;
+  return seg;
+}
+
+/* Free the segment and release its reference to the chunk */
+M_P(void, m_bcha1n, _free_segment, m_bcha1n_segment_t *seg)
+{
+  if (atomic_fetch_sub(&seg->chunk->cpt, 1U) == 1U) {
+    M_MEMORY_DEL(m_context, seg->chunk);
+  }
+  M_MEMORY_DEL(m_context, seg);
+}
+
+/* Free a list of segments */
+M_P(void, m_bcha1n, _free_list, m_bcha1n_segment_t *seg)
+{
+  while (seg != NULL) {
+    m_bcha1n_segment_t *next = seg->next;
+    m_bcha1n_free_segment M_R(seg);
+    seg = next;
+  }
+}
+
+/* Return true if bytes can be appended to the segment:
+   it ends at the end of the written bytes of its chunk,
+   the chunk is not full and not shared */
+M_INLINE bool
+m_bcha1n_writable_p(const m_bcha1n_segment_t *seg)
+{
+  return seg != NULL && seg->end == seg->chunk->used
+    && seg->end < M_USE_BCHAIN_CHUNK_SIZE
+    && atomic_load(&seg->chunk->cpt) == 1U;
+}
+
+/* Append the segment at the end of the chain */
+M_INLINE void
+m_bcha1n_link_back(m_bchain_t b, m_bcha1n_segment_t *seg)
+{
+  seg->next = NULL;
+  if (b->tail == NULL) {
+    b->head = seg;
+  } else {
+    b->tail->next = seg;
+  }
+  b->tail = seg;
+  b->size += seg->end - seg->begin;
+}
+
+/* Get an empty writable segment from the spare list or a new one */
+M_P(m_bcha1n_segment_t *, m_bcha1n, _get_spare, m_bchain_t b)
+{
+  m_bcha1n_segment_t *seg = b->spare;
+  if (seg != NULL) {
+    b->spare = seg->next;
+    seg->next = NULL;
+    return seg;
+  }
+  return m_bcha1n_new_segment M_R(NULL);
+}
+
+/* Release the first segment of the chain (which shall be fully consumed).
+   If its chunk is not shared, it is kept for writing if there is no spare. */
+M_P(void, m_bcha1n, _release_head, m_bchain_t b)
+{
+  m_bcha1n_segment_t *seg = b->head;
+  M_ASSERT (seg != NULL && seg->begin == seg->end);
+  b->head = seg->next;
+  if (b->head == NULL) {
+    b->tail = NULL;
+  }
+  if (b->spare == NULL && atomic_load(&seg->chunk->cpt) == 1U) {
+    seg->chunk->used = 0;
+    seg->begin = seg->end = 0;
+    seg->next = NULL;
+    b->spare = seg;
+  } else {
+    m_bcha1n_free_segment M_R(seg);
+  }
+}
+
+M_INLINE void
+m_bchain_init(m_bchain_t b)
+{
+  b->size  = 0;
+  b->head  = NULL;
+  b->tail  = NULL;
+  b->spare = NULL;
+  M_BCHA1N_CONTRACT(b);
+}
+
+/* Remove all the bytes of the chain (keeping the spare chunks) */
+M_P(void, m_bchain, _reset, m_bchain_t b)
+{
+  M_BCHA1N_CONTRACT(b);
+  m_bcha1n_free_list M_R(b->head);
+  b->head = b->tail = NULL;
+  b->size = 0;
+  M_BCHA1N_CONTRACT(b);
+}
+
+M_P(void, m_bchain, _clear, m_bchain_t b)
+{
+  M_BCHA1N_CONTRACT(b);
+  m_bcha1n_free_list M_R(b->head);
+  m_bcha1n_free_list M_R(b->spare);
+  /* Ensure that the chain can't be used anymore */
+  b->head = b->tail = b->spare = NULL;
+  b->size = SIZE_MAX;
+}
+
+M_INLINE size_t
+m_bchain_size(const m_bchain_t b)
+{
+  M_BCHA1N_CONTRACT(b);
+  return b->size;
+}
+
+M_INLINE bool
+m_bchain_empty_p(const m_bchain_t b)
+{
+  M_BCHA1N_CONTRACT(b);
+  return b->size == 0;
+}
+
+/* Return the number of segments of the chain */
+M_INLINE size_t
+m_bchain_segment_count(const m_bchain_t b)
+{
+  M_BCHA1N_CONTRACT(b);
+  size_t n = 0;
+  for(const m_bcha1n_segment_t *seg = b->head; seg != NULL; seg = seg->next) {
+    n++;
+  }
+  return n;
+}
+
+/* Append the 'n' bytes of 'buffer' at the end of the chain */
+M_P(void, m_bchain, _push_back_bytes, m_bchain_t b, size_t n, const void *buffer)
+{
+  M_BCHA1N_CONTRACT(b);
+  M_ASSERT (buffer != NULL || n == 0);
+  const uint8_t *src = (const uint8_t *) buffer;
+  while (n > 0) {
+    if (!m_bcha1n_writable_p(b->tail)) {
+      m_bcha1n_link_back(b, m_bcha1n_get_spare M_R(b));
+    }
+    m_bcha1n_segment_t *seg = b->tail;
+    size_t k = M_MIN(n, (size_t) M_USE_BCHAIN_CHUNK_SIZE - seg->end);
+    memcpy(&seg->chunk->data[seg->end], src, k);
+    seg->end += k;
+    seg->chunk->used = seg->end;
+    b->size += k;
+    src += k;
+    n -= k;
+  }
+  M_BCHA1N_CONTRACT(b);
+}
+
+M_P(void, m_bchain, _push_back, m_bchain_t b, uint8_t c)
+{
+  m_bchain_push_back_bytes M_R(b, 1, &c);
+}
+
+/* Copy the 'n' first bytes of the chain in 'buffer' without consuming them */
+M_INLINE void
+m_bchain_peek_bytes(const m_bchain_t b, size_t n, void *buffer)
+{
+  M_BCHA1N_CONTRACT(b);
+  M_ASSERT (n <= b->size);
+  uint8_t *dst = (uint8_t *) buffer;
+  for(const m_bcha1n_segment_t *seg = b->head; n > 0; seg = seg->next) {
+    size_t k = M_MIN(n, seg->end - seg->begin);
+    memcpy(dst, &seg->chunk->data[seg->begin], k);
+    dst += k;
+    n -= k;
+  }
+}
+
+/* Remove the 'n' first bytes of the chain */
+M_P(void, m_bchain, _consume, m_bchain_t b, size_t n)
+{
+  M_BCHA1N_CONTRACT(b);
+  M_ASSERT (n <= b->size);
+  b->size -= n;
+  while (n > 0) {
+    m_bcha1n_segment_t *seg = b->head;
+    size_t k = M_MIN(n, seg->end - seg->begin);
+    seg->begin += k;
+    n -= k;
+    if (seg->begin == seg->end) {
+      m_bcha1n_release_head M_R(b);
+    }
+  }
+  M_BCHA1N_CONTRACT(b);
+}
+
+/* Copy the 'n' first bytes of the chain in 'buffer' and remove them */
+M_P(void, m_bchain, _pop_front_bytes, size_t n, void *buffer, m_bchain_t b)
+{
+  m_bchain_peek_bytes(b, n, buffer);
+  m_bchain_consume M_R(b, n);
+}
+
+/* Move the 'n' first bytes of 'src' at the end of 'dst' without copying them.
+   Complete segments are moved, a partially moved segment shares its chunk
+   between both chains. */
+M_P(void, m_bchain, _splice_back_bytes, m_bchain_t dst, m_bchain_t src, size_t n)
+{
+  M_BCHA1N_CONTRACT(dst);
+  M_BCHA1N_CONTRACT(src);
+  M_ASSERT (dst != src);
+  M_ASSERT (n <= src->size);
+  while (n > 0) {
+    m_bcha1n_segment_t *seg = src->head;
+    size_t len = seg->end - seg->begin;
+    if (len <= n) {
+      // Move the whole segment
+      src->head = seg->next;
+      if (src->head == NULL) {
+        src->tail = NULL;
+      }
+      src->size -= len;
+      m_bcha1n_link_back(dst, seg);
+      n -= len;
+    } else {
+      // Split the segment: both chains reference the chunk
+      m_bcha1n_segment_t *part = m_bcha1n_new_segment M_R(seg->chunk);
+      part->begin = seg->begin;
+      part->end   = seg->begin + n;
+      seg->begin += n;
+      src->size -= n;
+      m_bcha1n_link_back(dst, part);
+      n = 0;
+    }
+  }
+  M_BCHA1N_CONTRACT(dst);
+  M_BCHA1N_CONTRACT(src);
+}
+
+/* Move all the bytes of 'src' at the end of 'dst' in O(1) */
+M_INLINE void
+m_bchain_splice_back(m_bchain_t dst, m_bchain_t src)
+{
+  M_BCHA1N_CONTRACT(dst);
+  M_BCHA1N_CONTRACT(src);
+  M_ASSERT (dst != src);
+  if (src->head != NULL) {
+    if (dst->tail == NULL) {
+      dst->head = src->head;
+    } else {
+      dst->tail->next = src->head;
+    }
+    dst->tail = src->tail;
+    dst->size += src->size;
+    src->head = src->tail = NULL;
+    src->size = 0;
+  }
+  M_BCHA1N_CONTRACT(dst);
+  M_BCHA1N_CONTRACT(src);
+}
+
+/* Append to 'dst' the bytes of 'src' by sharing its chunks (no copy) */
+M_P(void, m_bcha1n, _share_back, m_bchain_t dst, const m_bchain_t src)
+{
+  for(const m_bcha1n_segment_t *seg = src->head; seg != NULL; seg = seg->next) {
+    m_bcha1n_segment_t *copy = m_bcha1n_new_segment M_R(seg->chunk);
+    copy->begin = seg->begin;
+    copy->end   = seg->end;
+    m_bcha1n_link_back(dst, copy);
+  }
+}
+
+/* Initialize 'b' with the same bytes than 'src' in O(number of segments):
+   the chunks are shared, not copied */
+M_P(void, m_bchain, _init_set, m_bchain_t b, const m_bchain_t src)
+{
+  M_BCHA1N_CONTRACT(src);
+  m_bchain_init(b);
+  m_bcha1n_share_back M_R(b, src);
+  M_BCHA1N_CONTRACT(b);
+}
+
+M_P(void, m_bchain, _set, m_bchain_t b, const m_bchain_t src)
+{
+  M_BCHA1N_CONTRACT(b);
+  M_BCHA1N_CONTRACT(src);
+  if (b != src) {
+    m_bchain_reset M_R(b);
+    m_bcha1n_share_back M_R(b, src);
+  }
+  M_BCHA1N_CONTRACT(b);
+}
+
+M_INLINE void
+m_bchain_init_move(m_bchain_t b, m_bchain_t src)
+{
+  M_BCHA1N_CONTRACT(src);
+  *b = *src;
+  /* Ensure that the source can't be used anymore */
+  src->head = src->tail = src->spare = NULL;
+  src->size = SIZE_MAX;
+  M_BCHA1N_CONTRACT(b);
+}
+
+M_P(void, m_bchain, _move, m_bchain_t b, m_bchain_t src)
+{
+  M_ASSERT (b != src);
+  m_bchain_clear M_R(b);
+  m_bchain_init_move(b, src);
+}
+
+M_INLINE void
+m_bchain_swap(m_bchain_t b1, m_bchain_t b2)
+{
+  M_BCHA1N_CONTRACT(b1);
+  M_BCHA1N_CONTRACT(b2);
+  M_SWAP(size_t, b1->size, b2->size);
+  M_SWAP(m_bcha1n_segment_t *, b1->head, b2->head);
+  M_SWAP(m_bcha1n_segment_t *, b1->tail, b2->tail);
+  M_SWAP(m_bcha1n_segment_t *, b1->spare, b2->spare);
+  M_BCHA1N_CONTRACT(b1);
+  M_BCHA1N_CONTRACT(b2);
+}
+
+/* Return true if both chains have the same bytes */
+M_INLINE bool
+m_bchain_equal_p(const m_bchain_t b1, const m_bchain_t b2)
+{
+  M_BCHA1N_CONTRACT(b1);
+  M_BCHA1N_CONTRACT(b2);
+  if (b1->size != b2->size) {
+    return false;
+  }
+  const m_bcha1n_segment_t *s1 = b1->head, *s2 = b2->head;
+  size_t o1 = s1 == NULL ? 0 : s1->begin, o2 = s2 == NULL ? 0 : s2->begin;
+  size_t n = b1->size;
+  while (n > 0) {
+    size_t k = M_MIN(s1->end - o1, s2->end - o2);
+    if (memcmp(&s1->chunk->data[o1], &s2->chunk->data[o2], k) != 0) {
+      return false;
+    }
+    o1 += k;
+    o2 += k;
+    n  -= k;
+    if (o1 == s1->end && s1->next != NULL) {
+      s1 = s1->next;
+      o1 = s1->begin;
+    }
+    if (o2 == s2->end && s2->next != NULL) {
+      s2 = s2->next;
+      o2 = s2->begin;
+    }
+  }
+  return true;
+}
+
+#if M_USE_BCHAIN_IOVEC
+
+/* Fill 'iov' with at most 'n' entries referencing the bytes of the chain
+   (in order) and return the number of filled entries.
+   Typical usage is to call writev with them, then m_bchain_consume
+   with the number of written bytes. */
+M_INLINE size_t
+m_bchain_get_iovec(const m_bchain_t b, size_t n, struct iovec iov[])
+{
+  M_BCHA1N_CONTRACT(b);
+  size_t i = 0;
+  for(const m_bcha1n_segment_t *seg = b->head; seg != NULL && i < n; seg = seg->next) {
+    iov[i].iov_base = (void *) (uintptr_t) &seg->chunk->data[seg->begin];
+    iov[i].iov_len  = seg->end - seg->begin;
+    i++;
+  }
+  return i;
+}
+
+/* Fill 'iov' with at most 'n' entries referencing free space at the end
+   of the chain for at least 'size' bytes (if 'n' is big enough)
+   and return the number of filled entries.
+   Typical usage is to call readv with them, then m_bchain_commit
+   with the number of read bytes, without any other operation on the chain
+   in between. */
+M_P(size_t, m_bchain, _reserve_iovec, m_bchain_t b, size_t size, size_t n, struct iovec iov[])
+{
+  M_BCHA1N_CONTRACT(b);
+  size_t i = 0;
+  if (n > 0 && m_bcha1n_writable_p(b->tail)) {
+    m_bcha1n_segment_t *seg = b->tail;
+    iov[0].iov_base = &seg->chunk->data[seg->end];
+    iov[0].iov_len  = M_USE_BCHAIN_CHUNK_SIZE - seg->end;
+    size -= M_MIN(size, iov[0].iov_len);
+    i++;
+  }
+  // Then the spare chunks (allocating new ones if needed)
+  m_bcha1n_segment_t **last = &b->spare;
+  while (i < n && (size > 0 || *last != NULL)) {
+    if (*last == NULL) {
+      *last = m_bcha1n_new_segment M_R(NULL);
+    }
+    iov[i].iov_base = &(*last)->chunk->data[0];
+    iov[i].iov_len  = M_USE_BCHAIN_CHUNK_SIZE;
+    size -= M_MIN(size, (size_t) M_USE_BCHAIN_CHUNK_SIZE);
+    last = &(*last)->next;
+    i++;
+  }
+  return i;
+}
+
+/* Add to the chain the 'n' first bytes written in the free space
+   returned by m_bchain_reserve_iovec */
+M_P(void, m_bchain, _commit, m_bchain_t b, size_t n)
+{
+  M_BCHA1N_CONTRACT(b);
+  M_UNUSED_CONTEXT();
+  while (n > 0) {
+    if (!m_bcha1n_writable_p(b->tail)) {
+      M_ASSERT (b->spare != NULL);
+      m_bcha1n_segment_t *seg = b->spare;
+      b->spare = seg->next;
+      m_bcha1n_link_back(b, seg);
+    }
+    m_bcha1n_segment_t *seg = b->tail;
+    size_t k = M_MIN(n, (size_t) M_USE_BCHAIN_CHUNK_SIZE - seg->end);
+    seg->end += k;
+    seg->chunk->used = seg->end;
+    b->size += k;
+    n -= k;
+  }
+  M_BCHA1N_CONTRACT(b);
+}
+
+#endif
+
+#ifndef M_USE_CONTEXT
+#define M_BCHAIN_OPLIST                                                       \
+  (INIT(m_bchain_init), INIT_SET(m_bchain_init_set), SET(m_bchain_set),       \
+   INIT_MOVE(m_bchain_init_move), MOVE(m_bchain_move),                        \
+   SWAP(m_bchain_swap), RESET(m_bchain_reset), EMPTY_P(m_bchain_empty_p),     \
+   SUBTYPE(uint8_t), PUSH(m_bchain_push_back), GET_SIZE(m_bchain_size),       \
+   CLEAR(m_bchain_clear), EQUAL(m_bchain_equal_p),                            \
+   TYPE(m_bchain_t), GENTYPE(struct m_bchain_s*)                              \
+   )
+#else
+#define M_BCHAIN_OPLIST                                                       \
+  (INIT(m_bchain_init), INIT_SET(API_0P(m_bchain_init_set)), SET(API_0P(m_bchain_set)), \
+   INIT_MOVE(m_bchain_init_move), MOVE(API_0P(m_bchain_move)),                \
+   SWAP(m_bchain_swap), RESET(API_0P(m_bchain_reset)), EMPTY_P(m_bchain_empty_p), \
+   SUBTYPE(uint8_t), PUSH(API_0P(m_bchain_push_back)), GET_SIZE(m_bchain_size), \
+   CLEAR(API_0P(m_bchain_clear)), EQUAL(m_bchain_equal_p),                    \
+   TYPE(m_bchain_t), GENTYPE(struct m_bchain_s*)                              \
+   )
+#endif
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_bchain_t() M_BCHAIN_OPLIST
+
+M_END_PROTECTED_CODE
+
+/********************************************************************************/
+/*                                                                              */
+/* Define the small name (i.e. without the prefix) of the API provided by this  */
+/* header if it is needed                                                       */
+/*                                                                              */
+/********************************************************************************/
+#if M_USE_SMALL_NAME
+
+#define bchain_t m_bchain_t
+#define bchain_init m_bchain_init
+#define bchain_reset m_bchain_reset
+#define bchain_clear m_bchain_clear
+#define bchain_size m_bchain_size
+#define bchain_empty_p m_bchain_empty_p
+#define bchain_segment_count m_bchain_segment_count
+#define bchain_push_back_bytes m_bchain_push_back_bytes
+#define bchain_push_back m_bchain_push_back
+#define bchain_peek_bytes m_bchain_peek_bytes
+#define bchain_consume m_bchain_consume
+#define bchain_pop_front_bytes m_bchain_pop_front_bytes
+#define bchain_splice_back_bytes m_bchain_splice_back_bytes
+#define bchain_splice_back m_bchain_splice_back
+#define bchain_init_set m_bchain_init_set
+#define bchain_set m_bchain_set
+#define bchain_init_move m_bchain_init_move
+#define bchain_move m_bchain_move
+#define bchain_swap m_bchain_swap
+#define bchain_equal_p m_bchain_equal_p
+#define bchain_get_iovec m_bchain_get_iovec
+#define bchain_reserve_iovec m_bchain_reserve_iovec
+#define bchain_commit m_bchain_commit
+#define BCHAIN_OPLIST M_BCHAIN_OPLIST
+#define M_OPL_bchain_t() M_BCHAIN_OPLIST
+
+#endif
+
+#endif
@@ -104,7 +104,7 @@ m_bitset_reset(m_bitset_t t)
 M_P(void, m_bitset, _clear, m_bitset_t t)
 {
   m_bitset_reset(t);
-  M_MEMORY_FREE(m_context, m_b1tset_limb_ct, t->ptr, t->alloc);
+  M_VMEM_FREE(m_context, m_b1tset_limb_ct, t->ptr, t->alloc);
   // This is not really needed, but is safer
   // This representation is invalid and will be detected by the contract.
   // A C compiler should be able to optimize out theses initializations.
@@ -122,7 +122,7 @@ M_P(void, m_bitset, _set, m_bitset_t d, const m_bitset_t s)
   if (M_LIKELY (s->size > 0)) {
     // Test if enough space in target
     if (s->size > M_B1TSET_FROM_ALLOC (d->alloc)) {
-      m_b1tset_limb_ct *ptr = M_MEMORY_REALLOC (m_context, m_b1tset_limb_ct, d->ptr, d->alloc, needAlloc);
+      m_b1tset_limb_ct *ptr = M_VMEM_REALLOC (m_context, m_b1tset_limb_ct, d->ptr, d->alloc, needAlloc);
       if (M_UNLIKELY_NOMEM (ptr == NULL)) {
         M_MEMORY_FULL(m_b1tset_limb_ct, needAlloc);
       }
@@ -209,7 +209,7 @@ M_P(void, m_bitset, _push_back, m_bitset_t v, bool x)
       M_MEMORY_FULL(m_b1tset_limb_ct, needAlloc);
     }
     // Alloc memory
-    m_b1tset_limb_ct *ptr = M_MEMORY_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, needAlloc);
+    m_b1tset_limb_ct *ptr = M_VMEM_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, needAlloc);
     // Check if success
     if (M_UNLIKELY_NOMEM (ptr == NULL) ) {
       M_MEMORY_FULL(m_b1tset_limb_ct, needAlloc);
@@ -245,7 +245,7 @@ M_P(void, m_bitset, _resize, m_bitset_t v, size_t size)
   size_t newAlloc = M_B1TSET_TO_ALLOC (size);
   if (newAlloc > v->alloc) {
     // Allocate more limbs to store the bitset.
-    m_b1tset_limb_ct *ptr = M_MEMORY_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, newAlloc);
+    m_b1tset_limb_ct *ptr = M_VMEM_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, newAlloc);
     if (M_UNLIKELY_NOMEM (ptr == NULL) ) {
       M_MEMORY_FULL(m_b1tset_limb_ct, newAlloc);
     }
@@ -290,12 +290,12 @@ M_P(void, m_bitset, _reserve, m_bitset_t v, size_t alloc)
   }
   if (M_UNLIKELY (newAlloc == 0)) {
     // Free all memory used by the bitsets
-    M_MEMORY_FREE (m_context, m_b1tset_limb_ct, v->ptr, v->alloc);
+    M_VMEM_FREE (m_context, m_b1tset_limb_ct, v->ptr, v->alloc);
     v->size = v->alloc = 0;
     v->ptr = NULL;
   } else {
     // Allocate more memory or reduce memory usage
-    m_b1tset_limb_ct *ptr = M_MEMORY_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, newAlloc);
+    m_b1tset_limb_ct *ptr = M_VMEM_REALLOC (m_context, m_b1tset_limb_ct, v->ptr, v->alloc, newAlloc);
     if (M_UNLIKELY_NOMEM (ptr == NULL) ) {
       M_MEMORY_FULL(m_b1tset_limb_ct, newAlloc);
     }
@@ -833,6 +833,59 @@ m_bitset_popcount(const m_bitset_t set)
   return s;
 }
 
+/* Return the number of bytes needed by the flat image of the bitset */
+M_INLINE size_t
+m_bitset_image_size(const m_bitset_t set)
+{
+  M_B1TSET_CONTRACT(set);
+  return M_CORE_IMAGE_ALIGN
+    + m_core_image_section_size(M_B1TSET_TO_ALLOC(set->size), sizeof(m_b1tset_limb_ct));
+}
+
+/* Write the flat image of the bitset in the buffer 'image' of 'len' bytes.
+   Return the number of bytes written, or 0 if the buffer is too small */
+M_INLINE size_t
+m_bitset_to_image(void *image, size_t len, const m_bitset_t set)
+{
+  M_B1TSET_CONTRACT(set);
+  const size_t size = m_bitset_image_size(set);
+  if (M_UNLIKELY (image == NULL || len < size)) return 0;
+  char *p = (char *) m_core_image_set_header(image, M_CORE_IMAGE_KIND('B','I','T','S'),
+                                             sizeof(m_b1tset_limb_ct), set->size, 0, 0, 0, 0);
+  const size_t n = M_B1TSET_TO_ALLOC(set->size) * sizeof(m_b1tset_limb_ct);
+  if (n != 0) memcpy(p, set->ptr, n);
+  memset(p + n, 0, size - M_CORE_IMAGE_ALIGN - n);
+  return size;
+}
+
+/* Make 'view' a read-only bitset referencing the flat image 'image' of 'len' bytes
+   without copying it. The view shall neither be modified nor cleared.
+   Return false if the image is not a valid bitset image */
+M_INLINE bool
+m_bitset_view_from_image(m_bitset_t view, const void *image, size_t len)
+{
+  const m_core_image_header_t *header =
+    m_core_image_get_header(image, len, M_CORE_IMAGE_KIND('B','I','T','S'), sizeof(m_b1tset_limb_ct));
+  if (M_UNLIKELY (header == NULL)) return false;
+  const size_t size = (size_t) header->count;
+  if (M_UNLIKELY (size >= ((size_t)-1) - M_B1TSET_LIMB_BIT)) return false;
+  const size_t alloc = M_B1TSET_TO_ALLOC(size);
+  if (M_UNLIKELY (m_core_image_section_size(alloc, sizeof(m_b1tset_limb_ct)) > len - M_CORE_IMAGE_ALIGN))
+    return false;
+  const char *p = (const char *) image + M_CORE_IMAGE_ALIGN;
+  if (M_UNLIKELY (!m_core_image_aligned_p(p, sizeof(m_b1tset_limb_ct)))) return false;
+  const m_b1tset_limb_ct *limb = (const m_b1tset_limb_ct *) (const void *) p;
+  // The bits after the last one shall be cleared
+  if (size % M_B1TSET_LIMB_BIT != 0
+      && (limb[alloc-1] >> (size % M_B1TSET_LIMB_BIT)) != 0) return false;
+  view->size = size;
+  view->alloc = alloc;
+  /* The view is read-only: the constness of the image is restored by the API */
+  view->ptr = alloc == 0 ? NULL : (m_b1tset_limb_ct *) (uintptr_t) limb;
+  M_B1TSET_CONTRACT(view);
+  return true;
+}
+
 /* Oplist for a bitset */
 #ifndef M_USE_CONTEXT
 #define M_BITSET_OPLIST                                                       \
@@ -966,6 +1019,9 @@ m_bitset_popcount(const m_bitset_t set)
 #define bitset_clz m_bitset_clz
 #define bitset_ctz m_bitset_ctz
 #define bitset_popcount m_bitset_popcount
+#define bitset_image_size m_bitset_image_size
+#define bitset_to_image m_bitset_to_image
+#define bitset_view_from_image m_bitset_view_from_image
 #define bitset_get_str m_bitset_get_str
 
 #define BITSET_OPLIST    M_BITSET_OPLIST
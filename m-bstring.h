@@ -445,6 +445,344 @@ m_bstring_release_access(m_bstring_t v)
     M_BSTRING_CONTRACT (v);
 }
 
+/* Index returned in case of error instead of the position within the byte string */
+#define M_BSTRING_FAILURE ((size_t)-1)
+
+/* The search functions use the libc memchr (which is vectorized)
+   or process the buffer per words of 8 bytes (SWAR). */
+#define M_BSTR1NG_HIGH_BITS UINT64_C(0x8080808080808080)
+#define M_BSTR1NG_LOW_BITS  UINT64_C(0x0101010101010101)
+
+/* Maximum size of the set of find_any_of to process it per words */
+#define M_BSTR1NG_ANY_OF_SWAR_MAX 4
+
+/* Load a word of 8 bytes from the (unaligned) buffer */
+M_INLINE uint64_t
+m_bstr1ng_load64(const uint8_t buf[])
+{
+    uint64_t w;
+    memcpy(&w, buf, sizeof w);
+    return w;
+}
+
+/* Return a word with the high bit set for exactly each zero byte of w */
+M_INLINE uint64_t
+m_bstr1ng_zero_bytes64(uint64_t w)
+{
+    const uint64_t low7 = ~M_BSTR1NG_HIGH_BITS;
+    return ~(((w & low7) + low7) | w | low7);
+}
+
+/* Return the position of the first byte 'c' from position 'start'
+   or M_BSTRING_FAILURE if not found */
+M_INLINE size_t
+m_bstring_find_byte(const m_bstring_t v, uint8_t c, size_t start)
+{
+    M_BSTRING_CONTRACT (v);
+    M_ASSERT_INDEX (start, v->size + 1);
+    const uint8_t *base = m_bstr1ng_cstr(v);
+    if (start >= v->size) {
+        return M_BSTRING_FAILURE;
+    }
+    const uint8_t *p = (const uint8_t *) memchr(&base[start], c, v->size - start);
+    return p == NULL ? M_BSTRING_FAILURE : (size_t) (p - base);
+}
+
+/* Return the position of the first occurrence of the 'n' bytes of 'pattern'
+   from position 'start' or M_BSTRING_FAILURE if not found */
+M_INLINE size_t
+m_bstring_find_bytes(const m_bstring_t v, size_t n, const void *pattern, size_t start)
+{
+    M_BSTRING_CONTRACT (v);
+    M_ASSERT_INDEX (start, v->size + 1);
+    M_ASSERT (pattern != NULL || n == 0);
+    const uint8_t *pat = (const uint8_t *) pattern;
+    if (n == 0) {
+        return start;
+    }
+    if (n > v->size || start > v->size - n) {
+        return M_BSTRING_FAILURE;
+    }
+    const uint8_t *base = m_bstr1ng_cstr(v);
+    const uint8_t *p    = &base[start];
+    // Last position where the pattern may start
+    const uint8_t *last = &base[v->size - n];
+    while (p <= last) {
+        // Find the first byte, then filter by the last byte before comparing
+        p = (const uint8_t *) memchr(p, pat[0], (size_t) (last - p) + 1);
+        if (p == NULL) {
+            break;
+        }
+        if (p[n-1] == pat[n-1] && memcmp(p, pat, n) == 0) {
+            return (size_t) (p - base);
+        }
+        p++;
+    }
+    return M_BSTRING_FAILURE;
+}
+
+/* Return the position of the first byte which is one of the 'n' bytes of 'set'
+   from position 'start' or M_BSTRING_FAILURE if not found */
+M_INLINE size_t
+m_bstring_find_any_of(const m_bstring_t v, size_t n, const void *set, size_t start)
+{
+    M_BSTRING_CONTRACT (v);
+    M_ASSERT_INDEX (start, v->size + 1);
+    M_ASSERT (set != NULL || n == 0);
+    const uint8_t *s = (const uint8_t *) set;
+    if (n == 1) {
+        return m_bstring_find_byte(v, s[0], start);
+    }
+    // Bitmap of the bytes of the set
+    uint32_t tab[8] = { 0 };
+    for(size_t i = 0; i < n; i++) {
+        tab[s[i] >> 5] |= UINT32_C(1) << (s[i] & 31);
+    }
+    const uint8_t *base = m_bstr1ng_cstr(v);
+    size_t i = start;
+    if (n <= M_BSTR1NG_ANY_OF_SWAR_MAX) {
+        // Skip the words of 8 bytes which contain no byte of the set
+        // (for bigger sets, the bitmap lookup is faster).
+        uint64_t pattern[M_BSTR1NG_ANY_OF_SWAR_MAX];
+        for(size_t j = 0; j < n; j++) {
+            pattern[j] = M_BSTR1NG_LOW_BITS * s[j];
+        }
+        while (v->size - i >= 8) {
+            const uint64_t w = m_bstr1ng_load64(&base[i]);
+            uint64_t m = 0;
+            for(size_t j = 0; j < n; j++) {
+                m |= m_bstr1ng_zero_bytes64(w ^ pattern[j]);
+            }
+            if (m != 0) {
+                break;
+            }
+            i += 8;
+        }
+    }
+    for( ; i < v->size; i++) {
+        const uint8_t c = base[i];
+        if ((tab[c >> 5] >> (c & 31)) & 1) {
+            return i;
+        }
+    }
+    return M_BSTRING_FAILURE;
+}
+
+/* Return the number of bytes 'c' in the byte string */
+M_INLINE size_t
+m_bstring_count_byte(const m_bstring_t v, uint8_t c)
+{
+    M_BSTRING_CONTRACT (v);
+    const uint8_t *p = m_bstr1ng_cstr(v);
+    const uint8_t *end = p + v->size;
+    const uint64_t pattern = M_BSTR1NG_LOW_BITS * c;
+    size_t count = 0;
+    while (end - p >= 8) {
+        // One bit 7 per matching byte. Sum these bits in the high byte.
+        uint64_t m = m_bstr1ng_zero_bytes64(m_bstr1ng_load64(p) ^ pattern);
+        count += (size_t) (((m >> 7) * M_BSTR1NG_LOW_BITS) >> 56);
+        p += 8;
+    }
+    while (p != end) {
+        count += (*p++ == c);
+    }
+    return count;
+}
+
+/* CURSOR:
+   Read a byte string from its beginning without copying it,
+   decoding fixed size integers and variable size integers (LEB128).
+   All the read functions return false (without moving the cursor)
+   if there are not enough bytes left.
+   The cursor is invalidated by any modification of the byte string. */
+typedef struct m_bstring_cursor_s {
+    const uint8_t *ptr;   // Bytes of the byte string
+    size_t size;          // Number of bytes
+    size_t pos;           // Position of the next byte to read
+} m_bstring_cursor_t[1];
+
+// Contract of a byte string cursor
+#define M_BSTR1NG_CURSOR_CONTRACT(c) do {                                     \
+    M_ASSERT( (c) != NULL );                                                  \
+    M_ASSERT( (c)->pos <= (c)->size );                                        \
+    M_ASSERT( (c)->ptr != NULL || (c)->size == 0 );                           \
+  } while (0)
+
+M_INLINE void
+m_bstring_cursor_init(m_bstring_cursor_t c, const m_bstring_t v)
+{
+    M_BSTRING_CONTRACT (v);
+    c->ptr  = m_bstr1ng_cstr(v);
+    c->size = v->size;
+    c->pos  = 0;
+}
+
+/* Return the position of the cursor in the byte string */
+M_INLINE size_t
+m_bstring_cursor_pos(const m_bstring_cursor_t c)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    return c->pos;
+}
+
+/* Return the number of bytes left to read */
+M_INLINE size_t
+m_bstring_cursor_remaining(const m_bstring_cursor_t c)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    return c->size - c->pos;
+}
+
+M_INLINE bool
+m_bstring_cursor_end_p(const m_bstring_cursor_t c)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    return c->pos == c->size;
+}
+
+/* Skip 'n' bytes */
+M_INLINE bool
+m_bstring_cursor_skip(m_bstring_cursor_t c, size_t n)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    if (n > c->size - c->pos) {
+        return false;
+    }
+    c->pos += n;
+    return true;
+}
+
+/* Get a pointer to the 'n' next bytes (without copying them) */
+M_INLINE bool
+m_bstring_cursor_get_bytes(m_bstring_cursor_t c, size_t n, const uint8_t **ptr)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    if (n > c->size - c->pos) {
+        return false;
+    }
+    *ptr = &c->ptr[c->pos];
+    c->pos += n;
+    return true;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_u8(m_bstring_cursor_t c, uint8_t *x)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    if (c->pos == c->size) {
+        return false;
+    }
+    *x = c->ptr[c->pos++];
+    return true;
+}
+
+/* Internal: read an unsigned integer of 'n' bytes in little (resp. big) endian */
+M_INLINE bool
+m_bstr1ng_cursor_get_uint(m_bstring_cursor_t c, size_t n, bool big_endian, uint64_t *x)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    if (n > c->size - c->pos) {
+        return false;
+    }
+    const uint8_t *p = &c->ptr[c->pos];
+    uint64_t r = 0;
+    for(size_t i = 0; i < n; i++) {
+        r |= (uint64_t) p[big_endian ? n - 1 - i : i] << (8 * i);
+    }
+    c->pos += n;
+    *x = r;
+    return true;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_le16(m_bstring_cursor_t c, uint16_t *x)
+{
+    uint64_t r;
+    bool b = m_bstr1ng_cursor_get_uint(c, 2, false, &r);
+    if (b) { *x = (uint16_t) r; }
+    return b;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_le32(m_bstring_cursor_t c, uint32_t *x)
+{
+    uint64_t r;
+    bool b = m_bstr1ng_cursor_get_uint(c, 4, false, &r);
+    if (b) { *x = (uint32_t) r; }
+    return b;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_le64(m_bstring_cursor_t c, uint64_t *x)
+{
+    return m_bstr1ng_cursor_get_uint(c, 8, false, x);
+}
+
+M_INLINE bool
+m_bstring_cursor_get_be16(m_bstring_cursor_t c, uint16_t *x)
+{
+    uint64_t r;
+    bool b = m_bstr1ng_cursor_get_uint(c, 2, true, &r);
+    if (b) { *x = (uint16_t) r; }
+    return b;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_be32(m_bstring_cursor_t c, uint32_t *x)
+{
+    uint64_t r;
+    bool b = m_bstr1ng_cursor_get_uint(c, 4, true, &r);
+    if (b) { *x = (uint32_t) r; }
+    return b;
+}
+
+M_INLINE bool
+m_bstring_cursor_get_be64(m_bstring_cursor_t c, uint64_t *x)
+{
+    return m_bstr1ng_cursor_get_uint(c, 8, true, x);
+}
+
+/* Read an unsigned variable size integer (LEB128: 7 bits per byte,
+   least significant group first, high bit set if another byte follows).
+   Return false if the integer is truncated or doesn't fit in 64 bits */
+M_INLINE bool
+m_bstring_cursor_get_varint(m_bstring_cursor_t c, uint64_t *x)
+{
+    M_BSTR1NG_CURSOR_CONTRACT(c);
+    uint64_t r = 0;
+    size_t pos = c->pos;
+    for(unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos == c->size) {
+            return false;
+        }
+        const uint8_t b = c->ptr[pos++];
+        // The 10th byte can only provide the last bit
+        if (shift == 63 && b > 1) {
+            return false;
+        }
+        r |= (uint64_t) (b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            c->pos = pos;
+            *x = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Read a signed variable size integer (LEB128 of its zigzag encoding) */
+M_INLINE bool
+m_bstring_cursor_get_svarint(m_bstring_cursor_t c, int64_t *x)
+{
+    uint64_t r;
+    bool b = m_bstring_cursor_get_varint(c, &r);
+    if (b) {
+        // Zigzag decoding: 0, -1, 1, -2, 2, ...
+        *x = (r & 1) ? -(int64_t) (r >> 1) - 1 : (int64_t) (r >> 1);
+    }
+    return b;
+}
+
 // No Iterator planned for this container (No added value)
 
 #if M_USE_STDIO
@@ -606,6 +944,26 @@ M_P(m_serial_return_code_t, m_bstring, _in_serial, m_bstring_t v, m_serial_read_
 #define bstring_in_serial m_bstring_in_serial
 #define bstring_swap m_bstring_swap
 #define bstring_splice m_bstring_splice
+#define bstring_find_byte m_bstring_find_byte
+#define bstring_find_bytes m_bstring_find_bytes
+#define bstring_find_any_of m_bstring_find_any_of
+#define bstring_count_byte m_bstring_count_byte
+#define bstring_cursor_t m_bstring_cursor_t
+#define bstring_cursor_init m_bstring_cursor_init
+#define bstring_cursor_pos m_bstring_cursor_pos
+#define bstring_cursor_remaining m_bstring_cursor_remaining
+#define bstring_cursor_end_p m_bstring_cursor_end_p
+#define bstring_cursor_skip m_bstring_cursor_skip
+#define bstring_cursor_get_bytes m_bstring_cursor_get_bytes
+#define bstring_cursor_get_u8 m_bstring_cursor_get_u8
+#define bstring_cursor_get_le16 m_bstring_cursor_get_le16
+#define bstring_cursor_get_le32 m_bstring_cursor_get_le32
+#define bstring_cursor_get_le64 m_bstring_cursor_get_le64
+#define bstring_cursor_get_be16 m_bstring_cursor_get_be16
+#define bstring_cursor_get_be32 m_bstring_cursor_get_be32
+#define bstring_cursor_get_be64 m_bstring_cursor_get_be64
+#define bstring_cursor_get_varint m_bstring_cursor_get_varint
+#define bstring_cursor_get_svarint m_bstring_cursor_get_svarint
 #define BSTRING_OPLIST M_BSTRING_OPLIST
 #define M_OPL_bstring_t() M_BSTRING_OPLIST
 
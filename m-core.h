@@ -32,6 +32,7 @@
 #include <string.h>
 #include <ctype.h> /* For toupper, tolower, isprint, isspace */
 #include <assert.h>
+#include <float.h> /* For FLT_EVAL_METHOD */
 #include <stdlib.h>  /* For abort, malloc, realloc, free, strtol, strtoul, strtoll, strtoull, strtof, strtod, strtold, rand */
 
 /* By default, always use stdio. Can be turned off in specific environment if needed
@@ -420,6 +421,135 @@ M_BEGIN_PROTECTED_CODE
 #endif
 
 
+/* Define allocators for large arrays:
+ * void *M_VMEM_REALLOC(context, type, ptr, o, n):
+ * void M_VMEM_FREE(context, type, ptr, o):
+ *    Same interface as M_MEMORY_REALLOC & M_MEMORY_FREE.
+ *    They can be used as the REALLOC & FREE operators of an oplist
+ *    (typically to store very large arrays).
+ * If M_USE_VMEM is defined to 1 on Linux, arrays greater or equal than
+ * M_USE_VMEM_THRESHOLD bytes are directly mapped from the system,
+ * so that their pages are only committed on first touch,
+ * and they grow with mremap (if available) which moves the pages
+ * instead of copying the data: growing costs only the new pages,
+ * and doesn't temporary double the resident memory.
+ * If M_USE_VMEM_HUGEPAGE is defined to 1, the kernel is advised to back
+ * such arrays with transparent huge pages.
+ * Smaller arrays are handled by realloc & free.
+ * The given size 'o' shall be the exact size of the array (it is used to
+ * select how the array has been allocated).
+ * NOTE: _GNU_SOURCE shall be defined before any system header
+ * (for MAP_ANONYMOUS & mremap).
+ * Otherwise, they are the same as M_MEMORY_REALLOC & M_MEMORY_FREE.
+ */
+#if defined(M_USE_VMEM) && M_USE_VMEM && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if defined(M_USE_VMEM) && M_USE_VMEM && defined(MAP_ANONYMOUS)
+
+#ifndef M_USE_VMEM_THRESHOLD
+#define M_USE_VMEM_THRESHOLD (1024UL*1024UL)
+#endif
+
+#ifndef M_USE_VMEM_HUGEPAGE
+#define M_USE_VMEM_HUGEPAGE 0
+#endif
+
+/* Round the size to a multiple of the page size.
+   The page size is queried on each call (without any shared state):
+   its cost is negligible compared to the following system call */
+M_INLINE size_t
+m_core_vmem_round(size_t size)
+{
+  const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+  return (size + page - 1) / page * page;
+}
+
+/* Map 'size' bytes of anonymous memory (page aligned size) */
+M_INLINE void *
+m_core_vmem_map(size_t size)
+{
+  void *p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return NULL;
+  }
+#if M_USE_VMEM_HUGEPAGE && defined(MADV_HUGEPAGE)
+  // Only an advice: failure is not an error
+  (void) madvise(p, size, MADV_HUGEPAGE);
+#endif
+  return p;
+}
+
+M_INLINE void
+m_core_vmem_free(void *ptr, size_t old_size)
+{
+  if (old_size >= M_USE_VMEM_THRESHOLD) {
+    if (ptr != NULL) {
+      munmap(ptr, m_core_vmem_round(old_size));
+    }
+  } else {
+    free(ptr);
+  }
+}
+
+M_INLINE void *
+m_core_vmem_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+  if (ptr == NULL) {
+    old_size = 0;
+  }
+  const bool old_vmem = old_size >= M_USE_VMEM_THRESHOLD;
+  const bool new_vmem = new_size >= M_USE_VMEM_THRESHOLD;
+  if (!old_vmem && !new_vmem) {
+    return realloc(ptr, new_size);
+  }
+  const size_t new_round = new_vmem ? m_core_vmem_round(new_size) : new_size;
+  if (old_vmem && new_vmem) {
+    const size_t old_round = m_core_vmem_round(old_size);
+    if (old_round == new_round) {
+      return ptr;
+    }
+#ifdef MREMAP_MAYMOVE
+    // Move the pages to a new virtual address if needed (no copy)
+    void *p = mremap(ptr, old_round, new_round, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) {
+      return NULL;
+    }
+#if M_USE_VMEM_HUGEPAGE && defined(MADV_HUGEPAGE)
+    (void) madvise(p, new_round, MADV_HUGEPAGE);
+#endif
+    return p;
+#endif
+  }
+  // Switch between the allocators (or no mremap): allocate, copy & release
+  void *p = new_vmem ? m_core_vmem_map(new_round) : malloc(new_size);
+  if (p == NULL) {
+    return NULL;
+  }
+  if (ptr != NULL) {
+    memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+  }
+  m_core_vmem_free(ptr, old_size);
+  return p;
+}
+
+#ifdef __cplusplus
+# define M_VMEM_REALLOC(ctx, type, ptr, o, n)                                 \
+  ((type*) (M_UNLIKELY ((n) > SIZE_MAX / sizeof(type)) ? NULL : m_core_vmem_realloc ((ptr), (o)*sizeof (type), (n)*sizeof (type))))
+#else
+# define M_VMEM_REALLOC(ctx, type, ptr, o, n)                                 \
+  (M_UNLIKELY ((n) > SIZE_MAX / sizeof(type)) ? NULL : m_core_vmem_realloc ((ptr), (o)*sizeof (type), (n)*sizeof (type)))
+#endif
+# define M_VMEM_FREE(ctx, type, ptr, o) m_core_vmem_free((ptr), (o)*sizeof (type))
+
+#else
+# define M_VMEM_REALLOC M_MEMORY_REALLOC
+# define M_VMEM_FREE M_MEMORY_FREE
+#endif
+
+
 // Default global memory context is to consider the global context as '0' if it is not defined.
 #ifndef M_USE_GLOBAL_CONTEXT
 #define M_USE_GLOBAL_CONTEXT 0
@@ -2847,6 +2977,368 @@ M_INLINE char m_core_str_nospace(const char **str)
   return c;
 }
 
+/* Fast conversion between numbers and their decimal representation.
+   Integers are formatted two digits at a time.
+   Floating point numbers are formatted using the shortest representation
+   which reads back to the same value: an exact fixed-point path handles
+   the common magnitudes and the C library handles the remaining cases.
+   Parsing uses an exact fast path for short decimal numbers and falls back
+   to the C library for all other cases (hexadecimal, infinity, long mantissa...).
+*/
+
+/* Size of the buffer needed to format any integer (including final null char) */
+#define M_CORE_FMT_INT_SIZE 24
+
+/* Size of the buffer needed to format any float or double (including final null char) */
+#define M_CORE_FMT_FLOAT_SIZE 32
+
+/* Return the power of 10 'k' for k in [0..22] (all exactly representable as double) */
+M_INLINE double
+m_core_pow10(unsigned k)
+{
+  static const double tab[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  M_ASSERT(k < 23);
+  return tab[k];
+}
+
+/* Format the unsigned integer 'n' in decimal into 'buf'.
+   Return the number of characters written (excluding the final null char) */
+M_INLINE size_t
+m_core_fmt_uj(char buf[M_CORE_FMT_INT_SIZE], unsigned long long n)
+{
+  static const char digits[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+  char tmp[M_CORE_FMT_INT_SIZE];
+  char *p = &tmp[M_CORE_FMT_INT_SIZE];
+  while (n >= 100) {
+    unsigned d = (unsigned) (n % 100U) * 2U;
+    n /= 100U;
+    *--p = digits[d+1];
+    *--p = digits[d];
+  }
+  if (n >= 10) {
+    unsigned d = (unsigned) n * 2U;
+    *--p = digits[d+1];
+    *--p = digits[d];
+  } else {
+    // 0123456789 are mandatory in this order as characters, as per C standard.
+    *--p = (char) ('0' + n);
+  }
+  size_t len = (size_t) (&tmp[M_CORE_FMT_INT_SIZE] - p);
+  memcpy(buf, p, len);
+  buf[len] = 0;
+  return len;
+}
+
+/* Format the signed integer 'n' in decimal into 'buf'.
+   Return the number of characters written (excluding the final null char) */
+M_INLINE size_t
+m_core_fmt_sj(char buf[M_CORE_FMT_INT_SIZE], long long n)
+{
+  if (n < 0) {
+    buf[0] = '-';
+    return 1 + m_core_fmt_uj(buf + 1, 0ULL - (unsigned long long) n);
+  }
+  return m_core_fmt_uj(buf, (unsigned long long) n);
+}
+
+/* Internal: format the fixed point number (-1)^neg * m / 10^k into 'buf' */
+M_INLINE size_t
+m_core_fmt_fixed(char buf[M_CORE_FMT_FLOAT_SIZE], bool neg, unsigned long long m, unsigned k)
+{
+  char digits[M_CORE_FMT_INT_SIZE];
+  size_t n = m_core_fmt_uj(digits, m);
+  size_t i = 0;
+  if (neg) {
+    buf[i++] = '-';
+  }
+  if (k == 0) {
+    memcpy(&buf[i], digits, n);
+    i += n;
+  } else if (n <= k) {
+    buf[i++] = '0';
+    buf[i++] = '.';
+    memset(&buf[i], '0', k - n);
+    i += k - n;
+    memcpy(&buf[i], digits, n);
+    i += n;
+  } else {
+    memcpy(&buf[i], digits, n - k);
+    i += n - k;
+    buf[i++] = '.';
+    memcpy(&buf[i], &digits[n - k], k);
+    i += k;
+  }
+  M_ASSERT(i < M_CORE_FMT_FLOAT_SIZE);
+  buf[i] = 0;
+  return i;
+}
+
+/* The fast paths need the floating point operations to be performed
+   in the precision of their type (or double precision for float). */
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1)
+# define M_CORE_FAST_FLOAT 1
+#else
+# define M_CORE_FAST_FLOAT 0
+#endif
+
+#if M_USE_STDIO
+
+/* Internal: format the integral value 'x' of digits 'm' in exponent
+   notation if it is shorter than its fixed notation (like 1e+15).
+   Return the number of characters written, or 0 if nothing is written */
+M_INLINE size_t
+m_core_fmt_exp_if_shorter(char buf[M_CORE_FMT_FLOAT_SIZE], double x, unsigned long long m)
+{
+  int zeros = 0, prec = 0;
+  for( ; m >= 10 && m % 10 == 0; m /= 10) {
+    zeros++;
+  }
+  for( ; m != 0; m /= 10) {
+    prec++;
+  }
+  // Length of "D.DDDe+XX" (the exponent is lower than 100)
+  if (prec + (prec > 1) + 4 >= prec + zeros) {
+    return 0;
+  }
+  return (size_t) snprintf(buf, M_CORE_FMT_FLOAT_SIZE, "%.*g", prec, x);
+}
+
+/* Internal: format 'x' with the lowest precision of %g in [low, high]
+   that reads back to 'x' (with strtod or strtof).
+   Such a precision is searched by bisection, the highest one being
+   always exact. */
+M_INLINE size_t
+m_core_fmt_g(char buf[M_CORE_FMT_FLOAT_SIZE], double x, bool is_float, int low, int high)
+{
+  while (low < high) {
+    const int prec = (low + high) / 2;
+    const int n = snprintf(buf, M_CORE_FMT_FLOAT_SIZE, "%.*g", prec, x);
+    if (n > 0 && (is_float ? strtof(buf, NULL) == (float) x : strtod(buf, NULL) == x)) {
+      high = prec;
+    } else {
+      low = prec + 1;
+    }
+  }
+  return (size_t) snprintf(buf, M_CORE_FMT_FLOAT_SIZE, "%.*g", low, x);
+}
+
+/* Format the double 'x' into 'buf' with the shortest representation
+   that reads back to 'x' (with strtod).
+   Return the number of characters written (excluding the final null char) */
+M_INLINE size_t
+m_core_fmt_double(char buf[M_CORE_FMT_FLOAT_SIZE], double x)
+{
+#if M_CORE_FAST_FLOAT
+  const double a = x < 0 ? -x : x;
+  // 2^53 is the limit of the exactly representable integers.
+  if (a >= 1e-4 && a < 9007199254740992.0) {
+    for(unsigned k = 0; k < 23; k++) {
+      const double p = m_core_pow10(k);
+      const double t = a * p;
+      if (t >= 9007199254740992.0) {
+        break;
+      }
+      const unsigned long long m = (unsigned long long) (t + 0.5);
+      // Both m and p are exact, so the division is correctly rounded.
+      if ((double) m / p == a) {
+        const size_t n = k == 0 ? m_core_fmt_exp_if_shorter(buf, x, m) : 0;
+        return n != 0 ? n : m_core_fmt_fixed(buf, x < 0, m, k);
+      }
+    }
+  }
+#endif
+  return m_core_fmt_g(buf, x, false, 1, 17);
+}
+
+/* Format the float 'x' into 'buf' with the shortest representation
+   that reads back to 'x' (with strtof).
+   Return the number of characters written (excluding the final null char) */
+M_INLINE size_t
+m_core_fmt_float(char buf[M_CORE_FMT_FLOAT_SIZE], float x)
+{
+#if M_CORE_FAST_FLOAT
+  const float a = x < 0 ? -x : x;
+  // 2^24 is the limit of the exactly representable integers.
+  if (a >= 1e-4f && a < 16777216.0f) {
+    for(unsigned k = 0; k < 11; k++) {
+      const double t = (double) a * m_core_pow10(k);
+      if (t >= 16777216.0) {
+        break;
+      }
+      const unsigned long long m = (unsigned long long) (t + 0.5);
+      if ((float) ((float) m / (float) m_core_pow10(k)) == a) {
+        const size_t n = k == 0 ? m_core_fmt_exp_if_shorter(buf, (double) x, m) : 0;
+        return n != 0 ? n : m_core_fmt_fixed(buf, x < 0, m, k);
+      }
+    }
+  }
+#endif
+  return m_core_fmt_g(buf, (double) x, true, 1, 9);
+}
+
+#endif /* M_USE_STDIO */
+
+/* Internal: scan a simple decimal floating point number of 'str'
+   as (-1)^neg * m * 10^e with at most 19 significant digits.
+   Return false if the number is not of this form (so that the C library
+   shall be used) */
+M_INLINE bool
+m_core_scan_decimal(const char str[], bool *neg, unsigned long long *m, int *e, const char **endptr)
+{
+  const char *p = str;
+  unsigned long long mant = 0;
+  int exp10 = 0, sig = 0;
+  bool digit = false;
+  while (isspace((unsigned char) *p)) { p++; }
+  *neg = (*p == '-');
+  if (*p == '-' || *p == '+') { p++; }
+  while (*p >= '0' && *p <= '9') {
+    if (mant != 0 || *p != '0') {
+      if (++sig > 19) { return false; }
+      mant = mant * 10U + (unsigned) (*p - '0');
+    }
+    digit = true;
+    p++;
+  }
+  if (*p == '.') {
+    p++;
+    while (*p >= '0' && *p <= '9') {
+      if (mant != 0 || *p != '0') {
+        if (++sig > 19) { return false; }
+        mant = mant * 10U + (unsigned) (*p - '0');
+      }
+      exp10--;
+      digit = true;
+      p++;
+    }
+  }
+  // Hexadecimal numbers are handled by the C library
+  if (!digit || *p == 'x' || *p == 'X') { return false; }
+  if (*p == 'e' || *p == 'E') {
+    const char *q = p + 1;
+    bool eneg = (*q == '-');
+    if (*q == '-' || *q == '+') { q++; }
+    if (*q >= '0' && *q <= '9') {
+      int ev = 0;
+      do {
+        // Saturate the exponent: it is out of range of the fast path anyway
+        if (ev < 10000) { ev = ev * 10 + (*q - '0'); }
+        q++;
+      } while (*q >= '0' && *q <= '9');
+      exp10 += eneg ? -ev : ev;
+      p = q;
+    }
+  }
+  *m = mant;
+  *e = exp10;
+  *endptr = p;
+  return true;
+}
+
+/* Like strtoull but faster for decimal numbers */
+M_INLINE unsigned long long
+m_core_strtoull(const char str[], char **endptr, int base)
+{
+  const char *p = str;
+  if (base == 10) {
+    while (isspace((unsigned char) *p)) { p++; }
+    if (*p == '+') { p++; }
+    if (*p >= '0' && *p <= '9') {
+      // 19 digits cannot overflow
+      unsigned long long n = 0;
+      unsigned i = 0;
+      do {
+        n = n * 10U + (unsigned) (*p++ - '0');
+      } while (++i < 19 && *p >= '0' && *p <= '9');
+      if (!(*p >= '0' && *p <= '9')) {
+        if (endptr != NULL) { *endptr = (char *) (uintptr_t) p; }
+        return n;
+      }
+    }
+  }
+  return strtoull(str, endptr, base);
+}
+
+/* Like strtoll but faster for decimal numbers */
+M_INLINE long long
+m_core_strtoll(const char str[], char **endptr, int base)
+{
+  const char *p = str;
+  if (base == 10) {
+    while (isspace((unsigned char) *p)) { p++; }
+    bool neg = (*p == '-');
+    if (*p == '-' || *p == '+') { p++; }
+    if (*p >= '0' && *p <= '9') {
+      // 19 digits cannot overflow an unsigned long long
+      unsigned long long n = 0;
+      unsigned i = 0;
+      do {
+        n = n * 10U + (unsigned) (*p++ - '0');
+      } while (++i < 19 && *p >= '0' && *p <= '9');
+      if (!(*p >= '0' && *p <= '9') && n <= (unsigned long long) LLONG_MAX) {
+        if (endptr != NULL) { *endptr = (char *) (uintptr_t) p; }
+        return neg ? -(long long) n : (long long) n;
+      }
+    }
+  }
+  return strtoll(str, endptr, base);
+}
+
+/* Like strtod but faster for short decimal numbers */
+M_INLINE double
+m_core_strtod(const char str[], char **endptr)
+{
+#if M_CORE_FAST_FLOAT
+  bool neg;
+  unsigned long long m;
+  int e;
+  const char *p;
+  // Clinger's fast path: both m and 10^|e| are exact,
+  // so the result is correctly rounded.
+  if (m_core_scan_decimal(str, &neg, &m, &e, &p)
+      && (m == 0 || (m <= (1ULL << 53) && e >= -22 && e <= 22))) {
+    double d = (double) m;
+    if (m != 0) {
+      d = e < 0 ? d / m_core_pow10((unsigned) -e) : d * m_core_pow10((unsigned) e);
+    }
+    if (endptr != NULL) { *endptr = (char *) (uintptr_t) p; }
+    return neg ? -d : d;
+  }
+#endif
+  return strtod(str, endptr);
+}
+
+/* Like strtof but faster for short decimal numbers */
+M_INLINE float
+m_core_strtof(const char str[], char **endptr)
+{
+#if M_CORE_FAST_FLOAT
+  bool neg;
+  unsigned long long m;
+  int e;
+  const char *p;
+  if (m_core_scan_decimal(str, &neg, &m, &e, &p)
+      && (m == 0 || (m <= (1ULL << 24) && e >= -10 && e <= 10))) {
+    float d = (float) m;
+    if (m != 0) {
+      float p10 = (float) m_core_pow10((unsigned) (e < 0 ? -e : e));
+      d = e < 0 ? d / p10 : d * p10;
+    }
+    if (endptr != NULL) { *endptr = (char *) (uintptr_t) p; }
+    return neg ? -d : d;
+  }
+#endif
+  return strtof(str, endptr);
+}
+
 /* Transform a C variable into a m_string_t (needs m-string.h) */
 #define M_GET_STRING_ARG(str, x, append)                                      \
   (append ? m_string_cat_printf : m_string_printf) M_R(str, M_PRINTF_FORMAT(x), M_CORE_PRINTF_ARG(x))
@@ -2905,18 +3397,18 @@ m_core_parse_bool (bool *ptr, const char str[], const char **endptr)
     return end != str;                                                        \
     }
 
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_schar, signed char, strtol, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_uchar, unsigned char, strtoul, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sshort, signed short, strtol, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ushort, unsigned short, strtoul, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sint, signed int, strtol, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_uint, unsigned int, strtoul, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_schar, signed char, m_core_strtoll, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_uchar, unsigned char, m_core_strtoull, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sshort, signed short, m_core_strtoll, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ushort, unsigned short, m_core_strtoull, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sint, signed int, m_core_strtoll, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_uint, unsigned int, m_core_strtoull, M_DEFERRED_COMMA 10)
 M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_slong, signed long, strtol, M_DEFERRED_COMMA 10)
 M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ulong, unsigned long, strtoul, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sllong, signed long long, strtoll, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ullong, unsigned long long, strtoull, M_DEFERRED_COMMA 10)
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_float, float, strtof, )
-M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_double, double, strtod, )
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_sllong, signed long long, m_core_strtoll, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ullong, unsigned long long, m_core_strtoull, M_DEFERRED_COMMA 10)
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_float, float, m_core_strtof, )
+M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_double, double, m_core_strtod, )
 M_PARSE_DEFAULT_TYPE_DEF(m_core_parse_ldouble, long double, strtold, )
 
 /* Internal macro to separate two arguments by a semicolon */
@@ -3327,13 +3819,34 @@ M_INLINE unsigned int m_core_ctz64(uint64_t limb)
 
 #endif
 
+/* Load a word from a potentially unaligned buffer */
+M_INLINE uint16_t m_core_load16(const uint8_t *p)
+{
+  uint16_t w;
+  memcpy(&w, p, sizeof w);
+  return w;
+}
+
+M_INLINE uint32_t m_core_load32(const uint8_t *p)
+{
+  uint32_t w;
+  memcpy(&w, p, sizeof w);
+  return w;
+}
+
+M_INLINE uint64_t m_core_load64(const uint8_t *p)
+{
+  uint64_t w;
+  memcpy(&w, p, sizeof w);
+  return w;
+}
+
 /* Implement a kind of FNV1A Hash.
    Inspired by http://www.sanmayce.com/Fastest_Hash/ Jesteress and port to 64 bits.
    See https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
-   The buffer given as argument shall be aligned:
-   - to 8 (resp. 4) if size is greater than 8 on 64 bits (resp. 4 on 32 bits),
-   - to the power of 2 just lower or equal to its size otherwise.
-   NOTE: A lot of cast. Not really type nor alignement safe.
+   The buffer given as argument doesn't need to be aligned:
+   the words are loaded through memcpy (which is turned into a single load
+   by the compiler on targets supporting unaligned accesses).
    NOTE: Can be reduced to very few instructions if constant size argument.
    FIXME: It is trivial for an attacker to generate collision and HASH_SEED doesn't prevent it.
  */
@@ -3347,25 +3860,21 @@ m_core_hash (const void *str, size_t length)
   const uint8_t *p = (const uint8_t *)str;
 
   M_ASSERT (str != NULL || length == 0);
-  M_ASSERT ( (( (uintptr_t)p & (sizeof(uint32_t)-1) ) == 0) || (length <= sizeof(uint32_t)));
-  M_ASSERT ( (( (uintptr_t)p & (sizeof(uint16_t)-1) ) == 0) || (length <= sizeof(uint16_t)));
 
   // Main loop that handles 64 bits at a time.
   while (length >= 2*sizeof(uint32_t)) {
-    const uint32_t *ptr = (const uint32_t *) (uintptr_t) p;
-    hash32 = (hash32 ^ (m_core_rotl32a(ptr[0], 5) ^ ptr[1])) * prime;
+    hash32 = (hash32 ^ (m_core_rotl32a(m_core_load32(p), 5)
+                        ^ m_core_load32(p + sizeof(uint32_t)))) * prime;
     length -= 2*sizeof(uint32_t);
     p += 2*sizeof(uint32_t);
   }
   // Cases: 0,1,2,3,4,5,6,7
   if (length & sizeof(uint32_t)) {
-    const uint32_t *ptr = (const uint32_t *) (uintptr_t) p;
-    hash32 = (hash32 ^ ptr[0]) * prime;
+    hash32 = (hash32 ^ m_core_load32(p)) * prime;
     p += sizeof(uint32_t);
     }
   if (length & sizeof(uint16_t)) {
-    const uint16_t *ptr = (const uint16_t *) (uintptr_t) p;
-    hash32 = (hash32 ^ ptr[0]) * prime;
+    hash32 = (hash32 ^ m_core_load16(p)) * prime;
     p += sizeof(uint16_t);
   }
   if (length & 1)
@@ -3382,32 +3891,26 @@ m_core_hash (const void *str, size_t length)
   const uint8_t *p = M_ASSIGN_CAST(const uint8_t *, str);
 
   M_ASSERT (str != NULL || length == 0);
-  M_ASSERT ( (( (uintptr_t)p & (sizeof(uint64_t)-1) ) == 0) || (length <= sizeof(uint32_t)));
-  M_ASSERT ( (( (uintptr_t)p & (sizeof(uint32_t)-1) ) == 0) || (length <= sizeof(uint32_t)));
-  M_ASSERT ( (( (uintptr_t)p & (sizeof(uint16_t)-1) ) == 0) || (length <= sizeof(uint16_t)));
 
   // Main loop that handles 128 bits at a time.
   while (length >= 2*sizeof(uint64_t)) {
-    const uint64_t *ptr = (const uint64_t *) (uintptr_t) p;
-    hash64 = (hash64 ^ (m_core_rotl64a(ptr[0], 5) ^ ptr[1])) * prime;
+    hash64 = (hash64 ^ (m_core_rotl64a(m_core_load64(p), 5)
+                        ^ m_core_load64(p + sizeof(uint64_t)))) * prime;
     length -= 2*sizeof(uint64_t);
     p += 2*sizeof(uint64_t);
   }
   //Cases: 0 to 15.
   if (length & sizeof(uint64_t)) {
-    const uint64_t *ptr = (const uint64_t *) (uintptr_t) p;
-    hash64 = (hash64 ^ ptr[0]) * prime;
+    hash64 = (hash64 ^ m_core_load64(p)) * prime;
     p += sizeof(uint64_t);
     }
   // Cases: 0,1,2,3,4,5,6,7
   if (length & sizeof(uint32_t)) {
-    const uint32_t *ptr = (const uint32_t *) (uintptr_t) p;
-    hash64 = (hash64 ^ ptr[0]) * prime;
+    hash64 = (hash64 ^ m_core_load32(p)) * prime;
     p += sizeof(uint32_t);
     }
   if (length & sizeof(uint16_t)) {
-    const uint16_t *ptr = (const uint16_t *) (uintptr_t) p;
-    hash64 = (hash64 ^ ptr[0]) * prime;
+    hash64 = (hash64 ^ m_core_load16(p)) * prime;
     p += sizeof(uint16_t);
   }
   if (length & 1)
@@ -3417,8 +3920,7 @@ m_core_hash (const void *str, size_t length)
 #endif
 
 /* HASH function for a C-string (to be used within oplist)
- * We cannot use m_core_hash due to the alignment constraint,
- * and it avoids computing the size before computing the hash.
+ * It avoids computing the size before computing the hash.
  */
 M_INLINE size_t m_core_cstr_hash(const char str[])
 {
@@ -3530,6 +4032,9 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #undef OOR_EQUAL
 #undef PROPERTIES
 #undef EMPLACE_TYPE
+#undef VIEW_TYPE
+#undef VIEW_HASH
+#undef VIEW_EQUAL
 #undef NEW
 #undef DEL
 #undef REALLOC
@@ -3745,6 +4250,15 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #ifdef EMPLACE_TYPE
 #error "EMPLACE_TYPE is defined, it conflicts with the M*LIB OPLIST system, undefine it before including M*LIB headers"
 #endif
+#ifdef VIEW_TYPE
+#error "VIEW_TYPE is defined, it conflicts with the M*LIB OPLIST system, undefine it before including M*LIB headers"
+#endif
+#ifdef VIEW_HASH
+#error "VIEW_HASH is defined, it conflicts with the M*LIB OPLIST system, undefine it before including M*LIB headers"
+#endif
+#ifdef VIEW_EQUAL
+#error "VIEW_EQUAL is defined, it conflicts with the M*LIB OPLIST system, undefine it before including M*LIB headers"
+#endif
 #ifdef NEW
 #error "NEW is defined, it conflicts with the M*LIB OPLIST system, undefine it before including M*LIB headers"
 #endif
@@ -3841,6 +4355,9 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #define M_X_LIMITS_LIMITS(a)       ,a,
 #define M_X_PROPERTIES_PROPERTIES(a) ,a,
 #define M_X_EMPLACE_TYPE_EMPLACE_TYPE(a) ,a,
+#define M_X_VIEW_TYPE_VIEW_TYPE(a) ,a,
+#define M_X_VIEW_HASH_VIEW_HASH(a) ,a,
+#define M_X_VIEW_EQUAL_VIEW_EQUAL(a) ,a,
 // As attribute customization
 #define M_X_NEW_NEW(a)             ,a,
 #define M_X_DEL_DEL(a)             ,a,
@@ -3852,6 +4369,7 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 // As properties only
 #define M_X_LET_AS_INIT_WITH_LET_AS_INIT_WITH(a) ,a,
 #define M_X_NOCLEAR_NOCLEAR(a)     ,a,
+#define M_X_FLAT_FLAT(a)           ,a,
 #define M_X_THREADSAFE_THREADSAFE(a)     ,a,
 
 /* From an oplist - an unorded list of methods : like "INIT(mpz_init),CLEAR(mpz_clear),SET(mpz_set)" -
@@ -3932,6 +4450,9 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #define M_GET_OOR_EQUAL(...) M_GET_METHOD(OOR_EQUAL,   M_NO_DEF_OOR_EQUAL, __VA_ARGS__)
 #define M_GET_PROPERTIES(...) M_GET_METHOD(PROPERTIES, (),                 __VA_ARGS__)
 #define M_GET_EMPLACE_TYPE(...) M_GET_METHOD(EMPLACE_TYPE,             ,   __VA_ARGS__)
+#define M_GET_VIEW_TYPE(...) M_GET_METHOD(VIEW_TYPE,   ,                   __VA_ARGS__)
+#define M_GET_VIEW_HASH(...) M_GET_METHOD(VIEW_HASH,   M_NO_DEF_VIEW_HASH, __VA_ARGS__)
+#define M_GET_VIEW_EQUAL(...) M_GET_METHOD(VIEW_EQUAL, M_NO_DEF_VIEW_EQUAL, __VA_ARGS__)
 // As attribute customization
 #define M_GET_NEW(...)       M_GET_METHOD(NEW,         M_MEMORY_ALLOC,     __VA_ARGS__)
 #define M_GET_DEL(...)       M_GET_METHOD(DEL,         M_MEMORY_DEL,       __VA_ARGS__)
@@ -4008,6 +4529,8 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #define M_CALL_OOR_EQUAL(oplist, ...) M_APPLY_API(M_GET_OOR_EQUAL oplist, oplist, __VA_ARGS__)
 //#define M_CALL_PROPERTIES(oplist, ...) M_APPLY_API(M_GET_PROPERTIES oplist, oplist, __VA_ARGS__)
 //#define M_CALL_EMPLACE_TYPE(oplist, ...) M_APPLY_API(M_GET_EMPLACE_TYPE oplist, oplist, __VA_ARGS__)
+#define M_CALL_VIEW_HASH(oplist, ...) M_APPLY_API(M_GET_VIEW_HASH oplist, oplist, __VA_ARGS__)
+#define M_CALL_VIEW_EQUAL(oplist, ...) M_APPLY_API(M_GET_VIEW_EQUAL oplist, oplist, __VA_ARGS__)
 // m_context is always added here!
 #define M_CALL_NEW(oplist, ...) M_APPLY_API(M_GET_NEW oplist, oplist, m_context, __VA_ARGS__)
 #define M_CALL_DEL(oplist, ...) M_APPLY_API(M_GET_DEL oplist, oplist, m_context, __VA_ARGS__)
@@ -4227,6 +4750,8 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #define M_NO_DEF_IN_SERIAL(...)   M_NO_DEFAULT(IN_SERIAL, m_serial_return_code_t)
 #define M_NO_DEF_OOR_SET(...)     M_NO_DEFAULT(OOR_SET, void)
 #define M_NO_DEF_OOR_EQUAL(...)   M_NO_DEFAULT(OOR_EQUAL, bool)
+#define M_NO_DEF_VIEW_HASH(...)   M_NO_DEFAULT(VIEW_HASH, size_t)
+#define M_NO_DEF_VIEW_EQUAL(...)  M_NO_DEFAULT(VIEW_EQUAL, bool)
 
 /* Create a type with an invalid static assertion.
    Creating a type allowed the macro into something not too bad
@@ -4397,7 +4922,7 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 #define M_POD_OPLIST                                                          \
   (INIT(M_RESET_POD), INIT_SET(M_SET_DEFAULT), SET(M_SET_DEFAULT), CLEAR(M_NOTHING_DEFAULT), \
    EQUAL(M_MEMEQ_POD), CMP(M_MEMCMP_POD), HASH(M_HASH_POD_DEFAULT), SWAP(M_SWAP_DEFAULT), \
-   INIT_MOVE(M_SET_DEFAULT) )
+   INIT_MOVE(M_SET_DEFAULT), PROPERTIES( (FLAT(1)) ) )
 
 
 /* NOTE: Theses operators are to be used with array of size 1, the '[1]' tricks
@@ -4485,12 +5010,19 @@ M_INLINE size_t m_core_cstr_hash(const char str[])
 /* Obsolete name */
 #define M_DEFAULT_OPLIST M_BASIC_OPLIST
 
+/* Specialized oplist for an arithmetic type (integer or floating point).
+ * Unlike M_BASIC_OPLIST (which is also used for pointers),
+ * it has the FLAT property: an object is fully represented by its bytes.
+ */
+#define M_ARITH_OPLIST                                                        \
+  M_OPEXTEND(M_BASIC_OPLIST, PROPERTIES( (NOCLEAR(1), FLAT(1)) ))
+
 /* Specialized oplist for a boolean.
  * M_BASIC_OPLIST is nearly ok, except for ADD/SUB/MUL/DIV
  * that generates warnings with boolean.
  */
 #define M_BOOL_OPLIST                                                         \
-  M_OPEXTEND(M_BASIC_OPLIST, TYPE(_Bool), ADD(M_OR_DEFAULT), MUL(M_AND_DEFAULT), \
+  M_OPEXTEND(M_ARITH_OPLIST, TYPE(_Bool), ADD(M_OR_DEFAULT), MUL(M_AND_DEFAULT), \
               SUB(0), DIV(0))
 
 
@@ -4765,13 +5297,13 @@ m_core_parse2_enum (const char str[], const char **endptr)
 /* Register simple classic C types (no qualifier)
  * We cannot register type with qualifier (for example long long) however.
  */
-#define M_OPL_char() M_OPEXTEND(M_BASIC_OPLIST, TYPE(char))
-#define M_OPL_short() M_OPEXTEND(M_BASIC_OPLIST, TYPE(short))
-#define M_OPL_int() M_OPEXTEND(M_BASIC_OPLIST, TYPE(int))
-#define M_OPL_unsigned() M_OPEXTEND(M_BASIC_OPLIST, TYPE(unsigned))
-#define M_OPL_long() M_OPEXTEND(M_BASIC_OPLIST, TYPE(long))
-#define M_OPL_float() M_OPEXTEND(M_BASIC_OPLIST, TYPE(float))
-#define M_OPL_double() M_OPEXTEND(M_BASIC_OPLIST, TYPE(double))
+#define M_OPL_char() M_OPEXTEND(M_ARITH_OPLIST, TYPE(char))
+#define M_OPL_short() M_OPEXTEND(M_ARITH_OPLIST, TYPE(short))
+#define M_OPL_int() M_OPEXTEND(M_ARITH_OPLIST, TYPE(int))
+#define M_OPL_unsigned() M_OPEXTEND(M_ARITH_OPLIST, TYPE(unsigned))
+#define M_OPL_long() M_OPEXTEND(M_ARITH_OPLIST, TYPE(long))
+#define M_OPL_float() M_OPEXTEND(M_ARITH_OPLIST, TYPE(float))
+#define M_OPL_double() M_OPEXTEND(M_ARITH_OPLIST, TYPE(double))
 #define M_OPL_bool()   M_BOOL_OPLIST
 #define M_OPL__Bool()  M_BOOL_OPLIST
 
@@ -5641,6 +6173,15 @@ inline m_serial_return_code_t operator&(m_serial_return_code_t a, m_serial_retur
 #define M_USE_SERIAL_MAX_DATA_SIZE 4
 #endif
 
+/* Kind of the elements of a contiguous array of basic C type
+ * given to the optional raw array services of the serializer:
+ * signed integers, unsigned integers or floats.
+ * M_SERIAL_RAW_NONE means that the elements cannot be handled as raw data.
+ */
+typedef enum m_serial_raw_kind_e {
+  M_SERIAL_RAW_NONE = 0, M_SERIAL_RAW_SINT = 1, M_SERIAL_RAW_UINT = 2, M_SERIAL_RAW_FLOAT = 3
+} m_serial_raw_kind_t;
+
 /* Different types of types that can be stored in a serial object to represent it:
  * a boolean
  * different kind of integers
@@ -5687,7 +6228,8 @@ typedef struct m_serial_read_s {
 } m_serial_read_t[1];
 
 /* Interface that has to be exported by the serial read object.
- * All function pointers shall be not null.
+ * All function pointers shall be not null, except the last one (read_raw_array)
+ * which is an optional fast path for contiguous arrays of basic C types.
  */
 typedef struct m_serial_read_interface_s {
   m_serial_return_code_t (*read_boolean)(m_serial_read_t,bool *);
@@ -5703,6 +6245,7 @@ typedef struct m_serial_read_interface_s {
   m_serial_return_code_t (*read_tuple_id)(m_serial_local_t, m_serial_read_t, const char *const field_name [], const int max, int *);
   m_serial_return_code_t (*read_variant_start)(m_serial_local_t, m_serial_read_t, const char *const field_name[], const int max, int*);
   m_serial_return_code_t (*read_variant_end)(m_serial_local_t, m_serial_read_t);
+  m_serial_return_code_t (*read_raw_array)(m_serial_local_t, m_serial_read_t, void *, const size_t size_of_type, const m_serial_raw_kind_t, const size_t number_of_elements);
 } m_serial_read_interface_t;
 
 
@@ -5720,7 +6263,8 @@ typedef struct m_serial_write_s {
 } m_serial_write_t[1];
 
 /* Interface that has to be exported by the serial write object.
- * All function pointers shall be not null.
+ * All function pointers shall be not null, except the last one (write_raw_array)
+ * which is an optional fast path for contiguous arrays of basic C types.
  */
 typedef struct m_serial_write_interface_s {
   m_serial_return_code_t (*write_boolean)(M_P_EXPAND m_serial_write_t,const bool data);
@@ -5739,6 +6283,7 @@ typedef struct m_serial_write_interface_s {
   m_serial_return_code_t (*write_tuple_end)(M_P_EXPAND m_serial_local_t, m_serial_write_t);
   m_serial_return_code_t (*write_variant_start)(M_P_EXPAND m_serial_local_t, m_serial_write_t, const char * const field_name[], const int max, const int index);
   m_serial_return_code_t (*write_variant_end)(M_P_EXPAND m_serial_local_t, m_serial_write_t);
+  m_serial_return_code_t (*write_raw_array)(M_P_EXPAND m_serial_write_t, const void *, const size_t size_of_type, const m_serial_raw_kind_t, const size_t number_of_elements);
 } m_serial_write_interface_t;
 
 
@@ -5822,6 +6367,91 @@ M_IN_SERIAL_DEFAULT_TYPE_DEF(m_core_in_serial_float, float, read_float, long dou
 M_IN_SERIAL_DEFAULT_TYPE_DEF(m_core_in_serial_double, double, read_float, long double)
 M_IN_SERIAL_DEFAULT_TYPE_DEF(m_core_in_serial_ldouble, long double, read_float, long double)
 
+/* Return the kind of the elements of type 'type' for the raw array services
+   of the serializer if the oplist 'oplist' uses the default serialization
+   of the basic C types (so that a contiguous array of such elements
+   can be serialized as a whole), M_SERIAL_RAW_NONE otherwise.
+   NOTE: It can only be different from M_SERIAL_RAW_NONE in C11 */
+#define M_SERIAL_RAW_KIND(oplist, type)                                       \
+  M_IF(M_AND(M_KEYWORD_P(M_OUT_SERIAL_DEFAULT_ARG, M_GET_OUT_SERIAL oplist),  \
+             M_KEYWORD_P(M_IN_SERIAL_DEFAULT_ARG, M_GET_IN_SERIAL oplist)))   \
+  (M_SER1AL_RAW_KIND_TYPE(type), M_SERIAL_RAW_NONE)
+
+#define M_PATTERN_M_OUT_SERIAL_DEFAULT_ARG_M_OUT_SERIAL_DEFAULT_ARG ,
+#define M_PATTERN_M_IN_SERIAL_DEFAULT_ARG_M_IN_SERIAL_DEFAULT_ARG ,
+
+/* Booleans are excluded as their serialized form is not their raw form */
+#define M_SER1AL_RAW_KIND_TYPE(type)                                          \
+  _Generic(((void)0, (type) 0),                                               \
+           char: (CHAR_MIN < 0 ? M_SERIAL_RAW_SINT : M_SERIAL_RAW_UINT),      \
+           signed char: M_SERIAL_RAW_SINT,                                    \
+           unsigned char: M_SERIAL_RAW_UINT,                                  \
+           signed short: M_SERIAL_RAW_SINT,                                   \
+           unsigned short: M_SERIAL_RAW_UINT,                                 \
+           signed int: M_SERIAL_RAW_SINT,                                     \
+           unsigned int: M_SERIAL_RAW_UINT,                                   \
+           long int: M_SERIAL_RAW_SINT,                                       \
+           unsigned long int: M_SERIAL_RAW_UINT,                              \
+           long long int: M_SERIAL_RAW_SINT,                                  \
+           unsigned long long int: M_SERIAL_RAW_UINT,                         \
+           float: M_SERIAL_RAW_FLOAT,                                         \
+           double: M_SERIAL_RAW_FLOAT,                                        \
+           long double: M_SERIAL_RAW_FLOAT,                                   \
+           default: M_SERIAL_RAW_NONE)
+
+/* Helper function for the serializers implementing write_raw_array:
+   Return the integer at index 'i' of the raw array 'data' of elements
+   of 'size_of_type' bytes and of kind 'kind', promoted to long long
+   (with the same conversion as M_OUT_SERIAL_DEFAULT_ARG) */
+M_INLINE long long
+m_core_serial_raw_integer(const void *data, size_t size_of_type, m_serial_raw_kind_t kind, size_t i)
+{
+  const char *p = (const char *) data + i * size_of_type;
+  bool s = (kind == M_SERIAL_RAW_SINT);
+  M_ASSERT (kind == M_SERIAL_RAW_SINT || kind == M_SERIAL_RAW_UINT);
+  if (size_of_type == 1) {
+    uint8_t u8;
+    memcpy(&u8, p, sizeof u8);
+    return s ? (long long) (int8_t) u8 : (long long) u8;
+  } else if (size_of_type == 2) {
+    uint16_t u16;
+    memcpy(&u16, p, sizeof u16);
+    return s ? (long long) (int16_t) u16 : (long long) u16;
+  } else if (size_of_type == 4) {
+    uint32_t u32;
+    memcpy(&u32, p, sizeof u32);
+    return s ? (long long) (int32_t) u32 : (long long) u32;
+  } else {
+    M_ASSERT (size_of_type == 8);
+    uint64_t u64;
+    memcpy(&u64, p, sizeof u64);
+    return (long long) u64;
+  }
+}
+
+/* Helper function for the serializers implementing write_raw_array:
+   Return the float at index 'i' of the raw array 'data' of elements
+   of 'size_of_type' bytes */
+M_INLINE long double
+m_core_serial_raw_float(const void *data, size_t size_of_type, size_t i)
+{
+  const char *p = (const char *) data + i * size_of_type;
+  if (size_of_type == sizeof (float)) {
+    float f1;
+    memcpy(&f1, p, sizeof f1);
+    return f1;
+  } else if (size_of_type == sizeof (double)) {
+    double f2;
+    memcpy(&f2, p, sizeof f2);
+    return f2;
+  } else {
+    M_ASSERT (size_of_type == sizeof (long double));
+    long double f3;
+    memcpy(&f3, p, sizeof f3);
+    return f3;
+  }
+}
+
 /* Helper function for M_ENUM_IN_SERIAL */
 M_INLINE long long
 m_core_in_serial_enum(m_serial_read_t serial)
@@ -5854,6 +6484,113 @@ m_core_serial_fail(void)
   return M_SERIAL_FAIL;
 }
 
+
+
+/************************************************************/
+/************************ Flat image ************************/
+/************************************************************/
+
+/* A flat image of a container is an aligned header followed by
+ * the raw memory representation of the container (the payload),
+ * organized in sections aligned on M_CORE_IMAGE_ALIGN bytes.
+ * An image can be viewed in place (typically from mmap'ed memory) as a read-only
+ * container without copy. It is not portable: it shall be read
+ * by a program using the same types on the same system. */
+
+/* Alignment of the header and of the sections of an image */
+#define M_CORE_IMAGE_ALIGN 64
+
+/* Kind of the container of an image */
+#define M_CORE_IMAGE_KIND(a,b,c,d)                                            \
+  ((uint32_t) (a) | (uint32_t) (b) << 8 | (uint32_t) (c) << 16 | (uint32_t) (d) << 24)
+
+/* Header of an image (M_CORE_IMAGE_ALIGN bytes) */
+typedef struct m_core_image_header_s {
+  char     magic[8];       /* M_CORE_IMAGE_MAGIC */
+  uint32_t marker;         /* M_CORE_IMAGE_MARKER (to detect endianness mismatch) */
+  uint32_t kind;           /* Kind of the container */
+  uint64_t size_of_type;   /* Size of the elements of the payload */
+  uint64_t count;          /* Number of elements */
+  uint64_t param[4];       /* Parameters specific to the container */
+} m_core_image_header_t;
+
+#define M_CORE_IMAGE_MAGIC  "M*LIBIMG"
+#define M_CORE_IMAGE_MARKER 0x01020304U
+
+/* Round up 'n' to the alignment of a section of an image.
+   Return 0 in case of overflow */
+M_INLINE size_t
+m_core_image_round(size_t n)
+{
+  if (M_UNLIKELY (n > SIZE_MAX - (M_CORE_IMAGE_ALIGN - 1))) return 0;
+  return (n + M_CORE_IMAGE_ALIGN - 1) & ~(size_t) (M_CORE_IMAGE_ALIGN - 1);
+}
+
+/* Return the size of a section of 'count' elements of 'size_of_type' bytes,
+   or SIZE_MAX in case of overflow */
+M_INLINE size_t
+m_core_image_section_size(size_t count, size_t size_of_type)
+{
+  if (M_UNLIKELY (size_of_type != 0 && count > SIZE_MAX / size_of_type)) return SIZE_MAX;
+  size_t n = m_core_image_round(count * size_of_type);
+  return (n == 0 && count * size_of_type != 0) ? SIZE_MAX : n;
+}
+
+/* Write the header of an image of the given kind
+   at the beginning of 'image' and return the pointer to its payload */
+M_INLINE void *
+m_core_image_set_header(void *image, uint32_t kind, size_t size_of_type, size_t count,
+                        uint64_t p0, uint64_t p1, uint64_t p2, uint64_t p3)
+{
+  m_core_image_header_t header;
+  M_STATIC_ASSERT(sizeof header <= M_CORE_IMAGE_ALIGN, M_LIB_INTERNAL, "Header of an image is too big");
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, M_CORE_IMAGE_MAGIC, sizeof header.magic);
+  header.marker = M_CORE_IMAGE_MARKER;
+  header.kind = kind;
+  header.size_of_type = size_of_type;
+  header.count = count;
+  header.param[0] = p0;
+  header.param[1] = p1;
+  header.param[2] = p2;
+  header.param[3] = p3;
+  memset(image, 0, M_CORE_IMAGE_ALIGN);
+  memcpy(image, &header, sizeof header);
+  return (char *) image + M_CORE_IMAGE_ALIGN;
+}
+
+/* Check the header of the image 'image' of 'len' bytes
+   for the given kind and size of elements.
+   Return the header if it is valid, NULL otherwise.
+   The image shall be aligned on the alignment of its types (like
+   the memory returned by malloc or mmap) */
+M_INLINE const m_core_image_header_t *
+m_core_image_get_header(const void *image, size_t len, uint32_t kind, size_t size_of_type)
+{
+  if (M_UNLIKELY (image == NULL || len < M_CORE_IMAGE_ALIGN)) return NULL;
+  if (M_UNLIKELY ((uintptr_t) image % sizeof (uint64_t) != 0)) return NULL;
+  const m_core_image_header_t *header = (const m_core_image_header_t *) image;
+  if (M_UNLIKELY (memcmp(header->magic, M_CORE_IMAGE_MAGIC, sizeof header->magic) != 0
+                  || header->marker != M_CORE_IMAGE_MARKER
+                  || header->kind != kind
+                  || header->size_of_type != size_of_type
+                  || header->count > SIZE_MAX)) {
+    return NULL;
+  }
+  return header;
+}
+
+/* Test if the pointer 'p' of a section of an image
+   is suitably aligned for elements of 'size_of_type' bytes
+   (the alignment of a type divides its size) */
+M_INLINE bool
+m_core_image_aligned_p(const void *p, size_t size_of_type)
+{
+  size_t align = size_of_type & (~size_of_type + 1);
+  if (align == 0 || align > 16) align = 16;
+  return (uintptr_t) p % align == 0;
+}
+
 M_END_PROTECTED_CODE
 
 #endif
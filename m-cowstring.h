@@ -0,0 +1,569 @@
+/*
+ * M*LIB - COPY ON WRITE STRING module
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_COWSTRING_H
+#define MSTARLIB_COWSTRING_H
+
+#include "m-core.h"
+#include "m-atomic.h"
+#include "m-string.h"
+
+M_BEGIN_PROTECTED_CODE
+
+/* Size of the buffer embedded in the string object itself
+   (including the final null char).
+   Strings shorter than this are never allocated, nor shared. */
+#ifndef M_USE_COWSTRING_SHORT_SIZE
+#define M_USE_COWSTRING_SHORT_SIZE (2*sizeof (void*))
+#endif
+
+/* A heap buffer of characters shared by one or several strings.
+   The characters of a node are never modified while it is shared
+   by more than one string. */
+typedef struct m_cowstring_node_s {
+  atomic_uint cpt;                      // Number of strings sharing the node
+  size_t alloc;                         // Allocated size of 'str'
+  char str[M_MIN_FLEX_ARRAY_SIZE];      // Characters of the string (null terminated)
+} m_c0wstring_node_t;
+
+/* A copy on write string:
+   - if its size is lower than M_USE_COWSTRING_SHORT_SIZE, the characters
+   are stored in the object itself,
+   - otherwise they are stored in a reference counted node
+   which is shared by all the copies of the string.
+   The node is duplicated only when a shared string is modified.
+   The reference counter is atomic so that copies of the same string
+   can be used by different threads. */
+typedef struct m_cowstring_s {
+  size_t size;                          // Number of characters (excluding the final null char)
+  union {
+    m_c0wstring_node_t *node;           // if size >= M_USE_COWSTRING_SHORT_SIZE
+    char buffer[M_USE_COWSTRING_SHORT_SIZE]; // if size < M_USE_COWSTRING_SHORT_SIZE
+  } u;
+} m_cowstring_t[1];
+
+/* Define a copy on write string pointer (for internal use only) */
+typedef struct m_cowstring_s *m_cowstring_ptr;
+typedef const struct m_cowstring_s *m_cowstring_srcptr;
+
+/* PREFIX:
+   m_c0wstring_: private methods
+   m_cowstring_: public methods
+*/
+
+/* Contract of a copy on write string */
+#define M_C0WSTRING_CONTRACT(s) do {                                          \
+    M_ASSERT ((s) != NULL);                                                   \
+    M_ASSERT (m_c0wstring_short_p(s)                                          \
+              ? (s)->u.buffer[(s)->size] == 0                                 \
+              : ((s)->u.node != NULL && atomic_load(&(s)->u.node->cpt) > 0    \
+                 && (s)->u.node->alloc > (s)->size                            \
+                 && (s)->u.node->str[(s)->size] == 0));                       \
+  } while (0)
+
+/* Return true if the characters are stored in the object itself */
+M_INLINE bool
+m_c0wstring_short_p(const m_cowstring_t s)
+{
+  return s->size < M_USE_COWSTRING_SHORT_SIZE;
+}
+
+/* Create a new node of 'alloc' bytes with a reference counter of 1 */
+M_P(m_c0wstring_node_t *, m_c0wstring, _new_node, size_t alloc)
+{
+  const size_t size = offsetof(m_c0wstring_node_t, str) + alloc;
+  m_c0wstring_node_t *n = (m_c0wstring_node_t *)(void *) M_MEMORY_REALLOC(m_context, char, NULL, 0, size);
+  if (M_UNLIKELY_NOMEM (n == NULL)) {
+    M_MEMORY_FULL(char, size);
+  }
+  atomic_init(&n->cpt, 1U);
+  n->alloc = alloc;
+  return n;
+}
+
+/* Release a reference to the node and free it if it was the last one */
+M_P(void, m_c0wstring, _unref, m_c0wstring_node_t *n)
+{
+  if (atomic_fetch_sub(&n->cpt, 1U) == 1U) {
+    M_MEMORY_FREE(m_context, char, (char *)(void *) n, offsetof(m_c0wstring_node_t, str) + n->alloc);
+  }
+}
+
+/* Return true if the node of the string is not shared with another string */
+M_INLINE bool
+m_c0wstring_unique_p(const m_cowstring_t s)
+{
+  M_ASSERT (!m_c0wstring_short_p(s));
+  return atomic_load(&s->u.node->cpt) == 1U;
+}
+
+M_INLINE void
+m_cowstring_init(m_cowstring_t s)
+{
+  s->size = 0;
+  s->u.buffer[0] = 0;
+  M_C0WSTRING_CONTRACT(s);
+}
+
+M_P(void, m_cowstring, _clear, m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  if (!m_c0wstring_short_p(s)) {
+    m_c0wstring_unref M_R(s->u.node);
+  }
+  // Crash if the string is used after clear
+  s->size = M_USE_COWSTRING_SHORT_SIZE;
+  s->u.node = NULL;
+}
+
+M_P(void, m_cowstring, _reset, m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  if (!m_c0wstring_short_p(s)) {
+    m_c0wstring_unref M_R(s->u.node);
+  }
+  m_cowstring_init(s);
+}
+
+/* Initialize the string to the other one.
+   Both strings share the same node: the complexity is constant */
+M_INLINE void
+m_cowstring_init_set(m_cowstring_t d, const m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  *d = *s;
+  if (!m_c0wstring_short_p(s)) {
+    atomic_fetch_add(&s->u.node->cpt, 1U);
+  }
+  M_C0WSTRING_CONTRACT(d);
+}
+
+/* Set the string to the other one (in constant time) */
+M_P(void, m_cowstring, _set, m_cowstring_t d, const m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(d);
+  M_C0WSTRING_CONTRACT(s);
+  if (M_UNLIKELY (d == s)) {
+    return;
+  }
+  m_cowstring_clear M_R(d);
+  m_cowstring_init_set(d, s);
+}
+
+M_INLINE void
+m_cowstring_init_move(m_cowstring_t d, m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  *d = *s;
+  // Crash if the string is used after move
+  s->size = M_USE_COWSTRING_SHORT_SIZE;
+  s->u.node = NULL;
+}
+
+M_P(void, m_cowstring, _move, m_cowstring_t d, m_cowstring_t s)
+{
+  M_ASSERT (d != s);
+  m_cowstring_clear M_R(d);
+  m_cowstring_init_move(d, s);
+}
+
+M_INLINE void
+m_cowstring_swap(m_cowstring_t s1, m_cowstring_t s2)
+{
+  M_C0WSTRING_CONTRACT(s1);
+  M_C0WSTRING_CONTRACT(s2);
+  M_SWAP(struct m_cowstring_s, *s1, *s2);
+}
+
+/* Return the number of characters (bytes) of the string */
+M_INLINE size_t
+m_cowstring_size(const m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  return s->size;
+}
+
+M_INLINE bool
+m_cowstring_empty_p(const m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  return s->size == 0;
+}
+
+/* Return a constant pointer to the null terminated characters of the string.
+   The pointer is valid until the next modification of the string */
+M_INLINE const char *
+m_cowstring_get_cstr(const m_cowstring_t s)
+{
+  M_C0WSTRING_CONTRACT(s);
+  return m_c0wstring_short_p(s) ? s->u.buffer : s->u.node->str;
+}
+
+/* Return a view of the characters of the string */
+M_INLINE m_string_view_t
+m_cowstring_get_view(const m_cowstring_t s)
+{
+  return m_string_view_cstrn(m_cowstring_get_cstr(s), m_cowstring_size(s));
+}
+
+/* Return the character at offset 'pos' of the string */
+M_INLINE char
+m_cowstring_get_char(const m_cowstring_t s, size_t pos)
+{
+  M_ASSERT_INDEX(pos, m_cowstring_size(s));
+  return m_cowstring_get_cstr(s)[pos];
+}
+
+/* Set the string to the 'n' first characters of 'str'.
+   'str' may point to the characters of the string itself */
+M_P(void, m_cowstring, _set_cstrn, m_cowstring_t s, const char str[], size_t n)
+{
+  M_C0WSTRING_CONTRACT(s);
+  M_ASSERT (str != NULL || n == 0);
+  m_c0wstring_node_t *old = m_c0wstring_short_p(s) ? NULL : s->u.node;
+  if (n < M_USE_COWSTRING_SHORT_SIZE) {
+    // 'old' is still alive, so 'str' remains valid
+    memmove(s->u.buffer, str, n);
+    s->u.buffer[n] = 0;
+  } else if (old != NULL && old->alloc > n && m_c0wstring_unique_p(s)) {
+    memmove(old->str, str, n);
+    old->str[n] = 0;
+    old = NULL;
+  } else {
+    m_c0wstring_node_t *node = m_c0wstring_new_node M_R(n + 1);
+    memcpy(node->str, str, n);
+    node->str[n] = 0;
+    s->u.node = node;
+  }
+  s->size = n;
+  if (old != NULL) {
+    m_c0wstring_unref M_R(old);
+  }
+  M_C0WSTRING_CONTRACT(s);
+}
+
+M_P(void, m_cowstring, _set_cstr, m_cowstring_t s, const char str[])
+{
+  M_ASSERT (str != NULL);
+  m_cowstring_set_cstrn M_R(s, str, strlen(str));
+}
+
+M_P(void, m_cowstring, _set_string, m_cowstring_t s, const m_string_t str)
+{
+  m_cowstring_set_cstrn M_R(s, m_string_get_cstr(str), m_string_size(str));
+}
+
+M_P(void, m_cowstring, _init_set_cstr, m_cowstring_t s, const char str[])
+{
+  m_cowstring_init(s);
+  m_cowstring_set_cstr M_R(s, str);
+}
+
+M_P(void, m_cowstring, _init_set_string, m_cowstring_t s, const m_string_t str)
+{
+  m_cowstring_init(s);
+  m_cowstring_set_string M_R(s, str);
+}
+
+/* Append the 'n' first characters of 'str' to the string.
+   If the node of the string is shared, the string gets its own copy first */
+M_P(void, m_cowstring, _cat_cstrn, m_cowstring_t s, const char str[], size_t n)
+{
+  M_C0WSTRING_CONTRACT(s);
+  M_ASSERT (str != NULL || n == 0);
+  const size_t size = s->size;
+  const size_t new_size = size + n;
+  if (new_size < M_USE_COWSTRING_SHORT_SIZE) {
+    memmove(&s->u.buffer[size], str, n);
+    s->u.buffer[new_size] = 0;
+  } else if (!m_c0wstring_short_p(s) && s->u.node->alloc > new_size
+             && m_c0wstring_unique_p(s)) {
+    memmove(&s->u.node->str[size], str, n);
+    s->u.node->str[new_size] = 0;
+  } else {
+    // Reserve some extra space for the next concatenations
+    m_c0wstring_node_t *node = m_c0wstring_new_node M_R(new_size + 1 + new_size / 2);
+    const char *old_str = m_cowstring_get_cstr(s);
+    memcpy(node->str, old_str, size);
+    memcpy(&node->str[size], str, n);
+    node->str[new_size] = 0;
+    if (!m_c0wstring_short_p(s)) {
+      m_c0wstring_unref M_R(s->u.node);
+    }
+    s->u.node = node;
+  }
+  s->size = new_size;
+  M_C0WSTRING_CONTRACT(s);
+}
+
+M_P(void, m_cowstring, _cat_cstr, m_cowstring_t s, const char str[])
+{
+  M_ASSERT (str != NULL);
+  m_cowstring_cat_cstrn M_R(s, str, strlen(str));
+}
+
+M_P(void, m_cowstring, _cat, m_cowstring_t s, const m_cowstring_t s2)
+{
+  m_cowstring_cat_cstrn M_R(s, m_cowstring_get_cstr(s2), m_cowstring_size(s2));
+}
+
+M_P(void, m_cowstring, _push_back, m_cowstring_t s, char c)
+{
+  m_cowstring_cat_cstrn M_R(s, &c, 1);
+}
+
+/* Set the character at offset 'pos' of the string to 'c'.
+   If the node of the string is shared, the string gets its own copy first */
+M_P(void, m_cowstring, _set_char, m_cowstring_t s, size_t pos, char c)
+{
+  M_C0WSTRING_CONTRACT(s);
+  M_ASSERT_INDEX(pos, s->size);
+  if (m_c0wstring_short_p(s)) {
+    s->u.buffer[pos] = c;
+    return;
+  }
+  if (!m_c0wstring_unique_p(s)) {
+    m_c0wstring_node_t *node = m_c0wstring_new_node M_R(s->size + 1);
+    memcpy(node->str, s->u.node->str, s->size + 1);
+    m_c0wstring_unref M_R(s->u.node);
+    s->u.node = node;
+  }
+  s->u.node->str[pos] = c;
+  M_C0WSTRING_CONTRACT(s);
+}
+
+/* Set the string 'v' to the characters of the copy on write string */
+M_P(void, m_cowstring, _get_string, m_string_t v, const m_cowstring_t s)
+{
+  m_string_set_view M_R(v, m_cowstring_get_view(s));
+}
+
+M_INLINE bool
+m_cowstring_equal_p(const m_cowstring_t s1, const m_cowstring_t s2)
+{
+  M_ASSERT (s1 != NULL && s2 != NULL);
+  // OOR values have a size which cannot be the size of a valid string
+  if (s1->size != s2->size) {
+    return false;
+  }
+  // Strings sharing the same node are equal
+  if (!m_c0wstring_short_p(s1) && s1->u.node == s2->u.node) {
+    return true;
+  }
+  return memcmp(m_cowstring_get_cstr(s1), m_cowstring_get_cstr(s2), s1->size) == 0;
+}
+
+M_INLINE bool
+m_cowstring_equal_cstr_p(const m_cowstring_t s, const char str[])
+{
+  M_ASSERT (str != NULL);
+  return strcmp(m_cowstring_get_cstr(s), str) == 0;
+}
+
+/* Compare the strings and return the sort order
+   (negative if less, 0 if equal, positive if greater) */
+M_INLINE int
+m_cowstring_cmp(const m_cowstring_t s1, const m_cowstring_t s2)
+{
+  return strcmp(m_cowstring_get_cstr(s1), m_cowstring_get_cstr(s2));
+}
+
+M_INLINE int
+m_cowstring_cmp_cstr(const m_cowstring_t s, const char str[])
+{
+  M_ASSERT (str != NULL);
+  return strcmp(m_cowstring_get_cstr(s), str);
+}
+
+/* Return the hash of the string.
+   It is equal to the hash of the equivalent m_string_t */
+M_INLINE size_t
+m_cowstring_hash(const m_cowstring_t s)
+{
+  return m_core_hash(m_cowstring_get_cstr(s), m_cowstring_size(s));
+}
+
+/* Set the string to an Out-Of-Range value 'k' (used by open addressing dictionaries) */
+M_INLINE void
+m_cowstring_oor_set(m_cowstring_t s, unsigned char k)
+{
+  s->size = SIZE_MAX - k;
+  s->u.node = NULL;
+}
+
+M_INLINE bool
+m_cowstring_oor_equal_p(const m_cowstring_t s, unsigned char k)
+{
+  return s->size == SIZE_MAX - k;
+}
+
+/* Transform the string into a formatted string
+   and set it to (or append in) the string 'v' */
+M_P(void, m_cowstring, _get_str, m_string_t v, const m_cowstring_t s, bool append)
+{
+  m_str1ng_get_strn M_R(v, m_cowstring_get_cstr(s), m_cowstring_size(s), append);
+}
+
+/* Parse a formatted string from 'str' and set the string to it */
+M_P(bool, m_cowstring, _parse_str, m_cowstring_t s, const char str[], const char **endptr)
+{
+  m_string_t tmp;
+  m_string_init(tmp);
+  bool b = m_string_parse_str M_R(tmp, str, endptr);
+  m_cowstring_set_string M_R(s, tmp);
+  m_string_clear M_R(tmp);
+  return b;
+}
+
+#if M_USE_STDIO
+
+/* Transform the string into a formatted string
+   and output it in the given FILE */
+M_INLINE void
+m_cowstring_out_str(FILE *f, const m_cowstring_t s)
+{
+  M_ASSERT (f != NULL);
+  m_str1ng_out_strn(f, m_cowstring_get_cstr(s), m_cowstring_size(s));
+}
+
+/* Read a formatted string from the FILE and set the string to it */
+M_P(bool, m_cowstring, _in_str, m_cowstring_t s, FILE *f)
+{
+  m_string_t tmp;
+  m_string_init(tmp);
+  bool b = m_string_in_str M_R(tmp, f);
+  m_cowstring_set_string M_R(s, tmp);
+  m_string_clear M_R(tmp);
+  return b;
+}
+
+#endif
+
+/* Output the string into the serializer */
+M_P(m_serial_return_code_t, m_cowstring, _out_serial, m_serial_write_t serial, const m_cowstring_t s)
+{
+  M_ASSERT (serial != NULL && serial->m_interface != NULL);
+  return serial->m_interface->write_string M_R(serial, m_cowstring_get_cstr(s), m_cowstring_size(s));
+}
+
+/* Read a string from the serializer and set the string to it */
+M_P(m_serial_return_code_t, m_cowstring, _in_serial, m_cowstring_t s, m_serial_read_t serial)
+{
+  M_ASSERT (serial != NULL && serial->m_interface != NULL);
+  m_string_t tmp;
+  m_string_init(tmp);
+  m_serial_return_code_t r = serial->m_interface->read_string M_R(serial, tmp);
+  m_cowstring_set_string M_R(s, tmp);
+  m_string_clear M_R(tmp);
+  return r;
+}
+
+/* Define the OPLIST of a copy on write string */
+#ifndef M_USE_CONTEXT
+#define M_COWSTRING_OPLIST                                                    \
+  (INIT(m_cowstring_init),INIT_SET(m_cowstring_init_set), SET(m_cowstring_set), \
+   INIT_WITH(m_cowstring_init_set_cstr),                                      \
+   INIT_MOVE(m_cowstring_init_move), MOVE(m_cowstring_move),                  \
+   SWAP(m_cowstring_swap), RESET(m_cowstring_reset),                          \
+   EMPTY_P(m_cowstring_empty_p),                                              \
+   CLEAR(m_cowstring_clear), HASH(m_cowstring_hash), EQUAL(m_cowstring_equal_p), \
+   CMP(m_cowstring_cmp), TYPE(m_cowstring_t), GENTYPE(struct m_cowstring_s*), \
+   PARSE_STR(m_cowstring_parse_str), GET_STR(m_cowstring_get_str),            \
+   OUT_STR(m_cowstring_out_str), IN_STR(m_cowstring_in_str),                  \
+   OUT_SERIAL(m_cowstring_out_serial), IN_SERIAL(m_cowstring_in_serial),      \
+   OOR_EQUAL(m_cowstring_oor_equal_p), OOR_SET(m_cowstring_oor_set)           \
+   )
+#else
+#define M_COWSTRING_OPLIST                                                    \
+  (INIT(m_cowstring_init),INIT_SET(m_cowstring_init_set), SET(API_0P(m_cowstring_set)), \
+   INIT_WITH(API_0P(m_cowstring_init_set_cstr)),                              \
+   INIT_MOVE(m_cowstring_init_move), MOVE(API_0P(m_cowstring_move)),          \
+   SWAP(m_cowstring_swap), RESET(API_0P(m_cowstring_reset)),                  \
+   EMPTY_P(m_cowstring_empty_p),                                              \
+   CLEAR(API_0P(m_cowstring_clear)), HASH(m_cowstring_hash), EQUAL(m_cowstring_equal_p), \
+   CMP(m_cowstring_cmp), TYPE(m_cowstring_t), GENTYPE(struct m_cowstring_s*), \
+   PARSE_STR(API_0P(m_cowstring_parse_str)), GET_STR(API_0P(m_cowstring_get_str)), \
+   OUT_STR(m_cowstring_out_str), IN_STR(API_0P(m_cowstring_in_str)),          \
+   OUT_SERIAL(API_0P(m_cowstring_out_serial)), IN_SERIAL(API_0P(m_cowstring_in_serial)), \
+   OOR_EQUAL(m_cowstring_oor_equal_p), OOR_SET(m_cowstring_oor_set)           \
+   )
+#endif
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_cowstring_t() M_COWSTRING_OPLIST
+
+M_END_PROTECTED_CODE
+
+/********************************************************************************/
+/*                                                                              */
+/* Define the small name (i.e. without the prefix) of the API provided by this  */
+/* header if it is needed                                                       */
+/*                                                                              */
+/********************************************************************************/
+#if M_USE_SMALL_NAME
+
+#define cowstring_t m_cowstring_t
+#define cowstring_init m_cowstring_init
+#define cowstring_clear m_cowstring_clear
+#define cowstring_reset m_cowstring_reset
+#define cowstring_init_set m_cowstring_init_set
+#define cowstring_set m_cowstring_set
+#define cowstring_init_move m_cowstring_init_move
+#define cowstring_move m_cowstring_move
+#define cowstring_swap m_cowstring_swap
+#define cowstring_size m_cowstring_size
+#define cowstring_empty_p m_cowstring_empty_p
+#define cowstring_get_str m_cowstring_get_str
+#define cowstring_get_cstr m_cowstring_get_cstr
+#define cowstring_get_view m_cowstring_get_view
+#define cowstring_get_char m_cowstring_get_char
+#define cowstring_set_strn m_cowstring_set_cstrn
+#define cowstring_set_str m_cowstring_set_cstr
+#define cowstring_set_string m_cowstring_set_string
+#define cowstring_init_set_str m_cowstring_init_set_cstr
+#define cowstring_init_set_string m_cowstring_init_set_string
+#define cowstring_cat_strn m_cowstring_cat_cstrn
+#define cowstring_cat_str m_cowstring_cat_cstr
+#define cowstring_cat m_cowstring_cat
+#define cowstring_push_back m_cowstring_push_back
+#define cowstring_set_char m_cowstring_set_char
+#define cowstring_get_string m_cowstring_get_string
+#define cowstring_equal_p m_cowstring_equal_p
+#define cowstring_equal_str_p m_cowstring_equal_cstr_p
+#define cowstring_cmp m_cowstring_cmp
+#define cowstring_cmp_str m_cowstring_cmp_cstr
+#define cowstring_hash m_cowstring_hash
+#define cowstring_oor_set m_cowstring_oor_set
+#define cowstring_oor_equal_p m_cowstring_oor_equal_p
+#define cowstring_parse_str m_cowstring_parse_str
+#define cowstring_out_str m_cowstring_out_str
+#define cowstring_in_str m_cowstring_in_str
+#define cowstring_out_serial m_cowstring_out_serial
+#define cowstring_in_serial m_cowstring_in_serial
+#define COWSTRING_OPLIST M_COWSTRING_OPLIST
+#define M_OPL_cowstring_t M_OPL_m_cowstring_t
+
+#endif
+
+#endif
@@ -125,6 +125,38 @@
   M_END_PROTECTED_CODE
 
 
+/* Define a fixed capacity dictionary associating the key key_type to the
+   value value_type with an Open Addressing implementation and its associated
+   functions. The table of N entries (N shall be a power of 2) is stored
+   within the dictionary object itself, so that it never allocates memory:
+   the methods that would need to grow the table return a failure code instead.
+   KEY_OPLIST needs the operators OOR_EQUAL & OOR_SET.
+   USAGE:
+     STATIC_DICT_OA_DEF2(name, key_type, key_oplist, value_type, value_oplist, N)
+   OR
+     STATIC_DICT_OA_DEF2(name, key_type, value_type, N)
+*/
+#define M_STATIC_DICT_OA_DEF2(name, key_type, ...)                            \
+  M_STATIC_DICT_OA_DEF2_AS(name, M_F(name,_t), M_F(name,_it_t), M_F(name,_itref_t), key_type, __VA_ARGS__)
+
+
+/* Define a fixed capacity dictionary associating the key key_type to the
+   value value_type with an Open Addressing implementation
+   as the given name name_t with its associated functions.
+   KEY_OPLIST needs the operators OOR_EQUAL & OOR_SET.
+   USAGE:
+     STATIC_DICT_OA_DEF2_AS(name, name_t, it_t, itref_t, key_type, key_oplist, value_type, value_oplist, N)
+   OR
+     STATIC_DICT_OA_DEF2_AS(name, name_t, it_t, itref_t, key_type, value_type, N)
+*/
+#define M_STATIC_DICT_OA_DEF2_AS(name, name_t, it_t, itref_t, key_type, ...)  \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_D1CT_STATIC_OA_DEF_P1(M_IF_NARGS_EQ2(__VA_ARGS__)                         \
+                  ((name, key_type, M_GLOBAL_OPLIST_OR_DEF(key_type)(), M_RET_ARG1(__VA_ARGS__), M_GLOBAL_OPLIST_OR_DEF(M_RET_ARG1(__VA_ARGS__))(), M_RET_ARG2(__VA_ARGS__), name_t, it_t, itref_t ), \
+                   (name, key_type, __VA_ARGS__, name_t, it_t, itref_t )))    \
+  M_END_PROTECTED_CODE
+
+
 /* Define the oplist of a dictionary (DICT_DEF2 or DICT_OA_DEF2).
    USAGE:
      DICT_OPLIST(name, oplist of the key type, oplist of the value type)
@@ -145,6 +177,18 @@
    M_D1CT_SET_OPLIST_P1((__VA_ARGS__ )))
 
 
+/* Define the oplist of a fixed capacity dictionary (STATIC_DICT_OA_DEF2).
+   It is the same as the one of a dictionary, except that the methods
+   which fail on a full dictionary are disabled (generic code cannot check it).
+   USAGE:
+     STATIC_DICT_OA_OPLIST(name, oplist of the key type, oplist of the value type)
+   OR
+     STATIC_DICT_OA_OPLIST(name)
+*/
+#define M_STATIC_DICT_OA_OPLIST(...)                                          \
+  M_OPEXTEND(M_DICT_OPLIST(__VA_ARGS__), SET_KEY(0), SAFE_GET_KEY(0), INIT_WITH(0))
+
+
 /*****************************************************************************/
 /******************************** INTERNAL ***********************************/
 /*****************************************************************************/
@@ -471,6 +515,10 @@ M_ARRAY_DEF(m_array_index, m_indexhash_t, M_POD_OPLIST)
     }                                                                         \
   }                                                                           \
                                                                               \
+  M_IF(M_TEST_METHOD_ALTER_P(VIEW_TYPE, key_oplist))                          \
+  (M_D1CT_DEF_GET_VIEW, M_EAT)                                                \
+  (name, key_oplist, value_type, isSet, dict_t, M_GET_VIEW_TYPE key_oplist)   \
+                                                                              \
   M_P(void, name, _i_resize_up, dict_t h, m_index_t newSize, bool updateLimit) \
   {                                                                           \
     /* NOTE: Contract may not be fulfilled here */                            \
@@ -861,9 +909,137 @@ M_ARRAY_DEF(m_array_index, m_indexhash_t, M_POD_OPLIST)
     return (const it_deref_t *) &d->data[d->index[it->index].index].pair M_IF(isSet)(.key, ); \
   }                                                                           \
                                                                               \
-  M_D1CT_FUNC_ADDITIONAL_DEF2(name, key_type, key_oplist, value_type, value_oplist, isSet, dict_t, dict_it_t, it_deref_t)
+  M_D1CT_FUNC_ADDITIONAL_DEF2(name, key_type, key_oplist, value_type, value_oplist, isSet, dict_t, dict_it_t, it_deref_t) \
+                                                                              \
+  M_IF(M_D1CT_IMAGE_P(isSet, key_oplist, value_oplist))                       \
+  (M_D1CT_DEF_IMAGE, M_EAT)                                                   \
+  (name, key_type, key_oplist, value_type, value_oplist, isSet, dict_t)
 
 
+
+/* Test if the flat image functions can be defined for the dictionary:
+   the key (and the value for a map) shall be flat (FLAT property) */
+#define M_D1CT_IMAGE_P(isSet, key_oplist, value_oplist)                       \
+  M_IF(isSet)(M_GET_PROPERTY(key_oplist, FLAT),                               \
+              M_AND(M_GET_PROPERTY(key_oplist, FLAT), M_GET_PROPERTY(value_oplist, FLAT)))
+
+/* Kind of the flat image of a dictionary.
+   The size of the index type is part of it as the index table is
+   stored as is */
+#define M_D1CT_IMAGE_KIND                                                     \
+  M_CORE_IMAGE_KIND('D','I','C', '0' + (int) sizeof (m_index_t))
+
+/* Define the flat image functions of a dictionary:
+   the image is the header, then a section with the hash seed,
+   then the index table and then the data table, each table being stored as is.
+   The hash of the keys shall be the same for the writer and the reader
+   of the image (same build, same M_USE_HASH_SEED, which is checked),
+   and the image shall be trusted: only its header is validated */
+#define M_D1CT_DEF_IMAGE(name, key_type, key_oplist, value_type, value_oplist, isSet, dict_t) \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _image_size)(const dict_t map)                                    \
+  {                                                                           \
+    M_D1CT_CONTRACT(map);                                                     \
+    const size_t index = m_core_image_section_size((size_t) map->mask + 1, sizeof (m_indexhash_t)); \
+    const size_t data = m_core_image_section_size(map->freelist_count, sizeof (M_F(name, _freelist_ct))); \
+    return 2 * M_CORE_IMAGE_ALIGN + index + data;                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _to_image)(void *image, size_t len, const dict_t map)             \
+  {                                                                           \
+    M_D1CT_CONTRACT(map);                                                     \
+    const size_t size = M_F(name, _image_size)(map);                          \
+    if (M_UNLIKELY (image == NULL || len < size)) return 0;                   \
+    memset(image, 0, size);                                                   \
+    char *p = (char *) m_core_image_set_header(image, M_D1CT_IMAGE_KIND,      \
+                                               sizeof (M_F(name, _freelist_ct)), map->count, \
+                                               map->mask, map->freelist_count, \
+                                               map->freelist_first_data, map->count_delete); \
+    const uint64_t seed = (uint64_t) M_USE_HASH_SEED;                         \
+    memcpy(p, &seed, sizeof seed);                                            \
+    p += M_CORE_IMAGE_ALIGN;                                                  \
+    memcpy(p, map->index, ((size_t) map->mask + 1) * sizeof (m_indexhash_t)); \
+    p += m_core_image_section_size((size_t) map->mask + 1, sizeof (m_indexhash_t)); \
+    memcpy(p, map->data, (size_t) map->freelist_count * sizeof (M_F(name, _freelist_ct))); \
+    return size;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _view_from_image)(dict_t view, const void *image, size_t len)     \
+  {                                                                           \
+    const m_core_image_header_t *header =                                     \
+      m_core_image_get_header(image, len, M_D1CT_IMAGE_KIND, sizeof (M_F(name, _freelist_ct))); \
+    if (M_UNLIKELY (header == NULL)) return false;                            \
+    const uint64_t mask = header->param[0], freelist_count = header->param[1]; \
+    const uint64_t first = header->param[2], count_delete = header->param[3]; \
+    if (M_UNLIKELY (mask >= (m_index_t) -1 || !M_POWEROF2_P(mask+1)           \
+                    || mask+1 < M_D1CT_INITIAL_SIZE                           \
+                    || freelist_count > mask + 3                              \
+                    || freelist_count < 2 || header->count > freelist_count - 2 \
+                    || first >= freelist_count || (first != 0 && first < 2)   \
+                    || (first == 0 && header->count + 2 != freelist_count)    \
+                    || count_delete < header->count || count_delete > mask))  \
+      return false;                                                           \
+    /* The hash of the keys depends on the seed */                            \
+    uint64_t seed;                                                            \
+    if (M_UNLIKELY (len < 2 * M_CORE_IMAGE_ALIGN)) return false;              \
+    memcpy(&seed, (const char *) image + M_CORE_IMAGE_ALIGN, sizeof seed);    \
+    if (M_UNLIKELY (seed != (uint64_t) M_USE_HASH_SEED)) return false;        \
+    const size_t avail = len - 2 * M_CORE_IMAGE_ALIGN;                        \
+    const size_t index = m_core_image_section_size((size_t) mask + 1, sizeof (m_indexhash_t)); \
+    const size_t data = m_core_image_section_size((size_t) freelist_count, sizeof (M_F(name, _freelist_ct))); \
+    if (M_UNLIKELY (index > avail || data > avail - index))                   \
+      return false;                                                           \
+    const char *p = (const char *) image + 2 * M_CORE_IMAGE_ALIGN;            \
+    if (M_UNLIKELY (!m_core_image_aligned_p(p, sizeof (m_indexhash_t))        \
+                    || !m_core_image_aligned_p(p + index, sizeof (M_F(name, _freelist_ct))))) \
+      return false;                                                           \
+    view->count = (m_index_t) header->count;                                  \
+    view->count_delete = (m_index_t) count_delete;                            \
+    view->mask = (m_index_t) mask;                                            \
+    view->freelist_first_data = (m_index_t) first;                            \
+    view->freelist_count = (m_index_t) freelist_count;                        \
+    view->freelist_cap = (m_index_t) freelist_count;                          \
+    M_C3(m_d1ct_,name,_update_limit)(view, (m_index_t) (mask + 1));           \
+    if (M_UNLIKELY (view->count > view->upper_limit))                         \
+      return false;                                                           \
+    /* The view is read-only: the constness of the image is restored by the API */ \
+    view->index = (m_indexhash_t *) (uintptr_t) p;                            \
+    view->data = (M_F(name, _freelist_ct) *) (uintptr_t) (p + index);         \
+    M_D1CT_CONTRACT(view);                                                    \
+    return true;                                                              \
+  }                                                                           \
+
+
+
+/* Define the lookup of a key through its view type,
+   if the key oplist defines a VIEW_TYPE
+   (the HASH of the key and the VIEW_HASH of its view shall be equal) */
+#define M_D1CT_DEF_GET_VIEW(name, key_oplist, value_type, isSet, dict_t, view_type) \
+  M_INLINE value_type *                                                       \
+  M_F(name, _get_view)(const dict_t map, view_type const key)                 \
+  {                                                                           \
+    M_D1CT_CONTRACT(map);                                                     \
+    const m_index_t mask = map->mask;                                         \
+    m_index_t hash = (m_index_t) M_CALL_VIEW_HASH(key_oplist, key);           \
+    m_index_t p = hash & mask;                                                \
+    m_index_t s = 1;                                                          \
+    while (true) {                                                            \
+      if (M_LIKELY (hash == map->index[p].hash)) {                            \
+        m_index_t d = map->index[p].index;                                    \
+        if (M_LIKELY(d >=2 && M_CALL_VIEW_EQUAL(key_oplist, map->data[d].pair.key, key))) { \
+          return &map->data[d].pair.M_IF(isSet)(key, value);                  \
+        }                                                                     \
+      }                                                                       \
+      if (M_LIKELY (map->index[p].index == 0)) {                              \
+        return NULL;                                                          \
+      }                                                                       \
+      p = (p + M_D1CT_OA_PROBING(s)) & mask;                                  \
+    }                                                                         \
+  }
+
 /* Define additional functions for dictionary (Common for all kinds of dictionary).
    Do not used any specific fields of the dictionary but the public API
 
@@ -1502,6 +1678,30 @@ enum m_d1ct_oa_element_e {
 #define M_D1CT_OASET_DEF_P2(name, key_type, key_oplist, dict_t, dict_it_t, it_deref_t) \
   M_IF_OPLIST(key_oplist)(M_D1CT_OASET_DEF_P4, M_D1CT_OASET_DEF_FAILURE)(name, key_type, key_oplist, dict_t, dict_it_t, it_deref_t)
 
+
+/* Define the lookup of a key through its view type,
+   if the key oplist defines a VIEW_TYPE
+   (the HASH of the key and the VIEW_HASH of its view shall be equal) */
+#define M_D1CT_OA_DEF_GET_VIEW(name, key_oplist, value_type, isSet, dict_t, view_type) \
+  M_INLINE value_type *                                                       \
+  M_F(name, _get_view)(const dict_t dict, view_type const key)                \
+  {                                                                           \
+    M_D1CT_OA_CONTRACT(dict);                                                 \
+    M_F(name, _pair_ct) *const data = dict->data;                             \
+    const size_t mask = dict->mask;                                           \
+    size_t p = M_CALL_VIEW_HASH(key_oplist, key) & mask;                      \
+    size_t s = 1;                                                             \
+    while (true) {                                                            \
+      if (M_CALL_OOR_EQUAL(key_oplist, data[p].key, M_D1CT_OA_EMPTY))         \
+        return NULL;                                                          \
+      if (!M_CALL_OOR_EQUAL(key_oplist, data[p].key, M_D1CT_OA_DELETED)       \
+          && M_CALL_VIEW_EQUAL(key_oplist, data[p].key, key))                 \
+        return &data[p].M_IF(isSet)(key, value);                              \
+      p = (p + M_D1CT_OA_PROBING(s)) & mask;                                  \
+      M_ASSERT (s <= dict->mask);                                             \
+    }                                                                         \
+  }
+
 /* Stop processing with a compilation failure */
 #define M_D1CT_OASET_DEF_FAILURE(name, key_type, key_oplist, dict_t, dict_it_t, it_deref_t) \
   M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(DICT_OASET_DEF): the given argument is not a valid oplist: " M_AS_STR(key_oplist) )
@@ -1649,6 +1849,10 @@ enum m_d1ct_oa_element_e {
     }                                                                         \
   }                                                                           \
                                                                               \
+  M_IF(M_TEST_METHOD_ALTER_P(VIEW_TYPE, key_oplist))                          \
+  (M_D1CT_OA_DEF_GET_VIEW, M_EAT)                                             \
+  (name, key_oplist, value_type, isSet, dict_t, M_GET_VIEW_TYPE key_oplist)   \
+                                                                              \
   M_IF_DEBUG(                                                                 \
   M_INLINE bool                                                               \
   M_C3(m_d1ct_,name,_control_after_resize)(const dict_t h)                    \
@@ -2284,6 +2488,599 @@ M_P(void, name, _bulk_update, dict_t dict, unsigned n, value_type val[M_VLA(n)],
   M_D1CT_OA_CONTRACT (dict);                                                  \
 }                                                                             \
 
+
+/* Define the fixed capacity Open Addressing dictionary.
+   Contrary to the dynamic one, it uses linear probing so that
+   an erased entry can be removed by shifting back the following entries
+   of its cluster (no DELETED state is needed and the performance doesn't
+   degrade after many erasures).
+   The maximum number of entries is limited to N*M_D1CT_OA_UPPER_BOUND.
+*/
+
+/* Compute the number of items a table of N entries can store */
+#define M_D1CT_STATIC_OA_CAPACITY(N)                                          \
+  ((size_t) ((double) (N) * M_D1CT_OA_UPPER_BOUND))
+
+#ifdef NDEBUG
+#define M_D1CT_STATIC_OA_CONTRACT(dict, N)
+#else
+#define M_D1CT_STATIC_OA_CONTRACT(dict, N) do {                               \
+    M_ASSERT ( (dict) != NULL);                                               \
+    M_ASSERT( (dict)->count <= M_D1CT_STATIC_OA_CAPACITY(N));                 \
+  } while (0)
+#endif
+
+#define M_D1CT_STATIC_OA_DEF_P1(args) M_ID( M_D1CT_STATIC_OA_DEF_P2 args )
+
+/* Validate the key oplist before going further */
+#define M_D1CT_STATIC_OA_DEF_P2(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_IF_OPLIST(key_oplist)(M_D1CT_STATIC_OA_DEF_P3, M_D1CT_STATIC_OA_DEF_FAILURE)(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t)
+
+/* Validate the value oplist before going further */
+#define M_D1CT_STATIC_OA_DEF_P3(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_IF_OPLIST(value_oplist)(M_D1CT_STATIC_OA_DEF_P4, M_D1CT_STATIC_OA_DEF_FAILURE)(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t)
+
+/* Stop processing with a compilation failure */
+#define M_D1CT_STATIC_OA_DEF_FAILURE(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(STATIC_DICT_OA_DEF2): at least one of the given argument is not a valid oplist: " M_AS_STR(key_oplist) " / " M_AS_STR(value_oplist) )
+
+#define M_D1CT_STATIC_OA_DEF_P4(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_D1CT_STATIC_OA_DEF_TYPE(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_CHECK_COMPATIBLE_OPLIST(name, 1, key_type, key_oplist)                    \
+  M_CHECK_COMPATIBLE_OPLIST(name, 2, value_type, value_oplist)                \
+  M_D1CT_STATIC_OA_DEF_CORE(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_D1CT_STATIC_OA_DEF_IT(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+  M_D1CT_STATIC_OA_DEF_IO(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t)
+
+/* Define the types */
+#define M_D1CT_STATIC_OA_DEF_TYPE(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+                                                                              \
+  typedef struct M_F(name, _pair_s) {                                         \
+    key_type   key;                                                           \
+    value_type value;                                                         \
+  } M_F(name, _pair_ct);                                                      \
+                                                                              \
+  /* Define type returned by the _ref method of an iterator */                \
+  typedef struct M_F(name, _pair_s) it_deref_t;                               \
+                                                                              \
+  typedef struct M_F(name,_s) {                                               \
+    size_t count;                                                             \
+    struct M_F(name, _pair_s) data[N];                                        \
+  } dict_t[1];                                                                \
+  typedef struct M_F(name, _s) *M_F(name, _ptr);                              \
+  typedef const struct M_F(name, _s) *M_F(name, _srcptr);                     \
+                                                                              \
+  typedef struct M_F(name, _it_s) {                                           \
+    const struct M_F(name,_s) *dict;                                          \
+    size_t index;                                                             \
+  } dict_it_t[1];                                                             \
+                                                                              \
+  /* Define internal types for oplist */                                      \
+  typedef dict_t M_F(name, _ct);                                              \
+  typedef it_deref_t M_F(name, _subtype_ct);                                  \
+  typedef key_type M_F(name, _key_ct);                                        \
+  typedef value_type M_F(name, _value_ct);                                    \
+  typedef dict_it_t M_F(name, _it_ct);                                        \
+
+/* Define the core functions */
+#define M_D1CT_STATIC_OA_DEF_CORE(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+                                                                              \
+  M_P(void, name, _init, dict_t dict)                                         \
+  {                                                                           \
+    M_STATIC_ASSERT(N >= 2 && M_POWEROF2_P(N), M_LIB_DIMENSION, "(STATIC_DICT_OA_DEF2): the number of entries shall be a power of 2."); \
+    M_UNUSED_CONTEXT();                                                       \
+    dict->count = 0;                                                          \
+    /* Populate the table with the 'empty' representation */                  \
+    for(size_t i = 0; i < N; i++) {                                           \
+      M_CALL_OOR_SET(key_oplist, dict->data[i].key, M_D1CT_OA_EMPTY);         \
+    }                                                                         \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reset, dict_t dict)                                        \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    M_UNUSED_CONTEXT();                                                       \
+    for(size_t i = 0; i < N && dict->count > 0; i++) {                        \
+      if (!M_CALL_OOR_EQUAL(key_oplist, dict->data[i].key, M_D1CT_OA_EMPTY)) { \
+        M_CALL_CLEAR(key_oplist, dict->data[i].key);                          \
+        M_CALL_CLEAR(value_oplist, dict->data[i].value);                      \
+        M_CALL_OOR_SET(key_oplist, dict->data[i].key, M_D1CT_OA_EMPTY);       \
+        dict->count--;                                                        \
+      }                                                                       \
+    }                                                                         \
+    M_ASSERT (dict->count == 0);                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _clear, dict_t dict)                                        \
+  {                                                                           \
+    M_F(name, _reset) M_R(dict);                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_C3(m_d1ct_,name,_i_find)(const dict_t dict, key_type const key)           \
+  {                                                                           \
+    /* NOTE: Key can not be the representation of empty */                    \
+    M_ASSERT (!M_CALL_OOR_EQUAL(key_oplist, key, M_D1CT_OA_EMPTY));           \
+    /* Return the position of the key, or the empty entry ending its cluster. \
+       There is always at least one empty entry, so the loop ends. */         \
+    size_t p = M_CALL_HASH(key_oplist, key) & (N-1);                          \
+    while (!M_CALL_OOR_EQUAL(key_oplist, dict->data[p].key, M_D1CT_OA_EMPTY)  \
+           && !M_CALL_EQUAL(key_oplist, dict->data[p].key, key)) {            \
+      p = (p + 1) & (N-1);                                                    \
+    }                                                                         \
+    return p;                                                                 \
+  }                                                                           \
+                                                                              \
+  M_INLINE value_type * M_ATTR_HOT_FUNCTION                                   \
+  M_F(name, _get)(const dict_t dict, key_type const key)                      \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    size_t p = M_C3(m_d1ct_,name,_i_find)(dict, key);                         \
+    if (M_CALL_OOR_EQUAL(key_oplist, dict->data[p].key, M_D1CT_OA_EMPTY))     \
+      return NULL;                                                            \
+    /* The dictionary is logically const, not its values */                   \
+    return (value_type *) (uintptr_t) &dict->data[p].value;                   \
+  }                                                                           \
+                                                                              \
+  M_INLINE value_type const *                                                 \
+  M_F(name, _cget)(const dict_t map, key_type const key)                      \
+  {                                                                           \
+    return M_CONST_CAST(value_type, M_F(name,_get)(map, key));                \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _set_at, dict_t dict, key_type const key, value_type const value) \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    M_UNUSED_CONTEXT();                                                       \
+    size_t p = M_C3(m_d1ct_,name,_i_find)(dict, key);                         \
+    if (!M_CALL_OOR_EQUAL(key_oplist, dict->data[p].key, M_D1CT_OA_EMPTY)) {  \
+      M_CALL_SET(value_oplist, dict->data[p].value, value);                   \
+      return true;                                                            \
+    }                                                                         \
+    if (M_UNLIKELY (dict->count >= M_D1CT_STATIC_OA_CAPACITY(N)))             \
+      return false;                                                           \
+    M_CALL_INIT_SET(key_oplist, dict->data[p].key, key);                      \
+    M_CALL_INIT_SET(value_oplist, dict->data[p].value, value);                \
+    dict->count++;                                                            \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(value_type *, name, _safe_get, dict_t dict, key_type const key)         \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    M_UNUSED_CONTEXT();                                                       \
+    size_t p = M_C3(m_d1ct_,name,_i_find)(dict, key);                         \
+    if (!M_CALL_OOR_EQUAL(key_oplist, dict->data[p].key, M_D1CT_OA_EMPTY))    \
+      return &dict->data[p].value;                                            \
+    if (M_UNLIKELY (dict->count >= M_D1CT_STATIC_OA_CAPACITY(N)))             \
+      return NULL;                                                            \
+    M_CALL_INIT_SET(key_oplist, dict->data[p].key, key);                      \
+    M_CALL_INIT(value_oplist, dict->data[p].value);                           \
+    dict->count++;                                                            \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    return &dict->data[p].value;                                              \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name,_erase, dict_t dict, key_type const key)                     \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    M_UNUSED_CONTEXT();                                                       \
+    size_t i = M_C3(m_d1ct_,name,_i_find)(dict, key);                         \
+    if (M_CALL_OOR_EQUAL(key_oplist, dict->data[i].key, M_D1CT_OA_EMPTY))     \
+      return false;                                                           \
+    M_CALL_CLEAR(key_oplist, dict->data[i].key);                              \
+    M_CALL_CLEAR(value_oplist, dict->data[i].value);                          \
+    /* Shift back the following entries of the cluster which                  \
+       can't be reached anymore from their home position                      \
+       (the hole i is not within the cyclic range ]home, j]) */               \
+    size_t j = i;                                                             \
+    while (true) {                                                            \
+      j = (j + 1) & (N-1);                                                    \
+      if (M_CALL_OOR_EQUAL(key_oplist, dict->data[j].key, M_D1CT_OA_EMPTY))   \
+        break;                                                                \
+      size_t home = M_CALL_HASH(key_oplist, dict->data[j].key) & (N-1);       \
+      if (((j - home) & (N-1)) >= ((j - i) & (N-1))) {                        \
+        memcpy(&dict->data[i], &dict->data[j], sizeof dict->data[i]);         \
+        i = j;                                                                \
+      }                                                                       \
+    }                                                                         \
+    M_CALL_OOR_SET(key_oplist, dict->data[i].key, M_D1CT_OA_EMPTY);           \
+    dict->count--;                                                            \
+    M_D1CT_STATIC_OA_CONTRACT(dict, N);                                       \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _init_set, dict_t map, const dict_t org)                    \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(org, N);                                        \
+    M_ASSERT (map != org);                                                    \
+    M_UNUSED_CONTEXT();                                                       \
+    /* Both tables have the same size and hash: copy the entries in place */  \
+    for(size_t i = 0; i < N; i++) {                                           \
+      if (M_CALL_OOR_EQUAL(key_oplist, org->data[i].key, M_D1CT_OA_EMPTY)) {  \
+        M_CALL_OOR_SET(key_oplist, map->data[i].key, M_D1CT_OA_EMPTY);        \
+      } else {                                                                \
+        M_CALL_INIT_SET(key_oplist, map->data[i].key, org->data[i].key);      \
+        M_CALL_INIT_SET(value_oplist, map->data[i].value, org->data[i].value); \
+      }                                                                       \
+    }                                                                         \
+    map->count = org->count;                                                  \
+    M_D1CT_STATIC_OA_CONTRACT(map, N);                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _set, dict_t map, const dict_t org)                         \
+  {                                                                           \
+    if (M_LIKELY (map != org)) {                                              \
+      M_F(name, _clear)M_R(map);                                              \
+      M_F(name, _init_set)M_R(map, org);                                      \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init_move)(dict_t map, dict_t org)                               \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(org, N);                                        \
+    M_ASSERT (map != org);                                                    \
+    memcpy(map, org, sizeof (dict_t));                                        \
+    /* Mark org as empty (safety) */                                          \
+    for(size_t i = 0; i < N; i++) {                                           \
+      M_CALL_OOR_SET(key_oplist, org->data[i].key, M_D1CT_OA_EMPTY);          \
+    }                                                                         \
+    org->count = 0;                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(map, N);                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _move, dict_t map, dict_t org)                              \
+  {                                                                           \
+    M_ASSERT (map != org);                                                    \
+    M_F(name,_clear)M_R(map);                                                 \
+    M_F(name,_init_move)(map, org);                                           \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap)(dict_t d1, dict_t d2)                                      \
+  {                                                                           \
+    /* Swap entry by entry to avoid a large temporary on the stack */         \
+    for(size_t i = 0; i < N; i++) {                                           \
+      M_F(name, _pair_ct) tmp;                                                \
+      memcpy(&tmp, &d1->data[i], sizeof tmp);                                 \
+      memcpy(&d1->data[i], &d2->data[i], sizeof tmp);                         \
+      memcpy(&d2->data[i], &tmp, sizeof tmp);                                 \
+    }                                                                         \
+    M_SWAP(size_t, d1->count, d2->count);                                     \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name,_empty_p)(const dict_t map)                                        \
+  {                                                                           \
+    M_ASSERT(map != NULL);                                                    \
+    return map->count == 0;                                                   \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name,_full_p)(const dict_t map)                                         \
+  {                                                                           \
+    M_ASSERT(map != NULL);                                                    \
+    return map->count >= M_D1CT_STATIC_OA_CAPACITY(N);                        \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name,_size)(const dict_t map)                                           \
+  {                                                                           \
+    M_ASSERT(map != NULL);                                                    \
+    return map->count;                                                        \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name,_capacity)(const dict_t map)                                       \
+  {                                                                           \
+    M_ASSERT(map != NULL);                                                    \
+    return M_D1CT_STATIC_OA_CAPACITY(N);                                      \
+  }                                                                           \
+                                                                              \
+  M_IF_METHOD(EQUAL, value_oplist)(                                           \
+  M_INLINE bool                                                               \
+  M_F(name, _equal_p)(const dict_t dict1, const dict_t dict2)                 \
+  {                                                                           \
+    M_ASSERT (dict1 != NULL && dict2 != NULL);                                \
+    if (M_LIKELY (dict1->count != dict2->count))                              \
+      return false;                                                           \
+    /* The items may be stored at different positions                         \
+       (it depends on the insertion order) */                                 \
+    for(size_t i = 0; i < N; i++) {                                           \
+      if (M_CALL_OOR_EQUAL(key_oplist, dict1->data[i].key, M_D1CT_OA_EMPTY))  \
+        continue;                                                             \
+      value_type *ptr = M_F(name, _get)(dict2, dict1->data[i].key);           \
+      if (ptr == NULL)                                                        \
+        return false;                                                         \
+      if (M_CALL_EQUAL(value_oplist, dict1->data[i].value, *ptr) == false)    \
+        return false;                                                         \
+    }                                                                         \
+    return true;                                                              \
+  }                                                                           \
+  , /* no value equal */ )                                                    \
+
+/* Define the iterator functions */
+#define M_D1CT_STATIC_OA_DEF_IT(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it)(dict_it_t it, const dict_t d)                                \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(d, N);                                          \
+    M_ASSERT (it != NULL);                                                    \
+    it->dict = d;                                                             \
+    size_t i = 0;                                                             \
+    while (i < N && M_CALL_OOR_EQUAL(key_oplist, d->data[i].key, M_D1CT_OA_EMPTY)) { \
+      i++;                                                                    \
+    }                                                                         \
+    it->index = i;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_set)(dict_it_t it, const dict_it_t ref)                       \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    M_ASSERT (ref != NULL);                                                   \
+    it->dict = ref->dict;                                                     \
+    it->index = ref->index;                                                   \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_last)(dict_it_t it, const dict_t d)                           \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(d, N);                                          \
+    M_ASSERT (it != NULL);                                                    \
+    it->dict = d;                                                             \
+    /* if there is no item, the index will overflow, and stops the loop */    \
+    size_t i = N-1;                                                           \
+    while (i < N && M_CALL_OOR_EQUAL(key_oplist, d->data[i].key, M_D1CT_OA_EMPTY)) { \
+      i--;                                                                    \
+    }                                                                         \
+    it->index = i;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_end)(dict_it_t it, const dict_t d)                            \
+  {                                                                           \
+    M_D1CT_STATIC_OA_CONTRACT(d, N);                                          \
+    M_ASSERT (it != NULL);                                                    \
+    it->dict = d;                                                             \
+    it->index = N;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _end_p)(const dict_it_t it)                                       \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    return it->index >= N;                                                    \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _next)(dict_it_t it)                                              \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    size_t i = it->index;                                                     \
+    do {                                                                      \
+      i++;                                                                    \
+    } while (i < N && M_CALL_OOR_EQUAL(key_oplist, it->dict->data[i].key, M_D1CT_OA_EMPTY)); \
+    it->index = i;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _previous)(dict_it_t it)                                          \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    /* if index was 0, the operation will overflow, and stops the loop */     \
+    size_t i = it->index - 1;                                                 \
+    while (i < N && M_CALL_OOR_EQUAL(key_oplist, it->dict->data[i].key, M_D1CT_OA_EMPTY)) { \
+      i--;                                                                    \
+    }                                                                         \
+    it->index = i;                                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _last_p)(const dict_it_t it)                                      \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    dict_it_t it2;                                                            \
+    M_F(name,_it_set)(it2, it);                                               \
+    M_F(name, _next)(it2);                                                    \
+    return M_F(name, _end_p)(it2);                                            \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _it_equal_p)(const dict_it_t it1,const dict_it_t it2)             \
+  {                                                                           \
+    M_ASSERT (it1 != NULL && it2 != NULL);                                    \
+    return it1->dict == it2->dict && it1->index == it2->index;                \
+  }                                                                           \
+                                                                              \
+  M_INLINE it_deref_t *                                                       \
+  M_F(name, _ref)(const dict_it_t it)                                         \
+  {                                                                           \
+    M_ASSERT (it != NULL);                                                    \
+    M_ASSERT(!M_F(name, _end_p)(it));                                         \
+    const size_t i = it->index;                                               \
+    M_ASSERT (!M_CALL_OOR_EQUAL(key_oplist, it->dict->data[i].key, M_D1CT_OA_EMPTY)); \
+    /* The iterator is logically const, not the referenced item */            \
+    return (it_deref_t *) (uintptr_t) &it->dict->data[i];                     \
+  }                                                                           \
+                                                                              \
+  M_INLINE const  it_deref_t *                                                \
+  M_F(name, _cref)(const dict_it_t it)                                        \
+  {                                                                           \
+    return M_CONST_CAST(it_deref_t, M_F(name, _ref)(it));                     \
+  }                                                                           \
+
+/* Define the I/O functions.
+   Reading stops with a failure if the dictionary is full. */
+#define M_D1CT_STATIC_OA_DEF_IO(name, key_type, key_oplist, value_type, value_oplist, N, dict_t, dict_it_t, it_deref_t) \
+                                                                              \
+  M_IF_METHOD_BOTH(GET_STR, key_oplist, value_oplist)(                        \
+  M_P(void, name, _get_str, m_string_t str, const dict_t dict, const bool append) \
+  {                                                                           \
+    (append ? m_string_cat_cstr : m_string_set_cstr)M_R(str, "{");            \
+    dict_it_t it;                                                             \
+    bool print_comma = false;                                                 \
+    for (M_F(name, _it)(it, dict) ;                                           \
+         !M_F(name, _end_p)(it);                                              \
+         M_F(name, _next)(it)){                                               \
+      if (print_comma)                                                        \
+        m_string_push_back M_R(str, ',');                                     \
+      const it_deref_t *item = M_F(name, _cref)(it);                          \
+      M_CALL_GET_STR(key_oplist, str, item->key, true);                       \
+      m_string_push_back M_R(str, ':');                                       \
+      M_CALL_GET_STR(value_oplist, str, item->value, true);                   \
+      print_comma = true;                                                     \
+    }                                                                         \
+    m_string_push_back M_R(str, '}');                                         \
+  }                                                                           \
+  , /* no GET_STR */ )                                                        \
+                                                                              \
+  M_IF_METHOD_BOTH(OUT_STR, key_oplist, value_oplist)(                        \
+  M_INLINE void                                                               \
+  M_F(name, _out_str)(FILE *file, const dict_t dict)                          \
+  {                                                                           \
+    M_ASSERT (file != NULL);                                                  \
+    fputc ('{', file);                                                        \
+    dict_it_t it;                                                             \
+    bool print_comma = false;                                                 \
+    for (M_F(name, _it)(it, dict) ;                                           \
+         !M_F(name, _end_p)(it);                                              \
+         M_F(name, _next)(it)){                                               \
+      if (print_comma)                                                        \
+        fputc (',', file);                                                    \
+      const it_deref_t *item = M_F(name, _cref)(it);                          \
+      M_CALL_OUT_STR(key_oplist, file, item->key);                            \
+      fputc (':', file);                                                      \
+      M_CALL_OUT_STR(value_oplist, file, item->value);                        \
+      print_comma = true;                                                     \
+    }                                                                         \
+    fputc ('}', file);                                                        \
+  }                                                                           \
+  , /* no OUT_STR */ )                                                        \
+                                                                              \
+  M_IF_METHOD_BOTH(PARSE_STR, key_oplist, value_oplist)(                      \
+  M_P(bool, name, _parse_str, dict_t dict, const char str[], const char **endp) \
+  {                                                                           \
+    M_ASSERT (str != NULL);                                                   \
+    M_F(name, _reset)M_R(dict);                                               \
+    int c = m_core_str_nospace(&str);                                         \
+    if (M_UNLIKELY (c != '{')) { c = 0; goto exit; }                          \
+    c = m_core_str_nospace(&str);                                             \
+    if (M_UNLIKELY (c == '}' || c == 0)) goto exit;                           \
+    str--;                                                                    \
+    M_QLET(1, key, key_type, key_oplist)                                      \
+    M_QLET(2, value, value_type, value_oplist) {                              \
+      do {                                                                    \
+        c = m_core_str_nospace(&str);                                         \
+        str--;                                                                \
+        bool b = M_CALL_PARSE_STR(key_oplist, key, str, &str);                \
+        c = m_core_str_nospace(&str);                                         \
+        if (b == false || c != ':') { c = 0; break; }                         \
+        c = m_core_str_nospace(&str);                                         \
+        str--;                                                                \
+        b = M_CALL_PARSE_STR(value_oplist, value, str, &str);                 \
+        if (b == false) { c = 0; break; }                                     \
+        if (!M_F(name, _set_at)M_R(dict, key, value)) { c = 0; break; }       \
+        c = m_core_str_nospace(&str);                                         \
+      } while (c == ',');                                                     \
+    }                                                                         \
+  exit:                                                                       \
+    if (endp) *endp = str;                                                    \
+    return c == '}';                                                          \
+  }                                                                           \
+  , /* no PARSE_STR */ )                                                      \
+                                                                              \
+  M_IF_METHOD_BOTH(IN_STR, key_oplist, value_oplist)(                         \
+  M_P(bool, name, _in_str, dict_t dict, FILE *file)                           \
+  {                                                                           \
+    M_ASSERT (file != NULL);                                                  \
+    M_F(name, _reset)M_R(dict);                                               \
+    int c = m_core_fgetc_nospace(file);                                       \
+    if (M_UNLIKELY (c != '{')) return false;                                  \
+    c = m_core_fgetc_nospace(file);                                           \
+    if (M_UNLIKELY(c == '}')) return true;                                    \
+    if (M_UNLIKELY (c == EOF)) return false;                                  \
+    ungetc(c, file);                                                          \
+    M_QLET(1, key, key_type, key_oplist)                                      \
+    M_QLET(2, value, value_type, value_oplist) {                              \
+      do {                                                                    \
+        c = m_core_fgetc_nospace(file);                                       \
+        if (M_UNLIKELY (c == EOF)) { break; }                                 \
+        ungetc(c, file);                                                      \
+        bool b = M_CALL_IN_STR(key_oplist, key, file);                        \
+        c = m_core_fgetc_nospace(file);                                       \
+        if (M_UNLIKELY (b == false || c != ':')) { c = 0; break; }            \
+        c = m_core_fgetc_nospace(file);                                       \
+        if (M_UNLIKELY (c == EOF)) { break; }                                 \
+        ungetc(c, file);                                                      \
+        b = M_CALL_IN_STR(value_oplist, value, file);                         \
+        if (M_UNLIKELY (b == false)) { c = 0; break; }                        \
+        if (M_UNLIKELY (!M_F(name, _set_at)M_R(dict, key, value))) { c = 0; break; } \
+        c = m_core_fgetc_nospace(file);                                       \
+      } while (c == ',');                                                     \
+    }                                                                         \
+    return c == '}';                                                          \
+  }                                                                           \
+  , /* no IN_STR */ )                                                         \
+                                                                              \
+  M_IF_METHOD_BOTH(OUT_SERIAL, key_oplist, value_oplist)(                     \
+  M_P(m_serial_return_code_t, name, _out_serial, m_serial_write_t f, dict_t const t1) \
+  {                                                                           \
+    M_ASSERT (f != NULL && f->m_interface != NULL);                           \
+    m_serial_local_t local;                                                   \
+    m_serial_return_code_t ret;                                               \
+    bool first_done = false;                                                  \
+    dict_it_t it;                                                             \
+    ret = f->m_interface->write_map_start M_R(local, f, M_F(name, _size)(t1)); \
+    for (M_F(name, _it)(it, t1) ;                                             \
+         !M_F(name, _end_p)(it);                                              \
+         M_F(name, _next)(it)){                                               \
+      const it_deref_t *item = M_F(name, _cref)(it);                          \
+      if (first_done)                                                         \
+        ret |= f->m_interface->write_map_next M_R(local, f);                  \
+      ret |= M_CALL_OUT_SERIAL(key_oplist, f, item->key);                     \
+      ret |= f->m_interface->write_map_value M_R(local, f);                   \
+      ret |= M_CALL_OUT_SERIAL(value_oplist, f, item->value);                 \
+      first_done = true;                                                      \
+    }                                                                         \
+    ret |= f->m_interface->write_map_end M_R(local, f);                       \
+    return ret & M_SERIAL_FAIL;                                               \
+  }                                                                           \
+  , /* no OUT_SERIAL */ )                                                     \
+                                                                              \
+  M_IF_METHOD_BOTH(IN_SERIAL, key_oplist, value_oplist)(                      \
+  M_P(m_serial_return_code_t, name, _in_serial, dict_t t1, m_serial_read_t f) \
+  {                                                                           \
+    M_ASSERT (f != NULL && f->m_interface != NULL);                           \
+    m_serial_local_t local;                                                   \
+    m_serial_return_code_t ret;                                               \
+    size_t estimated_size = 0;                                                \
+    M_F(name,_reset)M_R(t1);                                                  \
+    M_QLET(1, key, key_type, key_oplist)                                      \
+    M_QLET(2, value, value_type, value_oplist) {                              \
+      ret = f->m_interface->read_map_start(local, f, &estimated_size);        \
+      if (M_UNLIKELY (ret != M_SERIAL_OK_CONTINUE)) break;                    \
+      do {                                                                    \
+        ret = M_CALL_IN_SERIAL(key_oplist, key, f);                           \
+        if (ret != M_SERIAL_OK_DONE) break;                                   \
+        ret = f->m_interface->read_map_value(local, f);                       \
+        if (ret != M_SERIAL_OK_CONTINUE) break;                               \
+        ret = M_CALL_IN_SERIAL(value_oplist, value, f);                       \
+        if (ret != M_SERIAL_OK_DONE) break;                                   \
+        if (!M_F(name, _set_at)M_R(t1, key, value)) {                         \
+          ret = M_SERIAL_FAIL;                                                \
+          break;                                                              \
+        }                                                                     \
+      } while ((ret = f->m_interface->read_map_next(local, f)) == M_SERIAL_OK_CONTINUE); \
+    }                                                                         \
+    return ret;                                                               \
+  }                                                                           \
+  , /* no in_serial */ )                                                      \
+
 /******************************** INTERNAL ***********************************/
 
 #if M_USE_SMALL_NAME
@@ -2297,6 +3094,9 @@ M_P(void, name, _bulk_update, dict_t dict, unsigned n, value_type val[M_VLA(n)],
 #define DICT_OASET_DEF_AS M_DICT_OASET_DEF_AS
 #define DICT_OPLIST M_DICT_OPLIST
 #define DICT_SET_OPLIST M_DICT_SET_OPLIST
+#define STATIC_DICT_OA_DEF2 M_STATIC_DICT_OA_DEF2
+#define STATIC_DICT_OA_DEF2_AS M_STATIC_DICT_OA_DEF2_AS
+#define STATIC_DICT_OA_OPLIST M_STATIC_DICT_OA_OPLIST
 #endif
 
 #endif
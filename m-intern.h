@@ -0,0 +1,436 @@
+/*
+ * M*LIB - STRING INTERN module
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_INTERN_H
+#define MSTARLIB_INTERN_H
+
+#include "m-core.h"
+#include "m-string.h"
+#include "m-thread.h"
+
+M_BEGIN_PROTECTED_CODE
+
+/* Size of an allocated block of the arena of an intern pool.
+   Strings bigger than this size get their own block. */
+#ifndef M_USE_INTERN_BLOCK_SIZE
+#define M_USE_INTERN_BLOCK_SIZE 65536
+#endif
+
+/* An interned string.
+   It is stored in the arena of the pool, followed by its characters.
+   It is never modified nor moved until the pool is cleared. */
+typedef struct m_intern_s {
+  size_t hash;      // Precomputed hash of the string
+  size_t size;      // Number of characters of the string
+} m_intern_s;
+
+/* Handle to an interned string. Two handles from the same pool
+   are equal if and only if the strings are equal. */
+typedef const struct m_intern_s *m_intern_t;
+
+/* Block of memory of the arena */
+typedef struct m_intern_block_s {
+  struct m_intern_block_s *next;  // Next allocated block
+  size_t alloc;                   // Allocated size of the block (in bytes)
+} m_intern_block_t;
+
+/* Intern pool.
+   It owns an arena storing the interned strings
+   and an open addressing hash table of the handles. */
+typedef struct m_intern_pool_s {
+  size_t count;             // Number of interned strings
+  size_t mask;              // Size of the table minus 1 (power of 2)
+  m_intern_t *table;        // Hash table of the interned strings (NULL if empty)
+  m_intern_block_t *block;  // Current block of the arena (head of the list)
+  size_t used;              // Used bytes in the current block
+} m_intern_pool_t[1];
+
+/* Intern pool that can be shared between threads */
+typedef struct m_intern_shared_pool_s {
+  m_mutex_t lock;
+  m_intern_pool_t pool;
+} m_intern_shared_pool_t[1];
+
+/* Contract of an intern pool */
+#define M_INTERN_CONTRACT(p) do {                                             \
+    M_ASSERT ((p) != NULL);                                                   \
+    M_ASSERT ((p)->table == NULL || (p)->count <= (p)->mask / 2);             \
+    M_ASSERT ((p)->block != NULL || (p)->used == 0);                          \
+  } while (0)
+
+/* Alignment of the interned strings within the arena */
+#define M_INTERN_ALIGN(n)                                                     \
+  (((n) + sizeof (m_intern_s) - 1) / sizeof (m_intern_s) * sizeof (m_intern_s))
+
+/* Return the C string of an interned string */
+M_INLINE const char *
+m_intern_cstr(m_intern_t h)
+{
+  M_ASSERT (h != NULL);
+  return (const char *) (h + 1);
+}
+
+/* Return the number of characters of an interned string */
+M_INLINE size_t
+m_intern_size(m_intern_t h)
+{
+  M_ASSERT (h != NULL);
+  return h->size;
+}
+
+/* Return the hash of an interned string (precomputed) */
+M_INLINE size_t
+m_intern_hash(m_intern_t h)
+{
+  M_ASSERT (h != NULL);
+  return h->hash;
+}
+
+/* Test if two interned strings (of the same pool) are equal */
+M_INLINE bool
+m_intern_equal_p(m_intern_t h1, m_intern_t h2)
+{
+  return h1 == h2;
+}
+
+/* Compare the content of two interned strings */
+M_INLINE int
+m_intern_cmp(m_intern_t h1, m_intern_t h2)
+{
+  if (h1 == h2) return 0;
+  // The strings may have embedded null characters
+  const size_t size = M_MIN(h1->size, h2->size);
+  int c = size == 0 ? 0 : memcmp(m_intern_cstr(h1), m_intern_cstr(h2), size);
+  if (c != 0) return c;
+  return h1->size < h2->size ? -1 : h1->size > h2->size;
+}
+
+M_INLINE void
+m_intern_pool_init(m_intern_pool_t p)
+{
+  p->count = 0;
+  p->mask  = 0;
+  p->table = NULL;
+  p->block = NULL;
+  p->used  = 0;
+  M_INTERN_CONTRACT(p);
+}
+
+/* Clear the pool. All the handles of the pool are invalidated */
+M_P(void, m_intern_pool, _clear, m_intern_pool_t p)
+{
+  M_INTERN_CONTRACT(p);
+  m_intern_block_t *b = p->block;
+  while (b != NULL) {
+    m_intern_block_t *next = b->next;
+    M_MEMORY_FREE(m_context, char, (char*) b, b->alloc);
+    b = next;
+  }
+  if (p->table != NULL) {
+    M_MEMORY_FREE(m_context, m_intern_t, p->table, p->mask + 1);
+  }
+  p->table = NULL;
+  p->block = NULL;
+}
+
+/* Return the number of interned strings in the pool */
+M_INLINE size_t
+m_intern_pool_size(const m_intern_pool_t p)
+{
+  M_INTERN_CONTRACT(p);
+  return p->count;
+}
+
+/* Return the slot of the table where the string is (or shall be) */
+M_INLINE size_t
+m_intern_pool_i_find(const m_intern_pool_t p, const char str[], size_t size, size_t hash)
+{
+  M_ASSERT (p->table != NULL);
+  size_t i = hash & p->mask;
+  while (p->table[i] != NULL) {
+    m_intern_t h = p->table[i];
+    if (h->hash == hash && h->size == size
+        && (size == 0 || memcmp(m_intern_cstr(h), str, size) == 0)) {
+      break;
+    }
+    i = (i + 1) & p->mask;
+  }
+  return i;
+}
+
+/* Double the size of the table */
+M_P(void, m_intern_pool, _i_rehash, m_intern_pool_t p)
+{
+  const size_t old_size = p->table == NULL ? 0 : p->mask + 1;
+  const size_t new_size = old_size == 0 ? 16 : 2 * old_size;
+  if (M_UNLIKELY_NOMEM (new_size <= old_size)) {
+    M_MEMORY_FULL(m_intern_t, new_size);
+  }
+  m_intern_t *table = M_MEMORY_REALLOC(m_context, m_intern_t, NULL, 0, new_size);
+  if (M_UNLIKELY_NOMEM (table == NULL)) {
+    M_MEMORY_FULL(m_intern_t, new_size);
+  }
+  for(size_t i = 0; i < new_size; i++) {
+    table[i] = NULL;
+  }
+  // Thanks to the precomputed hash, there is no need to access the strings
+  for(size_t i = 0; i < old_size; i++) {
+    m_intern_t h = p->table[i];
+    if (h != NULL) {
+      size_t j = h->hash & (new_size - 1);
+      while (table[j] != NULL) {
+        j = (j + 1) & (new_size - 1);
+      }
+      table[j] = h;
+    }
+  }
+  if (p->table != NULL) {
+    M_MEMORY_FREE(m_context, m_intern_t, p->table, old_size);
+  }
+  p->table = table;
+  p->mask  = new_size - 1;
+}
+
+/* Allocate space in the arena for a new interned string
+   of 'size' characters */
+M_P(struct m_intern_s *, m_intern_pool, _i_alloc, m_intern_pool_t p, size_t size)
+{
+  const size_t needed = M_INTERN_ALIGN(sizeof (m_intern_s) + size + 1);
+  if (M_UNLIKELY_NOMEM (needed <= size)) {
+    M_MEMORY_FULL(char, size);
+  }
+  if (p->block == NULL || p->used + needed > p->block->alloc) {
+    const size_t header = M_INTERN_ALIGN(sizeof (m_intern_block_t));
+    size_t alloc = header + needed;
+    if (alloc < M_USE_INTERN_BLOCK_SIZE) {
+      alloc = M_USE_INTERN_BLOCK_SIZE;
+    }
+    // The block is aligned for any object as it comes from a REALLOC of char
+    char *ptr = M_MEMORY_REALLOC(m_context, char, NULL, 0, alloc);
+    if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+      M_MEMORY_FULL(char, alloc);
+    }
+    m_intern_block_t *b = (m_intern_block_t *) (void *) ptr;
+    b->next  = p->block;
+    b->alloc = alloc;
+    p->block = b;
+    p->used  = header;
+  }
+  struct m_intern_s *h = (struct m_intern_s *) (void *) ((char *) p->block + p->used);
+  p->used += needed;
+  return h;
+}
+
+/* Intern the 'size' first characters of 'str' in the pool
+   and return its handle */
+M_P(m_intern_t, m_intern_pool, _intern_n, m_intern_pool_t p, const char str[], size_t size)
+{
+  M_INTERN_CONTRACT(p);
+  M_ASSERT (str != NULL || size == 0);
+  if (M_UNLIKELY (p->table == NULL)) {
+    m_intern_pool_i_rehash M_R(p);
+  }
+  const size_t hash = (size_t) m_core_hash(str, size);
+  size_t i = m_intern_pool_i_find(p, str, size, hash);
+  if (p->table[i] != NULL) {
+    // Already interned
+    return p->table[i];
+  }
+  // Grow the table and allocate the string before modifying the pool,
+  // so that it remains valid if an allocation fails.
+  if (M_UNLIKELY (p->count + 1 > p->mask / 2)) {
+    m_intern_pool_i_rehash M_R(p);
+    i = m_intern_pool_i_find(p, str, size, hash);
+  }
+  struct m_intern_s *h = m_intern_pool_i_alloc M_R(p, size);
+  h->hash = hash;
+  h->size = size;
+  char *dst = (char *) (h + 1);
+  if (size > 0) {
+    memcpy(dst, str, size);
+  }
+  dst[size] = 0;
+  p->table[i] = h;
+  p->count++;
+  M_INTERN_CONTRACT(p);
+  return h;
+}
+
+/* Intern the C string in the pool and return its handle */
+M_P(m_intern_t, m_intern_pool, _intern_str, m_intern_pool_t p, const char str[])
+{
+  M_ASSERT (str != NULL);
+  return m_intern_pool_intern_n M_R(p, str, strlen(str));
+}
+
+/* Intern the string in the pool and return its handle */
+M_P(m_intern_t, m_intern_pool, _intern, m_intern_pool_t p, const m_string_t str)
+{
+  return m_intern_pool_intern_n M_R(p, m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Return the handle of the C string if it is interned in the pool,
+   NULL otherwise */
+M_INLINE m_intern_t
+m_intern_pool_find_str(const m_intern_pool_t p, const char str[])
+{
+  M_INTERN_CONTRACT(p);
+  M_ASSERT (str != NULL);
+  if (p->table == NULL) {
+    return NULL;
+  }
+  const size_t size = strlen(str);
+  return p->table[m_intern_pool_i_find(p, str, size, (size_t) m_core_hash(str, size))];
+}
+
+
+/* Thread safe variant: the pool is protected by a mutex.
+   The handles can be used concurrently without lock
+   as an interned string is never modified until the pool is cleared. */
+
+M_INLINE void
+m_intern_shared_pool_init(m_intern_shared_pool_t p)
+{
+  m_mutex_init(p->lock);
+  m_intern_pool_init(p->pool);
+}
+
+M_INLINE void
+m_intern_shared_pool_clear(m_intern_shared_pool_t p)
+{
+  M_GLOBAL_CONTEXT();
+  m_intern_pool_clear M_R(p->pool);
+  m_mutex_clear(p->lock);
+}
+
+M_INLINE m_intern_t
+m_intern_shared_pool_intern_n(m_intern_shared_pool_t p, const char str[], size_t size)
+{
+  M_GLOBAL_CONTEXT();
+  m_intern_t h;
+  m_mutex_lock(p->lock);
+  // Don't keep the lock if the allocation of the string throws
+  M_ON_EXCEPTION(m_mutex_unlock(p->lock)) {
+    h = m_intern_pool_intern_n M_R(p->pool, str, size);
+  }
+  m_mutex_unlock(p->lock);
+  return h;
+}
+
+M_INLINE m_intern_t
+m_intern_shared_pool_intern_str(m_intern_shared_pool_t p, const char str[])
+{
+  M_ASSERT (str != NULL);
+  return m_intern_shared_pool_intern_n(p, str, strlen(str));
+}
+
+M_INLINE m_intern_t
+m_intern_shared_pool_intern(m_intern_shared_pool_t p, const m_string_t str)
+{
+  return m_intern_shared_pool_intern_n(p, m_string_get_cstr(str), m_string_size(str));
+}
+
+M_INLINE m_intern_t
+m_intern_shared_pool_find_str(m_intern_shared_pool_t p, const char str[])
+{
+  m_intern_t h;
+  m_mutex_lock(p->lock);
+  h = m_intern_pool_find_str(p->pool, str);
+  m_mutex_unlock(p->lock);
+  return h;
+}
+
+M_INLINE size_t
+m_intern_shared_pool_size(m_intern_shared_pool_t p)
+{
+  size_t n;
+  m_mutex_lock(p->lock);
+  n = m_intern_pool_size(p->pool);
+  m_mutex_unlock(p->lock);
+  return n;
+}
+
+/* Define the OPLIST of a handle to an interned string.
+   The handle is a basic pointer that doesn't own the string. */
+#define M_INTERN_OPLIST                                                       \
+  (INIT(M_INIT_DEFAULT), INIT_SET(M_SET_DEFAULT), SET(M_SET_DEFAULT),         \
+   CLEAR(M_NOTHING_DEFAULT), INIT_MOVE(M_SET_DEFAULT), MOVE(M_SET_DEFAULT),   \
+   SWAP(M_SWAP_DEFAULT), HASH(m_intern_hash), EQUAL(m_intern_equal_p),        \
+   CMP(m_intern_cmp), TYPE(m_intern_t), PROPERTIES( (NOCLEAR(1)) ) )
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_intern_t() M_INTERN_OPLIST
+
+/* Define the OPLIST of an intern pool */
+#ifndef M_USE_CONTEXT
+#define M_INTERN_POOL_OPLIST                                                  \
+  (INIT(m_intern_pool_init), CLEAR(m_intern_pool_clear),                      \
+   TYPE(m_intern_pool_t), GENTYPE(struct m_intern_pool_s*) )
+#else
+#define M_INTERN_POOL_OPLIST                                                  \
+  (INIT(m_intern_pool_init), CLEAR(API_0P(m_intern_pool_clear)),              \
+   TYPE(m_intern_pool_t), GENTYPE(struct m_intern_pool_s*) )
+#endif
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_intern_pool_t() M_INTERN_POOL_OPLIST
+
+M_END_PROTECTED_CODE
+
+/********************************************************************************/
+/*                                                                              */
+/* Define the small name (i.e. without the prefix) of the API provided by this  */
+/* header if it is needed                                                       */
+/*                                                                              */
+/********************************************************************************/
+#if M_USE_SMALL_NAME
+
+#define intern_t m_intern_t
+#define intern_cstr m_intern_cstr
+#define intern_size m_intern_size
+#define intern_hash m_intern_hash
+#define intern_equal_p m_intern_equal_p
+#define intern_cmp m_intern_cmp
+#define intern_pool_t m_intern_pool_t
+#define intern_pool_init m_intern_pool_init
+#define intern_pool_clear m_intern_pool_clear
+#define intern_pool_size m_intern_pool_size
+#define intern_pool_intern_n m_intern_pool_intern_n
+#define intern_pool_intern_str m_intern_pool_intern_str
+#define intern_pool_intern m_intern_pool_intern
+#define intern_pool_find_str m_intern_pool_find_str
+#define intern_shared_pool_t m_intern_shared_pool_t
+#define intern_shared_pool_init m_intern_shared_pool_init
+#define intern_shared_pool_clear m_intern_shared_pool_clear
+#define intern_shared_pool_intern_n m_intern_shared_pool_intern_n
+#define intern_shared_pool_intern_str m_intern_shared_pool_intern_str
+#define intern_shared_pool_intern m_intern_shared_pool_intern
+#define intern_shared_pool_find_str m_intern_shared_pool_find_str
+#define intern_shared_pool_size m_intern_shared_pool_size
+#define INTERN_OPLIST M_INTERN_OPLIST
+#define INTERN_POOL_OPLIST M_INTERN_POOL_OPLIST
+
+#endif
+
+#endif
@@ -46,6 +46,25 @@
   M_END_PROTECTED_CODE
 
 
+/* Define a fixed capacity priority queue of a given type and its associated
+   functions, storing up to N elements without any memory allocation.
+   Pushing an element returns false if the priority queue is full.
+   USAGE: STATIC_PRIOQUEUE_DEF(name, type, N [, oplist_of_the_type]) */
+#define M_STATIC_PRIOQUEUE_DEF(name, ...)                                     \
+  M_STATIC_PRIOQUEUE_DEF_AS(name, M_F(name,_t), M_F(name,_it_t), __VA_ARGS__)
+
+
+/* Define a fixed capacity priority queue of a given type and its associated
+   functions as the name name_t with an iterator named it_t
+   USAGE: STATIC_PRIOQUEUE_DEF_AS(name, name_t, it_t, type, N [, oplist_of_the_type]) */
+#define M_STATIC_PRIOQUEUE_DEF_AS(name, name_t, it_t, ...)                    \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_PR1OQUEUE_STATIC_DEF_P1(M_IF_NARGS_EQ2(__VA_ARGS__)                       \
+                    ((name, __VA_ARGS__, M_GLOBAL_OPLIST_OR_DEF(M_RET_ARG1(__VA_ARGS__))(), name_t, it_t ), \
+                     (name, __VA_ARGS__,                                        name_t, it_t ))) \
+  M_END_PROTECTED_CODE
+
+
 /* Define the oplist of a prioqueue of type.
    USAGE: PRIOQUEUE_OPLIST(name[, oplist of the type]) */
 #define M_PRIOQUEUE_OPLIST(...)                                               \
@@ -54,6 +73,14 @@
                         (__VA_ARGS__ )))
 
 
+/* Define the oplist of a fixed capacity prioqueue of type.
+   It is the same as the one of a priority queue, except that
+   PUSH (and INIT_WITH which uses it) are disabled, as pushing can fail.
+   USAGE: STATIC_PRIOQUEUE_OPLIST(name[, oplist of the type]) */
+#define M_STATIC_PRIOQUEUE_OPLIST(...)                                        \
+  M_OPEXTEND(M_PRIOQUEUE_OPLIST(__VA_ARGS__), PUSH(0), INIT_WITH(0))
+
+
 /*****************************************************************************/
 /********************************** INTERNAL *********************************/
 /*****************************************************************************/
@@ -170,10 +197,43 @@
   M_PR1OQUEUE_DEF_TYPE(name, type, oplist, prioqueue_t, it_t)                 \
   M_CHECK_COMPATIBLE_OPLIST(name, 1, type, oplist)                            \
   M_PR1OQUEUE_DEF_CORE(name, type, oplist, prioqueue_t, it_t)                 \
+  M_PR1OQUEUE_DEF_PUSH(name, type, oplist, prioqueue_t, it_t)                 \
   M_PR1OQUEUE_DEF_IT(name, type, oplist, prioqueue_t, it_t)                   \
   M_PR1OQUEUE_DEF_IO(name, type, oplist, prioqueue_t, it_t)                   \
   M_EMPLACE_QUEUE_DEF(name, prioqueue_t, _emplace, oplist, M_EMPLACE_QUEUE_GENE)
 
+/* Deferred evaluation for the fixed capacity definition */
+#define M_PR1OQUEUE_STATIC_DEF_P1(arg) M_ID( M_PR1OQUEUE_STATIC_DEF_P2 arg )
+
+/* Validate the oplist before going further */
+#define M_PR1OQUEUE_STATIC_DEF_P2(name, type, N, oplist, prioqueue_t, it_t)   \
+  M_IF_OPLIST(oplist)(M_PR1OQUEUE_STATIC_DEF_P3, M_PR1OQUEUE_STATIC_DEF_FAILURE)(name, type, N, oplist, prioqueue_t, it_t)
+
+/* Stop processing with a compilation failure */
+#define M_PR1OQUEUE_STATIC_DEF_FAILURE(name, type, N, oplist, prioqueue_t, it_t) \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(STATIC_PRIOQUEUE_DEF): the given argument is not a valid oplist: " #oplist)
+
+/* Define the fixed capacity priority queue:
+   - name: prefix to use,
+   - type: type of the contained objects,
+   - N: maximum number of objects in the container,
+   - oplist: oplist of the contained objects,
+   - prioqueue_t: type of the container,
+   - it_t: iterator of the container
+   It only differs from the priority queue by its internal array
+   and by its push methods which may fail.
+*/
+#define M_PR1OQUEUE_STATIC_DEF_P3(name, type, N, oplist, prioqueue_t, it_t)   \
+  /* Definition of the internal fixed capacity array */                       \
+  M_STATIC_ARRAY_DEF(M_F(name, _array), type, N, oplist)                      \
+  M_PR1OQUEUE_DEF_TYPE(name, type, oplist, prioqueue_t, it_t)                 \
+  M_CHECK_COMPATIBLE_OPLIST(name, 1, type, oplist)                            \
+  M_PR1OQUEUE_DEF_CORE(name, type, oplist, prioqueue_t, it_t)                 \
+  M_PR1OQUEUE_STATIC_DEF_PUSH(name, type, oplist, prioqueue_t, it_t)          \
+  M_PR1OQUEUE_DEF_IT(name, type, oplist, prioqueue_t, it_t)                   \
+  M_PR1OQUEUE_DEF_IO(name, type, oplist, prioqueue_t, it_t)                   \
+  M_EMPLACE_QUEUE_DEF(name, prioqueue_t, _emplace, oplist, M_PR1OQUEUE_STATIC_EMPLACE_DEF)
+
 /* Define the types */
 #define M_PR1OQUEUE_DEF_TYPE(name, type, oplist, prioqueue_t, it_t)           \
                                                                               \
@@ -279,12 +339,10 @@
     return M_F(name, _array_size)(p->array);                                  \
   }                                                                           \
                                                                               \
-  M_P(void, name, _push, prioqueue_t p, type const x)                         \
+  M_INLINE void                                                               \
+  M_F(name, _i_sift_up)(prioqueue_t p)                                        \
   {                                                                           \
-    /* Push back the new element at the end of the array */                   \
-    M_F(name, _array_push_back) M_R(p->array, x);                             \
-                                                                              \
-    /* Reorder the array by swapping with its parent                          \
+    /* Reorder the array by swapping the last element with its parent         \
      * until it reaches the right position */                                 \
     size_t i = M_F(name, _array_size)(p->array)-1;                            \
     while (i > 0) {                                                           \
@@ -417,6 +475,52 @@
    }                                                                          \
    , /* No EQUAL */ )                                                         \
 
+/* Define the push function */
+#define M_PR1OQUEUE_DEF_PUSH(name, type, oplist, prioqueue_t, it_t)           \
+  M_P(void, name, _push, prioqueue_t p, type const x)                         \
+  {                                                                           \
+    /* Push back the new element at the end of the array */                   \
+    M_F(name, _array_push_back) M_R(p->array, x);                             \
+    M_F(name, _i_sift_up)(p);                                                 \
+  }                                                                           \
+
+/* Define the push function of a fixed capacity priority queue */
+#define M_PR1OQUEUE_STATIC_DEF_PUSH(name, type, oplist, prioqueue_t, it_t)    \
+  M_P(bool, name, _push, prioqueue_t p, type const x)                         \
+  {                                                                           \
+    /* Push back the new element at the end of the array if there is room */  \
+    if (M_UNLIKELY (!M_F(name, _array_push_back) M_R(p->array, x)))           \
+      return false;                                                           \
+    M_F(name, _i_sift_up)(p);                                                 \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _full_p)(prioqueue_t const p)                                     \
+  {                                                                           \
+    return M_F(name, _array_full_p)(p->array);                                \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _capacity)(prioqueue_t const p)                                   \
+  {                                                                           \
+    return M_F(name, _array_capacity)(p->array);                              \
+  }                                                                           \
+
+/* Definition of the emplace function of a fixed capacity priority queue */
+#define M_PR1OQUEUE_STATIC_EMPLACE_DEF(name, name_t, function_name, oplist, init_func, exp_emplace_type) \
+  M_P(bool, name, function_name, name_t v                                     \
+                M_EMPLACE_LIST_TYPE_VAR(a, exp_emplace_type) )                \
+  {                                                                           \
+    bool ret;                                                                 \
+    M_GET_TYPE oplist data;                                                   \
+    M_EMPLACE_CALL_FUNC(a, init_func, oplist, data, exp_emplace_type);        \
+    M_DEFER( M_CALL_CLEAR(oplist, data) ) {                                   \
+      ret = M_F(name, _push) M_R(v, data);                                    \
+    }                                                                         \
+    return ret;                                                               \
+  }
+
 /* Define the IT based functions */
 #define M_PR1OQUEUE_DEF_IT(name, type, oplist, prioqueue_t, it_t)             \
                                                                               \
@@ -536,6 +640,9 @@
 #define PRIOQUEUE_DEF M_PRIOQUEUE_DEF
 #define PRIOQUEUE_DEF_AS M_PRIOQUEUE_DEF_AS
 #define PRIOQUEUE_OPLIST M_PRIOQUEUE_OPLIST
+#define STATIC_PRIOQUEUE_DEF M_STATIC_PRIOQUEUE_DEF
+#define STATIC_PRIOQUEUE_DEF_AS M_STATIC_PRIOQUEUE_DEF_AS
+#define STATIC_PRIOQUEUE_OPLIST M_STATIC_PRIOQUEUE_OPLIST
 #endif
 
 #endif
@@ -0,0 +1,1028 @@
+/*
+ * M*LIB - ROPE module
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_ROPE_H
+#define MSTARLIB_ROPE_H
+
+#include "m-core.h"
+#include "m-atomic.h"
+#include "m-string.h"
+
+M_BEGIN_PROTECTED_CODE
+
+/* Maximum size of a leaf built by concatenating two small leaves.
+   Below this size, the characters of both leaves are merged into one
+   so that a rope built piece by piece doesn't end up with one leaf
+   per piece. */
+#ifndef M_USE_ROPE_LEAF_SIZE
+#define M_USE_ROPE_LEAF_SIZE 512
+#endif
+
+/* A chunk of characters referenced by one or several leaves.
+   The referenced characters of a chunk are never modified. */
+typedef struct m_r0pe_chunk_s {
+  atomic_uint cpt;           // Number of leaves referencing the chunk
+  m_string_t str;            // Characters of the chunk
+} m_r0pe_chunk_t;
+
+/* A node of the balanced tree of a rope.
+   A node is never modified once built (except if it is not shared),
+   so that it can be shared by several ropes.
+   The reference counter is atomic so that ropes sharing nodes
+   can be used by different threads. */
+typedef struct m_rope_node_s {
+  atomic_uint cpt;               // Number of references to the node
+  unsigned int height;           // Height of the node (0 for a leaf)
+  size_t size;                   // Number of characters of the node (> 0)
+  struct m_rope_node_s *left;    // Left child (if internal node)
+  struct m_rope_node_s *right;   // Right child (if internal node)
+  m_r0pe_chunk_t *chunk;         // Chunk of the characters (if leaf)
+  size_t offset;                 // Offset of the characters in the chunk (if leaf)
+} m_rope_node_t;
+
+/* A rope: a string represented as a balanced tree of chunks */
+typedef struct m_rope_s {
+  m_rope_node_t *root;           // Root of the tree (NULL if empty)
+} m_rope_t[1];
+
+/* Define a rope pointer (for internal use only) */
+typedef struct m_rope_s *m_rope_ptr;
+typedef const struct m_rope_s *m_rope_srcptr;
+
+/* Iterator on a rope over UTF8 encoded code points */
+typedef struct m_rope_it_s {
+  m_string_unicode_t u;          // Decoded Unicode code point for the iterator
+  const char *ptr;               // Current character in the current leaf
+  const char *end;               // End of the current leaf
+  size_t pos;                    // Offset in the rope of the end of the current leaf
+  const m_rope_node_t *root;     // Root of the iterated rope
+} m_rope_it_t[1];
+
+/* PREFIX:
+   m_r0pe_: private methods
+   m_rope_: public methods
+*/
+
+/* Contract of a rope */
+#define M_R0PE_CONTRACT(r) do {                                               \
+    M_ASSERT ((r) != NULL);                                                   \
+    M_ASSERT ((r)->root == NULL                                               \
+              || (atomic_load(&(r)->root->cpt) > 0 && (r)->root->size > 0));  \
+  } while (0)
+
+/* Contract of a rope iterator */
+#define M_R0PE_IT_CONTRACT(it) do {                                           \
+    M_ASSERT ((it) != NULL);                                                  \
+    M_ASSERT ((it)->ptr <= (it)->end);                                        \
+    M_ASSERT ((it)->root != NULL || (it)->pos == 0);                          \
+  } while (0)
+
+/* Return the characters of a leaf */
+M_INLINE const char *
+m_r0pe_data(const m_rope_node_t *n)
+{
+  M_ASSERT (n != NULL && n->height == 0);
+  return m_string_get_cstr(n->chunk->str) + n->offset;
+}
+
+/* Take a new reference to the node */
+M_INLINE m_rope_node_t *
+m_r0pe_ref(m_rope_node_t *n)
+{
+  if (n != NULL) {
+    atomic_fetch_add(&n->cpt, 1U);
+  }
+  return n;
+}
+
+/* Release a reference to the node and free it if it was the last one */
+M_P(void, m_r0pe, _unref, m_rope_node_t *n)
+{
+  // Iterate on the right child to limit the recursion
+  while (n != NULL && atomic_fetch_sub(&n->cpt, 1U) == 1U) {
+    m_rope_node_t *next = NULL;
+    if (n->height == 0) {
+      m_r0pe_chunk_t *c = n->chunk;
+      if (atomic_fetch_sub(&c->cpt, 1U) == 1U) {
+        m_string_clear M_R(c->str);
+        M_MEMORY_DEL(m_context, c);
+      }
+    } else {
+      m_r0pe_unref M_R(n->left);
+      next = n->right;
+    }
+    M_MEMORY_DEL(m_context, n);
+    n = next;
+  }
+}
+
+/* Create a leaf of 'size' characters referencing the chunk from 'offset' */
+M_P(m_rope_node_t *, m_r0pe, _leaf, m_r0pe_chunk_t *c, size_t offset, size_t size)
+{
+  M_ASSERT (size > 0 && offset + size <= m_string_size(c->str));
+  m_rope_node_t *n = M_MEMORY_ALLOC(m_context, m_rope_node_t);
+  if (M_UNLIKELY_NOMEM (n == NULL)) {
+    M_MEMORY_FULL(m_rope_node_t, 1);
+  }
+  atomic_fetch_add(&c->cpt, 1U);
+  atomic_init(&n->cpt, 1U);
+  n->height = 0;
+  n->size   = size;
+  n->left   = NULL;
+  n->right  = NULL;
+  n->chunk  = c;
+  n->offset = offset;
+  return n;
+}
+
+/* Create a leaf owning a new chunk of the 'size' first characters of 'str'.
+   Return NULL if size is 0 */
+M_P(m_rope_node_t *, m_r0pe, _new_leaf, const char str[], size_t size)
+{
+  if (size == 0) {
+    return NULL;
+  }
+  m_r0pe_chunk_t *c = M_MEMORY_ALLOC(m_context, m_r0pe_chunk_t);
+  if (M_UNLIKELY_NOMEM (c == NULL)) {
+    M_MEMORY_FULL(m_r0pe_chunk_t, 1);
+  }
+  atomic_init(&c->cpt, 0U);
+  m_string_init(c->str);
+  m_string_set_view M_R(c->str, m_string_view_cstrn(str, size));
+  return m_r0pe_leaf M_R(c, 0, size);
+}
+
+/* Create a leaf owning a new chunk made of the string 'str' (moved) */
+M_P(m_rope_node_t *, m_r0pe, _new_leaf_move, m_string_t str)
+{
+  const size_t size = m_string_size(str);
+  if (size == 0) {
+    m_string_clear M_R(str);
+    return NULL;
+  }
+  m_r0pe_chunk_t *c = M_MEMORY_ALLOC(m_context, m_r0pe_chunk_t);
+  if (M_UNLIKELY_NOMEM (c == NULL)) {
+    M_MEMORY_FULL(m_r0pe_chunk_t, 1);
+  }
+  atomic_init(&c->cpt, 0U);
+  m_string_init_move(c->str, str);
+  return m_r0pe_leaf M_R(c, 0, size);
+}
+
+/* Create an internal node of the given children (references are stolen) */
+M_P(m_rope_node_t *, m_r0pe, _node, m_rope_node_t *l, m_rope_node_t *r)
+{
+  M_ASSERT (l != NULL && r != NULL);
+  M_ASSERT (l->height <= r->height + 1 && r->height <= l->height + 1);
+  m_rope_node_t *n = M_MEMORY_ALLOC(m_context, m_rope_node_t);
+  if (M_UNLIKELY_NOMEM (n == NULL)) {
+    M_MEMORY_FULL(m_rope_node_t, 1);
+  }
+  atomic_init(&n->cpt, 1U);
+  n->height = 1 + M_MAX(l->height, r->height);
+  n->size   = l->size + r->size;
+  n->left   = l;
+  n->right  = r;
+  n->chunk  = NULL;
+  n->offset = 0;
+  return n;
+}
+
+/* Release the internal node 'n' and return references to its children */
+M_P(void, m_r0pe, _open, m_rope_node_t *n, m_rope_node_t **l, m_rope_node_t **r)
+{
+  M_ASSERT (n != NULL && n->height > 0);
+  *l = n->left;
+  *r = n->right;
+  if (atomic_load(&n->cpt) == 1U) {
+    // Not shared: steal the references of the node
+    M_MEMORY_DEL(m_context, n);
+  } else {
+    // Take the references of the children before releasing the node,
+    // as the other owners may release it concurrently
+    m_r0pe_ref(*l);
+    m_r0pe_ref(*r);
+    m_r0pe_unref M_R(n);
+  }
+}
+
+/* Concatenate two small leaves into one leaf (references are stolen) */
+M_P(m_rope_node_t *, m_r0pe, _merge, m_rope_node_t *l, m_rope_node_t *r)
+{
+  M_ASSERT (l->height == 0 && r->height == 0);
+  m_r0pe_chunk_t *c = l->chunk;
+  if (atomic_load(&l->cpt) == 1U && atomic_load(&c->cpt) == 1U
+      && l->offset + l->size == m_string_size(c->str)) {
+    // The leaf is the only user of the end of its chunk:
+    // append the characters in place
+    m_string_cat_view M_R(c->str, m_string_view_cstrn(m_r0pe_data(r), r->size));
+    l->size += r->size;
+    m_r0pe_unref M_R(r);
+    return l;
+  }
+  m_string_t tmp;
+  m_string_init(tmp);
+  m_string_reserve M_R(tmp, l->size + r->size + 1);
+  m_string_set_view M_R(tmp, m_string_view_cstrn(m_r0pe_data(l), l->size));
+  m_string_cat_view M_R(tmp, m_string_view_cstrn(m_r0pe_data(r), r->size));
+  m_r0pe_unref M_R(l);
+  m_r0pe_unref M_R(r);
+  return m_r0pe_new_leaf_move M_R(tmp);
+}
+
+/* Concatenate two trees into a balanced tree (references are stolen).
+   The complexity is proportional to the difference of their heights. */
+M_P(m_rope_node_t *, m_r0pe, _join, m_rope_node_t *l, m_rope_node_t *r)
+{
+  if (l == NULL) {
+    return r;
+  }
+  if (r == NULL) {
+    return l;
+  }
+  if (l->height == 0 && r->height == 0
+      && l->size + r->size <= M_USE_ROPE_LEAF_SIZE) {
+    return m_r0pe_merge M_R(l, r);
+  }
+  m_rope_node_t *a, *b, *t, *t1, *t2, *u1, *u2;
+  if (l->height > r->height + 1) {
+    // Join with the right spine of the left tree
+    m_r0pe_open M_R(l, &a, &b);
+    t = m_r0pe_join M_R(b, r);
+    if (t->height <= a->height + 1) {
+      return m_r0pe_node M_R(a, t);
+    }
+    // The joined tree is too high: rotate it to the left
+    m_r0pe_open M_R(t, &t1, &t2);
+    if (t1->height <= t2->height) {
+      t = m_r0pe_node M_R(a, t1);
+      return m_r0pe_node M_R(t, t2);
+    }
+    m_r0pe_open M_R(t1, &u1, &u2);
+    t = m_r0pe_node M_R(a, u1);
+    t1 = m_r0pe_node M_R(u2, t2);
+    return m_r0pe_node M_R(t, t1);
+  }
+  if (r->height > l->height + 1) {
+    // Join with the left spine of the right tree
+    m_r0pe_open M_R(r, &a, &b);
+    t = m_r0pe_join M_R(l, a);
+    if (t->height <= b->height + 1) {
+      return m_r0pe_node M_R(t, b);
+    }
+    // The joined tree is too high: rotate it to the right
+    m_r0pe_open M_R(t, &t1, &t2);
+    if (t2->height <= t1->height) {
+      t = m_r0pe_node M_R(t2, b);
+      return m_r0pe_node M_R(t1, t);
+    }
+    m_r0pe_open M_R(t2, &u1, &u2);
+    t = m_r0pe_node M_R(u2, b);
+    t2 = m_r0pe_node M_R(t1, u1);
+    return m_r0pe_node M_R(t2, t);
+  }
+  return m_r0pe_node M_R(l, r);
+}
+
+/* Split the tree 'n' at offset 'pos' into the trees '*l' and '*r'
+   (the reference of 'n' is stolen) */
+M_P(void, m_r0pe, _split, m_rope_node_t *n, size_t pos, m_rope_node_t **l, m_rope_node_t **r)
+{
+  if (pos == 0) {
+    *l = NULL;
+    *r = n;
+    return;
+  }
+  M_ASSERT (n != NULL);
+  if (pos >= n->size) {
+    *l = n;
+    *r = NULL;
+    return;
+  }
+  if (n->height == 0) {
+    // Both parts of the leaf share the same chunk
+    *l = m_r0pe_leaf M_R(n->chunk, n->offset, pos);
+    *r = m_r0pe_leaf M_R(n->chunk, n->offset + pos, n->size - pos);
+    m_r0pe_unref M_R(n);
+    return;
+  }
+  m_rope_node_t *a, *b, *x, *y;
+  m_r0pe_open M_R(n, &a, &b);
+  if (pos <= a->size) {
+    m_r0pe_split M_R(a, pos, &x, &y);
+    *l = x;
+    *r = m_r0pe_join M_R(y, b);
+  } else {
+    m_r0pe_split M_R(b, pos - a->size, &x, &y);
+    *l = m_r0pe_join M_R(a, x);
+    *r = y;
+  }
+}
+
+/* Return the leaf of the tree containing the character at offset '*pos'
+   and update '*pos' to the offset within this leaf */
+M_INLINE const m_rope_node_t *
+m_r0pe_find(const m_rope_node_t *n, size_t *pos)
+{
+  M_ASSERT (n != NULL && *pos < n->size);
+  while (n->height > 0) {
+    if (*pos < n->left->size) {
+      n = n->left;
+    } else {
+      *pos -= n->left->size;
+      n = n->right;
+    }
+  }
+  return n;
+}
+
+M_INLINE void
+m_rope_init(m_rope_t r)
+{
+  r->root = NULL;
+  M_R0PE_CONTRACT(r);
+}
+
+M_P(void, m_rope, _clear, m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  m_r0pe_unref M_R(r->root);
+  r->root = NULL;
+}
+
+M_P(void, m_rope, _reset, m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  m_r0pe_unref M_R(r->root);
+  r->root = NULL;
+}
+
+/* Initialize the rope to the other one.
+   Both ropes share all their nodes: the complexity is constant */
+M_INLINE void
+m_rope_init_set(m_rope_t d, const m_rope_t s)
+{
+  M_R0PE_CONTRACT(s);
+  d->root = m_r0pe_ref(s->root);
+  M_R0PE_CONTRACT(d);
+}
+
+/* Set the rope to the other one (in constant time) */
+M_P(void, m_rope, _set, m_rope_t d, const m_rope_t s)
+{
+  M_R0PE_CONTRACT(d);
+  M_R0PE_CONTRACT(s);
+  m_rope_node_t *old = d->root;
+  d->root = m_r0pe_ref(s->root);
+  m_r0pe_unref M_R(old);
+}
+
+M_INLINE void
+m_rope_init_move(m_rope_t d, m_rope_t s)
+{
+  M_R0PE_CONTRACT(s);
+  d->root = s->root;
+  s->root = NULL;
+}
+
+M_P(void, m_rope, _move, m_rope_t d, m_rope_t s)
+{
+  M_R0PE_CONTRACT(d);
+  M_R0PE_CONTRACT(s);
+  m_r0pe_unref M_R(d->root);
+  d->root = s->root;
+  s->root = NULL;
+}
+
+M_INLINE void
+m_rope_swap(m_rope_t r1, m_rope_t r2)
+{
+  M_R0PE_CONTRACT(r1);
+  M_R0PE_CONTRACT(r2);
+  M_SWAP(m_rope_node_t *, r1->root, r2->root);
+}
+
+/* Return the number of characters (bytes) of the rope */
+M_INLINE size_t
+m_rope_size(const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  return r->root == NULL ? 0 : r->root->size;
+}
+
+M_INLINE bool
+m_rope_empty_p(const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  return r->root == NULL;
+}
+
+/* Return the character at offset 'pos' of the rope */
+M_INLINE char
+m_rope_get_char(const m_rope_t r, size_t pos)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT_INDEX(pos, m_rope_size(r));
+  const m_rope_node_t *n = m_r0pe_find(r->root, &pos);
+  return m_r0pe_data(n)[pos];
+}
+
+/* Set the rope to the 'size' first characters of 'str' */
+M_P(void, m_rope, _set_cstrn, m_rope_t r, const char str[], size_t size)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (str != NULL || size == 0);
+  m_rope_node_t *n = m_r0pe_new_leaf M_R(str, size);
+  m_r0pe_unref M_R(r->root);
+  r->root = n;
+}
+
+M_P(void, m_rope, _set_cstr, m_rope_t r, const char str[])
+{
+  M_ASSERT (str != NULL);
+  m_rope_set_cstrn M_R(r, str, strlen(str));
+}
+
+M_P(void, m_rope, _set_string, m_rope_t r, const m_string_t str)
+{
+  m_rope_set_cstrn M_R(r, m_string_get_cstr(str), m_string_size(str));
+}
+
+M_P(void, m_rope, _init_set_cstr, m_rope_t r, const char str[])
+{
+  m_rope_init(r);
+  m_rope_set_cstr M_R(r, str);
+}
+
+M_P(void, m_rope, _init_set_string, m_rope_t r, const m_string_t str)
+{
+  m_rope_init(r);
+  m_rope_set_string M_R(r, str);
+}
+
+/* Initialize the rope by moving the string 'str' in it:
+   the characters of the string are not copied */
+M_P(void, m_rope, _init_move_string, m_rope_t r, m_string_t str)
+{
+  r->root = m_r0pe_new_leaf_move M_R(str);
+  M_R0PE_CONTRACT(r);
+}
+
+/* Insert the tree 'n' at offset 'pos' of the rope (the reference is stolen) */
+M_P(void, m_r0pe, _insert_node, m_rope_t r, size_t pos, m_rope_node_t *n)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (pos <= m_rope_size(r));
+  m_rope_node_t *a, *b;
+  m_r0pe_split M_R(r->root, pos, &a, &b);
+  a = m_r0pe_join M_R(a, n);
+  r->root = m_r0pe_join M_R(a, b);
+  M_R0PE_CONTRACT(r);
+}
+
+/* Insert the 'size' first characters of 'str' at offset 'pos' of the rope */
+M_P(void, m_rope, _insert_cstrn, m_rope_t r, size_t pos, const char str[], size_t size)
+{
+  M_ASSERT (str != NULL || size == 0);
+  m_rope_node_t *n = m_r0pe_new_leaf M_R(str, size);
+  m_r0pe_insert_node M_R(r, pos, n);
+}
+
+M_P(void, m_rope, _insert_cstr, m_rope_t r, size_t pos, const char str[])
+{
+  M_ASSERT (str != NULL);
+  m_rope_insert_cstrn M_R(r, pos, str, strlen(str));
+}
+
+M_P(void, m_rope, _insert_string, m_rope_t r, size_t pos, const m_string_t str)
+{
+  m_rope_insert_cstrn M_R(r, pos, m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Insert the rope 's' at offset 'pos' of the rope 'r'.
+   The nodes of 's' are shared, not copied. */
+M_P(void, m_rope, _insert, m_rope_t r, size_t pos, const m_rope_t s)
+{
+  M_R0PE_CONTRACT(s);
+  m_r0pe_insert_node M_R(r, pos, m_r0pe_ref(s->root));
+}
+
+M_P(void, m_rope, _cat_cstrn, m_rope_t r, const char str[], size_t size)
+{
+  M_ASSERT (str != NULL || size == 0);
+  M_R0PE_CONTRACT(r);
+  m_rope_node_t *n = m_r0pe_new_leaf M_R(str, size);
+  r->root = m_r0pe_join M_R(r->root, n);
+}
+
+M_P(void, m_rope, _cat_cstr, m_rope_t r, const char str[])
+{
+  M_ASSERT (str != NULL);
+  m_rope_cat_cstrn M_R(r, str, strlen(str));
+}
+
+M_P(void, m_rope, _cat_string, m_rope_t r, const m_string_t str)
+{
+  m_rope_cat_cstrn M_R(r, m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Concatenate the rope 's' to the rope 'r' (sharing the nodes of 's') */
+M_P(void, m_rope, _cat, m_rope_t r, const m_rope_t s)
+{
+  M_R0PE_CONTRACT(r);
+  M_R0PE_CONTRACT(s);
+  r->root = m_r0pe_join M_R(r->root, m_r0pe_ref(s->root));
+}
+
+/* Erase 'size' characters from offset 'pos' of the rope */
+M_P(void, m_rope, _erase, m_rope_t r, size_t pos, size_t size)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (pos <= m_rope_size(r));
+  m_rope_node_t *a, *b, *c, *d;
+  m_r0pe_split M_R(r->root, pos, &a, &b);
+  m_r0pe_split M_R(b, size, &c, &d);
+  m_r0pe_unref M_R(c);
+  r->root = m_r0pe_join M_R(a, d);
+  M_R0PE_CONTRACT(r);
+}
+
+/* Replace the 'size' characters from offset 'pos' of the rope by 'str' */
+M_P(void, m_rope, _replace_at, m_rope_t r, size_t pos, size_t size, const char str[])
+{
+  m_rope_erase M_R(r, pos, size);
+  m_rope_insert_cstr M_R(r, pos, str);
+}
+
+/* Set the rope 'd' to at most 'size' characters of the rope 's'
+   from offset 'pos'. The characters are shared, not copied. */
+M_P(void, m_rope, _set_n, m_rope_t d, const m_rope_t s, size_t pos, size_t size)
+{
+  M_R0PE_CONTRACT(d);
+  M_R0PE_CONTRACT(s);
+  M_ASSERT (pos <= m_rope_size(s));
+  m_rope_node_t *a, *b, *c, *e;
+  m_r0pe_split M_R(m_r0pe_ref(s->root), pos, &a, &b);
+  m_r0pe_split M_R(b, size, &c, &e);
+  m_r0pe_unref M_R(a);
+  m_r0pe_unref M_R(e);
+  m_r0pe_unref M_R(d->root);
+  d->root = c;
+  M_R0PE_CONTRACT(d);
+}
+
+/* Keep only at most 'size' characters of the rope from offset 'pos' */
+M_P(void, m_rope, _mid, m_rope_t r, size_t pos, size_t size)
+{
+  m_rope_set_n M_R(r, r, pos, size);
+}
+
+/* Iterate over the leaves of the tree and concatenate their characters
+   to the string */
+M_P(void, m_r0pe, _cat_to_string, m_string_t v, const m_rope_node_t *n)
+{
+  while (n != NULL && n->height > 0) {
+    m_r0pe_cat_to_string M_R(v, n->left);
+    n = n->right;
+  }
+  if (n != NULL) {
+    m_string_cat_view M_R(v, m_string_view_cstrn(m_r0pe_data(n), n->size));
+  }
+}
+
+/* Set the string 'v' to the characters of the rope */
+M_P(void, m_rope, _flatten, m_string_t v, const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  m_string_reset(v);
+  m_string_reserve M_R(v, m_rope_size(r) + 1);
+  m_r0pe_cat_to_string M_R(v, r->root);
+}
+
+/* Set the iterator to the leaf containing the offset 'pos' of the rope
+   (or to the end of the rope) */
+M_INLINE void
+m_r0pe_it_load(m_rope_it_t it, size_t pos)
+{
+  const m_rope_node_t *n = it->root;
+  if (n == NULL || pos >= n->size) {
+    it->ptr = it->end = NULL;
+    it->pos = n == NULL ? 0 : n->size;
+    return;
+  }
+  size_t offset = pos;
+  n = m_r0pe_find(n, &offset);
+  const char *data = m_r0pe_data(n);
+  it->ptr = data + offset;
+  it->end = data + n->size;
+  it->pos = pos - offset + n->size;
+}
+
+/* Advance the iterator by 'n' characters within the current leaf */
+M_INLINE void
+m_r0pe_it_skip(m_rope_it_t it, size_t n)
+{
+  M_ASSERT (n <= (size_t) (it->end - it->ptr));
+  it->ptr += n;
+  if (it->ptr == it->end) {
+    m_r0pe_it_load(it, it->pos);
+  }
+}
+
+/* Start iteration over the UTF8 encoded unicode code point */
+M_INLINE void
+m_rope_it(m_rope_it_t it, const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (it != NULL);
+  it->u    = 0;
+  it->root = r->root;
+  m_r0pe_it_load(it, 0);
+  M_R0PE_IT_CONTRACT(it);
+}
+
+/* Set the iterator to the end of rope.
+   The iterator references therefore nothing. */
+M_INLINE void
+m_rope_it_end(m_rope_it_t it, const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (it != NULL);
+  it->u    = 0;
+  it->root = r->root;
+  m_r0pe_it_load(it, m_rope_size(r));
+  M_R0PE_IT_CONTRACT(it);
+}
+
+/* Set the iterator to the given position in the rope.
+   The given position shall reference a valid code point in the rope. */
+M_INLINE void
+m_rope_it_pos(m_rope_it_t it, const m_rope_t r, const size_t n)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (it != NULL);
+  M_ASSERT (n <= m_rope_size(r));
+  it->u    = 0;
+  it->root = r->root;
+  m_r0pe_it_load(it, n);
+  M_ASSERT (it->ptr == it->end || m_str1ng_utf8_start_p((unsigned char) *it->ptr));
+  M_R0PE_IT_CONTRACT(it);
+}
+
+M_INLINE void
+m_rope_it_set(m_rope_it_t it, const m_rope_it_t itsrc)
+{
+  M_R0PE_IT_CONTRACT(itsrc);
+  it->u    = itsrc->u;
+  it->ptr  = itsrc->ptr;
+  it->end  = itsrc->end;
+  it->pos  = itsrc->pos;
+  it->root = itsrc->root;
+}
+
+/* Return the current offset in the rope referenced by the iterator */
+M_INLINE size_t
+m_rope_it_get_pos(const m_rope_it_t it)
+{
+  M_R0PE_IT_CONTRACT(it);
+  return it->pos - (size_t) (it->end - it->ptr);
+}
+
+/* Test if the iterator has reached the end of the rope */
+M_INLINE bool
+m_rope_end_p(const m_rope_it_t it)
+{
+  M_R0PE_IT_CONTRACT(it);
+  return it->ptr == it->end;
+}
+
+M_INLINE bool
+m_rope_it_equal_p(const m_rope_it_t it1, const m_rope_it_t it2)
+{
+  M_R0PE_IT_CONTRACT(it1);
+  M_R0PE_IT_CONTRACT(it2);
+  return it1->root == it2->root && it1->ptr == it2->ptr
+    && m_rope_it_get_pos(it1) == m_rope_it_get_pos(it2);
+}
+
+/* Advance the iterator to the next UTF8 unicode code point
+   (which may be in another leaf) */
+M_INLINE void
+m_rope_next(m_rope_it_t it)
+{
+  M_R0PE_IT_CONTRACT(it);
+  M_ASSERT (!m_rope_end_p(it));
+  do {
+    m_r0pe_it_skip(it, 1);
+  } while (it->ptr != it->end && !m_str1ng_utf8_start_p((unsigned char) *it->ptr));
+}
+
+/* Return the unicode code point associated to the iterator.
+   Its encoding may be split between several leaves. */
+M_INLINE m_string_unicode_t
+m_rope_get_cref(const m_rope_it_t it)
+{
+  M_R0PE_IT_CONTRACT(it);
+  M_ASSERT (!m_rope_end_p(it));
+  m_rope_it_t cur;
+  m_rope_it_set(cur, it);
+  m_str1ng_utf8_state_e state = M_STR1NG_UTF8_STARTING;
+  m_string_unicode_t u = 0;
+  do {
+    m_str1ng_utf8_decode(*cur->ptr, &state, &u);
+    m_r0pe_it_skip(cur, 1);
+  } while (state != M_STR1NG_UTF8_STARTING && state != M_STR1NG_UTF8_ERROR
+           && cur->ptr != cur->end);
+  return M_UNLIKELY (state != M_STR1NG_UTF8_STARTING) ? M_STRING_UNICODE_ERROR : u;
+}
+
+M_INLINE const m_string_unicode_t *
+m_rope_cref(m_rope_it_t it)
+{
+  it->u = m_rope_get_cref(it);
+  return &it->u;
+}
+
+/* Compare the rope to the 'size' first characters of 'str' */
+M_INLINE int
+m_r0pe_cmp_cstrn(const m_rope_t r, const char str[], size_t size)
+{
+  m_rope_it_t it;
+  m_rope_it(it, r);
+  while (it->ptr != it->end && size > 0) {
+    size_t n = M_MIN((size_t) (it->end - it->ptr), size);
+    int c = memcmp(it->ptr, str, n);
+    if (c != 0) {
+      return c;
+    }
+    str  += n;
+    size -= n;
+    m_r0pe_it_skip(it, n);
+  }
+  return (it->ptr != it->end) - (size != 0);
+}
+
+M_INLINE bool
+m_rope_equal_cstr_p(const m_rope_t r, const char str[])
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (str != NULL);
+  const size_t size = strlen(str);
+  return size == m_rope_size(r) && m_r0pe_cmp_cstrn(r, str, size) == 0;
+}
+
+M_INLINE bool
+m_rope_equal_string_p(const m_rope_t r, const m_string_t str)
+{
+  M_R0PE_CONTRACT(r);
+  const size_t size = m_string_size(str);
+  return size == m_rope_size(r)
+    && m_r0pe_cmp_cstrn(r, m_string_get_cstr(str), size) == 0;
+}
+
+/* Compare both ropes leaf by leaf */
+M_INLINE int
+m_rope_cmp(const m_rope_t r1, const m_rope_t r2)
+{
+  M_R0PE_CONTRACT(r1);
+  M_R0PE_CONTRACT(r2);
+  if (r1->root == r2->root) {
+    return 0;
+  }
+  m_rope_it_t it1, it2;
+  m_rope_it(it1, r1);
+  m_rope_it(it2, r2);
+  while (it1->ptr != it1->end && it2->ptr != it2->end) {
+    size_t n = M_MIN((size_t) (it1->end - it1->ptr), (size_t) (it2->end - it2->ptr));
+    int c = memcmp(it1->ptr, it2->ptr, n);
+    if (c != 0) {
+      return c;
+    }
+    m_r0pe_it_skip(it1, n);
+    m_r0pe_it_skip(it2, n);
+  }
+  return (it1->ptr != it1->end) - (it2->ptr != it2->end);
+}
+
+M_INLINE bool
+m_rope_equal_p(const m_rope_t r1, const m_rope_t r2)
+{
+  return m_rope_size(r1) == m_rope_size(r2) && m_rope_cmp(r1, r2) == 0;
+}
+
+/* Return a hash of the rope.
+   It doesn't depend on how the rope is split in leaves.
+   It is not equal to the hash of the equivalent string. */
+M_INLINE size_t
+m_rope_hash(const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  M_HASH_DECL(hash);
+  m_rope_it_t it;
+  m_rope_it(it, r);
+  while (it->ptr != it->end) {
+    for(const char *p = it->ptr; p != it->end; p++) {
+      unsigned long u = (unsigned char) *p;
+      M_HASH_UP(hash, u);
+    }
+    m_r0pe_it_skip(it, (size_t) (it->end - it->ptr));
+  }
+  return M_HASH_FINAL(hash);
+}
+
+/* Transform the rope into a formatted string
+   and set it to (or append in) the string 'v' */
+M_P(void, m_rope, _get_str, m_string_t v, const m_rope_t r, bool append)
+{
+  m_string_t tmp;
+  m_string_init(tmp);
+  m_rope_flatten M_R(tmp, r);
+  m_string_get_str M_R(v, tmp, append);
+  m_string_clear M_R(tmp);
+}
+
+#if M_USE_STDIO
+
+/* Put the characters of the rope in the given FILE without formatting */
+M_INLINE bool
+m_rope_fputs(FILE *f, const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (f != NULL);
+  m_rope_it_t it;
+  m_rope_it(it, r);
+  while (it->ptr != it->end) {
+    size_t n = (size_t) (it->end - it->ptr);
+    if (fwrite(it->ptr, 1, n, f) != n) {
+      return false;
+    }
+    m_r0pe_it_skip(it, n);
+  }
+  return true;
+}
+
+/* Transform the rope into a formatted string
+   and output it in the given FILE */
+M_INLINE void
+m_rope_out_str(FILE *f, const m_rope_t r)
+{
+  M_R0PE_CONTRACT(r);
+  M_ASSERT (f != NULL);
+  m_rope_it_t it;
+  m_rope_it(it, r);
+  fputc('"', f);
+  while (it->ptr != it->end) {
+    size_t n = (size_t) (it->end - it->ptr);
+    m_str1ng_out_escaped(f, it->ptr, n);
+    m_r0pe_it_skip(it, n);
+  }
+  fputc('"', f);
+}
+
+/* Read a formatted string from the FILE and set the rope to it */
+M_P(bool, m_rope, _in_str, m_rope_t r, FILE *f)
+{
+  m_string_t tmp;
+  m_string_init(tmp);
+  bool b = m_string_in_str M_R(tmp, f);
+  m_rope_node_t *n = m_r0pe_new_leaf_move M_R(tmp);
+  m_r0pe_unref M_R(r->root);
+  r->root = n;
+  return b;
+}
+
+#endif
+
+/* Define the OPLIST of a rope */
+#ifndef M_USE_CONTEXT
+#define M_ROPE_OPLIST                                                         \
+  (INIT(m_rope_init),INIT_SET(m_rope_init_set), SET(m_rope_set),              \
+   INIT_MOVE(m_rope_init_move), MOVE(m_rope_move),                            \
+   SWAP(m_rope_swap), RESET(m_rope_reset),                                    \
+   EMPTY_P(m_rope_empty_p),                                                   \
+   CLEAR(m_rope_clear), HASH(m_rope_hash), EQUAL(m_rope_equal_p),             \
+   CMP(m_rope_cmp), TYPE(m_rope_t), GENTYPE(struct m_rope_s*),                \
+   GET_STR(m_rope_get_str), OUT_STR(m_rope_out_str), IN_STR(m_rope_in_str)    \
+   ,SUBTYPE(m_string_unicode_t)                                               \
+   ,IT_TYPE(m_rope_it_t)                                                      \
+   ,IT_FIRST(m_rope_it)                                                       \
+   ,IT_END(m_rope_it_end)                                                     \
+   ,IT_SET(m_rope_it_set)                                                     \
+   ,IT_END_P(m_rope_end_p)                                                    \
+   ,IT_EQUAL_P(m_rope_it_equal_p)                                             \
+   ,IT_NEXT(m_rope_next)                                                      \
+   ,IT_CREF(m_rope_cref)                                                      \
+   )
+#else
+#define M_ROPE_OPLIST                                                         \
+  (INIT(m_rope_init),INIT_SET(m_rope_init_set), SET(API_0P(m_rope_set)),      \
+   INIT_MOVE(m_rope_init_move), MOVE(API_0P(m_rope_move)),                    \
+   SWAP(m_rope_swap), RESET(API_0P(m_rope_reset)),                            \
+   EMPTY_P(m_rope_empty_p),                                                   \
+   CLEAR(API_0P(m_rope_clear)), HASH(m_rope_hash), EQUAL(m_rope_equal_p),     \
+   CMP(m_rope_cmp), TYPE(m_rope_t), GENTYPE(struct m_rope_s*),                \
+   GET_STR(API_0P(m_rope_get_str)), OUT_STR(m_rope_out_str),                  \
+   IN_STR(API_0P(m_rope_in_str))                                              \
+   ,SUBTYPE(m_string_unicode_t)                                               \
+   ,IT_TYPE(m_rope_it_t)                                                      \
+   ,IT_FIRST(m_rope_it)                                                       \
+   ,IT_END(m_rope_it_end)                                                     \
+   ,IT_SET(m_rope_it_set)                                                     \
+   ,IT_END_P(m_rope_end_p)                                                    \
+   ,IT_EQUAL_P(m_rope_it_equal_p)                                             \
+   ,IT_NEXT(m_rope_next)                                                      \
+   ,IT_CREF(m_rope_cref)                                                      \
+   )
+#endif
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_rope_t() M_ROPE_OPLIST
+
+M_END_PROTECTED_CODE
+
+/********************************************************************************/
+/*                                                                              */
+/* Define the small name (i.e. without the prefix) of the API provided by this  */
+/* header if it is needed                                                       */
+/*                                                                              */
+/********************************************************************************/
+#if M_USE_SMALL_NAME
+
+#define rope_t m_rope_t
+#define rope_it_t m_rope_it_t
+#define rope_init m_rope_init
+#define rope_clear m_rope_clear
+#define rope_reset m_rope_reset
+#define rope_init_set m_rope_init_set
+#define rope_set m_rope_set
+#define rope_init_move m_rope_init_move
+#define rope_move m_rope_move
+#define rope_swap m_rope_swap
+#define rope_size m_rope_size
+#define rope_empty_p m_rope_empty_p
+#define rope_get_char m_rope_get_char
+#define rope_set_strn m_rope_set_cstrn
+#define rope_set_str m_rope_set_cstr
+#define rope_set_string m_rope_set_string
+#define rope_init_set_str m_rope_init_set_cstr
+#define rope_init_set_string m_rope_init_set_string
+#define rope_init_move_string m_rope_init_move_string
+#define rope_insert_strn m_rope_insert_cstrn
+#define rope_insert_str m_rope_insert_cstr
+#define rope_insert_string m_rope_insert_string
+#define rope_insert m_rope_insert
+#define rope_cat_strn m_rope_cat_cstrn
+#define rope_cat_str m_rope_cat_cstr
+#define rope_cat_string m_rope_cat_string
+#define rope_cat m_rope_cat
+#define rope_erase m_rope_erase
+#define rope_replace_at m_rope_replace_at
+#define rope_set_n m_rope_set_n
+#define rope_mid m_rope_mid
+#define rope_flatten m_rope_flatten
+#define rope_it m_rope_it
+#define rope_it_end m_rope_it_end
+#define rope_it_pos m_rope_it_pos
+#define rope_it_set m_rope_it_set
+#define rope_it_get_pos m_rope_it_get_pos
+#define rope_end_p m_rope_end_p
+#define rope_it_equal_p m_rope_it_equal_p
+#define rope_next m_rope_next
+#define rope_get_cref m_rope_get_cref
+#define rope_cref m_rope_cref
+#define rope_equal_str_p m_rope_equal_cstr_p
+#define rope_equal_string_p m_rope_equal_string_p
+#define rope_cmp m_rope_cmp
+#define rope_equal_p m_rope_equal_p
+#define rope_hash m_rope_hash
+#define rope_get_str m_rope_get_str
+#define rope_fputs m_rope_fputs
+#define rope_out_str m_rope_out_str
+#define rope_in_str m_rope_in_str
+#define ROPE_OPLIST M_ROPE_OPLIST
+#define M_OPL_rope_t M_OPL_m_rope_t
+
+#endif
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "m-core.h"
 #include "m-string.h"
+#include "m-bstring.h"
 
 M_BEGIN_PROTECTED_CODE
 
@@ -37,51 +38,57 @@ M_BEGIN_PROTECTED_CODE
 /************************** FILE / WRITE / BIN    *******************************/
 /********************************************************************************/
 
+/* Maximum number of bytes of the compact form of a size_t */
+#define M_SER1AL_BIN_SIZE_MAX_LEN 9
+
 /* Internal service:
- * Write size_t in the stream in a compact form to reduce consumption
- * (and I/O bandwidth)
+ * Encode size_t in 'buf' in a compact form to reduce consumption
+ * (and I/O bandwidth) and return the number of bytes used.
  */
-M_INLINE bool
-m_ser1al_bin_write_size(FILE *f, const size_t size)
+M_INLINE size_t
+m_ser1al_bin_encode_size(unsigned char buf[M_SER1AL_BIN_SIZE_MAX_LEN], const size_t size)
 {
-  bool b;
-  if (M_LIKELY(size < 253))
-  {
-    b = EOF != fputc((unsigned char) size, f);
-  } else if (size < 1ULL << 16) {
-    b = EOF != fputc(253, f);    // Save 16 bits encoding
-    b &= EOF != fputc((unsigned char) (size >> 8), f);
-    b &= EOF != fputc((unsigned char) size, f);
-  } 
+  if (M_LIKELY(size < 253)) {
+    buf[0] = (unsigned char) size;
+    return 1;
+  }
+  unsigned l;
+  if (size < 1ULL << 16) {
+    buf[0] = 253;    // Save 16 bits encoding
+    l = 2;
+  }
 // For 32 bits systems, don't encode a 64 bits size_t
- #if SIZE_MAX < 1ULL<< 32
+#if SIZE_MAX < 1ULL<< 32
   else {
-    b = EOF != fputc(254, f);    // Save 32 bits encoding
-    b &= EOF != fputc((unsigned char) (size >> 24), f);
-    b &= EOF != fputc((unsigned char) (size >> 16), f);
-    b &= EOF != fputc((unsigned char) (size >> 8), f);
-    b &= EOF != fputc((unsigned char) size, f);
+    buf[0] = 254;    // Save 32 bits encoding
+    l = 4;
   }
- #else 
+#else
   else if (size < 1ULL<< 32) {
-    b = EOF != fputc(254, f);    // Save 32 bits encoding
-    b &= EOF != fputc((unsigned char) (size >> 24), f);
-    b &= EOF != fputc((unsigned char) (size >> 16), f);
-    b &= EOF != fputc((unsigned char) (size >> 8), f);
-    b &= EOF != fputc((unsigned char) size, f);
+    buf[0] = 254;    // Save 32 bits encoding
+    l = 4;
   } else {
-    b = EOF != fputc(255, f);    // Save 64 bits encoding
-    b &= EOF != fputc((unsigned char) (size >> 56), f);
-    b &= EOF != fputc((unsigned char) (size >> 48), f);
-    b &= EOF != fputc((unsigned char) (size >> 40), f);
-    b &= EOF != fputc((unsigned char) (size >> 32), f);
-    b &= EOF != fputc((unsigned char) (size >> 24), f);
-    b &= EOF != fputc((unsigned char) (size >> 16), f);
-    b &= EOF != fputc((unsigned char) (size >> 8), f);
-    b &= EOF != fputc((unsigned char) size, f);
+    buf[0] = 255;    // Save 64 bits encoding
+    l = 8;
   }
 #endif
-  return b;
+  // Big endian encoding of the size
+  for(unsigned i = 0; i < l; i++) {
+    buf[1+i] = (unsigned char) (size >> (8 * (l - 1 - i)));
+  }
+  return 1 + l;
+}
+
+/* Internal service:
+ * Write size_t in the stream in a compact form to reduce consumption
+ * (and I/O bandwidth)
+ */
+M_INLINE bool
+m_ser1al_bin_write_size(FILE *f, const size_t size)
+{
+  unsigned char buf[M_SER1AL_BIN_SIZE_MAX_LEN];
+  size_t n = m_ser1al_bin_encode_size(buf, size);
+  return fwrite(buf, 1, n, f) == n;
 }
 
 /* Internal service:
@@ -289,6 +296,23 @@ M_P(m_serial_return_code_t, m_ser1al_bin, _write_variant_end, m_serial_local_t l
   return M_SERIAL_OK_DONE;
 }
 
+/* Write the 'number_of_elements' elements of 'size_of_type' bytes
+   of the contiguous array 'data' into the serial stream 'serial' as a whole array.
+   The format is the same as writing each element separately:
+   the number of elements followed by the elements in their native form.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_bin, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  M_UNUSED_CONTEXT();
+  (void) kind; // Not needed: the elements are written as in memory
+  FILE *f = (FILE *)serial->data[0].p;
+  size_t n = fwrite (M_ASSIGN_CAST(const void*, &number_of_elements), sizeof number_of_elements, 1, f);
+  if (M_UNLIKELY (n != 1)) return m_core_serial_fail();
+  if (number_of_elements == 0) return M_SERIAL_OK_DONE;
+  n = fwrite (data, size_of_type, number_of_elements, f);
+  return n == number_of_elements ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
 /* The exported interface. */
 static const m_serial_write_interface_t m_ser1al_bin_write_interface = {
   m_ser1al_bin_write_boolean,
@@ -306,7 +330,8 @@ static const m_serial_write_interface_t m_ser1al_bin_write_interface = {
   m_ser1al_bin_write_tuple_id,
   m_ser1al_bin_write_tuple_end,
   m_ser1al_bin_write_variant_start,
-  m_ser1al_bin_write_variant_end
+  m_ser1al_bin_write_variant_end,
+  m_ser1al_bin_write_raw_array
 };
 
 M_INLINE void m_serial_bin_write_init(m_serial_write_t serial, FILE *f)
@@ -514,6 +539,20 @@ m_ser1al_bin_read_variant_end(m_serial_local_t local, m_serial_read_t serial)
   return M_SERIAL_OK_DONE;
 }
 
+/* Read from the stream 'serial' the 'number_of_elements' elements
+   of 'size_of_type' bytes of the array started by read_array_start
+   into the contiguous array 'data', and end the array.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_bin_read_raw_array(m_serial_local_t local, m_serial_read_t serial, void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  (void) local; // argument not used
+  (void) kind;  // Not needed: the elements are read as in memory
+  FILE *f = (FILE*) serial->data[0].p;
+  size_t n = fread (data, size_of_type, number_of_elements, f);
+  return n == number_of_elements ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
 static const m_serial_read_interface_t m_ser1al_bin_read_interface = {
   m_ser1al_bin_read_boolean,
   m_ser1al_bin_read_integer,
@@ -527,7 +566,8 @@ static const m_serial_read_interface_t m_ser1al_bin_read_interface = {
   m_ser1al_bin_read_tuple_start,
   m_ser1al_bin_read_tuple_id,
   m_ser1al_bin_read_variant_start,
-  m_ser1al_bin_read_variant_end
+  m_ser1al_bin_read_variant_end,
+  m_ser1al_bin_read_raw_array
 };
 
 M_INLINE void m_serial_bin_read_init(m_serial_read_t serial, FILE *f)
@@ -547,6 +587,579 @@ typedef m_serial_read_t m_serial_bin_read_t;
   (INIT_WITH(m_serial_bin_read_init), CLEAR(m_serial_bin_read_clear),         \
    TYPE(m_serial_bin_read_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
 
+
+/********************************************************************************/
+/************************** BUFFER / WRITE / BIN  *******************************/
+/********************************************************************************/
+
+/* The in-memory serializer uses the same format than the FILE serializer:
+   a buffer written by one can be read by the other */
+
+/* Write the boolean 'data' into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_boolean, m_serial_write_t serial, const bool data)
+{
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  m_bstring_push_back_bytes M_R(b, sizeof data, &data);
+  return M_SERIAL_OK_DONE;
+}
+
+/* Write the integer 'data' of 'size_of_type' bytes into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_integer, m_serial_write_t serial,const long long data, const size_t size_of_type)
+{
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  if (size_of_type == 1) {
+    int8_t i8 = (int8_t) data;
+    m_bstring_push_back_bytes M_R(b, sizeof i8, &i8);
+  } else if (size_of_type == 2) {
+    int16_t i16 = (int16_t) data;
+    m_bstring_push_back_bytes M_R(b, sizeof i16, &i16);
+  } else if (size_of_type == 4) {
+    int32_t i32 = (int32_t) data;
+    m_bstring_push_back_bytes M_R(b, sizeof i32, &i32);
+  } else {
+    M_ASSERT(size_of_type == 8);
+    int64_t i64 = (int64_t) data;
+    m_bstring_push_back_bytes M_R(b, sizeof i64, &i64);
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* Write the float 'data' of 'size_of_type' bytes into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_float, m_serial_write_t serial, const long double data, const size_t size_of_type)
+{
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  if (size_of_type == sizeof (float) ) {
+    float f1 = (float) data;
+    m_bstring_push_back_bytes M_R(b, sizeof f1, &f1);
+  } else if (size_of_type == sizeof (double) ) {
+    double f2 = (double) data;
+    m_bstring_push_back_bytes M_R(b, sizeof f2, &f2);
+  } else {
+    M_ASSERT(size_of_type == sizeof (long double) );
+    long double f3 = (long double) data;
+    m_bstring_push_back_bytes M_R(b, sizeof f3, &f3);
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* Write the null-terminated string 'data'into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_string, m_serial_write_t serial, const char data[], size_t length)
+{
+  M_ASSERT_SLOW(length == strlen(data) );
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  M_ASSERT(b != NULL && data != NULL);
+  // Write first the number of (non null) characters
+  unsigned char buf[M_SER1AL_BIN_SIZE_MAX_LEN];
+  size_t n = m_ser1al_bin_encode_size(buf, length);
+  m_bstring_push_back_bytes M_R(b, n, buf);
+  // Write the characters (excluding the final null char)
+  m_bstring_push_back_bytes M_R(b, length, data);
+  return M_SERIAL_OK_DONE;
+}
+
+/* Start writing an array of 'number_of_elements' objects into the serial stream 'serial'.
+   Return M_SERIAL_OK_CONTINUE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_array_start, m_serial_local_t local, m_serial_write_t serial, const size_t number_of_elements)
+{
+  (void) local; //Unused
+  if (number_of_elements == (size_t)-1) return M_SERIAL_FAIL_RETRY;
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  m_bstring_push_back_bytes M_R(b, sizeof number_of_elements, &number_of_elements);
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Start writing a variant into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE if the variant is empty, M_SERIAL_OK_CONTINUE otherwise */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_variant_start, m_serial_local_t local, m_serial_write_t serial, const char *const field_name[], const int max, const int index)
+{
+  (void) field_name;
+  (void) max;
+  (void) local;
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  m_bstring_push_back_bytes M_R(b, sizeof index, &index);
+  return (index < 0) ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Write the 'number_of_elements' elements of 'size_of_type' bytes
+   of the contiguous array 'data' into the serial stream 'serial' as a whole array.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  (void) kind; // Not needed: the elements are written as in memory
+  struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+  m_bstring_push_back_bytes M_R(b, sizeof number_of_elements, &number_of_elements);
+  if (number_of_elements != 0) {
+    m_bstring_push_back_bytes M_R(b, size_of_type * number_of_elements, data);
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* The exported interface.
+   The services which don't write anything are shared with the FILE serializer */
+static const m_serial_write_interface_t m_ser1al_buf_bin_write_interface = {
+  m_ser1al_buf_bin_write_boolean,
+  m_ser1al_buf_bin_write_integer,
+  m_ser1al_buf_bin_write_float,
+  m_ser1al_buf_bin_write_string,
+  m_ser1al_buf_bin_write_array_start,
+  m_ser1al_bin_write_array_next,
+  m_ser1al_bin_write_array_end,
+  m_ser1al_buf_bin_write_array_start,
+  m_ser1al_bin_write_map_value,
+  m_ser1al_bin_write_array_next,
+  m_ser1al_bin_write_array_end,
+  m_ser1al_bin_write_tuple_start,
+  m_ser1al_bin_write_tuple_id,
+  m_ser1al_bin_write_tuple_end,
+  m_ser1al_buf_bin_write_variant_start,
+  m_ser1al_bin_write_variant_end,
+  m_ser1al_buf_bin_write_raw_array
+};
+
+/* Initialize the BIN serial object for writing any object
+   at the end of the given byte string */
+M_INLINE void m_serial_bin_buffer_write_init(m_serial_write_t serial, m_bstring_t b)
+{
+  serial->m_interface = &m_ser1al_buf_bin_write_interface;
+  serial->data[0].p = M_ASSIGN_CAST(struct m_bstring_s *, b);
+}
+
+M_INLINE void m_serial_bin_buffer_write_clear(m_serial_write_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_write_t to the BIN buffer serializer with its proper OPLIST */
+typedef m_serial_write_t m_serial_bin_buffer_write_t;
+
+#define M_OPL_m_serial_bin_buffer_write_t()                                   \
+  (INIT_WITH(m_serial_bin_buffer_write_init), CLEAR(m_serial_bin_buffer_write_clear), \
+  TYPE(m_serial_bin_buffer_write_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+
+
+/********************************************************************************/
+/************************** BUFFER / READ  / BIN  *******************************/
+/********************************************************************************/
+
+/* State of the feed reader (push mode).
+   The window parsed by the buffer reader is either the last chunk
+   given by the user (borrowed) or the owned buffer 'ptr' */
+typedef struct m_ser1al_bin_feed_s {
+  unsigned char *ptr;   // Owned buffer of the bytes not parsed yet
+  size_t alloc;         // Allocated size of the owned buffer
+  size_t start;         // Position in the window of the next object to parse
+  size_t need;          // Size of the window needed to parse the object (0 if unknown)
+} m_ser1al_bin_feed_t;
+
+/* Internal service:
+ * Get the 'n' next bytes of the buffer of the stream 'serial' and skip them.
+ * Return NULL if there are not enough bytes left
+ * (recording how many bytes are needed for the feed reader).
+ */
+M_INLINE const unsigned char *
+m_ser1al_buf_bin_get(m_serial_read_t serial, size_t n)
+{
+  const unsigned char *p = (const unsigned char *) serial->data[0].cstr;
+  size_t size = serial->data[1].s;
+  size_t pos  = serial->data[2].s;
+  M_ASSERT (pos <= size);
+  if (M_UNLIKELY (n > size - pos)) {
+    m_ser1al_bin_feed_t *feed = (m_ser1al_bin_feed_t *) serial->data[3].p;
+    if (feed != NULL) {
+      feed->need = (n > SIZE_MAX - pos) ? SIZE_MAX : pos + n;
+    }
+    return NULL;
+  }
+  serial->data[2].s = pos + n;
+  return &p[pos];
+}
+
+/* Internal service:
+ * Read 'n' bytes from the buffer of the stream 'serial' into 'dst'.
+ */
+M_INLINE bool
+m_ser1al_buf_bin_read(m_serial_read_t serial, void *dst, size_t n)
+{
+  const unsigned char *p = m_ser1al_buf_bin_get(serial, n);
+  if (M_UNLIKELY (p == NULL)) {
+    return false;
+  }
+  memcpy(dst, p, n);
+  return true;
+}
+
+/* Internal service:
+ * Read size_t from the buffer of the stream 'serial' from its compact form
+ */
+M_INLINE bool
+m_ser1al_buf_bin_read_size(m_serial_read_t serial, size_t *size)
+{
+  const unsigned char *p = m_ser1al_buf_bin_get(serial, 1);
+  if (M_UNLIKELY (p == NULL)) return false;
+  if (M_LIKELY(*p < 253)) {
+    *size = *p;
+    return true;
+  }
+  size_t l = (*p == 255) ? 8 : (*p == 254) ? 4 : 2;
+  p = m_ser1al_buf_bin_get(serial, l);
+  if (M_UNLIKELY (p == NULL)) return false;
+  size_t s = 0;
+  for(size_t i = 0; i < l; i++) {
+    s = (s << 8) | p[i];
+  }
+  *size = s;
+  return true;
+}
+
+/* Read from the stream 'serial' a boolean.
+   Set '*b' with the boolean value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_boolean(m_serial_read_t serial, bool *b){
+  return m_ser1al_buf_bin_read(serial, b, sizeof *b) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Read from the stream 'serial' an integer that can be represented with 'size_of_type' bytes.
+   Set '*i' with the integer value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_integer(m_serial_read_t serial, long long *i, const size_t size_of_type){
+  int8_t   i8;
+  int16_t i16;
+  int32_t i32;
+  int64_t i64;
+  bool b;
+  if (size_of_type == 1) {
+    b = m_ser1al_buf_bin_read(serial, &i8, sizeof i8);
+    if (b) {
+      *i = i8;
+    }
+  } else if (size_of_type == 2) {
+    b = m_ser1al_buf_bin_read(serial, &i16, sizeof i16);
+    if (b) {
+      *i = i16;
+    }
+  } else if (size_of_type ==  4) {
+    b = m_ser1al_buf_bin_read(serial, &i32, sizeof i32);
+    if (b) {
+      *i = i32;
+    }
+  } else {
+    M_ASSERT(size_of_type == 8);
+    b = m_ser1al_buf_bin_read(serial, &i64, sizeof i64);
+    if (b) {
+      *i = i64;
+    }
+  }
+  return b ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Read from the stream 'serial' a float that can be represented with 'size_of_type' bytes.
+   Set '*r' with the boolean value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_float(m_serial_read_t serial, long double *r, const size_t size_of_type){
+  float   f1;
+  double  f2;
+  long double f3;
+  bool b;
+  if (size_of_type == sizeof f1) {
+    b = m_ser1al_buf_bin_read(serial, &f1, sizeof f1);
+    if (b) {
+      *r = f1;
+    }
+  } else if (size_of_type == sizeof f2) {
+    b = m_ser1al_buf_bin_read(serial, &f2, sizeof f2);
+    if (b) {
+      *r = f2;
+    }
+  } else {
+    M_ASSERT(size_of_type == sizeof f3);
+    b = m_ser1al_buf_bin_read(serial, &f3, sizeof f3);
+    if (b) {
+      *r = f3;
+    }
+  }
+  return b ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Read from the stream 'serial' a string.
+   Set 's' with the string if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_buf_bin, _read_string, m_serial_read_t serial, struct m_string_s *s)
+{
+  M_ASSERT(s != NULL);
+  // First read the number of non null characters
+  size_t length;
+  if (m_ser1al_buf_bin_read_size(serial, &length) != true) return m_core_serial_fail();
+  // Then get the characters (the size is checked before any allocation)
+  const unsigned char *p = m_ser1al_buf_bin_get(serial, length);
+  if (M_UNLIKELY (p == NULL)) return m_core_serial_fail();
+  m_string_set_cstrn M_R(s, (const char *) p, length);
+  return M_SERIAL_OK_DONE;
+}
+
+/* Start reading from the stream 'serial' an array.
+   Set '*num' with the number of elements, or 0 if it is not known.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the array continue,
+   M_SERIAL_OK_DONE if it succeeds and the array ends (the array is empty),
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_array_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
+{
+  if (!m_ser1al_buf_bin_read(serial, num, sizeof *num)) return m_core_serial_fail();
+  local->data[1].s = *num;
+  return (local->data[1].s == 0) ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Start reading a variant from the stream 'serial'.
+   Set '*id' with the corresponding index of the table 'field_name[max]'
+   associated to the parsed field in the stream.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the variant continues,
+   Return M_SERIAL_OK_DONE if it succeeds and the variant ends(variant is empty),
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_variant_start(m_serial_local_t local, m_serial_read_t serial, const char *const field_name[], const int max, int*id)
+{
+  (void) field_name;
+  (void) local; // argument not used
+  if (!m_ser1al_buf_bin_read(serial, id, sizeof *id) || *id >= max) return m_core_serial_fail();
+  return (*id < 0) ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Read from the stream 'serial' the 'number_of_elements' elements
+   of 'size_of_type' bytes of the array started by read_array_start
+   into the contiguous array 'data', and end the array.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_buf_bin_read_raw_array(m_serial_local_t local, m_serial_read_t serial, void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  (void) local; // argument not used
+  (void) kind;  // Not needed: the elements are read as in memory
+  if (M_UNLIKELY (size_of_type != 0 && number_of_elements > SIZE_MAX / size_of_type)) {
+    return m_core_serial_fail();
+  }
+  return m_ser1al_buf_bin_read(serial, data, size_of_type * number_of_elements) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* The exported interface.
+   The services which don't read anything are shared with the FILE serializer */
+static const m_serial_read_interface_t m_ser1al_buf_bin_read_interface = {
+  m_ser1al_buf_bin_read_boolean,
+  m_ser1al_buf_bin_read_integer,
+  m_ser1al_buf_bin_read_float,
+  m_ser1al_buf_bin_read_string,
+  m_ser1al_buf_bin_read_array_start,
+  m_ser1al_bin_read_array_next,
+  m_ser1al_buf_bin_read_array_start,
+  m_ser1al_bin_read_map_value,
+  m_ser1al_bin_read_array_next,
+  m_ser1al_bin_read_tuple_start,
+  m_ser1al_bin_read_tuple_id,
+  m_ser1al_buf_bin_read_variant_start,
+  m_ser1al_bin_read_variant_end,
+  m_ser1al_buf_bin_read_raw_array
+};
+
+/* Initialize the BIN serial object for reading any object
+   from the 'size' bytes of the buffer 'buffer'.
+   The buffer shall remain valid and unmodified while the serial object is used. */
+M_INLINE void m_serial_bin_buffer_read_init(m_serial_read_t serial, const void *buffer, size_t size)
+{
+  M_ASSERT (buffer != NULL || size == 0);
+  serial->m_interface = &m_ser1al_buf_bin_read_interface;
+  serial->data[0].cstr = (const char *) buffer;
+  serial->data[1].s = size;
+  serial->data[2].s = 0;
+  serial->data[3].p = NULL;
+}
+
+/* Return the number of bytes read from the buffer so far */
+M_INLINE size_t m_serial_bin_buffer_read_pos(const m_serial_read_t serial)
+{
+  return serial->data[2].s;
+}
+
+M_INLINE void m_serial_bin_buffer_read_clear(m_serial_read_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_read_t to the BIN buffer serializer with its proper OPLIST */
+typedef m_serial_read_t m_serial_bin_buffer_read_t;
+#define M_OPL_m_serial_bin_buffer_read_t()                                    \
+  (INIT_WITH(m_serial_bin_buffer_read_init), CLEAR(m_serial_bin_buffer_read_clear), \
+   TYPE(m_serial_bin_buffer_read_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+
+/********************************************************************************/
+/*************************** FEED / READ  / BIN  ********************************/
+/********************************************************************************/
+
+/* The feed reader parses the objects from the chunks of bytes given by the user
+   as they arrive (push mode) with the services of the buffer reader.
+   If an object is incomplete, its parsing fails and the reader keeps its bytes
+   so that the parsing can be restarted from the beginning of the object
+   once enough bytes have been fed. An object which is completely
+   inside a chunk is parsed directly from the chunk (no copy). */
+
+/* Initialize the BIN serial object for reading any object
+   from the chunks of bytes given by m_serial_bin_feed */
+M_INLINE void m_serial_bin_feed_init(m_serial_read_t serial)
+{
+  M_GLOBAL_CONTEXT();
+  m_ser1al_bin_feed_t *feed = M_MEMORY_ALLOC(m_context, m_ser1al_bin_feed_t);
+  if (M_UNLIKELY_NOMEM (feed == NULL)) {
+    M_MEMORY_FULL(m_ser1al_bin_feed_t, 1);
+    return;
+  }
+  feed->ptr = NULL;
+  feed->alloc = 0;
+  feed->start = 0;
+  feed->need = 0;
+  serial->m_interface = &m_ser1al_buf_bin_read_interface;
+  serial->data[0].cstr = NULL;
+  serial->data[1].s = 0;
+  serial->data[2].s = 0;
+  serial->data[3].p = feed;
+}
+
+/* Clear the BIN serial object for reading from chunks */
+M_INLINE void m_serial_bin_feed_clear(m_serial_read_t serial)
+{
+  M_GLOBAL_CONTEXT();
+  m_ser1al_bin_feed_t *feed = (m_ser1al_bin_feed_t *) serial->data[3].p;
+  M_ASSERT (feed != NULL);
+  M_MEMORY_FREE(m_context, unsigned char, feed->ptr, feed->alloc);
+  M_MEMORY_DEL(m_context, feed);
+}
+
+/* Internal service:
+ * Move the bytes of the window of the reader not parsed yet
+ * at the beginning of the owned buffer, followed by 'len' free bytes,
+ * and set the window of the reader to them.
+ * Return false in case of memory failure.
+ */
+M_INLINE bool
+m_ser1al_bin_feed_own(m_serial_read_t serial, size_t len)
+{
+  M_GLOBAL_CONTEXT();
+  m_ser1al_bin_feed_t *feed = (m_ser1al_bin_feed_t *) serial->data[3].p;
+  const size_t start = feed->start;
+  const size_t n = serial->data[1].s - start;
+  const bool owned = feed->ptr != NULL && serial->data[0].cstr == (const char *) feed->ptr;
+  if (M_UNLIKELY (len > SIZE_MAX - n)) {
+    M_MEMORY_FULL(unsigned char, len);
+    return false;
+  }
+  if (owned && start > 0) {
+    memmove(feed->ptr, feed->ptr + start, n);
+  }
+  if (n + len > feed->alloc) {
+    size_t alloc = M_MAX(n + len, feed->alloc + feed->alloc / 2);
+    unsigned char *ptr = M_MEMORY_REALLOC(m_context, unsigned char, feed->ptr, feed->alloc, alloc);
+    if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+      M_MEMORY_FULL(unsigned char, alloc);
+      return false;
+    }
+    feed->ptr = ptr;
+    feed->alloc = alloc;
+  }
+  if (!owned && n > 0) {
+    // Copy the bytes of the borrowed chunk (still valid)
+    memcpy(feed->ptr, serial->data[0].cstr + start, n);
+  }
+  feed->need = (feed->need > start) ? feed->need - start : 0;
+  feed->start = 0;
+  serial->data[0].cstr = (const char *) feed->ptr;
+  serial->data[1].s = n;
+  serial->data[2].s = 0;
+  return true;
+}
+
+/* Feed the BIN serial object with the 'len' bytes of the chunk 'ptr'.
+   The chunk is parsed in place if there is no pending byte:
+   it shall remain valid and unmodified until the next call to
+   m_serial_bin_feed, until m_serial_bin_feed_commit returns M_SERIAL_FAIL_RETRY
+   or until the serial object is cleared. Otherwise the chunk is copied. */
+M_INLINE void m_serial_bin_feed(m_serial_read_t serial, const void *ptr, size_t len)
+{
+  M_ASSERT (ptr != NULL || len == 0);
+  m_ser1al_bin_feed_t *feed = (m_ser1al_bin_feed_t *) serial->data[3].p;
+  M_ASSERT (feed != NULL);
+  const size_t remaining = serial->data[1].s - feed->start;
+  if (remaining == 0) {
+    // Nothing pending: borrow the chunk
+    feed->need = 0;
+    feed->start = 0;
+    serial->data[0].cstr = (const char *) ptr;
+    serial->data[1].s = len;
+    serial->data[2].s = 0;
+    return;
+  }
+  if (M_UNLIKELY (!m_ser1al_bin_feed_own(serial, len))) return;
+  if (len > 0) {
+    memcpy(feed->ptr + remaining, ptr, len);
+  }
+  serial->data[1].s = remaining + len;
+}
+
+/* Commit the parsing of an object from the BIN serial object,
+   which has returned 'ret':
+   - if the object has been parsed, the next object will be parsed
+   after it. Return 'ret'.
+   - if the object is incomplete, the next parsing will restart from the
+   beginning of the object (its bytes are kept and the chunk is no longer used).
+   The content of the object is unspecified. Return M_SERIAL_FAIL_RETRY.
+   - otherwise the data are invalid. Return M_SERIAL_FAIL.
+   Typical usage is:
+     ret = m_serial_bin_feed_commit(serial, obj_in_serial(obj, serial)); */
+M_INLINE m_serial_return_code_t
+m_serial_bin_feed_commit(m_serial_read_t serial, m_serial_return_code_t ret)
+{
+  m_ser1al_bin_feed_t *feed = (m_ser1al_bin_feed_t *) serial->data[3].p;
+  M_ASSERT (feed != NULL);
+  const size_t size = serial->data[1].s;
+  if (ret == M_SERIAL_OK_DONE || ret == M_SERIAL_OK_CONTINUE) {
+    feed->start = serial->data[2].s;
+    feed->need = 0;
+    return ret;
+  }
+  if (feed->need <= size) {
+    // Not a lack of bytes: the data are invalid
+    feed->need = 0;
+    serial->data[2].s = feed->start;
+    return M_SERIAL_FAIL;
+  }
+  // Keep the bytes of the incomplete object
+  if (M_UNLIKELY (!m_ser1al_bin_feed_own(serial, 0))) {
+    return M_SERIAL_FAIL;
+  }
+  return M_SERIAL_FAIL_RETRY;
+}
+
+/* Return the number of bytes which are known to be missing
+   to parse the next object (0 if it may be parsed).
+   This avoids parsing again an object which is known to be incomplete */
+M_INLINE size_t m_serial_bin_feed_missing(const m_serial_read_t serial)
+{
+  const m_ser1al_bin_feed_t *feed = (const m_ser1al_bin_feed_t *) serial->data[3].p;
+  M_ASSERT (feed != NULL);
+  const size_t size = serial->data[1].s;
+  return (feed->need > size) ? feed->need - size : 0;
+}
+
+/* Define a synonym of m_serial_read_t to the BIN feed serializer with its proper OPLIST */
+typedef m_serial_read_t m_serial_bin_feed_t;
+#define M_OPL_m_serial_bin_feed_t()                                           \
+  (INIT(m_serial_bin_feed_init), CLEAR(m_serial_bin_feed_clear),              \
+   TYPE(m_serial_bin_feed_t) )
+
 M_END_PROTECTED_CODE
 
 #endif
@@ -0,0 +1,365 @@
+/*
+ * M*LIB - Serial Frame
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_SERIAL_FRAME_H
+#define MSTARLIB_SERIAL_FRAME_H
+
+#include <stdint.h>
+
+#include "m-core.h"
+#include "m-bstring.h"
+#include "m-serial-bin.h"
+
+/* Use the CRC32C instructions of the target if they are available */
+#if defined(__SSE4_2__)
+# include <nmmintrin.h>
+# define M_SER1AL_FRAME_CRC_X86 1
+#elif defined(__ARM_FEATURE_CRC32)
+# include <arm_acle.h>
+# define M_SER1AL_FRAME_CRC_ARM 1
+#endif
+
+M_BEGIN_PROTECTED_CODE
+
+/* The framed file format:
+   - a file header: the magic "M*LIBFRM", the version of the frame format
+     and the version of the user format (both as 32 bits little endian),
+   - a sequence of records, each one made of:
+     + the size of its payload (32 bits little endian),
+     + the CRC32C of its payload (32 bits little endian),
+     + the CRC32C of the two previous fields (32 bits little endian),
+     + the payload: the BIN serialization of the objects of the record.
+   A corrupted size is detected before reading the payload,
+   and a torn record at the end of the file (after a crash) is detected
+   by the size or by the CRC of its payload. */
+
+#define M_SER1AL_FRAME_MAGIC       "M*LIBFRM"
+#define M_SER1AL_FRAME_FORMAT      1
+#define M_SER1AL_FRAME_HEADER_SIZE 16
+#define M_SER1AL_FRAME_RECORD_SIZE 12
+
+/* Table of the CRC32C (Castagnoli polynomial, reflected 0x82F63B78)
+   of all the bytes */
+static const uint32_t m_ser1al_frame_crc_table[256] = {
+  0x00000000U, 0xf26b8303U, 0xe13b70f7U, 0x1350f3f4U, 0xc79a971fU, 0x35f1141cU,
+  0x26a1e7e8U, 0xd4ca64ebU, 0x8ad958cfU, 0x78b2dbccU, 0x6be22838U, 0x9989ab3bU,
+  0x4d43cfd0U, 0xbf284cd3U, 0xac78bf27U, 0x5e133c24U, 0x105ec76fU, 0xe235446cU,
+  0xf165b798U, 0x030e349bU, 0xd7c45070U, 0x25afd373U, 0x36ff2087U, 0xc494a384U,
+  0x9a879fa0U, 0x68ec1ca3U, 0x7bbcef57U, 0x89d76c54U, 0x5d1d08bfU, 0xaf768bbcU,
+  0xbc267848U, 0x4e4dfb4bU, 0x20bd8edeU, 0xd2d60dddU, 0xc186fe29U, 0x33ed7d2aU,
+  0xe72719c1U, 0x154c9ac2U, 0x061c6936U, 0xf477ea35U, 0xaa64d611U, 0x580f5512U,
+  0x4b5fa6e6U, 0xb93425e5U, 0x6dfe410eU, 0x9f95c20dU, 0x8cc531f9U, 0x7eaeb2faU,
+  0x30e349b1U, 0xc288cab2U, 0xd1d83946U, 0x23b3ba45U, 0xf779deaeU, 0x05125dadU,
+  0x1642ae59U, 0xe4292d5aU, 0xba3a117eU, 0x4851927dU, 0x5b016189U, 0xa96ae28aU,
+  0x7da08661U, 0x8fcb0562U, 0x9c9bf696U, 0x6ef07595U, 0x417b1dbcU, 0xb3109ebfU,
+  0xa0406d4bU, 0x522bee48U, 0x86e18aa3U, 0x748a09a0U, 0x67dafa54U, 0x95b17957U,
+  0xcba24573U, 0x39c9c670U, 0x2a993584U, 0xd8f2b687U, 0x0c38d26cU, 0xfe53516fU,
+  0xed03a29bU, 0x1f682198U, 0x5125dad3U, 0xa34e59d0U, 0xb01eaa24U, 0x42752927U,
+  0x96bf4dccU, 0x64d4cecfU, 0x77843d3bU, 0x85efbe38U, 0xdbfc821cU, 0x2997011fU,
+  0x3ac7f2ebU, 0xc8ac71e8U, 0x1c661503U, 0xee0d9600U, 0xfd5d65f4U, 0x0f36e6f7U,
+  0x61c69362U, 0x93ad1061U, 0x80fde395U, 0x72966096U, 0xa65c047dU, 0x5437877eU,
+  0x4767748aU, 0xb50cf789U, 0xeb1fcbadU, 0x197448aeU, 0x0a24bb5aU, 0xf84f3859U,
+  0x2c855cb2U, 0xdeeedfb1U, 0xcdbe2c45U, 0x3fd5af46U, 0x7198540dU, 0x83f3d70eU,
+  0x90a324faU, 0x62c8a7f9U, 0xb602c312U, 0x44694011U, 0x5739b3e5U, 0xa55230e6U,
+  0xfb410cc2U, 0x092a8fc1U, 0x1a7a7c35U, 0xe811ff36U, 0x3cdb9bddU, 0xceb018deU,
+  0xdde0eb2aU, 0x2f8b6829U, 0x82f63b78U, 0x709db87bU, 0x63cd4b8fU, 0x91a6c88cU,
+  0x456cac67U, 0xb7072f64U, 0xa457dc90U, 0x563c5f93U, 0x082f63b7U, 0xfa44e0b4U,
+  0xe9141340U, 0x1b7f9043U, 0xcfb5f4a8U, 0x3dde77abU, 0x2e8e845fU, 0xdce5075cU,
+  0x92a8fc17U, 0x60c37f14U, 0x73938ce0U, 0x81f80fe3U, 0x55326b08U, 0xa759e80bU,
+  0xb4091bffU, 0x466298fcU, 0x1871a4d8U, 0xea1a27dbU, 0xf94ad42fU, 0x0b21572cU,
+  0xdfeb33c7U, 0x2d80b0c4U, 0x3ed04330U, 0xccbbc033U, 0xa24bb5a6U, 0x502036a5U,
+  0x4370c551U, 0xb11b4652U, 0x65d122b9U, 0x97baa1baU, 0x84ea524eU, 0x7681d14dU,
+  0x2892ed69U, 0xdaf96e6aU, 0xc9a99d9eU, 0x3bc21e9dU, 0xef087a76U, 0x1d63f975U,
+  0x0e330a81U, 0xfc588982U, 0xb21572c9U, 0x407ef1caU, 0x532e023eU, 0xa145813dU,
+  0x758fe5d6U, 0x87e466d5U, 0x94b49521U, 0x66df1622U, 0x38cc2a06U, 0xcaa7a905U,
+  0xd9f75af1U, 0x2b9cd9f2U, 0xff56bd19U, 0x0d3d3e1aU, 0x1e6dcdeeU, 0xec064eedU,
+  0xc38d26c4U, 0x31e6a5c7U, 0x22b65633U, 0xd0ddd530U, 0x0417b1dbU, 0xf67c32d8U,
+  0xe52cc12cU, 0x1747422fU, 0x49547e0bU, 0xbb3ffd08U, 0xa86f0efcU, 0x5a048dffU,
+  0x8ecee914U, 0x7ca56a17U, 0x6ff599e3U, 0x9d9e1ae0U, 0xd3d3e1abU, 0x21b862a8U,
+  0x32e8915cU, 0xc083125fU, 0x144976b4U, 0xe622f5b7U, 0xf5720643U, 0x07198540U,
+  0x590ab964U, 0xab613a67U, 0xb831c993U, 0x4a5a4a90U, 0x9e902e7bU, 0x6cfbad78U,
+  0x7fab5e8cU, 0x8dc0dd8fU, 0xe330a81aU, 0x115b2b19U, 0x020bd8edU, 0xf0605beeU,
+  0x24aa3f05U, 0xd6c1bc06U, 0xc5914ff2U, 0x37faccf1U, 0x69e9f0d5U, 0x9b8273d6U,
+  0x88d28022U, 0x7ab90321U, 0xae7367caU, 0x5c18e4c9U, 0x4f48173dU, 0xbd23943eU,
+  0xf36e6f75U, 0x0105ec76U, 0x12551f82U, 0xe03e9c81U, 0x34f4f86aU, 0xc69f7b69U,
+  0xd5cf889dU, 0x27a40b9eU, 0x79b737baU, 0x8bdcb4b9U, 0x988c474dU, 0x6ae7c44eU,
+  0xbe2da0a5U, 0x4c4623a6U, 0x5f16d052U, 0xad7d5351U
+};
+
+/* Update the CRC32C 'crc' with the 'size' bytes of 'data' and return it.
+   The CRC of a sequence of bytes starts from 0:
+   m_serial_frame_crc32c(m_serial_frame_crc32c(0, a, na), b, nb)
+   is the CRC of the concatenation of a and b. */
+M_INLINE uint32_t
+m_serial_frame_crc32c(uint32_t crc, const void *data, size_t size)
+{
+  const unsigned char *p = (const unsigned char *) data;
+  crc = ~crc;
+#if defined(M_SER1AL_FRAME_CRC_X86) || defined(M_SER1AL_FRAME_CRC_ARM)
+  while (size >= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof v);
+# if defined(M_SER1AL_FRAME_CRC_X86) && defined(__x86_64__)
+    crc = (uint32_t) _mm_crc32_u64(crc, v);
+# elif defined(M_SER1AL_FRAME_CRC_X86)
+    crc = _mm_crc32_u32(crc, (uint32_t) v);
+    crc = _mm_crc32_u32(crc, (uint32_t) (v >> 32));
+# else
+    crc = __crc32cd(crc, v);
+# endif
+    p += 8;
+    size -= 8;
+  }
+  while (size > 0) {
+# if defined(M_SER1AL_FRAME_CRC_X86)
+    crc = _mm_crc32_u8(crc, *p);
+# else
+    crc = __crc32cb(crc, *p);
+# endif
+    p++;
+    size--;
+  }
+#else
+  for(size_t i = 0; i < size; i++) {
+    crc = m_ser1al_frame_crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  }
+#endif
+  return ~crc;
+}
+
+/* Internal service:
+ * Encode / decode a 32 bits little endian integer */
+M_INLINE void
+m_ser1al_frame_put_u32(unsigned char *p, uint32_t v)
+{
+  for(int i = 0; i < 4; i++) {
+    p[i] = (unsigned char) (v >> (8 * i));
+  }
+}
+
+M_INLINE uint32_t
+m_ser1al_frame_get_u32(const unsigned char *p)
+{
+  uint32_t v = 0;
+  for(int i = 3; i >= 0; i--) {
+    v = (v << 8) | p[i];
+  }
+  return v;
+}
+
+/* Write the file header of the framed format
+   with the version 'version' of the user format into the FILE 'f'.
+   Return true if it succeeds, false otherwise */
+M_INLINE bool
+m_serial_frame_write_header(FILE *f, uint32_t version)
+{
+  unsigned char header[M_SER1AL_FRAME_HEADER_SIZE];
+  memcpy(header, M_SER1AL_FRAME_MAGIC, 8);
+  m_ser1al_frame_put_u32(&header[8], M_SER1AL_FRAME_FORMAT);
+  m_ser1al_frame_put_u32(&header[12], version);
+  return fwrite(header, 1, sizeof header, f) == sizeof header;
+}
+
+/* Read the file header of the framed format from the FILE 'f'
+   and set '*version' with the version of the user format.
+   Return true if it succeeds, false otherwise
+   (not a framed file or unsupported version of the frame format) */
+M_INLINE bool
+m_serial_frame_read_header(FILE *f, uint32_t *version)
+{
+  unsigned char header[M_SER1AL_FRAME_HEADER_SIZE];
+  if (fread(header, 1, sizeof header, f) != sizeof header
+      || memcmp(header, M_SER1AL_FRAME_MAGIC, 8) != 0
+      || m_ser1al_frame_get_u32(&header[8]) != M_SER1AL_FRAME_FORMAT)
+    return false;
+  *version = m_ser1al_frame_get_u32(&header[12]);
+  return true;
+}
+
+
+
+/********************************************************************************/
+/******************************** WRITE / FRAME *********************************/
+/********************************************************************************/
+
+/* Object to write records into a framed FILE */
+typedef struct m_serial_frame_write_s {
+  FILE        *file;        /* FILE to write the records to */
+  m_bstring_t  payload;     /* Payload of the record being written */
+} m_serial_frame_write_t[1];
+
+/* Initialize the object 'frame' for writing records at the current position
+   of the FILE 'f' (after the file header or after the last valid record) */
+M_INLINE void
+m_serial_frame_write_init(m_serial_frame_write_t frame, FILE *f)
+{
+  M_ASSERT (f != NULL);
+  frame->file = f;
+  m_bstring_init(frame->payload);
+}
+
+/* Clear the object 'frame' */
+M_INLINE void
+m_serial_frame_write_clear(m_serial_frame_write_t frame)
+{
+  M_GLOBAL_CONTEXT();
+  m_bstring_clear M_R(frame->payload);
+}
+
+/* Start a new record of 'frame' and initialize the BIN serial object 'serial'
+   so that the objects written with it are the payload of the record */
+M_INLINE void
+m_serial_frame_write_start(m_serial_frame_write_t frame, m_serial_write_t serial)
+{
+  m_bstring_reset(frame->payload);
+  m_serial_bin_buffer_write_init(serial, frame->payload);
+}
+
+/* End the record of 'frame' and write it into its FILE.
+   The FILE is not flushed.
+   Return true if it succeeds, false otherwise */
+M_INLINE bool
+m_serial_frame_write_end(m_serial_frame_write_t frame)
+{
+  size_t size = m_bstring_size(frame->payload);
+  if (M_UNLIKELY (size > UINT32_MAX)) return false;
+  const uint8_t *payload = m_bstring_view(frame->payload, 0, size);
+  unsigned char record[M_SER1AL_FRAME_RECORD_SIZE];
+  m_ser1al_frame_put_u32(&record[0], (uint32_t) size);
+  m_ser1al_frame_put_u32(&record[4], m_serial_frame_crc32c(0, payload, size));
+  m_ser1al_frame_put_u32(&record[8], m_serial_frame_crc32c(0, record, 8));
+  return fwrite(record, 1, sizeof record, frame->file) == sizeof record
+    && fwrite(payload, 1, size, frame->file) == size;
+}
+
+
+
+/********************************************************************************/
+/******************************** READ  / FRAME *********************************/
+/********************************************************************************/
+
+/* Object to read records from a framed FILE */
+typedef struct m_serial_frame_read_s {
+  FILE          *file;      /* FILE to read the records from */
+  unsigned char *ptr;       /* Payload of the last read record */
+  size_t         alloc;     /* Allocated size of the payload */
+} m_serial_frame_read_t[1];
+
+/* Initialize the object 'frame' for reading records from the current position
+   of the FILE 'f' (after the file header) */
+M_INLINE void
+m_serial_frame_read_init(m_serial_frame_read_t frame, FILE *f)
+{
+  M_ASSERT (f != NULL);
+  frame->file = f;
+  frame->ptr = NULL;
+  frame->alloc = 0;
+}
+
+/* Clear the object 'frame' */
+M_INLINE void
+m_serial_frame_read_clear(m_serial_frame_read_t frame)
+{
+  M_GLOBAL_CONTEXT();
+  M_MEMORY_FREE(m_context, unsigned char, frame->ptr, frame->alloc);
+}
+
+/* Internal service:
+ * Read the next record of the FILE of 'frame' and check it.
+ * Set '*size' with the size of its payload, stored in the buffer of 'frame'.
+ * Return M_SERIAL_OK_CONTINUE if a valid record has been read,
+ * M_SERIAL_OK_DONE if the end of the FILE is reached,
+ * M_SERIAL_FAIL if the record is torn or corrupted.
+ */
+M_INLINE m_serial_return_code_t
+m_ser1al_frame_read_record(m_serial_frame_read_t frame, size_t *size)
+{
+  unsigned char record[M_SER1AL_FRAME_RECORD_SIZE];
+  size_t n = fread(record, 1, sizeof record, frame->file);
+  if (n == 0 && feof(frame->file)) return M_SERIAL_OK_DONE;
+  if (M_UNLIKELY (n != sizeof record
+                  || m_ser1al_frame_get_u32(&record[8]) != m_serial_frame_crc32c(0, record, 8)))
+    return m_core_serial_fail();
+  size_t s = m_ser1al_frame_get_u32(&record[0]);
+  if (s > frame->alloc) {
+    M_GLOBAL_CONTEXT();
+    unsigned char *ptr = M_MEMORY_REALLOC(m_context, unsigned char, frame->ptr, frame->alloc, s);
+    if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+      M_MEMORY_FULL(unsigned char, s);
+      return m_core_serial_fail();
+    }
+    frame->ptr = ptr;
+    frame->alloc = s;
+  }
+  if (M_UNLIKELY (fread(frame->ptr, 1, s, frame->file) != s
+                  || m_ser1al_frame_get_u32(&record[4]) != m_serial_frame_crc32c(0, frame->ptr, s)))
+    return m_core_serial_fail();
+  *size = s;
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Read the next record of 'frame' and check its integrity.
+   Initialize the BIN serial object 'serial' for reading the objects of its payload
+   (valid until the next call).
+   Return M_SERIAL_OK_CONTINUE if a valid record has been read,
+   M_SERIAL_OK_DONE if there is no more record,
+   M_SERIAL_FAIL if the record is torn or corrupted */
+M_INLINE m_serial_return_code_t
+m_serial_frame_read_next(m_serial_frame_read_t frame, m_serial_read_t serial)
+{
+  size_t size = 0;
+  m_serial_return_code_t ret = m_ser1al_frame_read_record(frame, &size);
+  if (ret == M_SERIAL_OK_CONTINUE) {
+    m_serial_bin_buffer_read_init(serial, frame->ptr, size);
+  }
+  return ret;
+}
+
+/* Scan the records of the FILE 'f' from its current position (after the file header)
+   checking their integrity, and stop at the first record which is torn or corrupted.
+   Set '*count' with the number of valid records (if count is not NULL).
+   Return the position in the FILE after the last valid record
+   (where new records can be written) or -1 if the FILE cannot be read.
+   The FILE is left at this position. */
+M_INLINE long
+m_serial_frame_scan(FILE *f, size_t *count)
+{
+  m_serial_frame_read_t frame;
+  m_serial_frame_read_init(frame, f);
+  size_t n = 0;
+  long pos = ftell(f);
+  size_t size;
+  while (pos >= 0 && m_ser1al_frame_read_record(frame, &size) == M_SERIAL_OK_CONTINUE) {
+    pos += (long) (M_SER1AL_FRAME_RECORD_SIZE + size);
+    n++;
+  }
+  m_serial_frame_read_clear(frame);
+  if (count != NULL) *count = n;
+  if (pos >= 0 && fseek(f, pos, SEEK_SET) != 0) return -1;
+  return pos;
+}
+
+M_END_PROTECTED_CODE
+
+#endif
@@ -51,8 +51,9 @@ M_P(m_serial_return_code_t, m_ser1al_json, _write_integer, m_serial_write_t seri
   M_UNUSED_CONTEXT();
   (void) size_of_type; // Ignored
   FILE *f = (FILE *)serial->data[0].p;
-  int n = fprintf(f, "%lld", data);
-  return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();  
+  char buffer[M_CORE_FMT_INT_SIZE];
+  size_t n = m_core_fmt_sj(buffer, data);
+  return fwrite(buffer, 1, n, f) == n ? M_SERIAL_OK_DONE : m_core_serial_fail();
 }
 
 /* Write the float 'data' of 'size_of_type' bytes into the serial stream 'serial'.
@@ -60,10 +61,17 @@ M_P(m_serial_return_code_t, m_ser1al_json, _write_integer, m_serial_write_t seri
 M_P(m_serial_return_code_t, m_ser1al_json, _write_float, m_serial_write_t serial, const long double data, const size_t size_of_type)
 {
   M_UNUSED_CONTEXT();
-  (void) size_of_type; // Ignored
   FILE *f = (FILE *)serial->data[0].p;
-  int n = fprintf(f, "%Lf", data);
-  return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  char buffer[M_CORE_FMT_FLOAT_SIZE];
+  size_t n;
+  if (size_of_type == sizeof (float)) {
+    n = m_core_fmt_float(buffer, (float) data);
+  } else if (size_of_type == sizeof (double)) {
+    n = m_core_fmt_double(buffer, (double) data);
+  } else {
+    return fprintf(f, "%Lf", data) > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  }
+  return fwrite(buffer, 1, n, f) == n ? M_SERIAL_OK_DONE : m_core_serial_fail();
 }
 
 /* Write the null-terminated string 'data'into the serial stream 'serial'.
@@ -242,6 +250,41 @@ M_P(m_serial_return_code_t, m_ser1al_json, _write_variant_end, m_serial_local_t
   return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
 }
 
+/* Write the 'number_of_elements' elements of 'size_of_type' bytes and of kind 'kind'
+   of the contiguous array 'data' into the serial stream 'serial' as a whole array.
+   The elements are formatted in a local buffer which is written only when it is full.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_json, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  M_UNUSED_CONTEXT();
+  FILE *f = (FILE *)serial->data[0].p;
+  char buffer[16 * M_CORE_FMT_FLOAT_SIZE];
+  size_t n = 0;
+  buffer[n++] = '[';
+  for(size_t i = 0; i < number_of_elements; i++) {
+    if (n > sizeof buffer - M_CORE_FMT_FLOAT_SIZE - 2) {
+      if (fwrite(buffer, 1, n, f) != n) return m_core_serial_fail();
+      n = 0;
+    }
+    if (i != 0) buffer[n++] = ',';
+    if (kind != M_SERIAL_RAW_FLOAT) {
+      n += m_core_fmt_sj(&buffer[n], m_core_serial_raw_integer(data, size_of_type, kind, i));
+    } else if (size_of_type == sizeof (float)) {
+      n += m_core_fmt_float(&buffer[n], (float) m_core_serial_raw_float(data, size_of_type, i));
+    } else if (size_of_type == sizeof (double)) {
+      n += m_core_fmt_double(&buffer[n], (double) m_core_serial_raw_float(data, size_of_type, i));
+    } else {
+      if (fwrite(buffer, 1, n, f) != n
+          || fprintf(f, "%Lf", m_core_serial_raw_float(data, size_of_type, i)) <= 0) {
+        return m_core_serial_fail();
+      }
+      n = 0;
+    }
+  }
+  buffer[n++] = ']';
+  return fwrite(buffer, 1, n, f) == n ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
 /* The internal exported interface of m_serial_write_json
    If it is not used, it will be optimized away by the compiler. */
 static const m_serial_write_interface_t m_ser1al_json_write_interface = {
@@ -260,7 +303,8 @@ static const m_serial_write_interface_t m_ser1al_json_write_interface = {
   m_ser1al_json_write_tuple_id,
   m_ser1al_json_write_tuple_end,
   m_ser1al_json_write_variant_start,
-  m_ser1al_json_write_variant_end
+  m_ser1al_json_write_variant_end,
+  m_ser1al_json_write_raw_array
 };
 
 /* Initialize the JSON serial object for writing any object to JSON format in the given FILE */
@@ -285,302 +329,6 @@ typedef m_serial_write_t m_serial_json_write_t;
 
 
 
-/********************************************************************************/
-/*************************** FILE / READ  / JSON ********************************/
-/********************************************************************************/
-
-/* Read from the stream 'serial' a boolean.
-   Set '*b' with the boolean value if succeeds 
-   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_boolean(m_serial_read_t serial, bool *b){
-  FILE *f = (FILE*) serial->data[0].p;
-  int c = m_core_fgetc_nospace(f);
-  if (c == 't') {
-    *b = true;
-    c = fgetc(f);
-    if (c != 'r') return m_core_serial_fail();
-    c = fgetc(f);
-    if (c != 'u') return m_core_serial_fail();
-    c = fgetc(f);
-    if (c != 'e') return m_core_serial_fail();
-    return M_SERIAL_OK_DONE;
-  } else if (c == 'f') {
-    *b = false;
-    c = fgetc(f);
-    if (c != 'a') return m_core_serial_fail();
-    c = fgetc(f);
-    if (c != 'l') return m_core_serial_fail();
-    c = fgetc(f);
-    if (c != 's') return m_core_serial_fail();
-    c = fgetc(f);
-    if (c != 'e') return m_core_serial_fail();
-    return M_SERIAL_OK_DONE;
-  } else {
-    return m_core_serial_fail();
-  }
-}
-
-/* Read from the stream 'serial' an integer that can be represented with 'size_of_type' bytes.
-   Set '*i' with the integer value if succeeds 
-   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_integer(m_serial_read_t serial, long long *i, const size_t size_of_type){
-  (void) size_of_type; // Ignored
-  FILE *f = (FILE*) serial->data[0].p;
-  return m_core_fscanf(f, " %lld", i) == 1 ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-/* Read from the stream 'serial' a float that can be represented with 'size_of_type' bytes.
-   Set '*r' with the boolean value if succeeds 
-   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_float(m_serial_read_t serial, long double *r, const size_t size_of_type){
-  (void) size_of_type; // Ignored
-  FILE *f = (FILE*) serial->data[0].p;
-  return m_core_fscanf(f, " %Lf", r) == 1 ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-/* Read from the stream 'serial' a string.
-   Set 's' with the string if succeeds 
-   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
-M_P(m_serial_return_code_t, m_ser1al_json, _read_string, m_serial_read_t serial, struct m_string_s *s)
-{
-  FILE *f = (FILE*) serial->data[0].p;
-  int n = m_core_fscanf(f, " "); // Skip any leading spaces.
-  (void) n; // Unused return value.
-  return m_string_in_str M_R(s, f) ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-/* Start reading from the stream 'serial' an array.
-   Set '*num' with the number of elements, or 0 if it is not known.
-   Initialize 'local' so that it can be used to serialize the array 
-   (local is an unique serialization object of the array).
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the array continue,
-   M_SERIAL_OK_DONE if it succeeds and the array ends (the array is empty),
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_array_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int final1 = -1, final2 = -1;
-  int n = m_core_fscanf(f, " [%n ]%n", &final1, &final2);
-  (void) n; // Unused. Parsing is checked through c (more robust)
-  *num = 0; // don't know the size of the array.
-  // Test how much the parsing succeed.
-  if (final1 < 0) return m_core_serial_fail();
-  return (final2 < 0) ? M_SERIAL_OK_CONTINUE : M_SERIAL_OK_DONE;
-}
-
-/* Continue reading from the stream 'serial' an array.
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the array continue,
-   M_SERIAL_OK_DONE if it succeeds and the array ends,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_array_next(m_serial_local_t local, m_serial_read_t serial)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  char c = 0;
-  int n = m_core_fscanf(f, " %c", m_core_arg_size(&c, 1) );
-  (void) n; // Unused. Parsing is checked through c (more robust)
-  return c == ',' ? M_SERIAL_OK_CONTINUE : c == ']' ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-/* Start reading from the stream 'serial' a map.
-   Set '*num' with the number of elements, or 0 if it is not known.
-   Initialize 'local' so that it can be used to serialize the array 
-   (local is an unique serialization object of the array).
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the map continue,
-   M_SERIAL_OK_DONE if it succeeds and the map ends (the map is empty),
-   m_core_serial_fail() otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_map_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int final1 = -1, final2 = -1;
-  int n = m_core_fscanf(f, " {%n }%n", &final1, &final2);
-  (void) n; // Unused. Parsing is checked through final (more robust)
-  *num = 0; // don't know the size of the map.
-  // Test how much the parsing succeed.
-  if (final1 < 0) return m_core_serial_fail();
-  return (final2 < 0) ? M_SERIAL_OK_CONTINUE : M_SERIAL_OK_DONE;
-}
-
-/* Continue reading from the stream 'serial' the value separator
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the map continue,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_map_value(m_serial_local_t local, m_serial_read_t serial)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int final = -1;
-  int n = m_core_fscanf(f, " :%n", &final);
-  (void) n; // Unused. Parsing is checked through final (more robust)
-  return final > 0 ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
-}
-
-/* Continue reading from the stream 'serial' a map.
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the map continue,
-   M_SERIAL_OK_DONE if it succeeds and the map ends,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_map_next(m_serial_local_t local, m_serial_read_t serial)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  char c = 0;
-  int n = m_core_fscanf(f, " %c", m_core_arg_size(&c, 1) );
-  (void) n; // Unused. Parsing is checked through c (more robust)
-  return c == ',' ? M_SERIAL_OK_CONTINUE : c == '}' ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-/* Start reading a tuple from the stream 'serial'.
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the tuple continues,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_tuple_start(m_serial_local_t local, m_serial_read_t serial)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int final = -1;
-  int n = m_core_fscanf(f, " {%n", &final);
-  (void) n; // Unused. Parsing is checked through final (more robust)
-  return final > 0 ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
-}
-
-/* Continue reading a tuple from the stream 'serial'.
-   Set '*id' with the corresponding index of the table 'field_name[max]'
-   associated to the parsed field in the stream.
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the tuple continues,
-   Return M_SERIAL_OK_DONE if it succeeds and the tuple ends,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_tuple_id(m_serial_local_t local, m_serial_read_t serial, const char *const field_name [], const int max, int *id)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int c = m_core_fgetc_nospace(f);
-  if (c == EOF) return m_core_serial_fail();
-  if (c == '}') return M_SERIAL_OK_DONE;
-  if (c == ',') {
-     // If first call of read_tuple_id, it is a failure
-     if (*id == -1) return m_core_serial_fail();
-  } else {
-    // c should be \" but let fscanf parse it.
-    ungetc(c, f);
-  }
-  /* Read the field in the JSON */
-  c = -1;
-  char field[M_USE_IDENTIFIER_ALLOC+1];
-  int nn = m_core_fscanf(f, " \"%" M_AS_STR(M_USE_IDENTIFIER_ALLOC) "[^ \t\n\"]\":%n",
-                m_core_arg_size(field, M_USE_IDENTIFIER_ALLOC+1), &c);
-  (void) nn ; // Unused. Check is done through 'c' (more robust).
-  if (c <= 0)
-    return m_core_serial_fail();
-  /* Search for field in field_name */
-  for(int n = 0; n < max; n++) {
-    if (strcmp(field, field_name[n]) == 0) {
-      *id = n;
-      return M_SERIAL_OK_CONTINUE;
-    }
-  }
-  return m_core_serial_fail();
-}
-
-/* Start reading a variant from the stream 'serial'.
-   Set '*id' with the corresponding index of the table 'field_name[max]'
-   associated to the parsed field in the stream.
-   Return M_SERIAL_OK_CONTINUE if it succeeds and the variant continues,
-   Return M_SERIAL_OK_DONE if it succeeds and the variant ends(variant is empty),
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_variant_start(m_serial_local_t local, m_serial_read_t serial, const char *const field_name[], const int max, int*id)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-
-  int final1 = -1, final2 = -1;
-  // TODO: Accept 'null' as empty variant? 
-  int nn = m_core_fscanf(f, " {%n }%n", &final1, &final2);
-  (void) nn ; // Unused. Check is done through final (more robust).
-  // Test how much the parsing succeed.
-  if (final1 <= 0) return m_core_serial_fail();
-  if (final2 > 0)  return M_SERIAL_OK_DONE;
-
-  /* Read the field in the JSON */
-  char field[M_USE_IDENTIFIER_ALLOC+1];
-  nn = m_core_fscanf(f, " \"%" M_AS_STR(M_USE_IDENTIFIER_ALLOC) "[^ \t\n\"]\":%n", 
-                m_core_arg_size(field, M_USE_IDENTIFIER_ALLOC+1), &final2);
-  (void) nn ; // Unused. Check is done through final (more robust).
-  if (final2 <= 0) return m_core_serial_fail();
-
-  /* Linear Search for field in field_name */
-  for(int n = 0; n < max; n++) {
-    if (strcmp(field, field_name[n]) == 0) {
-      *id = n;
-      return M_SERIAL_OK_CONTINUE;
-    }
-  }
-  // Field not found
-  return m_core_serial_fail();
-}
-
-/* End reading a variant from the stream 'serial'.
-   Return M_SERIAL_OK_DONE if it succeeds and the variant ends,
-   M_SERIAL_FAIL otherwise */
-M_INLINE  m_serial_return_code_t
-m_ser1al_json_read_variant_end(m_serial_local_t local, m_serial_read_t serial)
-{
-  (void) local; // argument not used
-  FILE *f = (FILE*) serial->data[0].p;
-  int final = -1;
-  int n = m_core_fscanf(f, " }%n", &final);
-  (void) n ; // Unused. Check is done through final (more robust).
-  return final > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
-}
-
-static const m_serial_read_interface_t m_ser1al_json_read_interface = {
-  m_ser1al_json_read_boolean,
-  m_ser1al_json_read_integer,
-  m_ser1al_json_read_float,
-  m_ser1al_json_read_string,
-  m_ser1al_json_read_array_start,
-  m_ser1al_json_read_array_next,
-  m_ser1al_json_read_map_start,
-  m_ser1al_json_read_map_value,
-  m_ser1al_json_read_map_next,
-  m_ser1al_json_read_tuple_start,
-  m_ser1al_json_read_tuple_id,
-  m_ser1al_json_read_variant_start,
-  m_ser1al_json_read_variant_end
-};
-
-/* Initialize the JSON serial object for reading any object from JSON format in the given FILE */
-M_INLINE void m_serial_json_read_init(m_serial_read_t serial, FILE *f)
-{
-  serial->m_interface = &m_ser1al_json_read_interface;
-  serial->data[0].p = M_ASSIGN_CAST(void*, f);
-}
-
-/* Clear the JSON serial object for reading from the FILE */
-M_INLINE void m_serial_json_read_clear(m_serial_read_t serial)
-{
-  (void) serial; // Nothing to do
-}
-
-/* Define a synonym of m_serial_read_t 
-  to the JSON serializer with its proper OPLIST */
-typedef m_serial_read_t m_serial_json_read_t;
-#define M_OPL_m_serial_json_read_t()                                          \
-  (INIT_WITH(m_serial_json_read_init), CLEAR(m_serial_json_read_clear),       \
-  TYPE(m_serial_json_read_t) , PROPERTIES(( LET_AS_INIT_WITH(1) )) )
-
-
-
 /********************************************************************************/
 /************************** STRING / WRITE / JSON *******************************/
 /********************************************************************************/
@@ -601,18 +349,24 @@ M_P(m_serial_return_code_t, m_ser1al_str_json, _write_integer, m_serial_write_t
 {
   (void) size_of_type; // Ignored
   struct m_string_s *f = (struct m_string_s *)serial->data[0].p;
-  int n = m_string_cat_printf M_R(f, "%lld", data);
-  return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();  
+  m_string_cat_sj M_R(f, data);
+  return M_SERIAL_OK_DONE;
 }
 
 /* Write the float 'data' of 'size_of_type' bytes into the serial stream 'serial'.
    Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
 M_P(m_serial_return_code_t, m_ser1al_str_json, _write_float, m_serial_write_t serial, const long double data, const size_t size_of_type)
 {
-  (void) size_of_type; // Ignored
   struct m_string_s *f = (struct m_string_s *)serial->data[0].p;
-  int n = m_string_cat_printf M_R(f, "%Lf", data);
-  return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  if (size_of_type == sizeof (float)) {
+    m_string_cat_float M_R(f, (float) data);
+  } else if (size_of_type == sizeof (double)) {
+    m_string_cat_double M_R(f, (double) data);
+  } else {
+    int n = m_string_cat_printf M_R(f, "%Lf", data);
+    return n > 0 ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  }
+  return M_SERIAL_OK_DONE;
 }
 
 /* Write the null-terminated string 'data'into the serial stream 'serial'.
@@ -778,6 +532,42 @@ M_P(m_serial_return_code_t, m_ser1al_str_json, _write_variant_end, m_serial_loca
   return M_SERIAL_OK_CONTINUE;
 }
 
+/* Internal service:
+ * Append the element 'i' of 'size_of_type' bytes and of kind 'kind'
+ * of the contiguous array 'data' to the string 'f'.
+ * Return true if it succeeds, false otherwise.
+ */
+M_P(bool, m_ser1al_str_json, _cat_raw, struct m_string_s *f, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t i)
+{
+  if (kind != M_SERIAL_RAW_FLOAT) {
+    m_string_cat_sj M_R(f, m_core_serial_raw_integer(data, size_of_type, kind, i));
+  } else if (size_of_type == sizeof (float)) {
+    m_string_cat_float M_R(f, (float) m_core_serial_raw_float(data, size_of_type, i));
+  } else if (size_of_type == sizeof (double)) {
+    m_string_cat_double M_R(f, (double) m_core_serial_raw_float(data, size_of_type, i));
+  } else {
+    int n = m_string_cat_printf M_R(f, "%Lf", m_core_serial_raw_float(data, size_of_type, i));
+    return n > 0;
+  }
+  return true;
+}
+
+/* Write the 'number_of_elements' elements of 'size_of_type' bytes and of kind 'kind'
+   of the contiguous array 'data' into the serial stream 'serial' as a whole array.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_str_json, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  struct m_string_s *f = (struct m_string_s *)serial->data[0].p;
+  m_string_push_back M_R(f, '[');
+  for(size_t i = 0; i < number_of_elements; i++) {
+    if (i != 0) m_string_push_back M_R(f, ',');
+    if (!m_ser1al_str_json_cat_raw M_R(f, data, size_of_type, kind, i))
+      return m_core_serial_fail();
+  }
+  m_string_push_back M_R(f, ']');
+  return M_SERIAL_OK_DONE;
+}
+
 /* The internal exported interface of m_serial_write_json. */
 static const m_serial_write_interface_t m_ser1al_str_json_write_interface = {
   m_ser1al_str_json_write_boolean,
@@ -795,7 +585,8 @@ static const m_serial_write_interface_t m_ser1al_str_json_write_interface = {
   m_ser1al_str_json_write_tuple_id,
   m_ser1al_str_json_write_tuple_end,
   m_ser1al_str_json_write_variant_start,
-  m_ser1al_str_json_write_variant_end
+  m_ser1al_str_json_write_variant_end,
+  m_ser1al_str_json_write_raw_array
 };
 
 /* Initialize the JSON serial object for writing any object to JSON format in the given FILE */
@@ -819,6 +610,242 @@ typedef m_serial_write_t m_serial_str_json_write_t;
 
 
 
+/********************************************************************************/
+/*************************** SINK / WRITE / JSON ********************************/
+/********************************************************************************/
+
+/* The sink writer formats the JSON stream with the functions of the string writer
+   in a buffer which is given to a sink (a callback of the user)
+   each time it reaches a threshold, so that the memory used is bounded
+   whatever the size of the serialized object. */
+
+/* Segment of bytes given to a sink */
+typedef struct m_serial_json_iovec_s {
+  const char *ptr;              /* Bytes of the segment */
+  size_t      size;             /* Number of bytes of the segment */
+} m_serial_json_iovec_t;
+
+/* Sink of the sink writer: write the 'n' segments 'iov' (in this order)
+   using the user data 'data'. Return true if it succeeds, false otherwise */
+typedef bool (*m_serial_json_sink_ft)(void *data, const m_serial_json_iovec_t iov[], size_t n);
+
+/* State of the sink writer */
+typedef struct m_ser1al_json_sink_s {
+  m_string_t             buffer;     /* The JSON stream not given to the sink yet */
+  m_serial_json_sink_ft  sink;       /* The sink */
+  void                  *data;       /* The user data of the sink */
+  size_t                 threshold;  /* Size of the buffer which triggers a flush */
+  bool                   error;      /* The sink has failed */
+} m_ser1al_json_sink_t;
+
+/* Internal service:
+ * Give the buffer, followed by the 'size' bytes of 'ptr' (if size > 0),
+ * to the sink of the stream 'serial' and reset the buffer.
+ * Once the sink has failed, nothing is given to it anymore.
+ * Return true if it succeeds, false otherwise.
+ */
+M_INLINE bool
+m_ser1al_sink_json_flush(m_serial_write_t serial, const char *ptr, size_t size)
+{
+  m_ser1al_json_sink_t *s = (m_ser1al_json_sink_t *) serial->data[1].p;
+  m_serial_json_iovec_t iov[2];
+  size_t n = 0;
+  if (m_string_size(s->buffer) > 0) {
+    iov[n].ptr = m_string_get_cstr(s->buffer);
+    iov[n].size = m_string_size(s->buffer);
+    n++;
+  }
+  if (size > 0) {
+    iov[n].ptr = ptr;
+    iov[n].size = size;
+    n++;
+  }
+  if (n > 0 && M_LIKELY (!s->error)) {
+    s->error = !s->sink(s->data, iov, n);
+  }
+  m_string_reset(s->buffer);
+  return !s->error;
+}
+
+/* Internal service:
+ * Flush the buffer of the stream 'serial' if it has reached its threshold.
+ * Return 'ret' if it succeeds, M_SERIAL_FAIL if the sink has failed (now or before).
+ */
+M_INLINE m_serial_return_code_t
+m_ser1al_sink_json_check(m_serial_write_t serial, m_serial_return_code_t ret)
+{
+  m_ser1al_json_sink_t *s = (m_ser1al_json_sink_t *) serial->data[1].p;
+  if (M_UNLIKELY (m_string_size(s->buffer) >= s->threshold)) {
+    (void) m_ser1al_sink_json_flush(serial, NULL, 0);
+  }
+  return M_UNLIKELY (s->error) ? m_core_serial_fail() : ret;
+}
+
+/* The functions of the string writer which write the basic types
+   or which separate the elements of the containers are followed by a check
+   of the threshold. The ones which end a container also report the failure
+   of the sink. The other ones write a bounded number of characters. */
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_boolean, m_serial_write_t serial, const bool data)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_boolean M_R(serial, data));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_integer, m_serial_write_t serial, const long long data, const size_t size_of_type)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_integer M_R(serial, data, size_of_type));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_float, m_serial_write_t serial, const long double data, const size_t size_of_type)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_float M_R(serial, data, size_of_type));
+}
+
+/* Write the string 'data' into the serial stream 'serial'.
+   A string longer than the threshold which has no character to escape
+   is given to the sink with the buffer without being copied in the buffer.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_string, m_serial_write_t serial, const char data[], size_t length)
+{
+  m_ser1al_json_sink_t *s = (m_ser1al_json_sink_t *) serial->data[1].p;
+  if (length >= s->threshold) {
+    size_t i = 0;
+    while (i < length && isprint((unsigned char) data[i]) && data[i] != '"' && data[i] != '\\')
+      i++;
+    if (i == length) {
+      m_string_push_back M_R(s->buffer, '"');
+      bool b = m_ser1al_sink_json_flush(serial, data, length);
+      m_string_push_back M_R(s->buffer, '"');
+      return b ? M_SERIAL_OK_DONE : m_core_serial_fail();
+    }
+  }
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_string M_R(serial, data, length));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_array_next, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_array_next M_R(local, serial));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_array_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_array_end M_R(local, serial));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_map_next, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_map_next M_R(local, serial));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_map_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_map_end M_R(local, serial));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_tuple_id, m_serial_local_t local, m_serial_write_t serial, const char *const field_name[], const int max, const int index)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_tuple_id M_R(local, serial, field_name, max, index));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_tuple_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_tuple_end M_R(local, serial));
+}
+
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_variant_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_check(serial, m_ser1al_str_json_write_variant_end M_R(local, serial));
+}
+
+/* Write the contiguous array 'data' into the serial stream 'serial',
+   flushing the buffer between its elements if needed.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_sink_json, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  struct m_string_s *f = (struct m_string_s *)serial->data[0].p;
+  m_string_push_back M_R(f, '[');
+  for(size_t i = 0; i < number_of_elements; i++) {
+    if (i != 0) m_string_push_back M_R(f, ',');
+    if (!m_ser1al_str_json_cat_raw M_R(f, data, size_of_type, kind, i)
+        || m_ser1al_sink_json_check(serial, M_SERIAL_OK_DONE) != M_SERIAL_OK_DONE)
+      return m_core_serial_fail();
+  }
+  m_string_push_back M_R(f, ']');
+  return m_ser1al_sink_json_check(serial, M_SERIAL_OK_DONE);
+}
+
+/* The internal exported interface of the sink writer. */
+static const m_serial_write_interface_t m_ser1al_sink_json_write_interface = {
+  m_ser1al_sink_json_write_boolean,
+  m_ser1al_sink_json_write_integer,
+  m_ser1al_sink_json_write_float,
+  m_ser1al_sink_json_write_string,
+  m_ser1al_str_json_write_array_start,
+  m_ser1al_sink_json_write_array_next,
+  m_ser1al_sink_json_write_array_end,
+  m_ser1al_str_json_write_map_start,
+  m_ser1al_str_json_write_map_value,
+  m_ser1al_sink_json_write_map_next,
+  m_ser1al_sink_json_write_map_end,
+  m_ser1al_str_json_write_tuple_start,
+  m_ser1al_sink_json_write_tuple_id,
+  m_ser1al_sink_json_write_tuple_end,
+  m_ser1al_str_json_write_variant_start,
+  m_ser1al_sink_json_write_variant_end,
+  m_ser1al_sink_json_write_raw_array
+};
+
+/* Initialize the JSON serial object for writing any object to JSON format
+   into the sink 'sink' with the user data 'data'.
+   The JSON stream is given to the sink each time 'threshold' characters
+   have been formatted */
+M_INLINE void m_serial_json_sink_write_init(m_serial_write_t serial, m_serial_json_sink_ft sink, void *data, size_t threshold)
+{
+  M_GLOBAL_CONTEXT();
+  M_ASSERT (sink != NULL && threshold > 0);
+  m_ser1al_json_sink_t *s = M_MEMORY_ALLOC(m_context, m_ser1al_json_sink_t);
+  if (M_UNLIKELY_NOMEM (s == NULL)) {
+    M_MEMORY_FULL(m_ser1al_json_sink_t, 1);
+    return;
+  }
+  m_string_init(s->buffer);
+  m_string_reserve M_R(s->buffer, threshold + M_CORE_FMT_FLOAT_SIZE);
+  s->sink = sink;
+  s->data = data;
+  s->threshold = threshold;
+  s->error = false;
+  serial->m_interface = &m_ser1al_sink_json_write_interface;
+  serial->data[0].p = s->buffer;
+  serial->data[1].p = s;
+}
+
+/* Give the JSON stream not given yet to the sink of the JSON serial object.
+   Return M_SERIAL_OK_DONE if it succeeds,
+   M_SERIAL_FAIL if the sink has failed (now or before) */
+M_INLINE m_serial_return_code_t m_serial_json_sink_write_flush(m_serial_write_t serial)
+{
+  return m_ser1al_sink_json_flush(serial, NULL, 0) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Clear the JSON serial object for writing into a sink
+   (the JSON stream not given yet is given to the sink) */
+M_INLINE void m_serial_json_sink_write_clear(m_serial_write_t serial)
+{
+  M_GLOBAL_CONTEXT();
+  m_ser1al_json_sink_t *s = (m_ser1al_json_sink_t *) serial->data[1].p;
+  (void) m_ser1al_sink_json_flush(serial, NULL, 0);
+  m_string_clear M_R(s->buffer);
+  M_MEMORY_DEL(m_context, s);
+}
+
+/* Define a synonym to the JSON serializer with a proper OPLIST */
+typedef m_serial_write_t m_serial_json_sink_write_t;
+#define M_OPL_m_serial_json_sink_write_t()                                    \
+  (INIT_WITH(m_serial_json_sink_write_init), CLEAR(m_serial_json_sink_write_clear), \
+  TYPE(m_serial_json_sink_write_t) , PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+
+
 /********************************************************************************/
 /************************** STRING / READ  / JSON *******************************/
 /********************************************************************************/
@@ -841,17 +868,250 @@ m_ser1al_str_json_skip (const char **p)
   (*p)--;
 }
 
-/* Helper function to read a string with characters not present in reject */
+/* The JSON reader parses the stream from a block of memory:
+   - either the string given by the user,
+   - or a block read from the FILE given by the user, refilled when needed.
+   data[0].cstr is the current position in the (null terminated) block,
+   data[1].p is the block object of a FILE, or NULL for a string.
+   The same parsing functions are used for both kinds of stream. */
+
+/* Initial size of the block used to read a FILE.
+   Can be overloaded by user */
+#ifndef M_USE_SERIAL_JSON_BLOCK_SIZE
+#define M_USE_SERIAL_JSON_BLOCK_SIZE 65536
+#endif
+
+/* Minimum number of characters available after the skip of the spaces
+   (greater than any token of bounded size of the JSON stream) */
+#define M_SER1AL_JSON_LOOKAHEAD (M_USE_IDENTIFIER_ALLOC + 64)
+
+/* Block of a FILE being parsed */
+typedef struct m_ser1al_json_block_s {
+  FILE  *file;              /* FILE to read the block from */
+  size_t size;              /* Number of characters of the block */
+  size_t alloc;             /* Allocated size of the block */
+  bool   eof;               /* End of the FILE reached */
+  char  *ptr;               /* The block (null terminated) */
+} m_ser1al_json_block_t;
+
+/* Internal service:
+ * Refill the block of the stream 'serial' so that at least 'need'
+ * characters are available after the current position,
+ * except if the end of the FILE is reached.
+ * Nothing to do for a string stream (everything is available).
+ */
 M_INLINE void
-m_ser1al_str_json_gets(size_t alloc, char field[], const char reject[], const char **s)
+m_ser1al_json_refill(m_serial_read_t serial, size_t need)
+{
+  m_ser1al_json_block_t *b = (m_ser1al_json_block_t *) serial->data[1].p;
+  if (b == NULL) return;
+  M_ASSERT (serial->data[0].cstr >= b->ptr);
+  size_t pos = (size_t) (serial->data[0].cstr - b->ptr);
+  M_ASSERT (pos <= b->size);
+  if (b->size - pos >= need || b->eof) return;
+  // Move the characters not parsed yet at the beginning of the block
+  b->size -= pos;
+  memmove(b->ptr, b->ptr + pos, b->size);
+  serial->data[0].cstr = b->ptr;
+  if (M_UNLIKELY (need >= b->alloc)) {
+    M_GLOBAL_CONTEXT();
+    size_t alloc = M_MAX(2 * b->alloc, need + 1);
+    char *ptr = M_MEMORY_REALLOC(m_context, char, b->ptr, b->alloc, alloc);
+    if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+      M_MEMORY_FULL(char, alloc);
+      return;
+    }
+    b->ptr = ptr;
+    b->alloc = alloc;
+    serial->data[0].cstr = ptr;
+  }
+  // Fill the block (a FILE may return less characters than requested)
+  while (b->size < need) {
+    size_t n = fread(b->ptr + b->size, 1, b->alloc - 1 - b->size, b->file);
+    b->size += n;
+    if (n == 0) {
+      b->eof = true;
+      break;
+    }
+  }
+  b->ptr[b->size] = 0;
+}
+
+/* Internal service:
+ * Skip the spaces of the stream 'serial' and make sure that
+ * the next M_SER1AL_JSON_LOOKAHEAD characters are available.
+ * Return the reference to the current position of the stream.
+ */
+M_INLINE const char **
+m_ser1al_str_json_next(m_serial_read_t serial)
 {
-  M_ASSERT (alloc > 0);
-  size_t length = strcspn(*s, reject);
-  if (length >= alloc-1)
-    length = alloc - 1;
-  memcpy(field, *s, length);
-  field[length] = 0;
-  *s += length;
+  const char **f = &serial->data[0].cstr;
+  m_ser1al_json_refill(serial, M_SER1AL_JSON_LOOKAHEAD);
+  m_ser1al_str_json_skip(f);
+  while (M_UNLIKELY (**f == 0 && serial->data[1].p != NULL
+                     && !((m_ser1al_json_block_t *) serial->data[1].p)->eof)) {
+    // Only spaces in the block: continue skipping with the next block
+    m_ser1al_json_refill(serial, M_SER1AL_JSON_LOOKAHEAD);
+    m_ser1al_str_json_skip(f);
+  }
+  m_ser1al_json_refill(serial, M_SER1AL_JSON_LOOKAHEAD);
+  return f;
+}
+
+/* Internal service:
+ * Make sure that the whole token made of the characters of 'accept'
+ * at the current position of the stream 'serial' is available
+ * (a number can be longer than the look ahead).
+ */
+M_INLINE void
+m_ser1al_json_fill_token(m_serial_read_t serial, const char accept[])
+{
+  m_ser1al_json_block_t *b = (m_ser1al_json_block_t *) serial->data[1].p;
+  if (b == NULL) return;
+  size_t n = strspn(serial->data[0].cstr, accept);
+  while (serial->data[0].cstr[n] == 0 && !b->eof) {
+    m_ser1al_json_refill(serial, n + M_SER1AL_JSON_LOOKAHEAD);
+    n = strspn(serial->data[0].cstr, accept);
+  }
+}
+
+/* Internal service:
+ * Make sure that the whole quoted string at the current position
+ * of the stream 'serial' is available (a string has no length limit).
+ * The closing quote is searched with strcspn which is vectorized by the libc.
+ */
+M_INLINE void
+m_ser1al_json_fill_string(m_serial_read_t serial)
+{
+  m_ser1al_json_block_t *b = (m_ser1al_json_block_t *) serial->data[1].p;
+  if (b == NULL || *serial->data[0].cstr != '"') return;
+  size_t n = 1;
+  while (true) {
+    const char *p = serial->data[0].cstr;
+    n += strcspn(p + n, "\"\\");
+    if (p[n] == '"') return;
+    if (p[n] == '\\' && p[n+1] != 0) {
+      n += 2;
+      continue;
+    }
+    // End of the available characters reached within the string
+    if (b->eof) return;
+    m_ser1al_json_refill(serial, n + M_SER1AL_JSON_LOOKAHEAD);
+  }
+}
+
+/* Maximum nesting level of a value skipped by the JSON reader */
+#define M_SER1AL_JSON_SKIP_MAX_DEPTH 64
+
+/* Internal service:
+ * Return the position following the closing quote of the JSON string
+ * whose characters start at 'p' (escaped characters are skipped),
+ * or NULL if the string is not terminated.
+ */
+M_INLINE const char *
+m_ser1al_str_json_string_end(const char p[])
+{
+  while (true) {
+    p += strcspn(p, "\"\\");
+    if (*p == '"') return p + 1;
+    if (M_UNLIKELY (*p == 0 || p[1] == 0)) return NULL;
+    p += 2;
+  }
+}
+
+/* Internal service:
+ * Skip the JSON value at the current position of the stream 'serial'
+ * (a literal, a number, a string or a whole nested object / array)
+ * without materializing it and without any allocation.
+ * Only the nesting of the objects and arrays is checked.
+ * Return true if it succeeds, false otherwise.
+ */
+M_INLINE bool
+m_ser1al_str_json_skip_value(m_serial_read_t serial)
+{
+  // Bit 'n' is set if the container at depth 'n' is an array
+  uint64_t is_array = 0;
+  unsigned depth = 0;
+  do {
+    const char **f = m_ser1al_str_json_next(serial);
+    const char *p = *f;
+    char c = *p;
+    if (c == '"') {
+      m_ser1al_json_fill_string(serial);
+      p = m_ser1al_str_json_string_end(*f + 1);
+      if (M_UNLIKELY (p == NULL)) return false;
+      *f = p;
+    } else if (c == '{' || c == '[') {
+      if (M_UNLIKELY (depth >= M_SER1AL_JSON_SKIP_MAX_DEPTH)) return false;
+      is_array = (is_array & ~(UINT64_C(1) << depth))
+        | ((uint64_t) (c == '[') << depth);
+      depth++;
+      *f = p + 1;
+    } else if (c == '}' || c == ']') {
+      if (M_UNLIKELY (depth == 0)) return false;
+      depth--;
+      if (M_UNLIKELY (((is_array >> depth) & 1) != (c == ']'))) return false;
+      *f = p + 1;
+    } else if (c == ',' || c == ':') {
+      if (M_UNLIKELY (depth == 0)) return false;
+      *f = p + 1;
+    } else {
+      // Literal or number
+      const char accept[] = "+-.0123456789abcdefilnrstuEINAF";
+      m_ser1al_json_fill_token(serial, accept);
+      size_t n = strspn(*f, accept);
+      if (M_UNLIKELY (n == 0)) return false;
+      *f += n;
+    }
+  } while (depth > 0);
+  return true;
+}
+
+/* Internal service:
+ * Search the field 'name' of 'length' characters in the table 'field_name[max]'.
+ * The producer writes the fields usually in the order of the table,
+ * so the search starts from the field following the previous one 'prev'.
+ * Return the index of the field, or -1 if it is not found.
+ */
+M_INLINE int
+m_ser1al_str_json_find_field(const char name[], size_t length, const char *const field_name[], const int max, int prev)
+{
+  int n = (prev < 0 || prev + 1 >= max) ? 0 : prev + 1;
+  for(int i = 0; i < max; i++) {
+    if (strncmp(field_name[n], name, length) == 0 && field_name[n][length] == 0)
+      return n;
+    n = (n + 1 == max) ? 0 : n + 1;
+  }
+  return -1;
+}
+
+/* Internal service:
+ * Read from the stream 'serial' a field name followed by its separator
+ * and search it in the table 'field_name[max]' (see m_ser1al_str_json_find_field).
+ * The field name is parsed in place (no copy).
+ * Set '*id' with the index of the field, or -1 if it is unknown.
+ * Return true if it succeeds, false otherwise.
+ */
+M_INLINE bool
+m_ser1al_str_json_read_field(m_serial_read_t serial, const char *const field_name[], const int max, int prev, int *id)
+{
+  const char **f = m_ser1al_str_json_next(serial);
+  if (M_UNLIKELY (**f != '"')) return false;
+  m_ser1al_json_fill_string(serial);
+  const char *name = *f + 1;
+  size_t length = strcspn(name, "\"\\");
+  if (M_LIKELY (name[length] == '"')) {
+    *id = m_ser1al_str_json_find_field(name, length, field_name, max, prev);
+    *f = name + length + 1;
+  } else {
+    // The field names of the table have no escaped characters
+    const char *end = m_ser1al_str_json_string_end(name);
+    if (M_UNLIKELY (end == NULL)) return false;
+    *id = -1;
+    *f = end;
+  }
+  (void) m_ser1al_str_json_next(serial);
+  return m_ser1al_str_json_getc(f) == ':';
 }
 
 /* Read from the stream 'serial' a boolean.
@@ -859,8 +1119,7 @@ m_ser1al_str_json_gets(size_t alloc, char field[], const char reject[], const ch
    Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
 M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_boolean(m_serial_read_t serial, bool *b){
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   if (c == 't') {
     *b = true;
@@ -893,9 +1152,10 @@ m_ser1al_str_json_read_boolean(m_serial_read_t serial, bool *b){
 M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_integer(m_serial_read_t serial, long long *i, const size_t size_of_type){
   (void) size_of_type; // Ignored
-  const char **f = &serial->data[0].cstr;
+  const char **f = m_ser1al_str_json_next(serial);
+  m_ser1al_json_fill_token(serial, "+-0123456789");
   char *e;
-  *i = strtoll(*f, &e, 10);
+  *i = m_core_strtoll(*f, &e, 10);
   bool b = e != *f;
   serial->data[0].cstr = (const char*) e;
   return b ? M_SERIAL_OK_DONE : m_core_serial_fail();
@@ -906,10 +1166,16 @@ m_ser1al_str_json_read_integer(m_serial_read_t serial, long long *i, const size_
    Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
 M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_float(m_serial_read_t serial, long double *r, const size_t size_of_type){
-  (void) size_of_type; // Ignored
-  const char **f = &serial->data[0].cstr;
+  const char **f = m_ser1al_str_json_next(serial);
+  m_ser1al_json_fill_token(serial, "+-.0123456789abcdefinptxyABCDEFINPTXY");
   char *e;
-  *r = strtold(*f, &e);
+  if (size_of_type == sizeof (float)) {
+    *r = m_core_strtof(*f, &e);
+  } else if (size_of_type == sizeof (double)) {
+    *r = m_core_strtod(*f, &e);
+  } else {
+    *r = strtold(*f, &e);
+  }
   bool b = e != *f;
   serial->data[0].cstr = (const char*) e;
   return b ? M_SERIAL_OK_DONE : m_core_serial_fail();
@@ -920,8 +1186,8 @@ m_ser1al_str_json_read_float(m_serial_read_t serial, long double *r, const size_
    Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
 M_P(m_serial_return_code_t, m_ser1al_str_json, _read_string, m_serial_read_t serial, struct m_string_s *s)
 {
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
+  m_ser1al_json_fill_string(serial);
   const char *e;
   bool b = m_string_parse_str M_R(s, *f, &e);
   serial->data[0].cstr = e;
@@ -939,14 +1205,13 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_array_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   if (M_UNLIKELY(c != '[')) {
     return m_core_serial_fail();
   }
   *num = 0; // Don't know the size of the array.
-  m_ser1al_str_json_skip(f);
+  (void) m_ser1al_str_json_next(serial);
   if (M_UNLIKELY (**f == ']')) {
     c = m_ser1al_str_json_getc(f);
     assert( c == ']');
@@ -964,8 +1229,7 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_array_next(m_serial_local_t local, m_serial_read_t serial)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   return c == ',' ? M_SERIAL_OK_CONTINUE : c == ']' ? M_SERIAL_OK_DONE : m_core_serial_fail();
 }
@@ -981,14 +1245,13 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_map_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   if (M_UNLIKELY(c != '{')) {
     return m_core_serial_fail();
   }
   *num = 0; // Don't know the size of the map
-  m_ser1al_str_json_skip(f);
+  (void) m_ser1al_str_json_next(serial);
   if (M_UNLIKELY (**f == '}')) {
     c = m_ser1al_str_json_getc(f);
     assert(c == '}');
@@ -1005,8 +1268,7 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_map_value(m_serial_local_t local, m_serial_read_t serial)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   return c ==':' ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
 }
@@ -1019,8 +1281,7 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_map_next(m_serial_local_t local, m_serial_read_t serial)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
   return c == ',' ? M_SERIAL_OK_CONTINUE : c == '}' ? M_SERIAL_OK_DONE : m_core_serial_fail();
 }
@@ -1031,52 +1292,49 @@ m_ser1al_str_json_read_map_next(m_serial_local_t local, m_serial_read_t serial)
 M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_tuple_start(m_serial_local_t local, m_serial_read_t serial)
 {
-  (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   char c = m_ser1al_str_json_getc(f);
+  // No field read yet
+  local->data[0].b = true;
   return c == '{' ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
 }
 
 /* Continue reading a tuple from the stream 'serial'.
    Set '*id' with the corresponding index of the table 'field_name[max]'
    associated to the parsed field in the stream.
+   The fields of the stream which are not in the table are skipped.
    Return M_SERIAL_OK_CONTINUE if it succeeds and the tuple continues,
    Return M_SERIAL_OK_DONE if it succeeds and the tuple ends,
    M_SERIAL_FAIL otherwise */
 M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_tuple_id(m_serial_local_t local, m_serial_read_t serial, const char *const field_name [], const int max, int *id)
 {
-  (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
-  char c = m_ser1al_str_json_getc(f);
-  if (c == 0) return m_core_serial_fail();
-  if (c == '}') return M_SERIAL_OK_DONE;
-  if (c == ',') {
-    // If first call of read_tuple_id, it is a failure
-    if (M_UNLIKELY (*id == -1)) return m_core_serial_fail();
-    m_ser1al_str_json_skip(f);
-    c = m_ser1al_str_json_getc(f);
-  }
+  while (true) {
+    const char **f = m_ser1al_str_json_next(serial);
+    char c = **f;
+    if (c == '}') {
+      (void) m_ser1al_str_json_getc(f);
+      return M_SERIAL_OK_DONE;
+    }
+    if (c == ',') {
+      // If no field has been read yet, it is a failure
+      if (M_UNLIKELY (local->data[0].b)) return m_core_serial_fail();
+      (void) m_ser1al_str_json_getc(f);
+    }
+    local->data[0].b = false;
 
-  /* Read the field in the JSON */
-  char field[M_USE_IDENTIFIER_ALLOC+1];
-  if (M_UNLIKELY(c != '"')) return m_core_serial_fail();
-  m_ser1al_str_json_gets(M_USE_IDENTIFIER_ALLOC+1, field, " \t\n\"", f);
-  c = m_ser1al_str_json_getc(f);
-  if (M_UNLIKELY (c != '"')) return m_core_serial_fail();
-  c = m_ser1al_str_json_getc(f);
-  if (M_UNLIKELY (c != ':')) return m_core_serial_fail();
-
-  /* Search for field in field_name */
-  for(int n = 0; n < max; n++) {
-    if (strcmp(field, field_name[n]) == 0) {
+    /* Read the field in the JSON and search for it in field_name */
+    int n;
+    if (M_UNLIKELY (!m_ser1al_str_json_read_field(serial, field_name, max, *id, &n)))
+      return m_core_serial_fail();
+    if (M_LIKELY (n >= 0)) {
       *id = n;
       return M_SERIAL_OK_CONTINUE;
     }
+    // Unknown field: skip its value
+    if (M_UNLIKELY (!m_ser1al_str_json_skip_value(serial)))
+      return m_core_serial_fail();
   }
-  return m_core_serial_fail();
 }
 
 /* Start reading a variant from the stream 'serial'.
@@ -1089,34 +1347,25 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_variant_start(m_serial_local_t local, m_serial_read_t serial, const char *const field_name[], const int max, int*id)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   int c = m_ser1al_str_json_getc(f);
   if (M_UNLIKELY (c != '{'))
     // TODO: Accept 'null' as empty variant? 
     return m_core_serial_fail();
-  m_ser1al_str_json_skip(f);
-  c = m_ser1al_str_json_getc(f);
-  if (M_UNLIKELY (c == '}')) return M_SERIAL_OK_DONE; // Empty variant
-
-  /* Read the field in the JSON */
-  char field[M_USE_IDENTIFIER_ALLOC+1];
-  if (M_UNLIKELY(c != '"')) return m_core_serial_fail();
-  m_ser1al_str_json_gets(M_USE_IDENTIFIER_ALLOC+1, field, " \t\n\"", f);
-  c = m_ser1al_str_json_getc(f);
-  if (M_UNLIKELY (c != '"')) return m_core_serial_fail();
-  c = m_ser1al_str_json_getc(f);
-  if (M_UNLIKELY (c != ':')) return m_core_serial_fail();
-
-  /* Linear Search for field in field_name */
-  for(int n = 0; n < max; n++) {
-    if (strcmp(field, field_name[n]) == 0) {
-      *id = n;
-      return M_SERIAL_OK_CONTINUE;
-    }
+  (void) m_ser1al_str_json_next(serial);
+  if (M_UNLIKELY (**f == '}')) {
+    (void) m_ser1al_str_json_getc(f);
+    return M_SERIAL_OK_DONE; // Empty variant
   }
-  // Field not found
-  return m_core_serial_fail();
+
+  /* Read the field in the JSON and search for it in field_name */
+  int n;
+  if (M_UNLIKELY (!m_ser1al_str_json_read_field(serial, field_name, max, -1, &n)))
+    return m_core_serial_fail();
+  // Field not found: the variant cannot store it
+  if (M_UNLIKELY (n < 0)) return m_core_serial_fail();
+  *id = n;
+  return M_SERIAL_OK_CONTINUE;
 }
 
 /* End reading a variant from the stream 'serial'.
@@ -1126,8 +1375,7 @@ M_INLINE  m_serial_return_code_t
 m_ser1al_str_json_read_variant_end(m_serial_local_t local, m_serial_read_t serial)
 {
   (void) local; // argument not used
-  const char **f = &serial->data[0].cstr;
-  m_ser1al_str_json_skip(f);
+  const char **f = m_ser1al_str_json_next(serial);
   int c = m_ser1al_str_json_getc(f);
   return (M_UNLIKELY (c != '}')) ?  m_core_serial_fail() : M_SERIAL_OK_DONE;
 }
@@ -1145,7 +1393,8 @@ static const m_serial_read_interface_t m_ser1al_str_json_read_interface = {
   m_ser1al_str_json_read_tuple_start,
   m_ser1al_str_json_read_tuple_id,
   m_ser1al_str_json_read_variant_start,
-  m_ser1al_str_json_read_variant_end
+  m_ser1al_str_json_read_variant_end,
+  NULL /* No raw array: the number of elements is not known when reading */
 };
 
 /* Initialize the JSON serial object for reading any object from JSON format in the given const string */
@@ -1153,6 +1402,7 @@ M_INLINE void m_serial_str_json_read_init(m_serial_read_t serial, const char str
 {
   serial->m_interface = &m_ser1al_str_json_read_interface;
   serial->data[0].cstr = str;
+  serial->data[1].p = NULL;
 }
 
 /* Clear the JSON serial object for reading from the FILE */
@@ -1170,6 +1420,67 @@ typedef m_serial_read_t m_serial_str_json_read_t;
   TYPE(m_serial_str_json_read_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
 
 
+
+/********************************************************************************/
+/*************************** FILE / READ  / JSON ********************************/
+/********************************************************************************/
+
+/* The FILE reader parses the blocks read from the FILE
+   with the same functions than the string reader (no use of fscanf) */
+
+/* Initialize the JSON serial object for reading any object from JSON format in the given FILE.
+   The FILE is read by blocks: the characters read ahead of the parsed objects
+   are given back to the FILE by m_serial_json_read_clear if the FILE is seekable */
+M_INLINE void m_serial_json_read_init(m_serial_read_t serial, FILE *f)
+{
+  M_GLOBAL_CONTEXT();
+  M_ASSERT (f != NULL);
+  m_ser1al_json_block_t *b = M_MEMORY_ALLOC(m_context, m_ser1al_json_block_t);
+  if (M_UNLIKELY_NOMEM (b == NULL)) {
+    M_MEMORY_FULL(m_ser1al_json_block_t, 1);
+    return;
+  }
+  char *ptr = M_MEMORY_REALLOC(m_context, char, NULL, 0, M_USE_SERIAL_JSON_BLOCK_SIZE);
+  if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+    M_MEMORY_DEL(m_context, b);
+    M_MEMORY_FULL(char, M_USE_SERIAL_JSON_BLOCK_SIZE);
+    return;
+  }
+  ptr[0] = 0;
+  b->file = f;
+  b->size = 0;
+  b->alloc = M_USE_SERIAL_JSON_BLOCK_SIZE;
+  b->eof = false;
+  b->ptr = ptr;
+  serial->m_interface = &m_ser1al_str_json_read_interface;
+  serial->data[0].cstr = ptr;
+  serial->data[1].p = b;
+}
+
+/* Clear the JSON serial object for reading from the FILE */
+M_INLINE void m_serial_json_read_clear(m_serial_read_t serial)
+{
+  M_GLOBAL_CONTEXT();
+  m_ser1al_json_block_t *b = (m_ser1al_json_block_t *) serial->data[1].p;
+  M_ASSERT (b != NULL);
+  size_t ahead = b->size - (size_t) (serial->data[0].cstr - b->ptr);
+  if (ahead > 0) {
+    // Give back the characters read ahead to the FILE (if it is seekable)
+    int n = fseek(b->file, - (long) ahead, SEEK_CUR);
+    (void) n; // Nothing to do if it fails
+  }
+  M_MEMORY_FREE(m_context, char, b->ptr, b->alloc);
+  M_MEMORY_DEL(m_context, b);
+}
+
+/* Define a synonym of m_serial_read_t 
+  to the JSON serializer with its proper OPLIST */
+typedef m_serial_read_t m_serial_json_read_t;
+#define M_OPL_m_serial_json_read_t()                                          \
+  (INIT_WITH(m_serial_json_read_init), CLEAR(m_serial_json_read_clear),       \
+  TYPE(m_serial_json_read_t) , PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+
 M_END_PROTECTED_CODE
 
 #endif
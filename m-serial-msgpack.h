@@ -0,0 +1,896 @@
+/*
+ * M*LIB - Serial MessagePack
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_SERIAL_MSGPACK_H
+#define MSTARLIB_SERIAL_MSGPACK_H
+
+#include <stdint.h>
+
+#include "m-core.h"
+#include "m-string.h"
+#include "m-bstring.h"
+
+M_BEGIN_PROTECTED_CODE
+
+/* The MessagePack format (https://msgpack.org):
+   - integers and lengths are big endian and use the smallest encoding,
+   - floats are IEEE 754 big endian (float32 or float64),
+   - a tuple is a map of its field names to its field values,
+   - a variant is a map of one field name to its value, or nil if it is empty.
+   The FILE and the memory buffer targets use the same format and
+   share the same serializer: only the output (input) of the bytes differs. */
+
+/* Tags of the MessagePack format */
+#define M_SER1AL_MSGPACK_NIL      0xc0
+#define M_SER1AL_MSGPACK_FALSE    0xc2
+#define M_SER1AL_MSGPACK_TRUE     0xc3
+#define M_SER1AL_MSGPACK_FLOAT32  0xca
+#define M_SER1AL_MSGPACK_FLOAT64  0xcb
+#define M_SER1AL_MSGPACK_UINT8    0xcc
+#define M_SER1AL_MSGPACK_UINT16   0xcd
+#define M_SER1AL_MSGPACK_UINT32   0xce
+#define M_SER1AL_MSGPACK_UINT64   0xcf
+#define M_SER1AL_MSGPACK_INT8     0xd0
+#define M_SER1AL_MSGPACK_INT16    0xd1
+#define M_SER1AL_MSGPACK_INT32    0xd2
+#define M_SER1AL_MSGPACK_INT64    0xd3
+#define M_SER1AL_MSGPACK_STR8     0xd9
+#define M_SER1AL_MSGPACK_STR16    0xda
+#define M_SER1AL_MSGPACK_STR32    0xdb
+#define M_SER1AL_MSGPACK_ARRAY16  0xdc
+#define M_SER1AL_MSGPACK_ARRAY32  0xdd
+#define M_SER1AL_MSGPACK_MAP16    0xde
+#define M_SER1AL_MSGPACK_MAP32    0xdf
+#define M_SER1AL_MSGPACK_FIXMAP   0x80
+#define M_SER1AL_MSGPACK_FIXARRAY 0x90
+#define M_SER1AL_MSGPACK_FIXSTR   0xa0
+
+/* Maximum number of bytes of an encoded scalar (tag + 64 bits) */
+#define M_SER1AL_MSGPACK_MAX_LEN 9
+
+
+/********************************************************************************/
+/************************** ENCODING / DECODING  ********************************/
+/********************************************************************************/
+
+/* Internal service:
+ * Encode the 'len' bytes of 'value' in big endian in 'buf'
+ */
+M_INLINE void
+m_ser1al_msgpack_encode_be(unsigned char *buf, uint64_t value, unsigned len)
+{
+  for(unsigned i = 0; i < len; i++) {
+    buf[i] = (unsigned char) (value >> (8 * (len - 1 - i)));
+  }
+}
+
+/* Internal service:
+ * Decode the 'len' bytes of 'buf' in big endian
+ */
+M_INLINE uint64_t
+m_ser1al_msgpack_decode_be(const unsigned char *buf, unsigned len)
+{
+  uint64_t value = 0;
+  for(unsigned i = 0; i < len; i++) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+/* Internal service:
+ * Encode in 'buf' the integer 'data' with its smallest encoding
+ * and return the number of bytes used.
+ */
+M_INLINE size_t
+m_ser1al_msgpack_encode_integer(unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN], const long long data)
+{
+  unsigned len;
+  if (data >= 0) {
+    uint64_t u = (uint64_t) data;
+    if (M_LIKELY (u < 128)) {
+      buf[0] = (unsigned char) u; // positive fixint
+      return 1;
+    }
+    if (u <= UINT8_MAX)       { buf[0] = M_SER1AL_MSGPACK_UINT8;  len = 1; }
+    else if (u <= UINT16_MAX) { buf[0] = M_SER1AL_MSGPACK_UINT16; len = 2; }
+    else if (u <= UINT32_MAX) { buf[0] = M_SER1AL_MSGPACK_UINT32; len = 4; }
+    else                      { buf[0] = M_SER1AL_MSGPACK_UINT64; len = 8; }
+  } else {
+    if (data >= -32) {
+      buf[0] = (unsigned char) (data & 0xff); // negative fixint
+      return 1;
+    }
+    if (data >= INT8_MIN)       { buf[0] = M_SER1AL_MSGPACK_INT8;  len = 1; }
+    else if (data >= INT16_MIN) { buf[0] = M_SER1AL_MSGPACK_INT16; len = 2; }
+    else if (data >= INT32_MIN) { buf[0] = M_SER1AL_MSGPACK_INT32; len = 4; }
+    else                        { buf[0] = M_SER1AL_MSGPACK_INT64; len = 8; }
+  }
+  m_ser1al_msgpack_encode_be(&buf[1], (uint64_t) data, len);
+  return 1 + len;
+}
+
+/* Internal service:
+ * Encode in 'buf' the float 'data' of 'size_of_type' bytes
+ * (float32 for a float, float64 otherwise)
+ * and return the number of bytes used.
+ */
+M_INLINE size_t
+m_ser1al_msgpack_encode_float(unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN], const long double data, const size_t size_of_type)
+{
+  if (size_of_type == sizeof (float)) {
+    float f1 = (float) data;
+    uint32_t u32;
+    memcpy(&u32, &f1, sizeof u32);
+    buf[0] = M_SER1AL_MSGPACK_FLOAT32;
+    m_ser1al_msgpack_encode_be(&buf[1], u32, 4);
+    return 5;
+  } else {
+    // long double are reduced to double
+    double f2 = (double) data;
+    uint64_t u64;
+    memcpy(&u64, &f2, sizeof u64);
+    buf[0] = M_SER1AL_MSGPACK_FLOAT64;
+    m_ser1al_msgpack_encode_be(&buf[1], u64, 8);
+    return 9;
+  }
+}
+
+/* Internal service:
+ * Encode in 'buf' the header of a string, an array or a map of 'n' elements,
+ * given its fix tag, the maximum length of its fix form and its 8 bits tag
+ * (0 if none), and return the number of bytes used, or 0 if 'n' is too big.
+ */
+M_INLINE size_t
+m_ser1al_msgpack_encode_header(unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN], size_t n, unsigned fix, size_t fix_max, unsigned tag8)
+{
+  unsigned len;
+  if (n <= fix_max) {
+    buf[0] = (unsigned char) (fix | n);
+    return 1;
+  }
+  if (tag8 != 0 && n <= UINT8_MAX) {
+    buf[0] = (unsigned char) tag8; // Followed by the 16 and 32 bits tags
+    len = 1;
+  } else if (n <= UINT16_MAX) {
+    buf[0] = (unsigned char) (tag8 != 0 ? tag8 + 1 : (fix == M_SER1AL_MSGPACK_FIXARRAY ? M_SER1AL_MSGPACK_ARRAY16 : M_SER1AL_MSGPACK_MAP16));
+    len = 2;
+  } else if ((uint64_t) n <= UINT32_MAX) {
+    buf[0] = (unsigned char) (tag8 != 0 ? tag8 + 2 : (fix == M_SER1AL_MSGPACK_FIXARRAY ? M_SER1AL_MSGPACK_ARRAY32 : M_SER1AL_MSGPACK_MAP32));
+    len = 4;
+  } else {
+    return 0;
+  }
+  m_ser1al_msgpack_encode_be(&buf[1], n, len);
+  return 1 + len;
+}
+
+
+/********************************************************************************/
+/************************** FILE & BUFFER / WRITE  ******************************/
+/********************************************************************************/
+
+/* The writer state is:
+   - data[0].p : the FILE or the byte string,
+   - data[1].b : true if it writes into a byte string */
+
+/* Internal service:
+ * Write the 'n' bytes of 'buf' into the serial stream 'serial'.
+ * Return true if it succeeds.
+ */
+M_P(bool, m_ser1al_msgpack, _put, m_serial_write_t serial, const void *buf, size_t n)
+{
+  if (serial->data[1].b) {
+    struct m_bstring_s *b = (struct m_bstring_s *)serial->data[0].p;
+    m_bstring_push_back_bytes M_R(b, n, buf);
+    return true;
+  }
+  FILE *f = (FILE *)serial->data[0].p;
+  return fwrite(buf, 1, n, f) == n;
+}
+
+/* Internal service:
+ * Write the header of a string, an array or a map of 'n' elements
+ * into the serial stream 'serial'.
+ * Return true if it succeeds.
+ */
+M_P(bool, m_ser1al_msgpack, _put_header, m_serial_write_t serial, size_t n, unsigned fix, size_t fix_max, unsigned tag8)
+{
+  unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN];
+  size_t len = m_ser1al_msgpack_encode_header(buf, n, fix, fix_max, tag8);
+  return len != 0 && m_ser1al_msgpack_put M_R(serial, buf, len);
+}
+
+/* Write the boolean 'data' into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_boolean, m_serial_write_t serial, const bool data)
+{
+  unsigned char c = data ? M_SER1AL_MSGPACK_TRUE : M_SER1AL_MSGPACK_FALSE;
+  return m_ser1al_msgpack_put M_R(serial, &c, 1) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Write the integer 'data' of 'size_of_type' bytes into the serial stream 'serial'.
+   The integer is written with its smallest encoding, whatever its size.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_integer, m_serial_write_t serial,const long long data, const size_t size_of_type)
+{
+  (void) size_of_type; // Not needed: the encoding depends only on the value
+  unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN];
+  size_t n = m_ser1al_msgpack_encode_integer(buf, data);
+  return m_ser1al_msgpack_put M_R(serial, buf, n) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Write the float 'data' of 'size_of_type' bytes into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_float, m_serial_write_t serial, const long double data, const size_t size_of_type)
+{
+  unsigned char buf[M_SER1AL_MSGPACK_MAX_LEN];
+  size_t n = m_ser1al_msgpack_encode_float(buf, data, size_of_type);
+  return m_ser1al_msgpack_put M_R(serial, buf, n) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Write the null-terminated string 'data'into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_string, m_serial_write_t serial, const char data[], size_t length)
+{
+  M_ASSERT_SLOW(length == strlen(data) );
+  M_ASSERT(data != NULL);
+  if (!m_ser1al_msgpack_put_header M_R(serial, length, M_SER1AL_MSGPACK_FIXSTR, 31, M_SER1AL_MSGPACK_STR8))
+    return m_core_serial_fail();
+  return m_ser1al_msgpack_put M_R(serial, data, length) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Start writing an array of 'number_of_elements' objects into the serial stream 'serial'.
+   The number of elements shall be known.
+   Return M_SERIAL_OK_CONTINUE if it succeeds, M_SERIAL_FAIL_RETRY if the
+   number of elements is unknown, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_array_start, m_serial_local_t local, m_serial_write_t serial, const size_t number_of_elements)
+{
+  (void) local; //Unused
+  if (number_of_elements == (size_t)-1) return M_SERIAL_FAIL_RETRY;
+  return m_ser1al_msgpack_put_header M_R(serial, number_of_elements, M_SER1AL_MSGPACK_FIXARRAY, 15, 0) ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
+}
+
+/* Write an array separator between elements of an array into the serial stream 'serial' if needed.
+   Return M_SERIAL_OK_CONTINUE */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_array_next, m_serial_local_t local, m_serial_write_t serial)
+{
+  M_UNUSED_CONTEXT();
+  (void) local; // Unused
+  (void) serial; // Unused
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* End the writing of an array into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_array_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  M_UNUSED_CONTEXT();
+  (void) local; // Unused
+  (void) serial; // Unused
+  return M_SERIAL_OK_DONE;
+}
+
+/* Start writing a map of 'number_of_elements' pairs into the serial stream 'serial'.
+   Return M_SERIAL_OK_CONTINUE if it succeeds, M_SERIAL_FAIL_RETRY if the
+   number of elements is unknown, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_map_start, m_serial_local_t local, m_serial_write_t serial, const size_t number_of_elements)
+{
+  (void) local; //Unused
+  if (number_of_elements == (size_t)-1) return M_SERIAL_FAIL_RETRY;
+  return m_ser1al_msgpack_put_header M_R(serial, number_of_elements, M_SER1AL_MSGPACK_FIXMAP, 15, 0) ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
+}
+
+/* Write a value separator between element of the same pair of a map into the serial stream 'serial' if needed.
+   Return M_SERIAL_OK_CONTINUE */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_map_value, m_serial_local_t local, m_serial_write_t serial)
+{
+  M_UNUSED_CONTEXT();
+  (void) local; // argument not used
+  (void) serial;
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Start writing a tuple into the serial stream 'serial'.
+   The header of the map is written with the first field
+   (the number of fields is not known yet).
+   Return M_SERIAL_OK_CONTINUE */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_tuple_start, m_serial_local_t local, m_serial_write_t serial)
+{
+  M_UNUSED_CONTEXT();
+  (void) serial;
+  local->data[1].b = false;
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Start writing the field named field_name[index] of a tuple into the serial stream 'serial'.
+   Return M_SERIAL_OK_CONTINUE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_tuple_id, m_serial_local_t local, m_serial_write_t serial, const char *const field_name[], const int max, const int index)
+{
+  M_ASSERT (0 <= index && index < max);
+  if (!local->data[1].b) {
+    local->data[1].b = true;
+    if (!m_ser1al_msgpack_put_header M_R(serial, (size_t) max, M_SER1AL_MSGPACK_FIXMAP, 15, 0))
+      return m_core_serial_fail();
+  }
+  const char *name = field_name[index];
+  m_serial_return_code_t ret = m_ser1al_msgpack_write_string M_R(serial, name, strlen(name));
+  return ret == M_SERIAL_OK_DONE ? M_SERIAL_OK_CONTINUE : ret;
+}
+
+/* End the write of a tuple into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_tuple_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  if (!local->data[1].b) {
+    // Empty tuple
+    unsigned char c = M_SER1AL_MSGPACK_FIXMAP;
+    return m_ser1al_msgpack_put M_R(serial, &c, 1) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* Start writing a variant into the serial stream 'serial'.
+   If index <= 0, the variant is empty.
+     Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise
+   Otherwise, the field 'field_name[index]' will be filled.
+     Return M_SERIAL_OK_CONTINUE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_variant_start, m_serial_local_t local, m_serial_write_t serial, const char *const field_name[], const int max, const int index)
+{
+  (void) local; // argument not used
+  (void) max;
+  if (index < 0) {
+    unsigned char c = M_SER1AL_MSGPACK_NIL;
+    return m_ser1al_msgpack_put M_R(serial, &c, 1) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+  }
+  M_ASSERT (index < max);
+  unsigned char c = M_SER1AL_MSGPACK_FIXMAP | 1;
+  if (!m_ser1al_msgpack_put M_R(serial, &c, 1)) return m_core_serial_fail();
+  const char *name = field_name[index];
+  m_serial_return_code_t ret = m_ser1al_msgpack_write_string M_R(serial, name, strlen(name));
+  return ret == M_SERIAL_OK_DONE ? M_SERIAL_OK_CONTINUE : ret;
+}
+
+/* End Writing a variant into the serial stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_variant_end, m_serial_local_t local, m_serial_write_t serial)
+{
+  M_UNUSED_CONTEXT();
+  (void) local; // argument not used
+  (void) serial;
+  return M_SERIAL_OK_DONE;
+}
+
+/* Write the 'number_of_elements' elements of 'size_of_type' bytes
+   of the contiguous array 'data' into the serial stream 'serial' as a whole array.
+   The format is the same as writing each element separately,
+   but the elements are encoded by blocks before being written.
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _write_raw_array, m_serial_write_t serial, const void *data, const size_t size_of_type, const m_serial_raw_kind_t kind, const size_t number_of_elements)
+{
+  M_ASSERT (kind != M_SERIAL_RAW_NONE);
+  if (!m_ser1al_msgpack_put_header M_R(serial, number_of_elements, M_SER1AL_MSGPACK_FIXARRAY, 15, 0))
+    return m_core_serial_fail();
+  unsigned char buffer[64 * M_SER1AL_MSGPACK_MAX_LEN];
+  size_t n = 0;
+  for(size_t i = 0; i < number_of_elements; i++) {
+    if (kind == M_SERIAL_RAW_FLOAT) {
+      n += m_ser1al_msgpack_encode_float(&buffer[n], m_core_serial_raw_float(data, size_of_type, i), size_of_type);
+    } else {
+      n += m_ser1al_msgpack_encode_integer(&buffer[n], m_core_serial_raw_integer(data, size_of_type, kind, i));
+    }
+    if (n > sizeof buffer - M_SER1AL_MSGPACK_MAX_LEN) {
+      if (!m_ser1al_msgpack_put M_R(serial, buffer, n)) return m_core_serial_fail();
+      n = 0;
+    }
+  }
+  if (n > 0 && !m_ser1al_msgpack_put M_R(serial, buffer, n)) return m_core_serial_fail();
+  return M_SERIAL_OK_DONE;
+}
+
+/* The exported interface (shared by the FILE and the buffer serializers). */
+static const m_serial_write_interface_t m_ser1al_msgpack_write_interface = {
+  m_ser1al_msgpack_write_boolean,
+  m_ser1al_msgpack_write_integer,
+  m_ser1al_msgpack_write_float,
+  m_ser1al_msgpack_write_string,
+  m_ser1al_msgpack_write_array_start,
+  m_ser1al_msgpack_write_array_next,
+  m_ser1al_msgpack_write_array_end,
+  m_ser1al_msgpack_write_map_start,
+  m_ser1al_msgpack_write_map_value,
+  m_ser1al_msgpack_write_array_next,
+  m_ser1al_msgpack_write_array_end,
+  m_ser1al_msgpack_write_tuple_start,
+  m_ser1al_msgpack_write_tuple_id,
+  m_ser1al_msgpack_write_tuple_end,
+  m_ser1al_msgpack_write_variant_start,
+  m_ser1al_msgpack_write_variant_end,
+  m_ser1al_msgpack_write_raw_array
+};
+
+/* Initialize the MessagePack serial object for writing any object to the given FILE */
+M_INLINE void m_serial_msgpack_write_init(m_serial_write_t serial, FILE *f)
+{
+  M_ASSERT (f != NULL);
+  serial->m_interface = &m_ser1al_msgpack_write_interface;
+  serial->data[0].p = M_ASSIGN_CAST(void*, f);
+  serial->data[1].b = false;
+}
+
+M_INLINE void m_serial_msgpack_write_clear(m_serial_write_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_write_t to the MessagePack serializer with its proper OPLIST */
+typedef m_serial_write_t m_serial_msgpack_write_t;
+
+#define M_OPL_m_serial_msgpack_write_t()                                      \
+  (INIT_WITH(m_serial_msgpack_write_init), CLEAR(m_serial_msgpack_write_clear), \
+  TYPE(m_serial_msgpack_write_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+/* Initialize the MessagePack serial object for writing any object
+   at the end of the given byte string */
+M_INLINE void m_serial_msgpack_buffer_write_init(m_serial_write_t serial, m_bstring_t b)
+{
+  serial->m_interface = &m_ser1al_msgpack_write_interface;
+  serial->data[0].p = M_ASSIGN_CAST(struct m_bstring_s *, b);
+  serial->data[1].b = true;
+}
+
+M_INLINE void m_serial_msgpack_buffer_write_clear(m_serial_write_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_write_t to the MessagePack buffer serializer with its proper OPLIST */
+typedef m_serial_write_t m_serial_msgpack_buffer_write_t;
+
+#define M_OPL_m_serial_msgpack_buffer_write_t()                               \
+  (INIT_WITH(m_serial_msgpack_buffer_write_init), CLEAR(m_serial_msgpack_buffer_write_clear), \
+  TYPE(m_serial_msgpack_buffer_write_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+
+
+/********************************************************************************/
+/************************** FILE & BUFFER / READ  *******************************/
+/********************************************************************************/
+
+/* The reader state is:
+   - data[0].cstr : the buffer (NULL for a FILE),
+   - data[1].s : the size of the buffer,
+   - data[2].s : the number of bytes of the buffer read so far,
+   - data[3].p : the FILE (NULL for a buffer) */
+
+/* Internal service:
+ * Get the 'n' next bytes of the stream 'serial' and skip them.
+ * 'tmp' is a buffer of 'n' bytes used if the bytes are read from a FILE.
+ * Return NULL if there are not enough bytes left.
+ */
+M_INLINE const unsigned char *
+m_ser1al_msgpack_get(m_serial_read_t serial, unsigned char *tmp, size_t n)
+{
+  FILE *f = (FILE *) serial->data[3].p;
+  if (f != NULL) {
+    return fread(tmp, 1, n, f) == n ? tmp : NULL;
+  }
+  const unsigned char *p = (const unsigned char *) serial->data[0].cstr;
+  size_t size = serial->data[1].s;
+  size_t pos  = serial->data[2].s;
+  M_ASSERT (pos <= size);
+  if (M_UNLIKELY (n > size - pos)) {
+    return NULL;
+  }
+  serial->data[2].s = pos + n;
+  return &p[pos];
+}
+
+/* Internal service:
+ * Read the tag of the next value of the stream 'serial' into '*tag'.
+ * Return false if there is no byte left.
+ */
+M_INLINE bool
+m_ser1al_msgpack_read_tag(m_serial_read_t serial, unsigned *tag)
+{
+  unsigned char tmp[1];
+  const unsigned char *p = m_ser1al_msgpack_get(serial, tmp, 1);
+  if (M_UNLIKELY (p == NULL)) return false;
+  *tag = *p;
+  return true;
+}
+
+/* Internal service:
+ * Read the 'len' bytes big endian unsigned integer following a tag
+ * from the stream 'serial' into '*value'.
+ */
+M_INLINE bool
+m_ser1al_msgpack_read_be(m_serial_read_t serial, unsigned len, uint64_t *value)
+{
+  unsigned char tmp[8];
+  M_ASSERT (len <= 8);
+  const unsigned char *p = m_ser1al_msgpack_get(serial, tmp, len);
+  if (M_UNLIKELY (p == NULL)) return false;
+  *value = m_ser1al_msgpack_decode_be(p, len);
+  return true;
+}
+
+/* Internal service:
+ * Read the integer of tag 'tag' from the stream 'serial' into '*i'.
+ * An unsigned integer greater than LLONG_MAX is converted.
+ * Return false if 'tag' is not an integer or in case of failure.
+ */
+M_INLINE bool
+m_ser1al_msgpack_read_tagged_integer(m_serial_read_t serial, unsigned tag, long long *i)
+{
+  uint64_t u;
+  if (tag < 0x80) {
+    *i = (long long) tag;       // positive fixint
+    return true;
+  }
+  if (tag >= 0xe0) {
+    *i = (long long) tag - 256; // negative fixint
+    return true;
+  }
+  if (tag >= M_SER1AL_MSGPACK_UINT8 && tag <= M_SER1AL_MSGPACK_UINT64) {
+    unsigned len = 1U << (tag - M_SER1AL_MSGPACK_UINT8);
+    if (!m_ser1al_msgpack_read_be(serial, len, &u)) return false;
+    *i = (long long) u;
+    return true;
+  }
+  if (tag >= M_SER1AL_MSGPACK_INT8 && tag <= M_SER1AL_MSGPACK_INT64) {
+    unsigned len = 1U << (tag - M_SER1AL_MSGPACK_INT8);
+    if (!m_ser1al_msgpack_read_be(serial, len, &u)) return false;
+    // Sign extension
+    if (len < 8 && (u >> (8 * len - 1)) != 0) {
+      u |= ~((UINT64_C(1) << (8 * len)) - 1);
+    }
+    *i = (long long) u;
+    return true;
+  }
+  return false;
+}
+
+/* Internal service:
+ * Read the header of a string, an array or a map from the stream 'serial'
+ * given its fix tag, the maximum length of its fix form and its 8 bits tag
+ * (0 if none), and set '*num' with its number of elements.
+ * Return false if it is not such a value or in case of failure.
+ */
+M_INLINE bool
+m_ser1al_msgpack_read_header(m_serial_read_t serial, size_t *num, unsigned fix, unsigned fix_max, unsigned tag8)
+{
+  unsigned tag;
+  uint64_t n;
+  unsigned tag16;
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tag(serial, &tag))) return false;
+  if (tag >= fix && tag <= fix + fix_max) {
+    *num = tag - fix;
+    return true;
+  }
+  if (tag8 != 0) {
+    if (tag == tag8) {
+      if (!m_ser1al_msgpack_read_be(serial, 1, &n)) return false;
+      *num = (size_t) n;
+      return true;
+    }
+    tag16 = tag8 + 1;
+  } else {
+    tag16 = (fix == M_SER1AL_MSGPACK_FIXARRAY) ? M_SER1AL_MSGPACK_ARRAY16 : M_SER1AL_MSGPACK_MAP16;
+  }
+  if (tag == tag16 || tag == tag16 + 1) {
+    if (!m_ser1al_msgpack_read_be(serial, (tag == tag16) ? 2 : 4, &n)) return false;
+    if (M_UNLIKELY (n > SIZE_MAX)) return false;
+    *num = (size_t) n;
+    return true;
+  }
+  return false;
+}
+
+/* Internal service:
+ * Read a field name from the stream 'serial' and
+ * set '*id' with its index in the table 'field_name[max]'.
+ * Return false if it is not a known field or in case of failure.
+ */
+M_INLINE bool
+m_ser1al_msgpack_read_field(m_serial_read_t serial, const char *const field_name[], const int max, int *id)
+{
+  size_t length;
+  unsigned char tmp[M_USE_IDENTIFIER_ALLOC];
+  if (!m_ser1al_msgpack_read_header(serial, &length, M_SER1AL_MSGPACK_FIXSTR, 31, M_SER1AL_MSGPACK_STR8))
+    return false;
+  if (M_UNLIKELY (length >= M_USE_IDENTIFIER_ALLOC)) return false;
+  const unsigned char *p = m_ser1al_msgpack_get(serial, tmp, length);
+  if (M_UNLIKELY (p == NULL)) return false;
+  for(int n = 0; n < max; n++) {
+    if (strlen(field_name[n]) == length && memcmp(field_name[n], p, length) == 0) {
+      *id = n;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Read from the stream 'serial' a boolean.
+   Set '*b' with the boolean value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_boolean(m_serial_read_t serial, bool *b){
+  unsigned tag;
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tag(serial, &tag))) return m_core_serial_fail();
+  if (tag != M_SER1AL_MSGPACK_TRUE && tag != M_SER1AL_MSGPACK_FALSE) return m_core_serial_fail();
+  *b = (tag == M_SER1AL_MSGPACK_TRUE);
+  return M_SERIAL_OK_DONE;
+}
+
+/* Read from the stream 'serial' an integer that can be represented with 'size_of_type' bytes.
+   Any encoding of the integer is accepted as long as it fits in 'size_of_type' bytes
+   (as a signed or as an unsigned integer).
+   Set '*i' with the integer value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_integer(m_serial_read_t serial, long long *i, const size_t size_of_type){
+  unsigned tag;
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tag(serial, &tag))) return m_core_serial_fail();
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tagged_integer(serial, tag, i))) return m_core_serial_fail();
+  if (size_of_type < 8) {
+    const long long limit = 1LL << (8 * size_of_type);
+    if (M_UNLIKELY (*i < -limit / 2 || *i >= limit)) return m_core_serial_fail();
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* Read from the stream 'serial' a float that can be represented with 'size_of_type' bytes.
+   An integer is also accepted.
+   Set '*r' with the boolean value if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_float(m_serial_read_t serial, long double *r, const size_t size_of_type){
+  (void) size_of_type; // Not needed: the encoding gives the size
+  unsigned tag;
+  uint64_t u;
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tag(serial, &tag))) return m_core_serial_fail();
+  if (tag == M_SER1AL_MSGPACK_FLOAT32) {
+    if (!m_ser1al_msgpack_read_be(serial, 4, &u)) return m_core_serial_fail();
+    uint32_t u32 = (uint32_t) u;
+    float f1;
+    memcpy(&f1, &u32, sizeof f1);
+    *r = f1;
+  } else if (tag == M_SER1AL_MSGPACK_FLOAT64) {
+    if (!m_ser1al_msgpack_read_be(serial, 8, &u)) return m_core_serial_fail();
+    double f2;
+    memcpy(&f2, &u, sizeof f2);
+    *r = f2;
+  } else {
+    long long i;
+    if (!m_ser1al_msgpack_read_tagged_integer(serial, tag, &i)) return m_core_serial_fail();
+    *r = (long double) i;
+  }
+  return M_SERIAL_OK_DONE;
+}
+
+/* Read from the stream 'serial' a string.
+   Set 's' with the string if succeeds
+   Return M_SERIAL_OK_DONE if it succeeds, M_SERIAL_FAIL otherwise */
+M_P(m_serial_return_code_t, m_ser1al_msgpack, _read_string, m_serial_read_t serial, struct m_string_s *s)
+{
+  M_ASSERT(s != NULL);
+  size_t length;
+  if (!m_ser1al_msgpack_read_header(serial, &length, M_SER1AL_MSGPACK_FIXSTR, 31, M_SER1AL_MSGPACK_STR8))
+    return m_core_serial_fail();
+  FILE *f = (FILE *) serial->data[3].p;
+  if (f == NULL) {
+    // Get the characters in place (the size is checked before any allocation)
+    const unsigned char *p = m_ser1al_msgpack_get(serial, NULL, length);
+    if (M_UNLIKELY (p == NULL)) return m_core_serial_fail();
+    m_string_set_cstrn M_R(s, (const char *) p, length);
+    return M_SERIAL_OK_DONE;
+  }
+  // Use of internal string interface to dimension the string
+  char *p = m_str1ng_fit2size M_R(s, length + 1);
+  m_str1ng_set_size(s, length);
+  // NOTE: fread supports length == 0.
+  size_t n = fread(M_ASSIGN_CAST(void*, p), 1, length, f);
+  // Force the final null character
+  p[length] = 0;
+  return (n == length) ? M_SERIAL_OK_DONE : m_core_serial_fail();
+}
+
+/* Start reading from the stream 'serial' an array.
+   Set '*num' with the number of elements.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the array continue,
+   M_SERIAL_OK_DONE if it succeeds and the array ends (the array is empty),
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_array_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
+{
+  if (!m_ser1al_msgpack_read_header(serial, num, M_SER1AL_MSGPACK_FIXARRAY, 15, 0))
+    return m_core_serial_fail();
+  local->data[1].s = *num;
+  return (*num == 0) ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Continue reading from the stream 'serial' an array.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the array continue,
+   M_SERIAL_OK_DONE if it succeeds and the array ends */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_array_next(m_serial_local_t local, m_serial_read_t serial)
+{
+  (void) serial; // Unused
+  M_ASSERT(local->data[1].s > 0);
+  local->data[1].s --;
+  return local->data[1].s == 0 ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Start reading from the stream 'serial' a map.
+   Set '*num' with the number of pairs.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the map continue,
+   M_SERIAL_OK_DONE if it succeeds and the map ends (the map is empty),
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_map_start(m_serial_local_t local, m_serial_read_t serial, size_t *num)
+{
+  if (!m_ser1al_msgpack_read_header(serial, num, M_SER1AL_MSGPACK_FIXMAP, 15, 0))
+    return m_core_serial_fail();
+  local->data[1].s = *num;
+  return (*num == 0) ? M_SERIAL_OK_DONE : M_SERIAL_OK_CONTINUE;
+}
+
+/* Continue reading from the stream 'serial' the value separator
+   Return M_SERIAL_OK_CONTINUE */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_map_value(m_serial_local_t local, m_serial_read_t serial)
+{
+  (void) local; // argument not used
+  (void) serial;
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Start reading a tuple from the stream 'serial'.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the tuple continues,
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_tuple_start(m_serial_local_t local, m_serial_read_t serial)
+{
+  size_t num;
+  if (!m_ser1al_msgpack_read_header(serial, &num, M_SER1AL_MSGPACK_FIXMAP, 15, 0))
+    return m_core_serial_fail();
+  local->data[1].s = num;
+  return M_SERIAL_OK_CONTINUE;
+}
+
+/* Continue reading a tuple from the stream 'serial'.
+   Set '*id' with the corresponding index of the table 'field_name[max]'
+   associated to the parsed field in the stream (in any order).
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the tuple continues,
+   Return M_SERIAL_OK_DONE if it succeeds and the tuple ends,
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_tuple_id(m_serial_local_t local, m_serial_read_t serial, const char *const field_name [], const int max, int *id)
+{
+  if (local->data[1].s == 0) return M_SERIAL_OK_DONE;
+  local->data[1].s --;
+  return m_ser1al_msgpack_read_field(serial, field_name, max, id) ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
+}
+
+/* Start reading a variant from the stream 'serial'.
+   Set '*id' with the corresponding index of the table 'field_name[max]'
+   associated to the parsed field in the stream.
+   Return M_SERIAL_OK_CONTINUE if it succeeds and the variant continues,
+   Return M_SERIAL_OK_DONE if it succeeds and the variant ends(variant is empty),
+   M_SERIAL_FAIL otherwise */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_variant_start(m_serial_local_t local, m_serial_read_t serial, const char *const field_name[], const int max, int*id)
+{
+  (void) local; // argument not used
+  unsigned tag;
+  if (M_UNLIKELY (!m_ser1al_msgpack_read_tag(serial, &tag))) return m_core_serial_fail();
+  if (tag == M_SER1AL_MSGPACK_NIL) return M_SERIAL_OK_DONE;
+  if (tag != (M_SER1AL_MSGPACK_FIXMAP | 1)) return m_core_serial_fail();
+  return m_ser1al_msgpack_read_field(serial, field_name, max, id) ? M_SERIAL_OK_CONTINUE : m_core_serial_fail();
+}
+
+/* End reading a variant from the stream 'serial'.
+   Return M_SERIAL_OK_DONE */
+M_INLINE  m_serial_return_code_t
+m_ser1al_msgpack_read_variant_end(m_serial_local_t local, m_serial_read_t serial)
+{
+  (void) local; // argument not used
+  (void) serial;
+  return M_SERIAL_OK_DONE;
+}
+
+/* The exported interface (shared by the FILE and the buffer serializers).
+   No fast path for reading raw arrays: each element has its own encoding */
+static const m_serial_read_interface_t m_ser1al_msgpack_read_interface = {
+  m_ser1al_msgpack_read_boolean,
+  m_ser1al_msgpack_read_integer,
+  m_ser1al_msgpack_read_float,
+  m_ser1al_msgpack_read_string,
+  m_ser1al_msgpack_read_array_start,
+  m_ser1al_msgpack_read_array_next,
+  m_ser1al_msgpack_read_map_start,
+  m_ser1al_msgpack_read_map_value,
+  m_ser1al_msgpack_read_array_next,
+  m_ser1al_msgpack_read_tuple_start,
+  m_ser1al_msgpack_read_tuple_id,
+  m_ser1al_msgpack_read_variant_start,
+  m_ser1al_msgpack_read_variant_end,
+  NULL
+};
+
+/* Initialize the MessagePack serial object for reading any object from the given FILE */
+M_INLINE void m_serial_msgpack_read_init(m_serial_read_t serial, FILE *f)
+{
+  M_ASSERT (f != NULL);
+  serial->m_interface = &m_ser1al_msgpack_read_interface;
+  serial->data[0].cstr = NULL;
+  serial->data[1].s = 0;
+  serial->data[2].s = 0;
+  serial->data[3].p = M_ASSIGN_CAST(void*, f);
+}
+
+M_INLINE void m_serial_msgpack_read_clear(m_serial_read_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_read_t to the MessagePack serializer with its proper OPLIST */
+typedef m_serial_read_t m_serial_msgpack_read_t;
+#define M_OPL_m_serial_msgpack_read_t()                                       \
+  (INIT_WITH(m_serial_msgpack_read_init), CLEAR(m_serial_msgpack_read_clear), \
+   TYPE(m_serial_msgpack_read_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+/* Initialize the MessagePack serial object for reading any object
+   from the 'size' bytes of the buffer 'buffer'.
+   The buffer shall remain valid and unmodified while the serial object is used. */
+M_INLINE void m_serial_msgpack_buffer_read_init(m_serial_read_t serial, const void *buffer, size_t size)
+{
+  M_ASSERT (buffer != NULL || size == 0);
+  serial->m_interface = &m_ser1al_msgpack_read_interface;
+  serial->data[0].cstr = (const char *) buffer;
+  serial->data[1].s = size;
+  serial->data[2].s = 0;
+  serial->data[3].p = NULL;
+}
+
+/* Return the number of bytes read from the buffer so far */
+M_INLINE size_t m_serial_msgpack_buffer_read_pos(const m_serial_read_t serial)
+{
+  return serial->data[2].s;
+}
+
+M_INLINE void m_serial_msgpack_buffer_read_clear(m_serial_read_t serial)
+{
+  (void) serial; // Nothing to do
+}
+
+/* Define a synonym of m_serial_read_t to the MessagePack buffer serializer with its proper OPLIST */
+typedef m_serial_read_t m_serial_msgpack_buffer_read_t;
+#define M_OPL_m_serial_msgpack_buffer_read_t()                                \
+  (INIT_WITH(m_serial_msgpack_buffer_read_init), CLEAR(m_serial_msgpack_buffer_read_clear), \
+   TYPE(m_serial_msgpack_buffer_read_t), PROPERTIES(( LET_AS_INIT_WITH(1) )) )
+
+M_END_PROTECTED_CODE
+
+#endif
@@ -0,0 +1,531 @@
+/*
+ * M*LIB - Parallel serialization
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_SERIAL_PAR_H
+#define MSTARLIB_SERIAL_PAR_H
+
+#include <stdint.h>
+
+#include "m-core.h"
+#include "m-string.h"
+#include "m-bstring.h"
+#include "m-worker.h"
+#include "m-serial-bin.h"
+#include "m-serial-json.h"
+
+/* Define the parallel serialization functions named 'name'
+   of the container which oplist is 'cont_oplist'.
+   USAGE:
+   SERIAL_PAR_DEF(name, containerOplist|type if oplist has been registered) */
+#define M_SERIAL_PAR_DEF(name, cont_oplist)                                   \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_SER1AL_PAR_DEF_P1(name, M_GLOBAL_OPLIST(cont_oplist))                     \
+  M_END_PROTECTED_CODE
+
+
+/*****************************************************************************/
+/******************************** INTERNAL ***********************************/
+/*****************************************************************************/
+
+M_BEGIN_PROTECTED_CODE
+
+/* Number of chunks per worker:
+   having more chunks than workers balances the load between them */
+#ifndef M_USE_SERIAL_PAR_CHUNK_PER_WORKER
+#define M_USE_SERIAL_PAR_CHUNK_PER_WORKER 4
+#endif
+
+/* Minimum number of elements of a chunk */
+#ifndef M_USE_SERIAL_PAR_MIN_CHUNK
+#define M_USE_SERIAL_PAR_MIN_CHUNK 256
+#endif
+
+/* The binary record of a container is its BIN serialization
+   followed by an index footer:
+   - for each chunk, the offset of its first byte in the record and its number of elements,
+   - the number of chunks, the size of the BIN serialization and a magic number.
+   All fields of the footer are 64 bits unsigned integers in the native endianness,
+   like the BIN format */
+#define M_SER1AL_PAR_MAGIC "M*LIBPAR"
+#define M_SER1AL_PAR_ENTRY_SIZE   16
+#define M_SER1AL_PAR_TRAILER_SIZE 24
+
+/* Return the number of chunks to use to serialize 'n' elements
+   with the pool of workers 'workers' */
+M_INLINE size_t
+m_ser1al_par_chunk_count(size_t n, m_worker_t workers)
+{
+  (void) workers; // Not used if there is no worker
+  const size_t max = n / M_USE_SERIAL_PAR_MIN_CHUNK + 1;
+  const size_t chunk = (size_t) m_worker_count(workers) * M_USE_SERIAL_PAR_CHUNK_PER_WORKER;
+  return M_MIN(chunk, max);
+}
+
+/* Append the 64 bits integer 'x' to the byte string 'out' */
+M_INLINE void
+m_ser1al_par_push_u64(m_bstring_t out, uint64_t x)
+{
+  M_GLOBAL_CONTEXT();
+  m_bstring_push_back_bytes M_R(out, sizeof x, &x);
+}
+
+/* Read the 64 bits integer at 'p' */
+M_INLINE uint64_t
+m_ser1al_par_get_u64(const char *p)
+{
+  uint64_t x;
+  memcpy(&x, p, sizeof x);
+  return x;
+}
+
+/* Read the entry 'k' of the index footer 'entry':
+   set '*offset' to the offset of the chunk, and return its number of elements */
+M_INLINE size_t
+m_ser1al_par_entry(const char *entry, size_t k, size_t *offset)
+{
+  *offset = (size_t) m_ser1al_par_get_u64(entry + k * M_SER1AL_PAR_ENTRY_SIZE);
+  return (size_t) m_ser1al_par_get_u64(entry + k * M_SER1AL_PAR_ENTRY_SIZE + 8);
+}
+
+/* Parse the binary record 'buffer' of 'size' bytes:
+   set '*nchunk' to its number of chunks, '*data_size' to the size of the
+   BIN serialization, '*count' to the number of elements of the container
+   (serialized as a map if 'map' is true, as an array otherwise)
+   and return the first entry of the index footer.
+   Return NULL if the record is invalid */
+M_INLINE const char *
+m_ser1al_par_parse(const void *buffer, size_t size, bool map, size_t *nchunk, size_t *data_size, size_t *count)
+{
+  if (M_UNLIKELY (buffer == NULL || size < M_SER1AL_PAR_TRAILER_SIZE)) return NULL;
+  const char *trailer = (const char *) buffer + size - M_SER1AL_PAR_TRAILER_SIZE;
+  if (memcmp(trailer + 16, M_SER1AL_PAR_MAGIC, 8) != 0) return NULL;
+  const size_t avail = size - M_SER1AL_PAR_TRAILER_SIZE;
+  const uint64_t n = m_ser1al_par_get_u64(trailer);
+  const uint64_t d = m_ser1al_par_get_u64(trailer + 8);
+  if (M_UNLIKELY (n == 0 || n > avail / M_SER1AL_PAR_ENTRY_SIZE
+                  || d != avail - n * M_SER1AL_PAR_ENTRY_SIZE))
+    return NULL;
+  *nchunk = (size_t) n;
+  *data_size = (size_t) d;
+  const char *entry = (const char *) buffer + *data_size;
+
+  // Read the header of the container
+  m_serial_read_t f;
+  m_serial_local_t local;
+  m_serial_bin_buffer_read_init(f, buffer, *data_size);
+  m_serial_return_code_t ret = map
+    ? f->m_interface->read_map_start(local, f, count)
+    : f->m_interface->read_array_start(local, f, count);
+  size_t offset = m_serial_bin_buffer_read_pos(f);
+  m_serial_bin_buffer_read_clear(f);
+  if (ret == M_SERIAL_FAIL || *count == (size_t) -1) return NULL;
+  // Each element is serialized in at least one byte:
+  // reject a corrupted count before creating the elements
+  if (M_UNLIKELY (*count > *data_size - offset)) return NULL;
+
+  // The chunks shall be contiguous and cover all the elements
+  size_t total = 0;
+  for(size_t k = 0; k < *nchunk; k++) {
+    size_t o;
+    size_t c = m_ser1al_par_entry(entry, k, &o);
+    if (M_UNLIKELY (o != offset && (k == 0 || o < offset))) return NULL;
+    if (M_UNLIKELY (o > *data_size || c > *count - total)) return NULL;
+    offset = o;
+    total += c;
+  }
+  return total == *count ? entry : NULL;
+}
+
+/* Define the parallel serialization functions */
+#define M_SER1AL_PAR_DEF_P1(name, cont_oplist)                                \
+  M_IF_OPLIST(cont_oplist)(M_SER1AL_PAR_DEF_P2, M_SER1AL_PAR_DEF_FAILURE)(name, cont_oplist)
+
+/* Stop processing with a compilation failure */
+#define M_SER1AL_PAR_DEF_FAILURE(name, cont_oplist)                           \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(SERIAL_PAR_DEF): the given argument is not a valid oplist: " M_AS_STR(cont_oplist))
+
+/* A container exporting the oplist of its elements is serialized as an array of its elements.
+   Otherwise it is serialized as a map of its keys to its values
+   (the elements are pairs of a 'key' and a 'value' field) */
+#define M_SER1AL_PAR_DEF_P2(name, cont_oplist)                                \
+  M_IF(M_TEST_METHOD_ALTER_P(OPLIST, cont_oplist))                            \
+  (M_SER1AL_PAR_DEF_P3(name, 0, cont_oplist, M_GET_TYPE cont_oplist, M_GET_IT_TYPE cont_oplist, \
+                       M_GET_SUBTYPE cont_oplist, M_GET_OPLIST cont_oplist,   \
+                       M_GET_SUBTYPE cont_oplist, M_EMPTY_OPLIST),            \
+   M_SER1AL_PAR_DEF_P3(name, 1, cont_oplist, M_GET_TYPE cont_oplist, M_GET_IT_TYPE cont_oplist, \
+                       M_GET_KEY_TYPE cont_oplist, M_GET_KEY_OPLIST cont_oplist, \
+                       M_GET_VALUE_TYPE cont_oplist, M_GET_VALUE_OPLIST cont_oplist))
+
+/* Test if the elements can be read in place:
+   the container is an array that can be resized to the number of elements */
+#define M_SER1AL_PAR_INDEX_P(isMap, cont_oplist)                              \
+  M_AND(M_INV(isMap), M_AND(M_TEST_METHOD_P(IT_REF, cont_oplist), M_TEST_METHOD_P(SAFE_GET_KEY, cont_oplist)))
+
+/* Test if the elements can be inserted one by one in the container */
+#define M_SER1AL_PAR_INSERT_P(isMap, cont_oplist)                             \
+  M_IF(isMap)(M_TEST_METHOD_P(SET_KEY, cont_oplist), M_TEST_METHOD_P(PUSH, cont_oplist))
+
+/* Define the functions.
+   If the container is not a map, the element is the key, and the value is not used */
+#define M_SER1AL_PAR_DEF_P3(name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist) \
+                                                                              \
+  /* Define a work order: a chunk of consecutive elements of the container */ \
+  typedef struct M_C3(m_ser1al_par_,name,_task_s) {                           \
+    it_t it;                    /* First element of the chunk */              \
+    size_t first;               /* Index of the first element of the chunk */ \
+    size_t count;               /* Number of elements of the chunk */         \
+    m_bstring_t bin;            /* Output of the chunk (BIN format) */        \
+    m_string_t json;            /* Output of the chunk (JSON format) */       \
+    bool json_p;                /* Is the output in JSON format? */           \
+    const char *buffer;         /* Input of the chunk (BIN format) */         \
+    size_t size;                /* Size of the input of the chunk */          \
+    key_type *key;              /* Parsed keys of the chunk */                \
+    value_type *value;          /* Parsed values of the chunk */              \
+    m_serial_return_code_t ret; /* Result of the work order */                \
+  } M_C3(m_ser1al_par_,name,_task_ct);                                        \
+                                                                              \
+  M_IF_METHOD_BOTH(OUT_SERIAL, key_oplist, value_oplist)                      \
+  (M_SER1AL_PAR_DEF_OUT, M_EAT)                                               \
+  (name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist) \
+                                                                              \
+  M_IF(M_AND(M_TEST_METHOD_P(RESET, cont_oplist),                             \
+             M_AND(M_AND(M_TEST_METHOD_P(IN_SERIAL, key_oplist), M_TEST_METHOD_P(IN_SERIAL, value_oplist)), \
+                   M_AND(M_TEST_METHOD_P(INIT, key_oplist), M_TEST_METHOD_P(INIT, value_oplist))))) \
+  (M_IF(M_SER1AL_PAR_INDEX_P(isMap, cont_oplist))                             \
+   (M_SER1AL_PAR_DEF_IN_INDEX,                                                \
+    M_IF(M_SER1AL_PAR_INSERT_P(isMap, cont_oplist))(M_SER1AL_PAR_DEF_IN_INSERT, M_EAT)), \
+   M_EAT)                                                                     \
+  (name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist)
+
+/* Define the parallel output functions */
+#define M_SER1AL_PAR_DEF_OUT(name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist) \
+                                                                              \
+  /* Serialize a chunk of the container in its output buffer */               \
+  M_INLINE void                                                               \
+  M_C3(m_ser1al_par_,name,_out_task)(void *data)                              \
+  {                                                                           \
+    M_C3(m_ser1al_par_,name,_task_ct) *task = M_ASSIGN_CAST(M_C3(m_ser1al_par_,name,_task_ct) *, data); \
+    M_GLOBAL_CONTEXT();                                                       \
+    m_serial_write_t f;                                                       \
+    m_serial_local_t local;                                                   \
+    m_serial_return_code_t ret = M_SERIAL_OK_DONE;                            \
+    if (task->json_p) {                                                       \
+      m_serial_str_json_write_init(f, task->json);                            \
+    } else {                                                                  \
+      m_serial_bin_buffer_write_init(f, task->bin);                           \
+    }                                                                         \
+    for(size_t i = 0; i < task->count; i++) {                                 \
+      const M_GET_SUBTYPE cont_oplist *item = M_CALL_IT_CREF(cont_oplist, task->it); \
+      /* The separator before the first element of a chunk belongs to the chunk */ \
+      if (task->first + i != 0) {                                             \
+        ret |= f->m_interface->M_IF(isMap)(write_map_next, write_array_next) M_R(local, f); \
+      }                                                                       \
+      M_IF(isMap)(                                                            \
+        ret |= M_CALL_OUT_SERIAL(key_oplist, f, item->key);                   \
+        ret |= f->m_interface->write_map_value M_R(local, f);                 \
+        ret |= M_CALL_OUT_SERIAL(value_oplist, f, item->value);               \
+      ,                                                                       \
+        ret |= M_CALL_OUT_SERIAL(key_oplist, f, *item);                       \
+      )                                                                       \
+      M_CALL_IT_NEXT(cont_oplist, task->it);                                  \
+    }                                                                         \
+    task->ret = ret & M_SERIAL_FAIL;                                          \
+  }                                                                           \
+                                                                              \
+  /* Cut the container into chunks and serialize them on the workers */       \
+  M_INLINE M_C3(m_ser1al_par_,name,_task_ct) *                                \
+  M_C3(m_ser1al_par_,name,_out_start)(size_t *nchunk, const cont_t c, m_worker_t workers, bool json_p) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    const size_t n = M_CALL_GET_SIZE(cont_oplist, c);                         \
+    const size_t k = m_ser1al_par_chunk_count(n, workers);                    \
+    M_C3(m_ser1al_par_,name,_task_ct) *task = M_MEMORY_REALLOC(m_context, M_C3(m_ser1al_par_,name,_task_ct), NULL, 0, k); \
+    if (M_UNLIKELY_NOMEM (task == NULL)) {                                    \
+      M_MEMORY_FULL(M_C3(m_ser1al_par_,name,_task_ct), k);                    \
+    }                                                                         \
+    it_t it;                                                                  \
+    size_t first = 0;                                                         \
+    M_CALL_IT_FIRST(cont_oplist, it, c);                                      \
+    for(size_t i = 0; i < k; i++) {                                           \
+      task[i].first = first;                                                  \
+      task[i].count = n / k + (i < n % k);                                    \
+      task[i].json_p = json_p;                                                \
+      m_bstring_init(task[i].bin);                                            \
+      m_string_init(task[i].json);                                            \
+      M_CALL_IT_SET(cont_oplist, task[i].it, it);                             \
+      for(size_t j = 0; j < task[i].count; j++) {                             \
+        M_CALL_IT_NEXT(cont_oplist, it);                                      \
+      }                                                                       \
+      first += task[i].count;                                                 \
+    }                                                                         \
+    m_worker_sync_t block;                                                    \
+    m_worker_start(block, workers);                                           \
+    for(size_t i = 0; i < k; i++) {                                           \
+      m_worker_spawn(block, M_C3(m_ser1al_par_,name,_out_task), &task[i]);    \
+    }                                                                         \
+    m_worker_sync(block);                                                     \
+    *nchunk = k;                                                              \
+    return task;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_C3(m_ser1al_par_,name,_out_clear)(M_C3(m_ser1al_par_,name,_task_ct) *task, size_t nchunk) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      m_bstring_clear M_R(task[i].bin);                                       \
+      m_string_clear M_R(task[i].json);                                       \
+    }                                                                         \
+    M_MEMORY_FREE(m_context, M_C3(m_ser1al_par_,name,_task_ct), task, nchunk); \
+  }                                                                           \
+                                                                              \
+  M_INLINE m_serial_return_code_t                                             \
+  M_F(name, _out_serial_bin)(m_bstring_t out, const cont_t c, m_worker_t workers) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    const size_t base = m_bstring_size(out);                                  \
+    size_t nchunk;                                                            \
+    M_C3(m_ser1al_par_,name,_task_ct) *task =                                 \
+      M_C3(m_ser1al_par_,name,_out_start)(&nchunk, c, workers, false);        \
+    m_serial_write_t f;                                                       \
+    m_serial_local_t local;                                                   \
+    m_serial_bin_buffer_write_init(f, out);                                   \
+    m_serial_return_code_t ret = f->m_interface->M_IF(isMap)(write_map_start, write_array_start) \
+      M_R(local, f, M_CALL_GET_SIZE(cont_oplist, c));                         \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      /* Reuse the field 'size' to record the offset of the chunk */          \
+      task[i].size = m_bstring_size(out) - base;                              \
+      ret |= task[i].ret;                                                     \
+      m_bstring_splice M_R(out, task[i].bin);                                 \
+    }                                                                         \
+    ret |= f->m_interface->M_IF(isMap)(write_map_end, write_array_end) M_R(local, f); \
+    m_serial_bin_buffer_write_clear(f);                                       \
+    /* Write the index footer */                                              \
+    const size_t data_size = m_bstring_size(out) - base;                      \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      m_ser1al_par_push_u64(out, task[i].size);                               \
+      m_ser1al_par_push_u64(out, task[i].count);                              \
+    }                                                                         \
+    m_ser1al_par_push_u64(out, nchunk);                                       \
+    m_ser1al_par_push_u64(out, data_size);                                    \
+    m_bstring_push_back_bytes M_R(out, 8, M_SER1AL_PAR_MAGIC);                \
+    M_C3(m_ser1al_par_,name,_out_clear)(task, nchunk);                        \
+    return ret & M_SERIAL_FAIL;                                               \
+  }                                                                           \
+                                                                              \
+  M_INLINE m_serial_return_code_t                                             \
+  M_F(name, _out_serial_json)(m_string_t out, const cont_t c, m_worker_t workers) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    size_t nchunk;                                                            \
+    M_C3(m_ser1al_par_,name,_task_ct) *task =                                 \
+      M_C3(m_ser1al_par_,name,_out_start)(&nchunk, c, workers, true);         \
+    m_serial_write_t f;                                                       \
+    m_serial_local_t local;                                                   \
+    m_serial_str_json_write_init(f, out);                                     \
+    m_serial_return_code_t ret = f->m_interface->M_IF(isMap)(write_map_start, write_array_start) \
+      M_R(local, f, M_CALL_GET_SIZE(cont_oplist, c));                         \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      ret |= task[i].ret;                                                     \
+      m_string_cat M_R(out, task[i].json);                                    \
+    }                                                                         \
+    ret |= f->m_interface->M_IF(isMap)(write_map_end, write_array_end) M_R(local, f); \
+    m_serial_str_json_write_clear(f);                                         \
+    M_C3(m_ser1al_par_,name,_out_clear)(task, nchunk);                        \
+    return ret & M_SERIAL_FAIL;                                               \
+  }
+
+/* Cut the binary record into the work orders of its chunks */
+#define M_SER1AL_PAR_IN_START(name, buffer, entry, data_size, nchunk, task)   \
+  M_C3(m_ser1al_par_,name,_task_ct) *task = M_MEMORY_REALLOC(m_context, M_C3(m_ser1al_par_,name,_task_ct), NULL, 0, nchunk); \
+  if (M_UNLIKELY_NOMEM (task == NULL)) {                                      \
+    M_MEMORY_FULL(M_C3(m_ser1al_par_,name,_task_ct), nchunk);                 \
+  }                                                                           \
+  for(size_t i = 0; i < nchunk; i++) {                                        \
+    size_t offset, next = data_size;                                          \
+    task[i].count = m_ser1al_par_entry(entry, i, &offset);                    \
+    if (i + 1 < nchunk) {                                                     \
+      (void) m_ser1al_par_entry(entry, i + 1, &next);                         \
+    }                                                                         \
+    task[i].buffer = (const char *) buffer + offset;                          \
+    task[i].size = next - offset;                                             \
+  }
+
+/* Run the work orders of the binary record on the workers
+   and return M_SERIAL_OK_DONE if they have all succeeded */
+#define M_SER1AL_PAR_IN_RUN(name, workers, nchunk, task, func, ret)           \
+  m_worker_sync_t block;                                                      \
+  m_worker_start(block, workers);                                             \
+  for(size_t i = 0; i < nchunk; i++) {                                        \
+    m_worker_spawn(block, func, &task[i]);                                    \
+  }                                                                           \
+  m_worker_sync(block);                                                       \
+  m_serial_return_code_t ret = M_SERIAL_OK_DONE;                              \
+  for(size_t i = 0; i < nchunk; i++) {                                        \
+    ret |= task[i].ret;                                                       \
+  }                                                                           \
+  ret = (ret == M_SERIAL_OK_DONE) ? M_SERIAL_OK_DONE : M_SERIAL_FAIL;
+
+/* Define the parallel input function for arrays:
+   the elements are read in place */
+#define M_SER1AL_PAR_DEF_IN_INDEX(name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist) \
+                                                                              \
+  /* Read a chunk of elements in place */                                     \
+  M_INLINE void                                                               \
+  M_C3(m_ser1al_par_,name,_in_task)(void *data)                               \
+  {                                                                           \
+    M_C3(m_ser1al_par_,name,_task_ct) *task = M_ASSIGN_CAST(M_C3(m_ser1al_par_,name,_task_ct) *, data); \
+    M_GLOBAL_CONTEXT();                                                       \
+    m_serial_read_t f;                                                        \
+    m_serial_return_code_t ret = M_SERIAL_OK_DONE;                            \
+    m_serial_bin_buffer_read_init(f, task->buffer, task->size);               \
+    for(size_t i = 0; i < task->count && ret == M_SERIAL_OK_DONE; i++) {      \
+      ret = M_CALL_IN_SERIAL(key_oplist, *M_CALL_IT_REF(cont_oplist, task->it), f); \
+      M_CALL_IT_NEXT(cont_oplist, task->it);                                  \
+    }                                                                         \
+    if (ret == M_SERIAL_OK_DONE && m_serial_bin_buffer_read_pos(f) != task->size) { \
+      ret = M_SERIAL_FAIL;                                                    \
+    }                                                                         \
+    m_serial_bin_buffer_read_clear(f);                                        \
+    task->ret = ret;                                                          \
+  }                                                                           \
+                                                                              \
+  M_INLINE m_serial_return_code_t                                             \
+  M_F(name, _in_serial_bin)(cont_t c, const void *buffer, size_t size, m_worker_t workers) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    size_t nchunk, data_size, count;                                          \
+    M_CALL_RESET(cont_oplist, c);                                             \
+    const char *entry = m_ser1al_par_parse(buffer, size, false, &nchunk, &data_size, &count); \
+    if (M_UNLIKELY (entry == NULL)) {                                         \
+      return M_SERIAL_FAIL;                                                   \
+    }                                                                         \
+    /* Create all the elements, so that they can be read in parallel */       \
+    if (count != 0 && M_CALL_SAFE_GET_KEY(cont_oplist, c, count - 1) == NULL) { \
+      M_CALL_RESET(cont_oplist, c);                                           \
+      return M_SERIAL_FAIL;                                                   \
+    }                                                                         \
+    M_SER1AL_PAR_IN_START(name, buffer, entry, data_size, nchunk, task)       \
+    it_t it;                                                                  \
+    M_CALL_IT_FIRST(cont_oplist, it, c);                                      \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      M_CALL_IT_SET(cont_oplist, task[i].it, it);                             \
+      for(size_t j = 0; j < task[i].count; j++) {                             \
+        M_CALL_IT_NEXT(cont_oplist, it);                                      \
+      }                                                                       \
+    }                                                                         \
+    M_SER1AL_PAR_IN_RUN(name, workers, nchunk, task, M_C3(m_ser1al_par_,name,_in_task), ret) \
+    M_MEMORY_FREE(m_context, M_C3(m_ser1al_par_,name,_task_ct), task, nchunk); \
+    if (ret != M_SERIAL_OK_DONE) {                                            \
+      M_CALL_RESET(cont_oplist, c);                                           \
+    }                                                                         \
+    return ret;                                                               \
+  }
+
+/* Define the parallel input function for other containers:
+   the elements are parsed in parallel and then inserted in the container */
+#define M_SER1AL_PAR_DEF_IN_INSERT(name, isMap, cont_oplist, cont_t, it_t, key_type, key_oplist, value_type, value_oplist) \
+                                                                              \
+  /* Parse a chunk of elements in temporary buffers */                        \
+  M_INLINE void                                                               \
+  M_C3(m_ser1al_par_,name,_in_task)(void *data)                               \
+  {                                                                           \
+    M_C3(m_ser1al_par_,name,_task_ct) *task = M_ASSIGN_CAST(M_C3(m_ser1al_par_,name,_task_ct) *, data); \
+    M_GLOBAL_CONTEXT();                                                       \
+    const size_t n = task->count;                                             \
+    task->key = NULL;                                                         \
+    task->value = NULL;                                                       \
+    if (n != 0) {                                                             \
+      task->key = M_MEMORY_REALLOC(m_context, key_type, NULL, 0, n);          \
+      if (M_UNLIKELY_NOMEM (task->key == NULL)) {                             \
+        M_MEMORY_FULL(key_type, n);                                           \
+      }                                                                       \
+      M_IF(isMap)(                                                            \
+      task->value = M_MEMORY_REALLOC(m_context, value_type, NULL, 0, n);      \
+      if (M_UNLIKELY_NOMEM (task->value == NULL)) {                           \
+        M_MEMORY_FULL(value_type, n);                                         \
+      }                                                                       \
+      , )                                                                     \
+    }                                                                         \
+    for(size_t i = 0; i < n; i++) {                                           \
+      M_CALL_INIT(key_oplist, task->key[i]);                                  \
+      M_IF(isMap)(M_CALL_INIT(value_oplist, task->value[i]);, )               \
+    }                                                                         \
+    m_serial_read_t f;                                                        \
+    m_serial_return_code_t ret = M_SERIAL_OK_DONE;                            \
+    m_serial_bin_buffer_read_init(f, task->buffer, task->size);               \
+    for(size_t i = 0; i < n && ret == M_SERIAL_OK_DONE; i++) {                \
+      ret = M_CALL_IN_SERIAL(key_oplist, task->key[i], f);                    \
+      M_IF(isMap)(                                                            \
+      if (ret == M_SERIAL_OK_DONE) {                                          \
+        ret = M_CALL_IN_SERIAL(value_oplist, task->value[i], f);              \
+      }                                                                       \
+      , )                                                                     \
+    }                                                                         \
+    if (ret == M_SERIAL_OK_DONE && m_serial_bin_buffer_read_pos(f) != task->size) { \
+      ret = M_SERIAL_FAIL;                                                    \
+    }                                                                         \
+    m_serial_bin_buffer_read_clear(f);                                        \
+    task->ret = ret;                                                          \
+  }                                                                           \
+                                                                              \
+  M_INLINE m_serial_return_code_t                                             \
+  M_F(name, _in_serial_bin)(cont_t c, const void *buffer, size_t size, m_worker_t workers) \
+  {                                                                           \
+    M_GLOBAL_CONTEXT();                                                       \
+    size_t nchunk, data_size, count;                                          \
+    M_CALL_RESET(cont_oplist, c);                                             \
+    const char *entry = m_ser1al_par_parse(buffer, size, isMap, &nchunk, &data_size, &count); \
+    if (M_UNLIKELY (entry == NULL)) {                                         \
+      return M_SERIAL_FAIL;                                                   \
+    }                                                                         \
+    M_SER1AL_PAR_IN_START(name, buffer, entry, data_size, nchunk, task)       \
+    M_SER1AL_PAR_IN_RUN(name, workers, nchunk, task, M_C3(m_ser1al_par_,name,_in_task), ret) \
+    /* Insert the parsed elements in the order of the record */               \
+    for(size_t i = 0; i < nchunk; i++) {                                      \
+      for(size_t j = 0; j < task[i].count; j++) {                             \
+        if (ret == M_SERIAL_OK_DONE) {                                        \
+          M_IF(isMap)(M_CALL_SET_KEY(cont_oplist, c, task[i].key[j], task[i].value[j]), \
+                      M_CALL_PUSH(cont_oplist, c, task[i].key[j]));           \
+        }                                                                     \
+        M_CALL_CLEAR(key_oplist, task[i].key[j]);                             \
+        M_IF(isMap)(M_CALL_CLEAR(value_oplist, task[i].value[j]);, )          \
+      }                                                                       \
+      M_MEMORY_FREE(m_context, key_type, task[i].key, task[i].count);         \
+      M_IF(isMap)(M_MEMORY_FREE(m_context, value_type, task[i].value, task[i].count);, ) \
+    }                                                                         \
+    M_MEMORY_FREE(m_context, M_C3(m_ser1al_par_,name,_task_ct), task, nchunk); \
+    if (ret != M_SERIAL_OK_DONE) {                                            \
+      M_CALL_RESET(cont_oplist, c);                                           \
+    }                                                                         \
+    return ret;                                                               \
+  }
+
+M_END_PROTECTED_CODE
+
+#if M_USE_SMALL_NAME
+#define SERIAL_PAR_DEF M_SERIAL_PAR_DEF
+#endif
+
+#endif
@@ -0,0 +1,623 @@
+/*
+ * M*LIB - STRUCTURE OF ARRAYS module
+ *
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef MSTARLIB_SOA_H
+#define MSTARLIB_SOA_H
+
+#include "m-core.h"
+
+/* Define a dynamic array of records stored as a structure of arrays:
+   each field of the record is stored in its own contiguous array.
+   The fields are given like for a tuple.
+   USAGE:
+   SOA_ARRAY_DEF(name, (field1, type1[, oplist1]), (field2, type2[, oplist2]), ... ) */
+#define M_SOA_ARRAY_DEF(name, ...)                                            \
+  M_SOA_ARRAY_DEF_AS(name, M_F(name,_t), M_F(name,_it_t), __VA_ARGS__)
+
+
+/* Define a dynamic array of records stored as a structure of arrays
+   as the given name name_t with the iterator named it_t.
+   USAGE:
+   SOA_ARRAY_DEF_AS(name, name_t, it_t, (field1, type1[, oplist1]), (field2, type2[, oplist2]), ... ) */
+#define M_SOA_ARRAY_DEF_AS(name, name_t, it_t, ...)                           \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_S0A_DEF_P1( (name, name_t, it_t M_S0A_INJECT_GLOBAL(__VA_ARGS__)) )       \
+  M_END_PROTECTED_CODE
+
+
+/* Define the oplist of a structure of arrays.
+   USAGE: SOA_ARRAY_OPLIST(name) */
+#define M_SOA_ARRAY_OPLIST(name)                                              \
+  M_S0A_OPLIST_P3(name)
+
+
+/*****************************************************************************/
+/********************************** INTERNAL *********************************/
+/*****************************************************************************/
+
+/* Contract of a structure of arrays.
+   All the columns have the same size & the same capacity */
+#define M_S0A_CONTRACT(soa) do {                                              \
+    M_ASSERT (soa != NULL);                                                   \
+    M_ASSERT (soa->size <= soa->alloc);                                       \
+  } while (0)
+
+/* Inject the oplist within the list of arguments */
+#define M_S0A_INJECT_GLOBAL(...)                                              \
+  M_MAP(M_S0A_INJECT_OPLIST_A, __VA_ARGS__)
+
+/* Transform (x, type) into (x, type, oplist) if there is global registered oplist
+   or (x, type, M_BASIC_OPLIST) if there is no global one,
+   or keep (x, type, oplist) if oplist was already present */
+#define M_S0A_INJECT_OPLIST_A( duo_or_trio )                                  \
+  M_S0A_INJECT_OPLIST_B duo_or_trio
+
+#define M_S0A_INJECT_OPLIST_B( f, ... )                                       \
+  M_DEFERRED_COMMA                                                            \
+  M_IF_NARGS_EQ1(__VA_ARGS__)( (f, __VA_ARGS__, M_GLOBAL_OPLIST_OR_DEF(__VA_ARGS__)()), (f, __VA_ARGS__) )
+
+// Deferred evaluation
+#define M_S0A_DEF_P1(...)                M_ID( M_S0A_DEF_P2 __VA_ARGS__ )
+
+// Test if the third argument of (name, type, oplist) is an oplist
+#define M_S0A_IS_OPLIST_P(a)                                                  \
+  M_OPLIST_P(M_RET_ARG3 a)
+
+/* Validate the oplist before going further */
+#define M_S0A_DEF_P2(name, name_t, it_t, ...)                                 \
+  M_IF(M_REDUCE(M_S0A_IS_OPLIST_P, M_AND, __VA_ARGS__))                       \
+  (M_S0A_DEF_P3, M_S0A_DEF_FAILURE)(name, name_t, it_t, __VA_ARGS__)
+
+/* Stop processing with a compilation failure */
+#define M_S0A_DEF_FAILURE(name, name_t, it_t, ...)                            \
+  M_STATIC_FAILURE(M_LIB_NOT_AN_OPLIST, "(SOA_ARRAY_DEF): at least one of the given argument is not a valid oplist: " #__VA_ARGS__)
+
+/* Get the field name, the type or the oplist
+   based on the tuple (field, type, oplist) */
+#define M_S0A_GET_FIELD(f,t,o)     f
+#define M_S0A_GET_TYPE(f,t,o)      t
+#define M_S0A_GET_OPLIST(f,t,o)    o
+
+/* Get the oplist of the first field */
+#define M_S0A_FIRST_OPLIST(...)    M_S0A_GET_OPLIST M_RET_ARG1(__VA_ARGS__)
+
+/* Test if all the fields define the given method */
+#define M_S0A_IF_ALL(method, ...)                                             \
+  M_IF(M_REDUCE2(M_S0A_TEST_METHOD_P, M_AND, method, __VA_ARGS__))
+
+#define M_S0A_TEST_METHOD_P(method, trio)                                     \
+  M_TEST_METHOD_P(method, M_S0A_GET_OPLIST trio)
+
+/* Internal definition:
+   - name: prefix to be used
+   - name_t: name of the type
+   - it_t: name of the iterator
+   - ...: list of (field, type, oplist)
+*/
+#define M_S0A_DEF_P3(name, name_t, it_t, ...)                                 \
+  M_S0A_DEFINE_TYPE(name, name_t, it_t, __VA_ARGS__)                          \
+  M_MAP2(M_S0A_CONTROL_OPLIST, name, __VA_ARGS__)                             \
+  M_S0A_DEFINE_CORE(name, name_t, __VA_ARGS__)                                \
+  M_S0A_DEFINE_PUSH(name, name_t, __VA_ARGS__)                                \
+  M_S0A_IF_ALL(INIT, __VA_ARGS__)(M_S0A_DEFINE_RESIZE(name, name_t, __VA_ARGS__),) \
+  M_S0A_DEFINE_SET(name, name_t, __VA_ARGS__)                                 \
+  M_MAP3(M_S0A_DEFINE_FIELD, (name, name_t, it_t), __VA_ARGS__)               \
+  M_S0A_DEFINE_IT(name, name_t, it_t)
+
+/* Control that the oplist of the field is compatible with its type */
+#define M_S0A_CONTROL_OPLIST(name, a)                                         \
+  M_CHECK_COMPATIBLE_OPLIST(name, M_S0A_GET_FIELD a,                          \
+                            M_S0A_GET_TYPE a, M_S0A_GET_OPLIST a)
+
+/* Define the types:
+   one array per field, sharing the same size & capacity */
+#define M_S0A_DEFINE_TYPE(name, name_t, it_t, ...)                            \
+  typedef struct M_F(name, _s) {                                              \
+    size_t size;            /* Number of records in the arrays */             \
+    size_t alloc;           /* Allocated number of records of each array */   \
+    M_MAP(M_S0A_DEFINE_TYPE_ELE , __VA_ARGS__)                                \
+  } name_t[1];                                                                \
+                                                                              \
+  /* Define an iterator over the records */                                   \
+  typedef struct M_F(name, _it_s) {                                           \
+    size_t index;                       /* Index of the record */             \
+    const struct M_F(name, _s) *soa;    /* Reference of the container */      \
+  } it_t[1];                                                                  \
+                                                                              \
+  typedef struct M_F(name, _s) *M_F(name, _ptr);                              \
+  typedef const struct M_F(name, _s) *M_F(name, _srcptr);                     \
+  typedef name_t M_F(name, _ct);                                              \
+  typedef it_t M_F(name, _it_ct);                                             \
+
+#define M_S0A_DEFINE_TYPE_ELE(a)                                              \
+  M_S0A_GET_TYPE a *M_S0A_GET_FIELD a;
+
+/* Define the core functions (not depending on the field operators) */
+#define M_S0A_DEFINE_CORE(name, name_t, ...)                                  \
+  M_INLINE void                                                               \
+  M_F(name, _init)(name_t v)                                                  \
+  {                                                                           \
+    M_ASSERT (v != NULL);                                                     \
+    v->size = 0;                                                              \
+    v->alloc = 0;                                                             \
+    M_MAP(M_S0A_DEFINE_INIT_FUNC, __VA_ARGS__)                                \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reset, name_t v)                                           \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_UNUSED_CONTEXT();                                                       \
+    for(size_t i = 0; i < v->size; i++) {                                     \
+      M_MAP(M_S0A_DEFINE_CLEAR_FUNC, __VA_ARGS__)                             \
+    }                                                                         \
+    v->size = 0;                                                              \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _clear, name_t v)                                           \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_F(name, _reset) M_R(v);                                                 \
+    M_MAP(M_S0A_DEFINE_FREE_FUNC, __VA_ARGS__)                                \
+    v->alloc = 0;                                                             \
+  }                                                                           \
+                                                                              \
+  /* Set the capacity of all the arrays to 'alloc' records.                   \
+     All the new arrays are allocated before modifying the object,            \
+     so that it remains unchanged if one of the allocations fails. */         \
+  M_P(void, name, _i_realloc, name_t v, size_t alloc)                         \
+  {                                                                           \
+    M_ASSERT (v->size <= alloc);                                              \
+    bool ok = true;                                                           \
+    M_MAP(M_S0A_DEFINE_ALLOC_FUNC, __VA_ARGS__)                               \
+    if (M_UNLIKELY_NOMEM (!ok)) {                                             \
+      M_MAP(M_S0A_DEFINE_ALLOC_ROLLBACK_FUNC, __VA_ARGS__)                    \
+      M_MEMORY_FULL(struct M_F(name, _s), alloc);                             \
+      return;                                                                 \
+    }                                                                         \
+    M_MAP(M_S0A_DEFINE_ALLOC_COMMIT_FUNC, __VA_ARGS__)                        \
+    v->alloc = alloc;                                                         \
+  }                                                                           \
+                                                                              \
+  /* Ensure that the arrays can store at least 'size' records                 \
+     (using the growth policy of the first field) */                          \
+  M_P(void, name, _i_fit, name_t v, size_t size)                              \
+  {                                                                           \
+    if (M_UNLIKELY (size > v->alloc)) {                                       \
+      size_t alloc = M_CALL_INC_ALLOC(M_S0A_FIRST_OPLIST(__VA_ARGS__), v->alloc); \
+      if (M_UNLIKELY_NOMEM (alloc <= v->alloc)) {                             \
+        M_MEMORY_FULL(struct M_F(name, _s), -(size_t)1);                      \
+      }                                                                       \
+      alloc = M_MAX(alloc, size);                                             \
+      M_F(name, _i_realloc) M_R(v, alloc);                                    \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _reserve, name_t v, size_t alloc)                           \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    /* NOTE: Reserve below needed size to perform a shrink to fit */          \
+    if (v->size > alloc) {                                                    \
+      alloc = v->size;                                                        \
+    }                                                                         \
+    if (M_UNLIKELY (alloc == 0)) {                                            \
+      /* Free the arrays */                                                   \
+      M_MAP(M_S0A_DEFINE_FREE_FUNC, __VA_ARGS__)                              \
+      v->alloc = 0;                                                           \
+    } else {                                                                  \
+      M_F(name, _i_realloc) M_R(v, alloc);                                    \
+    }                                                                         \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _init_move)(name_t d, name_t s)                                   \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_S0A_CONTRACT(s);                                                        \
+    *d = *s;                                                                  \
+    /* Robustness */                                                          \
+    s->alloc = 0;                                                             \
+    M_S0A_CONTRACT(d);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _move, name_t d, name_t s)                                  \
+  {                                                                           \
+    M_ASSERT (d != s);                                                        \
+    M_F(name, _clear) M_R(d);                                                 \
+    M_F(name, _init_move)(d, s);                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _swap)(name_t v1, name_t v2)                                      \
+  {                                                                           \
+    M_S0A_CONTRACT(v1);                                                       \
+    M_S0A_CONTRACT(v2);                                                       \
+    M_SWAP(struct M_F(name, _s), *v1, *v2);                                   \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _empty_p)(const name_t v)                                         \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    return v->size == 0;                                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _size)(const name_t v)                                            \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    return v->size;                                                           \
+  }                                                                           \
+                                                                              \
+  M_INLINE size_t                                                             \
+  M_F(name, _capacity)(const name_t v)                                        \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    return v->alloc;                                                          \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_back, name_t v)                                        \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(0, v->size);                                               \
+    v->size--;                                                                \
+    const size_t i = v->size;                                                 \
+    M_MAP(M_S0A_DEFINE_CLEAR_FUNC, __VA_ARGS__)                               \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _pop_at, name_t v, size_t i)                                \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_MAP(M_S0A_DEFINE_CLEAR_FUNC, __VA_ARGS__)                               \
+    M_MAP(M_S0A_DEFINE_MEMMOVE_FUNC, __VA_ARGS__)                             \
+    v->size--;                                                                \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(bool, name, _erase, name_t v, size_t i)                                 \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    if (i >= v->size) return false;                                           \
+    M_F(name, _pop_at) M_R(v, i);                                             \
+    return true;                                                              \
+  }                                                                           \
+
+#define M_S0A_DEFINE_INIT_FUNC(a)                                             \
+  v->M_S0A_GET_FIELD a = NULL;
+
+#define M_S0A_DEFINE_CLEAR_FUNC(a)                                            \
+  M_CALL_CLEAR(M_S0A_GET_OPLIST a, v->M_S0A_GET_FIELD a[i]);
+
+#define M_S0A_DEFINE_FREE_FUNC(a)                                             \
+  M_CALL_FREE(M_S0A_GET_OPLIST a, M_S0A_GET_TYPE a, v->M_S0A_GET_FIELD a, v->alloc); \
+  v->M_S0A_GET_FIELD a = NULL;
+
+/* Allocate the new array of the field (if the previous ones succeeded) */
+#define M_S0A_DEFINE_ALLOC_FUNC(a)                                            \
+  M_S0A_GET_TYPE a *M_C(m_s0a_new_, M_S0A_GET_FIELD a) = ok ?                 \
+    M_CALL_REALLOC(M_S0A_GET_OPLIST a, M_S0A_GET_TYPE a, NULL, 0, alloc) : NULL; \
+  ok = ok && M_C(m_s0a_new_, M_S0A_GET_FIELD a) != NULL;
+
+/* Free the new array of the field if it has been allocated */
+#define M_S0A_DEFINE_ALLOC_ROLLBACK_FUNC(a)                                   \
+  if (M_C(m_s0a_new_, M_S0A_GET_FIELD a) != NULL) {                           \
+    M_CALL_FREE(M_S0A_GET_OPLIST a, M_S0A_GET_TYPE a, M_C(m_s0a_new_, M_S0A_GET_FIELD a), alloc); \
+  }
+
+/* Move the records of the field into its new array */
+#define M_S0A_DEFINE_ALLOC_COMMIT_FUNC(a)                                     \
+  if (v->size > 0) {                                                          \
+    memcpy(M_C(m_s0a_new_, M_S0A_GET_FIELD a), v->M_S0A_GET_FIELD a,          \
+           v->size * sizeof (M_S0A_GET_TYPE a));                              \
+  }                                                                           \
+  M_CALL_FREE(M_S0A_GET_OPLIST a, M_S0A_GET_TYPE a, v->M_S0A_GET_FIELD a, v->alloc); \
+  v->M_S0A_GET_FIELD a = M_C(m_s0a_new_, M_S0A_GET_FIELD a);
+
+#define M_S0A_DEFINE_MEMMOVE_FUNC(a)                                          \
+  memmove(&v->M_S0A_GET_FIELD a[i], &v->M_S0A_GET_FIELD a[i+1],               \
+          sizeof(M_S0A_GET_TYPE a) * (v->size-1-i));
+
+/* Define the push functions */
+#define M_S0A_DEFINE_PUSH(name, name_t, ...)                                  \
+  M_P(void, name, _push_back, name_t v M_MAP(M_S0A_DEFINE_PROTO, __VA_ARGS__)) \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_F(name, _i_fit) M_R(v, v->size + 1);                                    \
+    const size_t i = v->size;                                                 \
+    M_MAP(M_S0A_DEFINE_INIT_SET_FUNC, __VA_ARGS__)                            \
+    v->size++;                                                                \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _push_at, name_t v, size_t i M_MAP(M_S0A_DEFINE_PROTO, __VA_ARGS__)) \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT_INDEX(i, v->size+1);                                             \
+    M_F(name, _i_fit) M_R(v, v->size + 1);                                    \
+    M_MAP(M_S0A_DEFINE_MEMMOVE_UP_FUNC, __VA_ARGS__)                          \
+    M_MAP(M_S0A_DEFINE_INIT_SET_FUNC, __VA_ARGS__)                            \
+    v->size++;                                                                \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+
+#define M_S0A_DEFINE_PROTO(a)                                                 \
+  , M_S0A_GET_TYPE a const M_S0A_GET_FIELD a
+
+#define M_S0A_DEFINE_INIT_SET_FUNC(a)                                         \
+  M_CALL_INIT_SET(M_S0A_GET_OPLIST a, v->M_S0A_GET_FIELD a[i], M_S0A_GET_FIELD a);
+
+#define M_S0A_DEFINE_MEMMOVE_UP_FUNC(a)                                       \
+  memmove(&v->M_S0A_GET_FIELD a[i+1], &v->M_S0A_GET_FIELD a[i],               \
+          sizeof(M_S0A_GET_TYPE a) * (v->size-i));
+
+/* Define the resize function (if all fields have an INIT method) */
+#define M_S0A_DEFINE_RESIZE(name, name_t, ...)                                \
+  M_P(void, name, _resize, name_t v, size_t size)                             \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    if (v->size > size) {                                                     \
+      /* Decrease size of the arrays */                                       \
+      for(size_t i = size ; i < v->size; i++) {                               \
+        M_MAP(M_S0A_DEFINE_CLEAR_FUNC, __VA_ARGS__)                           \
+      }                                                                       \
+      v->size = size;                                                         \
+    } else if (v->size < size) {                                              \
+      /* Increase size of the arrays */                                       \
+      if (size > v->alloc) {                                                  \
+        M_F(name, _i_realloc) M_R(v, size);                                   \
+      }                                                                       \
+      for(size_t i = v->size ; i < size; i++) {                               \
+        M_MAP(M_S0A_DEFINE_INIT_FUNC2, __VA_ARGS__)                           \
+      }                                                                       \
+      v->size = size;                                                         \
+    }                                                                         \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+
+#define M_S0A_DEFINE_INIT_FUNC2(a)                                            \
+  M_CALL_INIT(M_S0A_GET_OPLIST a, v->M_S0A_GET_FIELD a[i]);
+
+/* Define the set functions */
+#define M_S0A_DEFINE_SET(name, name_t, ...)                                   \
+  M_P(void, name, _set, name_t v, const name_t s)                             \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_S0A_CONTRACT(s);                                                        \
+    if (M_UNLIKELY (v == s)) return;                                          \
+    M_F(name, _reset) M_R(v);                                                 \
+    M_F(name, _i_fit) M_R(v, s->size);                                        \
+    for(size_t i = 0; i < s->size; i++) {                                     \
+      M_MAP(M_S0A_DEFINE_INIT_SET_FUNC2, __VA_ARGS__)                         \
+      v->size = i + 1;                                                        \
+    }                                                                         \
+    M_S0A_CONTRACT(v);                                                        \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _init_set, name_t v, const name_t s)                        \
+  {                                                                           \
+    M_ASSERT (v != s);                                                        \
+    M_ON_EXCEPTION(M_F(name, _clear) M_R(v) ) {                               \
+      M_F(name, _init)(v);                                                    \
+      M_F(name, _set) M_R(v, s);                                              \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  M_P(void, name, _set_at, name_t v, size_t i M_MAP(M_S0A_DEFINE_PROTO, __VA_ARGS__)) \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_UNUSED_CONTEXT();                                                       \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    M_MAP(M_S0A_DEFINE_SET_FUNC, __VA_ARGS__)                                 \
+  }                                                                           \
+
+#define M_S0A_DEFINE_INIT_SET_FUNC2(a)                                        \
+  M_CALL_INIT_SET(M_S0A_GET_OPLIST a, v->M_S0A_GET_FIELD a[i], s->M_S0A_GET_FIELD a[i]);
+
+#define M_S0A_DEFINE_SET_FUNC(a)                                              \
+  M_CALL_SET(M_S0A_GET_OPLIST a, v->M_S0A_GET_FIELD a[i], M_S0A_GET_FIELD a);
+
+/* Define the accessors of a field:
+   the column of the field (a contiguous array of _size elements),
+   the element of the field in a given record
+   and the element of the field in the record referenced by an iterator. */
+#define M_S0A_DEFINE_FIELD(names, num, a)                                     \
+  M_S0A_DEFINE_FIELD_P2(M_RET_ARG1 names, M_RET_ARG2 names, M_RET_ARG3 names, \
+                        M_S0A_GET_FIELD a, M_S0A_GET_TYPE a)
+
+#define M_S0A_DEFINE_FIELD_P2(name, name_t, it_t, field, type)                \
+  M_INLINE type *                                                             \
+  M_C4(name, _get_, field, _ptr)(const name_t v)                              \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    return v->field;                                                          \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_C4(name, _cget_, field, _ptr)(const name_t v)                             \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    return M_CONST_CAST(type, v->field);                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_C3(name, _get_at_, field)(const name_t v, size_t i)                       \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    return &v->field[i];                                                      \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_C3(name, _cget_at_, field)(const name_t v, size_t i)                      \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT_INDEX(i, v->size);                                               \
+    return M_CONST_CAST(type, &v->field[i]);                                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE type *                                                             \
+  M_C3(name, _ref_, field)(const it_t it)                                     \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_C3(name, _get_at_, field)(it->soa, it->index);                   \
+  }                                                                           \
+                                                                              \
+  M_INLINE type const *                                                       \
+  M_C3(name, _cref_, field)(const it_t it)                                    \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return M_C3(name, _cget_at_, field)(it->soa, it->index);                  \
+  }                                                                           \
+
+/* Define the iterator over the records */
+#define M_S0A_DEFINE_IT(name, name_t, it_t)                                   \
+  M_INLINE void                                                               \
+  M_F(name, _it)(it_t it, const name_t v)                                     \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = 0;                                                            \
+    it->soa = v;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_last)(it_t it, const name_t v)                                \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT (it != NULL);                                                    \
+    /* If size is 0, index is -1 as unsigned, so it is greater than end */    \
+    it->index = v->size - 1;                                                  \
+    it->soa = v;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_end)(it_t it, const name_t v)                                 \
+  {                                                                           \
+    M_S0A_CONTRACT(v);                                                        \
+    M_ASSERT (it != NULL);                                                    \
+    it->index = v->size;                                                      \
+    it->soa = v;                                                              \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _it_set)(it_t it, const it_t org)                                 \
+  {                                                                           \
+    M_ASSERT (it != NULL && org != NULL);                                     \
+    it->index = org->index;                                                   \
+    it->soa = org->soa;                                                       \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _end_p)(const it_t it)                                            \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->soa != NULL);                                  \
+    return it->index >= it->soa->size;                                        \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _last_p)(const it_t it)                                           \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->soa != NULL);                                  \
+    return it->index + 1 >= it->soa->size;                                    \
+  }                                                                           \
+                                                                              \
+  M_INLINE bool                                                               \
+  M_F(name, _it_equal_p)(const it_t it1, const it_t it2)                      \
+  {                                                                           \
+    M_ASSERT(it1 != NULL && it2 != NULL);                                     \
+    return it1->soa == it2->soa && it1->index == it2->index;                  \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _next)(it_t it)                                                   \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->soa != NULL);                                  \
+    it->index ++;                                                             \
+  }                                                                           \
+                                                                              \
+  M_INLINE void                                                               \
+  M_F(name, _previous)(it_t it)                                               \
+  {                                                                           \
+    M_ASSERT(it != NULL && it->soa != NULL);                                  \
+    it->index --;                                                             \
+  }                                                                           \
+                                                                              \
+  /* Return the index of the record referenced by the iterator */             \
+  M_INLINE size_t                                                             \
+  M_F(name, _it_index)(const it_t it)                                         \
+  {                                                                           \
+    M_ASSERT(it != NULL);                                                     \
+    return it->index;                                                         \
+  }                                                                           \
+
+/* Define the oplist of the structure of arrays.
+   As a record is not an object by itself, there is no SUBTYPE
+   and no iterator operators. */
+#ifndef M_USE_CONTEXT
+#define M_S0A_OPLIST_P3(name)                                                 \
+  (INIT(M_F(name, _init))                                                     \
+   ,INIT_SET(M_F(name, _init_set))                                            \
+   ,SET(M_F(name, _set))                                                      \
+   ,CLEAR(M_F(name, _clear))                                                  \
+   ,INIT_MOVE(M_F(name, _init_move))                                          \
+   ,MOVE(M_F(name, _move))                                                    \
+   ,SWAP(M_F(name, _swap))                                                    \
+   ,RESET(M_F(name, _reset))                                                  \
+   ,EMPTY_P(M_F(name, _empty_p))                                              \
+   ,GET_SIZE(M_F(name, _size))                                                \
+   ,TYPE(M_F(name, _ct)) , GENTYPE(struct M_F(name,_s)*)                      \
+   ,NAME(name)                                                                \
+   )
+#else
+#define M_S0A_OPLIST_P3(name)                                                 \
+  (INIT(M_F(name, _init))                                                     \
+   ,INIT_SET(API_0P(M_F(name, _init_set)))                                    \
+   ,SET(API_0P(M_F(name, _set)))                                              \
+   ,CLEAR(API_0P(M_F(name, _clear)))                                          \
+   ,INIT_MOVE(M_F(name, _init_move))                                          \
+   ,MOVE(API_0P(M_F(name, _move)))                                            \
+   ,SWAP(M_F(name, _swap))                                                    \
+   ,RESET(API_0P(M_F(name, _reset)))                                          \
+   ,EMPTY_P(M_F(name, _empty_p))                                              \
+   ,GET_SIZE(M_F(name, _size))                                                \
+   ,TYPE(M_F(name, _ct)) , GENTYPE(struct M_F(name,_s)*)                      \
+   ,NAME(name)                                                                \
+   )
+#endif
+
+/********************************** INTERNAL *********************************/
+
+#if M_USE_SMALL_NAME
+#define SOA_ARRAY_DEF M_SOA_ARRAY_DEF
+#define SOA_ARRAY_DEF_AS M_SOA_ARRAY_DEF_AS
+#define SOA_ARRAY_OPLIST M_SOA_ARRAY_OPLIST
+#endif
+
+#endif
@@ -1049,6 +1049,441 @@ M_P(void, m_string, _replace_all, m_string_t v, const m_string_t str1, const m_s
   }
 }
 
+/* Load a word of 8 bytes from the buffer.
+   Loading a word is done through memcpy to support unaligned buffers
+   (which is turned into a single load by the compiler). */
+#define M_STR1NG_HIGH_BITS UINT64_C(0x8080808080808080)
+#define M_STR1NG_LOW_BITS  UINT64_C(0x0101010101010101)
+
+M_INLINE uint64_t
+m_str1ng_load64(const char buf[])
+{
+  uint64_t w;
+  memcpy(&w, buf, sizeof w);
+  return w;
+}
+
+/* Return a word with the high bit set for (at least) each zero byte of w.
+   A byte above a zero byte may also be flagged. */
+M_INLINE uint64_t
+m_str1ng_zero_bytes64(uint64_t w)
+{
+  return (w - M_STR1NG_LOW_BITS) & ~w & M_STR1NG_HIGH_BITS;
+}
+
+/* Compiled search object of one or several patterns.
+   A single pattern is searched using the libc memchr on its first byte
+   (which is vectorized) and is filtered by its last byte before comparing.
+   Several patterns are searched in one pass using an Aho-Corasick automaton,
+   compiled as a full transition table over the classes of bytes
+   used by the patterns (all other bytes share the class 0). */
+typedef struct m_string_searcher_s {
+  size_t     num;                // Number of patterns
+  size_t    *size;               // Size of each pattern
+  char      *pattern;            // Copy of the pattern (if only one pattern)
+  size_t     num_state;          // Number of allocated states of the automaton
+  size_t     num_class;          // Number of classes of bytes
+  uint32_t  *delta;              // Transition table (num_state x num_class)
+  uint32_t  *depth;              // Depth of each state
+  uint32_t  *match;              // 1 + index of the longest pattern which ends at each state (or 0)
+  unsigned char class_tab[256];  // Class of each byte
+} m_string_searcher_t[1];
+
+// Contract of a compiled search object
+#define M_STR1NG_SEARCHER_CONTRACT(s) do {                                    \
+    M_ASSERT ((s) != NULL);                                                   \
+    M_ASSERT ((s)->num >= 1 && (s)->size != NULL);                            \
+    M_ASSERT ((s)->num != 1 || (s)->pattern != NULL);                         \
+    M_ASSERT ((s)->num == 1 || ((s)->delta != NULL && (s)->depth != NULL      \
+                                && (s)->match != NULL));                      \
+  } while (0)
+
+/* Build the Aho-Corasick automaton of the given patterns */
+M_P(void, m_str1ng_searcher, _build, m_string_searcher_t s, size_t num, const char *const patterns[])
+{
+  // Compute the classes of bytes and the maximum number of states
+  size_t max_state = 1, num_class = 1;
+  memset(s->class_tab, 0, sizeof s->class_tab);
+  for(size_t i = 0; i < num; i++) {
+    for(const unsigned char *p = (const unsigned char *) patterns[i]; *p != 0; p++) {
+      if (s->class_tab[*p] == 0) {
+        s->class_tab[*p] = (unsigned char) num_class++;
+      }
+    }
+    max_state += s->size[i];
+  }
+  M_ASSERT (num_class <= 256);
+  // The offsets of the rows of the table shall fit in 31 bits
+  if (M_UNLIKELY_NOMEM (max_state > (UINT32_MAX >> 1) / num_class)) {
+    M_MEMORY_FULL(uint32_t, max_state);
+  }
+  uint32_t *delta = M_MEMORY_REALLOC(m_context, uint32_t, NULL, 0, max_state * num_class);
+  if (M_UNLIKELY_NOMEM (delta == NULL)) {
+    M_MEMORY_FULL(uint32_t, max_state * num_class);
+  }
+  uint32_t *depth = M_MEMORY_REALLOC(m_context, uint32_t, NULL, 0, max_state);
+  if (M_UNLIKELY_NOMEM (depth == NULL)) {
+    M_MEMORY_FULL(uint32_t, max_state);
+  }
+  uint32_t *match = M_MEMORY_REALLOC(m_context, uint32_t, NULL, 0, max_state);
+  if (M_UNLIKELY_NOMEM (match == NULL)) {
+    M_MEMORY_FULL(uint32_t, max_state);
+  }
+  // 'fail' is used both as the queue of the breadth first traversal
+  // and to record the failure link of each state.
+  uint32_t *fail = M_MEMORY_REALLOC(m_context, uint32_t, NULL, 0, 2 * max_state);
+  if (M_UNLIKELY_NOMEM (fail == NULL)) {
+    M_MEMORY_FULL(uint32_t, 2 * max_state);
+  }
+  uint32_t *queue = fail + max_state;
+
+  // Build the trie of the patterns.
+  // The root (state 0) cannot be a child, so 0 means 'no child' yet.
+  memset(delta, 0, max_state * num_class * sizeof(uint32_t));
+  depth[0] = 0;
+  match[0] = 0;
+  uint32_t num_state = 1;
+  for(size_t i = 0; i < num; i++) {
+    uint32_t state = 0;
+    for(const unsigned char *p = (const unsigned char *) patterns[i]; *p != 0; p++) {
+      uint32_t *next = &delta[state * num_class + s->class_tab[*p]];
+      if (*next == 0) {
+        depth[num_state] = depth[state] + 1;
+        match[num_state] = 0;
+        *next = num_state++;
+      }
+      state = *next;
+    }
+    // In case of duplicate patterns, the first one is kept.
+    if (match[state] == 0) {
+      match[state] = (uint32_t) (i + 1);
+    }
+  }
+
+  // Compute the failure links in breadth first order
+  // and transform the trie into a full transition table
+  size_t head = 0, tail = 0;
+  for(size_t c = 0; c < num_class; c++) {
+    uint32_t child = delta[c];
+    if (child != 0) {
+      fail[child] = 0;
+      queue[tail++] = child;
+    }
+  }
+  while (head < tail) {
+    uint32_t state = queue[head++];
+    uint32_t link  = fail[state];
+    // Inherit the longest pattern which is a proper suffix of the state
+    if (match[state] == 0) {
+      match[state] = match[link];
+    }
+    for(size_t c = 0; c < num_class; c++) {
+      uint32_t child = delta[state * num_class + c];
+      if (child != 0) {
+        fail[child] = delta[link * num_class + c];
+        queue[tail++] = child;
+      } else {
+        delta[state * num_class + c] = delta[link * num_class + c];
+      }
+    }
+  }
+  M_MEMORY_FREE(m_context, uint32_t, fail, 2 * max_state);
+  M_ASSERT (num_state <= max_state);
+
+  // Replace the next states by the offset of their rows in the table
+  // and flag the states which recognize a pattern
+  for(size_t j = 0; j < (size_t) num_state * num_class; j++) {
+    const uint32_t next = delta[j];
+    delta[j] = (uint32_t) ((next * num_class) << 1) | (match[next] != 0);
+  }
+  s->num_state = max_state;
+  s->num_class = num_class;
+  s->delta     = delta;
+  s->depth     = depth;
+  s->match     = match;
+}
+
+/* Compile the given table of 'num' patterns into a search object.
+   The patterns shall not be empty. */
+M_P(void, m_string_searcher, _init_multi, m_string_searcher_t s, size_t num, const char *const patterns[])
+{
+  M_ASSERT (s != NULL && num >= 1 && patterns != NULL);
+  s->num       = num;
+  s->pattern   = NULL;
+  s->num_state = 0;
+  s->num_class = 0;
+  s->delta     = NULL;
+  s->depth     = NULL;
+  s->match     = NULL;
+  s->size      = M_MEMORY_REALLOC(m_context, size_t, NULL, 0, num);
+  if (M_UNLIKELY_NOMEM (s->size == NULL)) {
+    M_MEMORY_FULL(size_t, num);
+  }
+  for(size_t i = 0; i < num; i++) {
+    M_ASSERT (patterns[i] != NULL && patterns[i][0] != 0);
+    s->size[i] = strlen(patterns[i]);
+  }
+  if (num == 1) {
+    s->pattern = M_MEMORY_REALLOC(m_context, char, NULL, 0, s->size[0] + 1);
+    if (M_UNLIKELY_NOMEM (s->pattern == NULL)) {
+      M_MEMORY_FULL(char, s->size[0] + 1);
+    }
+    memcpy(s->pattern, patterns[0], s->size[0] + 1);
+  } else {
+    m_str1ng_searcher_build M_R(s, num, patterns);
+  }
+  M_STR1NG_SEARCHER_CONTRACT(s);
+}
+
+/* Compile the given non empty C string into a search object */
+M_P(void, m_string_searcher, _init_cstr, m_string_searcher_t s, const char pattern[])
+{
+  m_string_searcher_init_multi M_R(s, 1, &pattern);
+}
+
+/* Compile the given non empty string into a search object */
+M_P(void, m_string_searcher, _init, m_string_searcher_t s, const m_string_t pattern)
+{
+  M_STR1NG_CONTRACT (pattern);
+  m_string_searcher_init_cstr M_R(s, m_string_get_cstr(pattern));
+}
+
+/* Clear the search object (destructor) */
+M_P(void, m_string_searcher, _clear, m_string_searcher_t s)
+{
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  if (s->num == 1) {
+    M_MEMORY_FREE(m_context, char, s->pattern, s->size[0] + 1);
+  } else {
+    M_MEMORY_FREE(m_context, uint32_t, s->delta, s->num_state * s->num_class);
+    M_MEMORY_FREE(m_context, uint32_t, s->depth, s->num_state);
+    M_MEMORY_FREE(m_context, uint32_t, s->match, s->num_state);
+  }
+  M_MEMORY_FREE(m_context, size_t, s->size, s->num);
+  s->size    = NULL;
+  s->pattern = NULL;
+  s->delta   = NULL;
+}
+
+/* Return the number of patterns of the search object */
+M_INLINE size_t
+m_string_searcher_size(const m_string_searcher_t s)
+{
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  return s->num;
+}
+
+/* Return the size of the pattern 'idx' of the search object */
+M_INLINE size_t
+m_string_searcher_pattern_size(const m_string_searcher_t s, size_t idx)
+{
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  M_ASSERT_INDEX (idx, s->num);
+  return s->size[idx];
+}
+
+/* Test if the pattern of the search object matches the text at offset i
+   (the text has enough bytes after i) */
+M_INLINE bool
+m_str1ng_searcher_match_p(const m_string_searcher_t s, const char text[], size_t i)
+{
+  const size_t n = s->size[0];
+  return text[i] == s->pattern[0] && text[i+n-1] == s->pattern[n-1]
+    && memcmp(&text[i+1], &s->pattern[1], n-1) == 0;
+}
+
+/* Search for the pattern of a search object of one pattern.
+   The libc memchr is used to search for its first byte as long as
+   the first byte is rare enough in the text. Otherwise, it switches to
+   a filter of 8 positions at a time on both the first and the last byte
+   of the pattern. */
+M_INLINE size_t
+m_str1ng_searcher_find1(const m_string_searcher_t s, const char text[], size_t size, size_t start)
+{
+  const size_t n = s->size[0];
+  if (n > size || start > size - n) {
+    return M_STRING_FAILURE;
+  }
+  // end is the number of possible offsets of the pattern
+  const size_t end = size - n + 1;
+  size_t i = start, false_hit = 0;
+  while (i < end) {
+    const char *p = M_ASSIGN_CAST(const char *, memchr(&text[i], s->pattern[0], end - i));
+    if (p == NULL) {
+      return M_STRING_FAILURE;
+    }
+    i = (size_t) (p - text);
+    if (m_str1ng_searcher_match_p(s, text, i)) {
+      return i;
+    }
+    i++;
+    if (M_UNLIKELY (++false_hit * 32 > i - start + 256)) {
+      break;
+    }
+  }
+  const uint64_t first = M_STR1NG_LOW_BITS * (unsigned char) s->pattern[0];
+  const uint64_t last  = M_STR1NG_LOW_BITS * (unsigned char) s->pattern[n-1];
+  while (i + 8 <= end) {
+    const uint64_t m = m_str1ng_zero_bytes64(m_str1ng_load64(&text[i]) ^ first)
+      & m_str1ng_zero_bytes64(m_str1ng_load64(&text[i+n-1]) ^ last);
+    if (M_UNLIKELY (m != 0)) {
+      for(size_t k = 0; k < 8; k++) {
+        if (m_str1ng_searcher_match_p(s, text, i + k)) {
+          return i + k;
+        }
+      }
+    }
+    i += 8;
+  }
+  for( ; i < end; i++) {
+    if (m_str1ng_searcher_match_p(s, text, i)) {
+      return i;
+    }
+  }
+  return M_STRING_FAILURE;
+}
+
+/* Search for the patterns of a search object of several patterns
+   using its automaton. The entries of the transition table are the
+   offsets of the rows of the next states (shifted by one),
+   with the low bit set if the next state recognizes a pattern. */
+M_INLINE size_t
+m_str1ng_searcher_findn(const m_string_searcher_t s, const char text[], size_t size, size_t start, size_t *idx)
+{
+  const uint32_t *delta = s->delta;
+  const unsigned char *class_tab = s->class_tab;
+  const size_t num_class = s->num_class;
+  uint32_t e = 0;
+  size_t i;
+  // Run the automaton until a pattern is recognized
+  for(i = start; i < size; i++) {
+    e = delta[(e >> 1) + class_tab[(unsigned char) text[i]]];
+    if (M_UNLIKELY (e & 1)) {
+      break;
+    }
+  }
+  if (i == size) {
+    return M_STRING_FAILURE;
+  }
+  size_t state = (e >> 1) / num_class;
+  size_t best = i + 1 - s->size[s->match[state] - 1];
+  *idx = s->match[state] - 1;
+  // Continue as long as a longer pattern starting at best may be recognized.
+  // The states can only represent suffixes which start further.
+  for(i++; i < size; i++) {
+    e = delta[(e >> 1) + class_tab[(unsigned char) text[i]]];
+    state = (e >> 1) / num_class;
+    if (i + 1 - s->depth[state] > best) {
+      break;
+    }
+    if (e & 1) {
+      const size_t pos = i + 1 - s->size[s->match[state] - 1];
+      if (pos <= best) {
+        best = pos;
+        *idx = s->match[state] - 1;
+      }
+    }
+  }
+  return best;
+}
+
+/* Search for the first occurrence of any pattern of the search object
+   in the buffer 'text' of 'size' bytes from the offset 'start'.
+   If several patterns match, the leftmost one is returned,
+   and the longest one if several of them start at the same offset.
+   Return its offset and set *idx to the index of the pattern
+   or return M_STRING_FAILURE if not found. */
+M_INLINE size_t
+m_str1ng_searcher_find(const m_string_searcher_t s, const char text[], size_t size, size_t start, size_t *idx)
+{
+  *idx = 0;
+  if (s->num == 1) {
+    return m_str1ng_searcher_find1(s, text, size, start);
+  }
+  return m_str1ng_searcher_findn(s, text, size, start, idx);
+}
+
+/* Search for the first occurrence of any pattern of the compiled search object
+   in the string from the position start.
+   If idx is not NULL, set *idx to the index of the matching pattern.
+   Return M_STRING_FAILURE if not found.
+   By default, start is zero and idx is NULL. */
+M_INLINE size_t
+m_string_search_compiled(const m_string_t v, const m_string_searcher_t s, size_t start, size_t *idx)
+{
+  M_STR1NG_CONTRACT (v);
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  M_ASSERT_INDEX (start, m_string_size(v)+1);
+  size_t i;
+  return m_str1ng_searcher_find(s, m_string_get_cstr(v), m_string_size(v), start, idx == NULL ? &i : idx);
+}
+
+/* Find all the non overlapping occurrences of the patterns of the compiled
+   search object in the string in one pass.
+   The offset of the first 'max' occurrences are stored in 'pos'
+   and the index of their pattern in 'idx' (if not NULL).
+   Return the total number of occurrences (which may be greater than 'max'). */
+M_INLINE size_t
+m_string_find_all(const m_string_t v, const m_string_searcher_t s, size_t max, size_t pos[], size_t idx[])
+{
+  M_STR1NG_CONTRACT (v);
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  M_ASSERT (max == 0 || pos != NULL);
+  const char *text = m_string_get_cstr(v);
+  const size_t size = m_string_size(v);
+  size_t count = 0, start = 0, i, k;
+  while ((i = m_str1ng_searcher_find(s, text, size, start, &k)) != M_STRING_FAILURE) {
+    if (count < max) {
+      pos[count] = i;
+      if (idx != NULL) {
+        idx[count] = k;
+      }
+    }
+    count++;
+    start = i + s->size[k];
+  }
+  return count;
+}
+
+/* Replace in the string all the non overlapping occurrences of the patterns
+   of the compiled search object by the C string of 'replacement'
+   of the same index, in one pass. */
+M_P(void, m_string, _replace_all_multi, m_string_t v, const m_string_searcher_t s, const char *const replacement[])
+{
+  M_STR1NG_CONTRACT (v);
+  M_STR1NG_SEARCHER_CONTRACT(s);
+  M_ASSERT (replacement != NULL);
+  const char *text = m_string_get_cstr(v);
+  const size_t size = m_string_size(v);
+  size_t start = 0, k;
+  size_t i = m_str1ng_searcher_find(s, text, size, 0, &k);
+  if (i == M_STRING_FAILURE) {
+    return;
+  }
+  // Build the new string in a temporary and swap them at the end
+  m_string_t tmp;
+  m_string_init(tmp);
+  char *ptr = m_str1ng_fit2size M_R(tmp, size + 1);
+  size_t len = 0;
+  do {
+    M_ASSERT (replacement[k] != NULL);
+    const size_t r = strlen(replacement[k]);
+    ptr = m_str1ng_fit2size M_R(tmp, len + (i - start) + r + 1);
+    memcpy(&ptr[len], &text[start], i - start);
+    len += i - start;
+    memcpy(&ptr[len], replacement[k], r);
+    len += r;
+    start = i + s->size[k];
+    i = m_str1ng_searcher_find(s, text, size, start, &k);
+  } while (i != M_STRING_FAILURE);
+  ptr = m_str1ng_fit2size M_R(tmp, len + (size - start) + 1);
+  memcpy(&ptr[len], &text[start], size - start + 1);
+  m_str1ng_set_size(tmp, len + size - start);
+  m_string_swap(v, tmp);
+  m_string_clear M_R(tmp);
+  M_STR1NG_CONTRACT (v);
+}
+
 // Define the fast integer to string conversions if requested
 // or if no support for stdarg.
 #if M_USE_FAST_STRING_CONV == 1 || M_USE_STDARG == 0
@@ -1159,6 +1594,65 @@ M_P(void, m_string, _set_sj, m_string_t v, long long n)
 }
 #endif
 
+/* Internal: append the 'n' characters of the buffer 'buf' to the string 'v' */
+M_P(void, m_str1ng, _cat_buffer, m_string_t v, const char buf[], size_t n)
+{
+  M_STR1NG_CONTRACT (v);
+  const size_t old_size = m_string_size(v);
+  char *ptr = m_str1ng_fit2size M_R(v, old_size + n + 1);
+  memcpy(&ptr[old_size], buf, n);
+  ptr[old_size + n] = 0;
+  m_str1ng_set_size(v, old_size + n);
+  M_STR1NG_CONTRACT (v);
+}
+
+/* Concatenate the decimal representation of the integer 'n' to the string 'v' */
+M_P(void, m_string, _cat_ui, m_string_t v, unsigned int n)
+{
+  char buffer[M_CORE_FMT_INT_SIZE];
+  size_t len = m_core_fmt_uj(buffer, n);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+
+M_P(void, m_string, _cat_si, m_string_t v, int n)
+{
+  char buffer[M_CORE_FMT_INT_SIZE];
+  size_t len = m_core_fmt_sj(buffer, n);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+
+M_P(void, m_string, _cat_uj, m_string_t v, unsigned long long n)
+{
+  char buffer[M_CORE_FMT_INT_SIZE];
+  size_t len = m_core_fmt_uj(buffer, n);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+
+M_P(void, m_string, _cat_sj, m_string_t v, long long n)
+{
+  char buffer[M_CORE_FMT_INT_SIZE];
+  size_t len = m_core_fmt_sj(buffer, n);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+
+#if M_USE_STDIO
+/* Concatenate the shortest decimal representation of 'x'
+   which reads back to the same value to the string 'v' */
+M_P(void, m_string, _cat_double, m_string_t v, double x)
+{
+  char buffer[M_CORE_FMT_FLOAT_SIZE];
+  size_t len = m_core_fmt_double(buffer, x);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+
+M_P(void, m_string, _cat_float, m_string_t v, float x)
+{
+  char buffer[M_CORE_FMT_FLOAT_SIZE];
+  size_t len = m_core_fmt_float(buffer, x);
+  m_str1ng_cat_buffer M_R(v, buffer, len);
+}
+#endif
+
 #if M_USE_STDARG
 
 /* Format in the string the given printf format */
@@ -1505,20 +1999,17 @@ m_string_oor_set(m_string_t s, unsigned char n)
    \n, \t & \r by their standard representation
    and other not printable character with \0xx */
 
-/* Transform the string 'v2' into a formatted string
+/* Transform the 'str_size' characters of 'str' into a formatted string
    and set it to (or append in) the string 'v'. */
-M_P(void, m_string, _get_str, m_string_t v, const m_string_t v2, bool append)
+M_P(void, m_str1ng, _get_strn, m_string_t v, const char str[], size_t str_size, bool append)
 {
-  M_STR1NG_CONTRACT(v2);
   M_STR1NG_CONTRACT(v);
-  M_ASSERT (v != v2); // Limitation
   size_t size = append ? m_string_size(v) : 0;
-  size_t v2_size = m_string_size(v2);
-  size_t targetSize = size + v2_size + 3;
+  size_t targetSize = size + str_size + 3;
   char *ptr = m_str1ng_fit2size M_R(v, targetSize);
   ptr[size ++] = '"';
-  for(size_t i = 0 ; i < v2_size; i++) {
-    const char c = m_string_get_char(v2,i);
+  for(size_t i = 0 ; i < str_size; i++) {
+    const char c = str[i];
     switch (c) {
     case '\\':
     case '"':
@@ -1557,19 +2048,25 @@ M_P(void, m_string, _get_str, m_string_t v, const m_string_t v2, bool append)
   M_STR1NG_CONTRACT (v);
 }
 
+/* Transform the string 'v2' into a formatted string
+   and set it to (or append in) the string 'v'. */
+M_P(void, m_string, _get_str, m_string_t v, const m_string_t v2, bool append)
+{
+  M_STR1NG_CONTRACT(v2);
+  M_ASSERT (v != v2); // Limitation
+  m_str1ng_get_strn M_R(v, m_string_get_cstr(v2), m_string_size(v2), append);
+}
+
 #if M_USE_STDIO
 
-/* Transform the string 'v2' into a formatted string
-   and output it in the given FILE */
+/* Output the 'size' characters of 'str' in the given FILE
+   with the escape sequences of a formatted string (without the quotes) */
 M_INLINE void
-m_string_out_str(FILE *f, const m_string_t v)
+m_str1ng_out_escaped(FILE *f, const char str[], size_t size)
 {
-  M_STR1NG_CONTRACT(v);
   M_ASSERT (f != NULL);
-  fputc('"', f);
-  size_t size = m_string_size(v);
   for(size_t i = 0 ; i < size; i++) {
-    const char c = m_string_get_char(v, i);
+    const char c = str[i];
     switch (c) {
     case '\\':
     case '"':
@@ -1592,9 +2089,27 @@ m_string_out_str(FILE *f, const m_string_t v)
       break;
     }
   }
+}
+
+/* Transform the 'size' characters of 'str' into a formatted string
+   and output it in the given FILE */
+M_INLINE void
+m_str1ng_out_strn(FILE *f, const char str[], size_t size)
+{
+  fputc('"', f);
+  m_str1ng_out_escaped(f, str, size);
   fputc('"', f);
 }
 
+/* Transform the string 'v' into a formatted string
+   and output it in the given FILE */
+M_INLINE void
+m_string_out_str(FILE *f, const m_string_t v)
+{
+  M_STR1NG_CONTRACT(v);
+  m_str1ng_out_strn(f, m_string_get_cstr(v), m_string_size(v));
+}
+
 /* Read the formatted string from the FILE
    and set the converted value in the string 'v'.
    Return true in case of success */
@@ -1638,83 +2153,603 @@ M_P(bool, m_string, _in_str, m_string_t v, FILE *f)
     m_string_push_back M_R(v, (char) c);
     c = fgetc(f);
   }
-  return c == '"';
+  return c == '"';
+}
+
+#endif // Have stdio
+
+/* Read the formatted string from the C string
+   and set the converted value in the string 'v'.
+   Return true in case of success
+   If endptr is not null, update the position of the parsing.
+*/
+M_P(bool, m_string, _parse_str, m_string_t v, const char str[], const char **endptr)
+{
+  M_STR1NG_CONTRACT(v);
+  M_ASSERT (str != NULL);
+  bool success = false;
+  int c = *str++;
+  if (c != '"') goto exit;
+  m_string_reset(v);
+  c = *str++;
+  while (c != '"' && c != 0) {
+    if (M_UNLIKELY (c == '\\')) {
+      c = *str++;
+      switch (c) {
+      case 'n':
+      case 't':
+      case 'r':
+      case '\\':
+      case '\"':
+        // This string acts as a perfect hashmap which supposes an ASCII mapping
+        // and (c^(c>>5)) is the hash function
+        c = " \r \" \n\\\t"[(c^(c>>5))& 0x07];
+        break;
+      default:
+        if (!(c >= '0' && c <= '7'))
+          goto exit;
+        int d1 = c - '0';
+        c = *str++;
+        if (!(c >= '0' && c <= '7'))
+          goto exit;
+        int d2 = c - '0';
+        c = *str++;
+        if (!(c >= '0' && c <= '7'))
+          goto exit;
+        int d3 = c - '0';
+        c = (d1 << 6) + (d2 << 3) + d3;
+        break;
+      }
+    }
+    m_string_push_back M_R(v, (char) c);
+    c = *str++;
+  }
+  success = (c == '"');
+ exit:
+  if (endptr != NULL) *endptr = str;
+  return success;
+}
+
+/* Transform the string 'v2' into a formatted string
+   and output it in the given serializer
+   See serialization for return code.
+*/
+M_P(m_serial_return_code_t, m_string, _out_serial, m_serial_write_t serial, const m_string_t v)
+{
+  M_ASSERT (serial != NULL && serial->m_interface != NULL);
+  return serial->m_interface->write_string M_R(serial, m_string_get_cstr(v), m_string_size(v) );
+}
+
+/* Read the formatted string from the serializer
+   and set the converted value in the string 'v'.
+   See serialization for return code.
+*/
+M_P(m_serial_return_code_t, m_string, _in_serial, m_string_t v, m_serial_read_t serial)
+{
+  M_ASSERT (serial != NULL && serial->m_interface != NULL);
+  return serial->m_interface->read_string M_R(serial, v);
+}
+
+/***********************************************************************/
+/*                                                                     */
+/*                           STRING VIEW                               */
+/*                                                                     */
+/***********************************************************************/
+
+/* A string view is a read only reference to a sequence of characters
+   that it doesn't own (which is not necessarily null terminated).
+   It is a small value type which remains valid as long as
+   the referenced characters are not modified nor freed.
+   For a string, any modification of the string invalidates its views. */
+typedef struct m_string_view_s {
+  const char *ptr;
+  size_t      size;
+} m_string_view_t;
+
+/* Return a view of the 'size' first characters of the buffer 'str' */
+M_INLINE m_string_view_t
+m_string_view_cstrn(const char str[], size_t size)
+{
+  M_ASSERT (str != NULL || size == 0);
+  m_string_view_t sv;
+  sv.ptr  = str;
+  sv.size = size;
+  return sv;
+}
+
+/* Return a view of the C string 'str' */
+M_INLINE m_string_view_t
+m_string_view_cstr(const char str[])
+{
+  M_ASSERT (str != NULL);
+  return m_string_view_cstrn(str, strlen(str));
+}
+
+/* Return a view of the string */
+M_INLINE m_string_view_t
+m_string_get_view(const m_string_t v)
+{
+  M_STR1NG_CONTRACT (v);
+  return m_string_view_cstrn(m_string_get_cstr(v), m_string_size(v));
+}
+
+/* Return the view of at most 'size' characters of the view from 'offset' */
+M_INLINE m_string_view_t
+m_string_view_mid(const m_string_view_t sv, size_t offset, size_t size)
+{
+  M_ASSERT_INDEX (offset, sv.size + 1);
+  return m_string_view_cstrn(sv.ptr + offset, M_MIN(sv.size - offset, size));
+}
+
+/* Return the pointer to the characters of the view (not null terminated) */
+M_INLINE const char *
+m_string_view_data(const m_string_view_t sv)
+{
+  return sv.ptr;
+}
+
+/* Return the number of characters of the view */
+M_INLINE size_t
+m_string_view_size(const m_string_view_t sv)
+{
+  return sv.size;
+}
+
+/* Test if the view is empty */
+M_INLINE bool
+m_string_view_empty_p(const m_string_view_t sv)
+{
+  return sv.size == 0;
+}
+
+/* Return the character at the position 'index' of the view */
+M_INLINE char
+m_string_view_get_char(const m_string_view_t sv, size_t index)
+{
+  M_ASSERT_INDEX (index, sv.size);
+  return sv.ptr[index];
+}
+
+/* Test if both views are equal */
+M_INLINE bool
+m_string_view_equal_p(const m_string_view_t sv1, const m_string_view_t sv2)
+{
+  return sv1.size == sv2.size
+    && (sv1.size == 0 || memcmp(sv1.ptr, sv2.ptr, sv1.size) == 0);
+}
+
+/* Test if the view is equal to the C string */
+M_INLINE bool
+m_string_view_equal_cstr_p(const m_string_view_t sv, const char str[])
+{
+  M_ASSERT (str != NULL);
+  return m_string_view_equal_p(sv, m_string_view_cstr(str));
+}
+
+/* Test if the string is equal to the view */
+M_INLINE bool
+m_string_equal_view_p(const m_string_t v, const m_string_view_t sv)
+{
+  return m_string_view_equal_p(m_string_get_view(v), sv);
+}
+
+/* Compare both views and return the sort order
+   (negative if less, 0 if equal, positive if greater) */
+M_INLINE int
+m_string_view_cmp(const m_string_view_t sv1, const m_string_view_t sv2)
+{
+  const size_t size = M_MIN(sv1.size, sv2.size);
+  int c = size == 0 ? 0 : memcmp(sv1.ptr, sv2.ptr, size);
+  if (c == 0) {
+    c = (sv1.size > sv2.size) - (sv1.size < sv2.size);
+  }
+  return c;
+}
+
+/* Return the hash of the view,
+   which is equal to the hash of a string of the same characters */
+M_INLINE size_t
+m_string_view_hash(const m_string_view_t sv)
+{
+  return m_core_hash(sv.ptr, sv.size);
+}
+
+/* Return the view without any characters from tab
+   at the beginning and at the end of the view. */
+M_INLINE m_string_view_t
+m_string_view_strim(const m_string_view_t sv, const char tab[])
+{
+  const char *b = sv.ptr;
+  size_t size = sv.size;
+  while (size > 0 && m_str1ng_strim_char(b[size-1], tab))
+    size --;
+  while (size > 0 && m_str1ng_strim_char(*b, tab)) {
+    b++;
+    size--;
+  }
+  return m_string_view_cstrn(b, size);
+}
+
+/* Split the view into fields separated by the character 'sep'
+   and store the views of the first 'max' fields into 'tab'.
+   Empty fields are kept.
+   Return the total number of fields (which may be greater than 'max'). */
+M_INLINE size_t
+m_string_view_split(m_string_view_t tab[], size_t max, const m_string_view_t sv, char sep)
+{
+  M_ASSERT (max == 0 || tab != NULL);
+  const char *p = sv.ptr;
+  const char *end = sv.ptr + sv.size;
+  size_t n = 0;
+  while (true) {
+    const char *q = p == end ? NULL
+      : M_ASSIGN_CAST(const char *, memchr(p, sep, (size_t) (end - p)));
+    if (q == NULL) {
+      q = end;
+    }
+    if (n < max) {
+      tab[n] = m_string_view_cstrn(p, (size_t) (q - p));
+    }
+    n++;
+    if (q == end) {
+      return n;
+    }
+    p = q + 1;
+  }
+}
+
+/* Split the string into fields separated by the character 'sep'
+   and store the views of the first 'max' fields into 'tab'
+   (See m_string_view_split) */
+M_INLINE size_t
+m_string_split_view(m_string_view_t tab[], size_t max, const m_string_t v, char sep)
+{
+  return m_string_view_split(tab, max, m_string_get_view(v), sep);
+}
+
+/* Tokenizer of a view: iterate over the tokens of a view
+   which are separated by any number of characters of a separator set */
+typedef struct m_string_tokenize_s {
+  m_string_view_t token;         // Current token
+  const char     *end;           // End of the view
+  const char     *sep;           // C string of the separator characters
+} m_string_tokenize_t[1];
+
+/* Update the current token of the tokenizer from the pointer 'p' */
+M_INLINE void
+m_str1ng_tokenize_from(m_string_tokenize_t it, const char *p)
+{
+  while (p != it->end && m_str1ng_strim_char(*p, it->sep)) {
+    p++;
+  }
+  const char *q = p;
+  while (q != it->end && !m_str1ng_strim_char(*q, it->sep)) {
+    q++;
+  }
+  it->token = m_string_view_cstrn(p, (size_t) (q - p));
+}
+
+/* Initialize the tokenizer over the view 'sv' with the set of separator
+   characters 'sep' and set it to the first token.
+   The C string 'sep' shall remain valid during the iteration. */
+M_INLINE void
+m_string_tokenize(m_string_tokenize_t it, const m_string_view_t sv, const char sep[])
+{
+  M_ASSERT (sep != NULL);
+  it->end = sv.ptr + sv.size;
+  it->sep = sep;
+  m_str1ng_tokenize_from(it, sv.ptr);
+}
+
+/* Test if there is no more token */
+M_INLINE bool
+m_string_tokenize_end_p(const m_string_tokenize_t it)
+{
+  return it->token.size == 0;
+}
+
+/* Move the tokenizer to the next token */
+M_INLINE void
+m_string_tokenize_next(m_string_tokenize_t it)
+{
+  M_ASSERT (!m_string_tokenize_end_p(it));
+  m_str1ng_tokenize_from(it, it->token.ptr + it->token.size);
+}
+
+/* Return a constant pointer to the view of the current token */
+M_INLINE const m_string_view_t *
+m_string_tokenize_cref(const m_string_tokenize_t it)
+{
+  M_ASSERT (!m_string_tokenize_end_p(it));
+  return &it->token;
+}
+
+/* Set the string to the characters of the view */
+M_P(void, m_string, _set_view, m_string_t v, const m_string_view_t sv)
+{
+  M_STR1NG_CONTRACT (v);
+  char *ptr = m_str1ng_fit2size M_R(v, sv.size + 1);
+  // The view may reference the string, so a memmove is needed
+  if (sv.size > 0) {
+    memmove(ptr, sv.ptr, sv.size);
+  }
+  ptr[sv.size] = 0;
+  m_str1ng_set_size(v, sv.size);
+  M_STR1NG_CONTRACT (v);
+}
+
+/* Concatenate the characters of the view to the string.
+   The view shall not reference the string. */
+M_P(void, m_string, _cat_view, m_string_t v, const m_string_view_t sv)
+{
+  M_STR1NG_CONTRACT (v);
+  if (M_LIKELY (sv.size > 0)) {
+    const size_t old_size = m_string_size(v);
+    char *ptr = m_str1ng_fit2size M_R(v, old_size + sv.size + 1);
+    memcpy(&ptr[old_size], sv.ptr, sv.size);
+    ptr[old_size + sv.size] = 0;
+    m_str1ng_set_size(v, old_size + sv.size);
+  }
+  M_STR1NG_CONTRACT (v);
+}
+
+/* Initialize the string to the characters of the view (constructor) */
+M_P(void, m_string, _init_set_view, m_string_t v, const m_string_view_t sv)
+{
+  m_string_init(v);
+  m_string_set_view M_R(v, sv);
+}
+
+/* Transform the view into a formatted string
+   and set it to (or append in) the string 'v'. */
+M_P(void, m_string_view, _get_str, m_string_t v, const m_string_view_t sv, bool append)
+{
+  m_str1ng_get_strn M_R(v, sv.ptr, sv.size, append);
+}
+
+#if M_USE_STDIO
+/* Transform the view into a formatted string
+   and output it in the given FILE */
+M_INLINE void
+m_string_view_out_str(FILE *f, const m_string_view_t sv)
+{
+  m_str1ng_out_strn(f, sv.ptr, sv.size);
+}
+#endif
+
+/* Output the view into the serializer */
+M_P(m_serial_return_code_t, m_string_view, _out_serial, m_serial_write_t serial, const m_string_view_t sv)
+{
+  M_ASSERT (serial != NULL && serial->m_interface != NULL);
+  return serial->m_interface->write_string M_R(serial, sv.ptr, sv.size);
+}
+
+#if M_USE_STDIO
+
+/* BUFFERED READER:
+   Read a FILE per big blocks into a buffer and provide its lines (or words)
+   as views on this buffer, without calling the FILE functions
+   for each line nor allocating memory for each line.
+ */
+
+/* Initial size of the buffer of a string reader.
+   The buffer is enlarged if a line doesn't fit in it */
+#ifndef M_USE_STRING_READER_SIZE
+#define M_USE_STRING_READER_SIZE 65536
+#endif
+
+/* Buffered reader of a FILE */
+typedef struct m_string_reader_s {
+  FILE *f;                // Read FILE
+  char *buffer;           // Buffer of the read characters
+  size_t alloc;           // Allocated size of the buffer
+  size_t pos;             // Offset in the buffer of the first unconsumed character
+  size_t end;             // Offset in the buffer of the end of the read characters
+  size_t offset;          // Number of consumed characters before the buffer
+  bool eof;               // True if the end of the FILE has been reached
+  bool stream;            // True if the FILE is not seekable (pipe, terminal, ...)
+} m_string_reader_t[1];
+
+#define M_STR1NG_READER_CONTRACT(r) do {                                      \
+    M_ASSERT ((r) != NULL && (r)->f != NULL && (r)->buffer != NULL);          \
+    M_ASSERT ((r)->pos <= (r)->end && (r)->end <= (r)->alloc);                \
+  } while (0)
+
+/* Initialize the reader for the given FILE */
+M_P(void, m_string_reader, _init, m_string_reader_t r, FILE *f)
+{
+  M_ASSERT (f != NULL);
+  char *ptr = M_MEMORY_REALLOC(m_context, char, NULL, 0, M_USE_STRING_READER_SIZE);
+  if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+    M_MEMORY_FULL(char, M_USE_STRING_READER_SIZE);
+  }
+  r->f      = f;
+  r->buffer = ptr;
+  r->alloc  = M_USE_STRING_READER_SIZE;
+  r->pos    = 0;
+  r->end    = 0;
+  r->offset = 0;
+  r->eof    = false;
+  // A pipe or a terminal can't tell its position
+  r->stream = ftell(f) < 0;
+  M_STR1NG_READER_CONTRACT(r);
 }
 
-#endif // Have stdio
+/* Clear the reader (the FILE is not closed) */
+M_P(void, m_string_reader, _clear, m_string_reader_t r)
+{
+  M_STR1NG_READER_CONTRACT(r);
+  M_MEMORY_FREE(m_context, char, r->buffer, r->alloc);
+  r->buffer = NULL;
+}
 
-/* Read the formatted string from the C string
-   and set the converted value in the string 'v'.
-   Return true in case of success
-   If endptr is not null, update the position of the parsing.
-*/
-M_P(bool, m_string, _parse_str, m_string_t v, const char str[], const char **endptr)
+/* Return the number of characters consumed by the reader */
+M_INLINE size_t
+m_string_reader_tell(const m_string_reader_t r)
 {
-  M_STR1NG_CONTRACT(v);
-  M_ASSERT (str != NULL);
-  bool success = false;
-  int c = *str++;
-  if (c != '"') goto exit;
-  m_string_reset(v);
-  c = *str++;
-  while (c != '"' && c != 0) {
-    if (M_UNLIKELY (c == '\\')) {
-      c = *str++;
-      switch (c) {
-      case 'n':
-      case 't':
-      case 'r':
-      case '\\':
-      case '\"':
-        // This string acts as a perfect hashmap which supposes an ASCII mapping
-        // and (c^(c>>5)) is the hash function
-        c = " \r \" \n\\\t"[(c^(c>>5))& 0x07];
-        break;
-      default:
-        if (!(c >= '0' && c <= '7'))
-          goto exit;
-        int d1 = c - '0';
-        c = *str++;
-        if (!(c >= '0' && c <= '7'))
-          goto exit;
-        int d2 = c - '0';
-        c = *str++;
-        if (!(c >= '0' && c <= '7'))
-          goto exit;
-        int d3 = c - '0';
-        c = (d1 << 6) + (d2 << 3) + d3;
+  M_STR1NG_READER_CONTRACT(r);
+  return r->offset + r->pos;
+}
+
+/* Read the next block of the FILE after the unconsumed characters,
+   moving them at the beginning of the buffer
+   (and enlarging the buffer if they fill it).
+   Return false if nothing can be read anymore */
+M_P(bool, m_str1ng_reader, _fill, m_string_reader_t r)
+{
+  M_STR1NG_READER_CONTRACT(r);
+  if (r->eof) {
+    return false;
+  }
+  if (r->pos > 0) {
+    memmove(r->buffer, r->buffer + r->pos, r->end - r->pos);
+    r->offset += r->pos;
+    r->end    -= r->pos;
+    r->pos     = 0;
+  }
+  if (r->end == r->alloc) {
+    size_t alloc = r->alloc + r->alloc / 2;
+    if (M_UNLIKELY_NOMEM (alloc <= r->alloc)) {
+      M_MEMORY_FULL(char, alloc);
+    }
+    char *ptr = M_MEMORY_REALLOC(m_context, char, r->buffer, r->alloc, alloc);
+    if (M_UNLIKELY_NOMEM (ptr == NULL)) {
+      M_MEMORY_FULL(char, alloc);
+    }
+    r->buffer = ptr;
+    r->alloc  = alloc;
+  }
+  const size_t request = r->alloc - r->end;
+  size_t n;
+  if (r->stream) {
+    // Don't wait for more characters than the current line,
+    // as they may not be available before long
+    int c = 0;
+    n = 0;
+    while (n < request && c != '\n' && (c = getc(r->f)) != EOF) {
+      r->buffer[r->end + n++] = (char) c;
+    }
+    r->eof = c == EOF;
+  } else {
+    n = fread(r->buffer + r->end, 1, request, r->f);
+    // fread only performs a short read at the end of the FILE (or on error)
+    r->eof = n < request;
+  }
+  r->end += n;
+  M_STR1NG_READER_CONTRACT(r);
+  return n > 0;
+}
+
+/* Read the next line of the FILE and set 'line' to a view of it.
+   With M_STRING_READ_PURE_LINE, the final '\n' or "\r\n" is removed,
+   with M_STRING_READ_LINE, it is kept,
+   and with M_STRING_READ_FILE, all the remaining FILE is read.
+   The view remains valid until the next call to the reader.
+   Return false if there is no more line */
+M_P(bool, m_string_reader, _get_line, m_string_view_t *line, m_string_reader_t r, m_string_fgets_t arg)
+{
+  M_STR1NG_READER_CONTRACT(r);
+  M_ASSERT (line != NULL);
+  const char *eol = NULL;
+  size_t scan = r->pos;
+  while (true) {
+    if (arg != M_STRING_READ_FILE) {
+      eol = (const char *) memchr(r->buffer + scan, '\n', r->end - scan);
+      if (eol != NULL) {
         break;
       }
     }
-    m_string_push_back M_R(v, (char) c);
-    c = *str++;
+    // The characters up to the end of the buffer have been scanned
+    const size_t scanned = r->end - r->pos;
+    if (!m_str1ng_reader_fill M_R(r)) {
+      break;
+    }
+    scan = r->pos + scanned;
   }
-  success = (c == '"');
- exit:
-  if (endptr != NULL) *endptr = str;
-  return success;
+  const size_t start = r->pos;
+  size_t stop = eol == NULL ? r->end : (size_t) (eol - r->buffer) + 1;
+  if (stop == start) {
+    return false;
+  }
+  r->pos = stop;
+  if (arg == M_STRING_READ_PURE_LINE && eol != NULL) {
+    stop --;
+    if (stop > start && r->buffer[stop-1] == '\r') {
+      stop --;
+    }
+  }
+  *line = m_string_view_cstrn(r->buffer + start, stop - start);
+  return true;
 }
 
-/* Transform the string 'v2' into a formatted string
-   and output it in the given serializer
-   See serialization for return code.
-*/
-M_P(m_serial_return_code_t, m_string, _out_serial, m_serial_write_t serial, const m_string_t v)
+/* Read the next line of the FILE and set the string 'v' to it
+   (like m_string_fgets) */
+M_P(bool, m_string_reader, _fgets, m_string_t v, m_string_reader_t r, m_string_fgets_t arg)
 {
-  M_ASSERT (serial != NULL && serial->m_interface != NULL);
-  return serial->m_interface->write_string M_R(serial, m_string_get_cstr(v), m_string_size(v) );
+  m_string_view_t line;
+  if (!m_string_reader_get_line M_R(&line, r, arg)) {
+    m_string_reset(v);
+    return false;
+  }
+  m_string_set_view M_R(v, line);
+  return true;
 }
 
-/* Read the formatted string from the serializer
-   and set the converted value in the string 'v'.
-   See serialization for return code.
-*/
-M_P(m_serial_return_code_t, m_string, _in_serial, m_string_t v, m_serial_read_t serial)
+/* Test if the character is in the set of separators */
+M_INLINE bool
+m_str1ng_reader_sep_p(const uint32_t tab[8], char c)
 {
-  M_ASSERT (serial != NULL && serial->m_interface != NULL);
-  return serial->m_interface->read_string M_R(serial, v);
+  const unsigned char u = (unsigned char) c;
+  return (tab[u / 32] >> (u % 32)) & 1;
+}
+
+/* Read the next word of the FILE and set 'word' to a view of it.
+   Words are separated by any of the characters of 'separator'.
+   The view remains valid until the next call to the reader.
+   Return false if there is no more word */
+M_P(bool, m_string_reader, _get_word, m_string_view_t *word, m_string_reader_t r, const char separator[])
+{
+  M_STR1NG_READER_CONTRACT(r);
+  M_ASSERT (word != NULL && separator != NULL);
+  uint32_t tab[8] = { 0 };
+  for(const char *p = separator; *p != 0; p++) {
+    const unsigned char u = (unsigned char) *p;
+    tab[u / 32] |= UINT32_C(1) << (u % 32);
+  }
+  // Skip the separators
+  while (true) {
+    while (r->pos < r->end && m_str1ng_reader_sep_p(tab, r->buffer[r->pos])) {
+      r->pos ++;
+    }
+    if (r->pos < r->end) {
+      break;
+    }
+    if (!m_str1ng_reader_fill M_R(r)) {
+      return false;
+    }
+  }
+  // Search for the end of the word
+  size_t scan = r->pos;
+  while (true) {
+    while (scan < r->end && !m_str1ng_reader_sep_p(tab, r->buffer[scan])) {
+      scan ++;
+    }
+    if (scan < r->end) {
+      break;
+    }
+    const size_t scanned = scan - r->pos;
+    if (!m_str1ng_reader_fill M_R(r)) {
+      break;
+    }
+    scan = r->pos + scanned;
+  }
+  *word = m_string_view_cstrn(r->buffer + r->pos, scan - r->pos);
+  r->pos = scan;
+  return true;
 }
 
+#endif
+
 /* UTF8 character classification:
  * 
  * 0*       --> type 1 byte  A
@@ -1827,6 +2862,164 @@ m_str1ng_utf8_encode(char buffer[5], m_string_unicode_t u)
   }
 }
 
+/* The following functions process the UTF8 stream word by word
+   (8 bytes at a time) as long as the bytes are ASCII characters,
+   falling back to the generic decoder otherwise. */
+
+/* Skip the ASCII characters at the start of the buffer.
+   Return the index of the first non ASCII character
+   (or a value close to size if there is none) */
+M_INLINE size_t
+m_str1ng_utf8_skip_ascii(const char buf[], size_t i, size_t size)
+{
+  while (i + 8 <= size
+         && (m_str1ng_load64(&buf[i]) & M_STR1NG_HIGH_BITS) == 0) {
+    i += 8;
+  }
+  return i;
+}
+
+/* Test if the decoded state is an error or an invalid code point */
+M_INLINE bool
+m_str1ng_utf8_invalid_p(m_str1ng_utf8_state_e s, m_string_unicode_t u)
+{
+  return (s == M_STR1NG_UTF8_ERROR)
+    || (s == M_STR1NG_UTF8_STARTING
+        && (u > 0x10FFFF /* out of range */
+            || (u >= 0xD800 && u <= 0xDFFF) /* surrogate halves */));
+}
+
+/* Check if the given buffer of 'size' bytes is a valid UTF8 stream
+   NOTE: Non-canonical representation are not always rejected */
+M_INLINE bool
+m_utf8_valid_p(const char buf[], size_t size)
+{
+  M_ASSERT (buf != NULL || size == 0);
+  m_str1ng_utf8_state_e s = M_STR1NG_UTF8_STARTING;
+  m_string_unicode_t u = 0;
+  size_t i = 0;
+  while (true) {
+    // Fast path: skip the ASCII characters between two code points
+    if (s == M_STR1NG_UTF8_STARTING) {
+      i = m_str1ng_utf8_skip_ascii(buf, i, size);
+    }
+    if (i >= size)
+      break;
+    m_str1ng_utf8_decode(buf[i], &s, &u);
+    if (m_str1ng_utf8_invalid_p(s, u))
+      return false;
+    i++;
+  }
+  // The last code point shall be complete
+  return s == M_STR1NG_UTF8_STARTING;
+}
+
+/* Compute the number of unicode code points encoded in the UTF8 buffer
+   of 'size' bytes */
+M_INLINE size_t
+m_utf8_length(const char buf[], size_t size)
+{
+  M_ASSERT (buf != NULL || size == 0);
+  size_t length = 0;
+  size_t i = 0;
+  for( ; i + 8 <= size; i += 8) {
+    const uint64_t w = m_str1ng_load64(&buf[i]);
+    // A continuation byte has its two high bits set to 10
+    const uint64_t cont = w & ~(w << 1) & M_STR1NG_HIGH_BITS;
+    // Sum the number of continuation bytes of the word in its high byte
+    const size_t n = (size_t) (((cont >> 7) * M_STR1NG_LOW_BITS) >> 56);
+    length += 8 - n;
+  }
+  for( ; i < size; i++) {
+    length += m_str1ng_utf8_start_p((unsigned char) buf[i]);
+  }
+  return length;
+}
+
+/* Decode the UTF8 buffer 'src' of 'size' bytes into the UTF32 array 'dst'
+   which can contain up to 'dst_size' code points.
+   Return the number of decoded code points, or SIZE_MAX if the buffer is not
+   a valid UTF8 stream or if 'dst' is too small.
+   NOTE: A 'dst_size' of m_utf8_length(src, size) code points is enough. */
+M_INLINE size_t
+m_utf8_to_utf32(m_string_unicode_t dst[], size_t dst_size, const char src[], size_t size)
+{
+  M_ASSERT (dst != NULL || dst_size == 0);
+  M_ASSERT (src != NULL || size == 0);
+  m_str1ng_utf8_state_e s = M_STR1NG_UTF8_STARTING;
+  m_string_unicode_t u = 0;
+  size_t n = 0;
+  size_t i = 0;
+  while (i < size) {
+    // Fast path: expand a word of ASCII characters at once
+    if (i + 8 <= size && n + 8 <= dst_size
+        && (m_str1ng_load64(&src[i]) & M_STR1NG_HIGH_BITS) == 0) {
+      for(unsigned k = 0; k < 8; k++) {
+        dst[n + k] = (m_string_unicode_t) (unsigned char) src[i + k];
+      }
+      n += 8;
+      i += 8;
+      continue;
+    }
+    // Slow path: decode a full code point
+    do {
+      m_str1ng_utf8_decode(src[i++], &s, &u);
+    } while (s != M_STR1NG_UTF8_STARTING && s != M_STR1NG_UTF8_ERROR && i < size);
+    if (M_UNLIKELY (m_str1ng_utf8_invalid_p(s, u) || s != M_STR1NG_UTF8_STARTING
+                    || n >= dst_size))
+      return SIZE_MAX;
+    dst[n++] = u;
+  }
+  return n;
+}
+
+/* Decode the UTF8 buffer 'src' of 'size' bytes into the UTF16 array 'dst'
+   which can contain up to 'dst_size' code units
+   (the code points above 0xFFFF are encoded as surrogate pairs).
+   Return the number of written code units, or SIZE_MAX if the buffer is not
+   a valid UTF8 stream or if 'dst' is too small.
+   NOTE: A 'dst_size' of 'size' code units is always enough. */
+M_INLINE size_t
+m_utf8_to_utf16(uint16_t dst[], size_t dst_size, const char src[], size_t size)
+{
+  M_ASSERT (dst != NULL || dst_size == 0);
+  M_ASSERT (src != NULL || size == 0);
+  m_str1ng_utf8_state_e s = M_STR1NG_UTF8_STARTING;
+  m_string_unicode_t u = 0;
+  size_t n = 0;
+  size_t i = 0;
+  while (i < size) {
+    // Fast path: expand a word of ASCII characters at once
+    if (i + 8 <= size && n + 8 <= dst_size
+        && (m_str1ng_load64(&src[i]) & M_STR1NG_HIGH_BITS) == 0) {
+      for(unsigned k = 0; k < 8; k++) {
+        dst[n + k] = (uint16_t) (unsigned char) src[i + k];
+      }
+      n += 8;
+      i += 8;
+      continue;
+    }
+    // Slow path: decode a full code point
+    do {
+      m_str1ng_utf8_decode(src[i++], &s, &u);
+    } while (s != M_STR1NG_UTF8_STARTING && s != M_STR1NG_UTF8_ERROR && i < size);
+    if (M_UNLIKELY (m_str1ng_utf8_invalid_p(s, u) || s != M_STR1NG_UTF8_STARTING))
+      return SIZE_MAX;
+    if (M_LIKELY (u <= 0xFFFFu)) {
+      if (M_UNLIKELY (n >= dst_size))
+        return SIZE_MAX;
+      dst[n++] = (uint16_t) u;
+    } else {
+      if (M_UNLIKELY (n + 2 > dst_size))
+        return SIZE_MAX;
+      u -= 0x10000u;
+      dst[n++] = (uint16_t) (0xD800u | (u >> 10));
+      dst[n++] = (uint16_t) (0xDC00u | (u & 0x3FFu));
+    }
+  }
+  return n;
+}
+
 /* Start iteration over the UTF8 encoded unicode code point */
 M_INLINE void
 m_string_it(m_string_it_t it, const m_string_t str)
@@ -2078,7 +3271,7 @@ M_INLINE size_t
 m_string_length_u(const m_string_t str)
 {
   M_STR1NG_CONTRACT(str);
-  return m_str1ng_utf8_length(m_string_get_cstr(str));
+  return m_utf8_length(m_string_get_cstr(str), m_string_size(str));
 }
 
 /* Check if a string is a valid UTF8 encoded stream */
@@ -2086,7 +3279,147 @@ M_INLINE bool
 m_string_utf8_p(const m_string_t str)
 {
   M_STR1NG_CONTRACT(str);
-  return m_str1ng_utf8_valid_str_p(m_string_get_cstr(str));
+  return m_utf8_valid_p(m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Decode the UTF8 string into the UTF32 array 'dst' of 'dst_size' code points.
+   Return the number of code points or SIZE_MAX in case of failure
+   (see m_utf8_to_utf32) */
+M_INLINE size_t
+m_string_get_utf32(m_string_unicode_t dst[], size_t dst_size, const m_string_t str)
+{
+  M_STR1NG_CONTRACT(str);
+  return m_utf8_to_utf32(dst, dst_size, m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Decode the UTF8 string into the UTF16 array 'dst' of 'dst_size' code units.
+   Return the number of code units or SIZE_MAX in case of failure
+   (see m_utf8_to_utf16) */
+M_INLINE size_t
+m_string_get_utf16(uint16_t dst[], size_t dst_size, const m_string_t str)
+{
+  M_STR1NG_CONTRACT(str);
+  return m_utf8_to_utf16(dst, dst_size, m_string_get_cstr(str), m_string_size(str));
+}
+
+/* Return the number of bytes needed to encode the code point in UTF8,
+   or 0 if it cannot be stored in a string
+   (null character, surrogate halves or out of range) */
+M_INLINE size_t
+m_str1ng_utf8_encode_size(m_string_unicode_t u)
+{
+  if (M_LIKELY (u <= 0x7Fu))
+    return u != 0;
+  if (u <= 0x7FFu)
+    return 2;
+  if (u <= 0xFFFFu)
+    return (u >= 0xD800u && u <= 0xDFFFu) ? 0 : 3;
+  return u <= 0x10FFFFu ? 4 : 0;
+}
+
+/* Concatenate the 'n' UTF32 code points of 'src' to the string,
+   encoding them in UTF8.
+   Return false (and let the string unmodified) if one code point
+   is invalid or null */
+M_P(bool, m_string, _cat_utf32, m_string_t str, const m_string_unicode_t src[], size_t n)
+{
+  M_STR1NG_CONTRACT(str);
+  M_ASSERT (src != NULL || n == 0);
+  // First pass: validate and compute the encoded size to allocate only once
+  size_t size = 0;
+  for(size_t i = 0; i < n; i++) {
+    size_t s = m_str1ng_utf8_encode_size(src[i]);
+    if (M_UNLIKELY (s == 0))
+      return false;
+    size += s;
+  }
+  const size_t old_size = m_string_size(str);
+  char *ptr = m_str1ng_fit2size M_R(str, old_size + size + 1);
+  // Second pass: encode
+  char *dst = &ptr[old_size];
+  for(size_t i = 0; i < n; i++) {
+    if (M_LIKELY (src[i] <= 0x7Fu)) {
+      *dst++ = (char) src[i];
+    } else {
+      char buffer[4+1];
+      int s = m_str1ng_utf8_encode(buffer, src[i]);
+      memcpy(dst, buffer, (size_t) s);
+      dst += s;
+    }
+  }
+  *dst = 0;
+  m_str1ng_set_size(str, old_size + size);
+  M_STR1NG_CONTRACT(str);
+  return true;
+}
+
+/* Concatenate the 'n' UTF16 code units of 'src' to the string,
+   encoding them in UTF8.
+   Return false (and let the string unmodified) if 'src' is not a valid
+   UTF16 stream (unpaired surrogate) or contains a null character */
+M_P(bool, m_string, _cat_utf16, m_string_t str, const uint16_t src[], size_t n)
+{
+  M_STR1NG_CONTRACT(str);
+  M_ASSERT (src != NULL || n == 0);
+  // First pass: validate and compute the encoded size to allocate only once
+  size_t size = 0;
+  for(size_t i = 0; i < n; i++) {
+    const m_string_unicode_t c = src[i];
+    if (M_LIKELY (c <= 0x7Fu)) {
+      if (M_UNLIKELY (c == 0))
+        return false;
+      size ++;
+    } else if (c <= 0x7FFu) {
+      size += 2;
+    } else if (c < 0xD800u || c > 0xDFFFu) {
+      size += 3;
+    } else if (c <= 0xDBFFu && i + 1 < n
+               && src[i+1] >= 0xDC00u && src[i+1] <= 0xDFFFu) {
+      size += 4;
+      i++;
+    } else {
+      return false;
+    }
+  }
+  const size_t old_size = m_string_size(str);
+  char *ptr = m_str1ng_fit2size M_R(str, old_size + size + 1);
+  // Second pass: encode
+  char *dst = &ptr[old_size];
+  for(size_t i = 0; i < n; i++) {
+    m_string_unicode_t c = src[i];
+    if (M_LIKELY (c <= 0x7Fu)) {
+      *dst++ = (char) c;
+      continue;
+    }
+    if (c >= 0xD800u && c <= 0xDBFFu) {
+      c = 0x10000u + (((c & 0x3FFu) << 10) | (src[i+1] & 0x3FFu));
+      i++;
+    }
+    char buffer[4+1];
+    int s = m_str1ng_utf8_encode(buffer, c);
+    memcpy(dst, buffer, (size_t) s);
+    dst += s;
+  }
+  *dst = 0;
+  m_str1ng_set_size(str, old_size + size);
+  M_STR1NG_CONTRACT(str);
+  return true;
+}
+
+/* Set the string to the 'n' UTF32 code points of 'src' encoded in UTF8.
+   Return false (and let the string empty) if one code point is invalid */
+M_P(bool, m_string, _set_utf32, m_string_t str, const m_string_unicode_t src[], size_t n)
+{
+  m_string_reset(str);
+  return m_string_cat_utf32 M_R(str, src, n);
+}
+
+/* Set the string to the 'n' UTF16 code units of 'src' encoded in UTF8.
+   Return false (and let the string empty) if 'src' is not a valid UTF16 stream */
+M_P(bool, m_string, _set_utf16, m_string_t str, const uint16_t src[], size_t n)
+{
+  m_string_reset(str);
+  return m_string_cat_utf16 M_R(str, src, n);
 }
 
 
@@ -2237,6 +3570,8 @@ namespace m_lib {
    ,IT_LAST(m_string_it_last)                                                 \
    ,IT_CREF(m_string_cref), PUSH(m_string_push_u)                             \
    ,EMPLACE_TYPE(const char*)                                                 \
+   ,VIEW_TYPE(m_string_view_t), VIEW_HASH(m_string_view_hash)                 \
+   ,VIEW_EQUAL(m_string_equal_view_p)                                         \
    )
 #else
 #define M_STRING_OPLIST                                                       \
@@ -2264,12 +3599,40 @@ namespace m_lib {
     ,IT_LAST(m_string_it_last)                                                \
     ,IT_CREF(m_string_cref), PUSH(API_0P(m_string_push_u))                    \
     ,EMPLACE_TYPE(const char*)                                                \
+    ,VIEW_TYPE(m_string_view_t), VIEW_HASH(m_string_view_hash)                \
+    ,VIEW_EQUAL(m_string_equal_view_p)                                        \
     )
 #endif
 
 /* Register the OPLIST as a global one */
 #define M_OPL_m_string_t() M_STRING_OPLIST
 
+/* Define the OPLIST of a STRING VIEW */
+#ifndef M_USE_CONTEXT
+#define M_STRING_VIEW_OPLIST                                                  \
+  (INIT(M_RESET_POD), INIT_SET(M_SET_DEFAULT), SET(M_SET_DEFAULT),            \
+   INIT_MOVE(M_SET_DEFAULT), MOVE(M_SET_DEFAULT), SWAP(M_SWAP_DEFAULT),       \
+   CLEAR(M_NOTHING_DEFAULT), EMPTY_P(m_string_view_empty_p),                  \
+   HASH(m_string_view_hash), EQUAL(m_string_view_equal_p),                    \
+   CMP(m_string_view_cmp), TYPE(m_string_view_t),                             \
+   GET_STR(m_string_view_get_str), OUT_STR(m_string_view_out_str),            \
+   OUT_SERIAL(m_string_view_out_serial)                                       \
+   )
+#else
+#define M_STRING_VIEW_OPLIST                                                  \
+  (INIT(M_RESET_POD), INIT_SET(M_SET_DEFAULT), SET(M_SET_DEFAULT),            \
+   INIT_MOVE(M_SET_DEFAULT), MOVE(M_SET_DEFAULT), SWAP(M_SWAP_DEFAULT),       \
+   CLEAR(M_NOTHING_DEFAULT), EMPTY_P(m_string_view_empty_p),                  \
+   HASH(m_string_view_hash), EQUAL(m_string_view_equal_p),                    \
+   CMP(m_string_view_cmp), TYPE(m_string_view_t),                             \
+   GET_STR(API_0P(m_string_view_get_str)), OUT_STR(m_string_view_out_str),    \
+   OUT_SERIAL(API_0P(m_string_view_out_serial))                               \
+   )
+#endif
+
+/* Register the OPLIST as a global one */
+#define M_OPL_m_string_view_t() M_STRING_VIEW_OPLIST
+
 /* Register the string_t oplist as a generic type */
 #define M_GENERIC_ORG_MLIB_COMP_CORE_OPLIST_1() M_STRING_OPLIST
 
@@ -2308,6 +3671,14 @@ namespace m_lib {
 #define m_string_replace(...)                                                 \
   m_string_replace(M_DEFAULT_ARGS(4, (0), __VA_ARGS__))
 
+/* Search for a compiled search object in a string (string, searcher[, start=0[, idx=NULL]]) */
+#define m_string_search_compiled(...)                                         \
+  m_string_search_compiled(M_DEFAULT_ARGS(4, (0, NULL), __VA_ARGS__))
+
+/* Strim a view from the given set of characters (default is " \n\r\t") */
+#define m_string_view_strim(...)                                              \
+  m_string_view_strim(M_DEFAULT_ARGS(2, ("  \n\r\t"), __VA_ARGS__))
+
 /* Strim a string from the given set of characters (default is " \n\r\t") */
 #define m_string_strim(...)                                                   \
   m_string_strim(M_DEFAULT_ARGS(2, ("  \n\r\t"), __VA_ARGS__))
@@ -2398,9 +3769,35 @@ namespace m_lib {
 /*                                                                     */
 /***********************************************************************/
 
+/* Internal Macro: Transform a C variable into a m_string_t
+   using the fast conversions for the integer and floating point types */
+#if M_USE_STDIO
+#define M_STR1NG_GET_STRING_FLOAT_ARG(str, x)                                 \
+  float: m_string_cat_float M_R(str, M_AS_TYPE(float, x)),                    \
+  double: m_string_cat_double M_R(str, M_AS_TYPE(double, x)),
+#else
+#define M_STR1NG_GET_STRING_FLOAT_ARG(str, x) /* Nothing */
+#endif
+#define M_STR1NG_GET_STRING_ARG(str, x, append)                               \
+  ((append) ? (void) 0 : m_string_reset(str),                                 \
+   _Generic(((void)0,(x)),                                                    \
+            bool: m_string_cat_ui M_R(str, M_AS_TYPE(bool, x)),               \
+            signed char: m_string_cat_si M_R(str, M_AS_TYPE(signed char, x)), \
+            unsigned char: m_string_cat_ui M_R(str, M_AS_TYPE(unsigned char, x)), \
+            signed short: m_string_cat_si M_R(str, M_AS_TYPE(signed short, x)), \
+            unsigned short: m_string_cat_ui M_R(str, M_AS_TYPE(unsigned short, x)), \
+            signed int: m_string_cat_si M_R(str, M_AS_TYPE(signed int, x)),   \
+            unsigned int: m_string_cat_ui M_R(str, M_AS_TYPE(unsigned int, x)), \
+            long int: m_string_cat_sj M_R(str, M_AS_TYPE(long int, x)),       \
+            unsigned long int: m_string_cat_uj M_R(str, M_AS_TYPE(unsigned long int, x)), \
+            long long int: m_string_cat_sj M_R(str, M_AS_TYPE(long long int, x)), \
+            unsigned long long int: m_string_cat_uj M_R(str, M_AS_TYPE(unsigned long long int, x)), \
+            M_STR1NG_GET_STRING_FLOAT_ARG(str, x)                             \
+            default: (void) M_GET_STRING_ARG(str, x, true) ))
+
 /* Internal Macro: Provide GET_STR method to default type */
 #undef M_GET_STR_METHOD_FOR_DEFAULT_TYPE
-#define M_GET_STR_METHOD_FOR_DEFAULT_TYPE GET_STR(M_GET_STRING_ARG)
+#define M_GET_STR_METHOD_FOR_DEFAULT_TYPE GET_STR(M_STR1NG_GET_STRING_ARG)
 
 /* Internal Macro: Provide support of m_string_t to the macro M_PRINT in C11 */
 
@@ -2837,6 +4234,81 @@ namespace m_lib {
   (M_GET_INIT oplist (v), M_C(M_GET_NAME oplist, _printf)(v, __VA_ARGS__))
 
 
+/***********************************************************************/
+/*                                                                     */
+/*                STRING SWITCH (dispatch on literals)                 */
+/*                                                                     */
+/***********************************************************************/
+
+/* Define a dispatcher 'name' over a set of string literals:
+   its functions return the index (from 0) of the first literal equal
+   to the given string, or -1 if there is none.
+   USAGE: M_STRING_SWITCH_DEF(name, "literal0", "literal1", ...)
+   The preprocessor cannot access the characters of a string literal,
+   so no perfect hash can be built at preprocessing time. Instead:
+   - a constant bitmask of the lengths of the literals rejects at once
+   most of the strings which match none of them,
+   - then the length and the first character of each literal
+   (both folded into constants by the compiler) are checked
+   before comparing the whole string.
+*/
+#define M_STRING_SWITCH_DEF(name, ...)                                        \
+  M_BEGIN_PROTECTED_CODE                                                      \
+  M_STR1NG_SWITCH_DEF_P2(name, __VA_ARGS__)                                   \
+  M_END_PROTECTED_CODE
+
+/************************** INTERNAL ***********************************/
+
+/* Bit of a length in the bitmask of the lengths
+   (all the lengths greater or equal to 63 share the last bit) */
+#define M_STR1NG_SWITCH_BIT(len)                                              \
+  (UINT64_C(1) << ((len) < 63 ? (len) : 63))
+
+#define M_STR1NG_SWITCH_MASK(lit)                                             \
+  | M_STR1NG_SWITCH_BIT(sizeof (lit) - 1)
+
+/* Test of the literal 'lit' of index 'i' (from 1) */
+#define M_STR1NG_SWITCH_CASE(name, i, lit)                                    \
+  if (len == sizeof (lit) - 1                                                 \
+      && (len == 0 || (str[0] == (lit)[0] && memcmp(str, lit, len) == 0))) {  \
+    return (i) - 1;                                                           \
+  }
+
+/* Expand the functions of the dispatcher */
+#define M_STR1NG_SWITCH_DEF_P2(name, ...)                                     \
+                                                                              \
+  M_INLINE int                                                                \
+  M_F(name, _strn)(const char str[], size_t len)                              \
+  {                                                                           \
+    M_ASSERT (str != NULL || len == 0);                                       \
+    const uint64_t mask = 0 M_MAP(M_STR1NG_SWITCH_MASK, __VA_ARGS__);         \
+    if ((mask & M_STR1NG_SWITCH_BIT(len)) == 0) {                             \
+      return -1;                                                              \
+    }                                                                         \
+    M_MAP3(M_STR1NG_SWITCH_CASE, name, __VA_ARGS__)                           \
+    return -1;                                                                \
+  }                                                                           \
+                                                                              \
+  M_INLINE int                                                                \
+  M_F(name, _cstr)(const char str[])                                          \
+  {                                                                           \
+    M_ASSERT (str != NULL);                                                   \
+    return M_F(name, _strn)(str, strlen(str));                                \
+  }                                                                           \
+                                                                              \
+  M_INLINE int                                                                \
+  M_F(name, _string)(const m_string_t str)                                    \
+  {                                                                           \
+    return M_F(name, _strn)(m_string_get_cstr(str), m_string_size(str));      \
+  }                                                                           \
+                                                                              \
+  M_INLINE int                                                                \
+  M_F(name, _view)(const m_string_view_t view)                                \
+  {                                                                           \
+    return M_F(name, _strn)(view.ptr, view.size);                             \
+  }
+
+
 
 /********************************************************************************/
 /*                                                                              */
@@ -2855,6 +4327,9 @@ namespace m_lib {
 #define STRING_READ_PURE_LINE M_STRING_READ_PURE_LINE
 #define STRING_READ_FILE M_STRING_READ_FILE
 #define string_fgets_t m_string_fgets_t
+#define string_searcher_t m_string_searcher_t
+#define string_view_t m_string_view_t
+#define string_tokenize_t m_string_tokenize_t
 #define string_unicode_t m_string_unicode_t
 #define STRING_UNICODE_ERROR M_STRING_UNICODE_ERROR
 #define string_it_t m_string_it_t
@@ -2905,6 +4380,48 @@ namespace m_lib {
 #define string_replace_at m_string_replace_at
 #define string_replace_all_str m_string_replace_all_cstr
 #define string_replace_all m_string_replace_all
+#define string_searcher_init_multi m_string_searcher_init_multi
+#define string_searcher_init_str m_string_searcher_init_cstr
+#define string_searcher_init m_string_searcher_init
+#define string_searcher_clear m_string_searcher_clear
+#define string_searcher_size m_string_searcher_size
+#define string_searcher_pattern_size m_string_searcher_pattern_size
+#define string_search_compiled m_string_search_compiled
+#define string_find_all m_string_find_all
+#define string_replace_all_multi m_string_replace_all_multi
+#define string_view_str m_string_view_cstr
+#define string_view_strn m_string_view_cstrn
+#define string_get_view m_string_get_view
+#define string_view_mid m_string_view_mid
+#define string_view_data m_string_view_data
+#define string_view_size m_string_view_size
+#define string_view_empty_p m_string_view_empty_p
+#define string_view_get_char m_string_view_get_char
+#define string_view_equal_p m_string_view_equal_p
+#define string_view_equal_str_p m_string_view_equal_cstr_p
+#define string_equal_view_p m_string_equal_view_p
+#define string_view_cmp m_string_view_cmp
+#define string_view_hash m_string_view_hash
+#define string_view_strim m_string_view_strim
+#define string_view_split m_string_view_split
+#define string_split_view m_string_split_view
+#define string_tokenize m_string_tokenize
+#define string_tokenize_end_p m_string_tokenize_end_p
+#define string_tokenize_next m_string_tokenize_next
+#define string_tokenize_cref m_string_tokenize_cref
+#define string_set_view m_string_set_view
+#define string_cat_view m_string_cat_view
+#define string_init_set_view m_string_init_set_view
+#define string_view_get_str m_string_view_get_str
+#define string_view_out_str m_string_view_out_str
+#define string_view_out_serial m_string_view_out_serial
+#define string_reader_t m_string_reader_t
+#define string_reader_init m_string_reader_init
+#define string_reader_clear m_string_reader_clear
+#define string_reader_tell m_string_reader_tell
+#define string_reader_get_line m_string_reader_get_line
+#define string_reader_fgets m_string_reader_fgets
+#define string_reader_get_word m_string_reader_get_word
 #define string_vprintf m_string_vprintf
 #define string_printf m_string_printf
 #define string_cat_vprintf m_string_cat_vprintf
@@ -2939,10 +4456,22 @@ namespace m_lib {
 #define string_pop_u m_string_pop_u
 #define string_length_u m_string_length_u
 #define string_utf8_p m_string_utf8_p
+#define string_get_utf32 m_string_get_utf32
+#define string_get_utf16 m_string_get_utf16
+#define string_cat_utf32 m_string_cat_utf32
+#define string_cat_utf16 m_string_cat_utf16
+#define string_set_utf32 m_string_set_utf32
+#define string_set_utf16 m_string_set_utf16
 #define string_set_ui m_string_set_ui
 #define string_set_si m_string_set_si
 #define string_set_uj m_string_set_uj
 #define string_set_sj m_string_set_sj
+#define string_cat_ui m_string_cat_ui
+#define string_cat_si m_string_cat_si
+#define string_cat_uj m_string_cat_uj
+#define string_cat_sj m_string_cat_sj
+#define string_cat_double m_string_cat_double
+#define string_cat_float m_string_cat_float
 #define string_it_pos m_string_it_pos
 #define string_it_get_pos m_string_it_get_pos
 #define string_previous m_string_previous
@@ -2951,6 +4480,8 @@ namespace m_lib {
 #define STRING_CTE M_STRING_CTE
 #define STRING_OPLIST M_STRING_OPLIST
 #define M_OPL_string_t M_OPL_m_string_t
+#define STRING_VIEW_OPLIST M_STRING_VIEW_OPLIST
+#define M_OPL_string_view_t M_OPL_m_string_view_t
 #define string_sets m_string_sets
 #define string_cats m_string_cats
 #define string_init_printf m_string_init_printf
@@ -2959,6 +4490,7 @@ namespace m_lib {
 #define BOUNDED_STRING_DEF M_BOUNDED_STRING_DEF
 #define BOUNDED_STRING_OPLIST M_BOUNDED_STRING_OPLIST
 #define BOUNDED_STRING_CTE M_BOUNDED_STRING_CTE
+#define STRING_SWITCH_DEF M_STRING_SWITCH_DEF
 
 #endif
 
@@ -0,0 +1,59 @@
+/*
+ * Test that the string module properly support exceptions
+ * 
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj-except.h"
+#include "m-intern.h"
+
+M_TRY_DEF_ONCE()
+
+static void test1(unsigned n)
+{
+    char buffer[32];
+    m_intern_shared_pool_t pool;
+    m_intern_shared_pool_init(pool);
+    M_TRY(test1) {
+        for(unsigned i = 0; i < 100*n; i++) {
+            sprintf(buffer, "word-%u", i);
+            m_intern_t h = m_intern_shared_pool_intern_str(pool, buffer);
+            assert(strcmp(m_intern_cstr(h), buffer) == 0);
+        }
+    } M_CATCH(test1, 0) {
+        // Nothing to do
+    }
+    // The lock of the pool has been released by the exception
+    assert(m_intern_shared_pool_size(pool) <= 100*n);
+    M_TRY(test1) {
+        m_intern_t h = m_intern_shared_pool_intern_str(pool, "word-0");
+        assert(m_intern_shared_pool_find_str(pool, "word-0") == h);
+    } M_CATCH(test1, 0) {
+        // Nothing to do
+    }
+    m_intern_shared_pool_clear(pool);
+}
+
+int main(void)
+{
+    do_test_exception(test1);
+    exit(0);
+}
@@ -24,11 +24,14 @@
 #include "test-obj.h"
 #include "m-array.h"
 #include "m-string.h"
+#include "m-algo.h"
 #include "coverage.h"
 
 START_COVERAGE
 ARRAY_DEF(array_uint, unsigned int)
 ARRAY_DEF(array_mpz, testobj_t, TESTOBJ_OPLIST)
+ARRAY_SBO_DEF(array_sbo_uint, unsigned int, 4)
+ARRAY_SBO_DEF(array_sbo_string, string_t, 2, STRING_OPLIST)
 END_COVERAGE
 #define ARRAY_UINT_OPLIST ARRAY_OPLIST(array_uint)
 
@@ -37,13 +40,25 @@ ARRAY_DEF(array_min_z, testobj_t, (INIT_SET(testobj_init_set), SET(testobj_set),
 ARRAY_DEF(array_min2_z, testobj_t, (INIT(testobj_init), CLEAR(testobj_clear), INIT_MOVE(M_COPY_A1_DEFAULT) ) )
 ARRAY_DEF(array_min3_z, testobj_t, (CLEAR(testobj_clear), INIT_MOVE(M_COPY_A1_DEFAULT)))
 
-ARRAY_DEF(array_ulong, uint64_t)
+ARRAY_DEF(array_ulong, uint64_t, M_ARITH_OPLIST)
+typedef struct { int x; double y; } point_t;
+ARRAY_DEF(array_point, point_t, M_POD_OPLIST)
 ARRAY_DEF(array_string, string_t)
 ARRAY_DEF_AS(array_double, ArrayDouble, ArrayDoubleIt, double)
 #define M_OPL_ArrayDouble() ARRAY_OPLIST(array_double, M_BASIC_OPLIST)
 
 ArrayDouble g_array = ARRAY_INIT_VALUE();
 
+ARRAY_SBO_DEF_AS(array_sbo_double, ArraySboDouble, ArraySboDoubleIt, double, 3)
+#define M_OPL_ArraySboDouble() ARRAY_SBO_OPLIST(array_sbo_double, M_BASIC_OPLIST)
+
+ArraySboDouble g_array_sbo = ARRAY_SBO_INIT_VALUE(3);
+
+STATIC_ARRAY_DEF(array_static_uint, unsigned int, 8)
+STATIC_ARRAY_DEF(array_static_string, string_t, 4, STRING_OPLIST)
+// The generic algorithms which would push in the array are not defined
+ALGO_DEF(algo_static_uint, STATIC_ARRAY_OPLIST(array_static_uint))
+
 static void test_uint(void)
 {
   array_uint_t v;
@@ -549,6 +564,287 @@ static void test_double(void)
   array_double_clear(g_array);
 }
 
+static void test_image(void)
+{
+  array_ulong_t a, view;
+  array_point_t other, pview;
+  array_ulong_init(a);
+  for(uint64_t i = 0; i < 1000; i++)
+    array_ulong_push_back(a, i * i);
+  size_t n = array_ulong_image_size(a);
+  assert (n % M_CORE_IMAGE_ALIGN == 0);
+  char *image = (char *) malloc(n);
+  assert (image != NULL);
+  assert (array_ulong_to_image(image, n-1, a) == 0);
+  assert (array_ulong_to_image(image, n, a) == n);
+  assert (array_ulong_view_from_image(view, image, n) == true);
+  assert (array_ulong_size(view) == 1000);
+  assert (array_ulong_equal_p(view, a));
+  assert ((const char *) array_ulong_cget(view, 0) == image + M_CORE_IMAGE_ALIGN);
+  // Truncated, misaligned or foreign images are rejected
+  assert (array_ulong_view_from_image(view, image, n - 8) == false);
+  assert (array_ulong_view_from_image(view, image + 1, n - 1) == false);
+  assert (array_point_view_from_image(other, image, n) == false);
+  // Empty array
+  array_ulong_reset(a);
+  assert (array_ulong_to_image(image, n, a) == M_CORE_IMAGE_ALIGN);
+  assert (array_ulong_view_from_image(view, image, M_CORE_IMAGE_ALIGN) == true);
+  assert (array_ulong_empty_p(view));
+  free(image);
+  array_ulong_clear(a);
+
+  // Only flat elements have images: not the pointers
+  assert (M_GET_PROPERTY(M_OPL_int(), FLAT));
+  assert (M_GET_PROPERTY(M_POD_OPLIST, FLAT));
+  assert (!M_GET_PROPERTY(M_BASIC_OPLIST, FLAT));
+  assert (!M_GET_PROPERTY(M_PTR_OPLIST, FLAT));
+  array_point_init(other);
+  for(int i = 0; i < 10; i++) {
+    point_t p = { i, i / 2.0 };
+    array_point_push_back(other, p);
+  }
+  n = array_point_image_size(other);
+  image = (char *) malloc(n);
+  assert (image != NULL);
+  assert (array_point_to_image(image, n, other) == n);
+  assert (array_point_view_from_image(pview, image, n) == true);
+  assert (array_point_equal_p(pview, other));
+  assert (array_point_cget(pview, 9)->y == 4.5);
+  free(image);
+  array_point_clear(other);
+}
+
+static void test_sbo(void)
+{
+  array_sbo_uint_t v, v2;
+  array_sbo_uint_init(v);
+  assert (array_sbo_uint_empty_p(v));
+  assert (array_sbo_uint_capacity(v) == 4);
+  for(unsigned int i = 0; i < 4; i++)
+    array_sbo_uint_push_back(v, i);
+  // Still stored inline
+  assert (array_sbo_uint_capacity(v) == 4);
+  assert (*array_sbo_uint_back(v) == 3);
+  array_sbo_uint_push_back(v, 4);
+  // Now spilled into the heap
+  assert (array_sbo_uint_capacity(v) > 4);
+  for(unsigned int i = 5; i < 100; i++)
+    array_sbo_uint_push_back(v, i);
+  assert (array_sbo_uint_size(v) == 100);
+  unsigned int s = 0;
+  for M_EACH(item, v, ARRAY_SBO_OPLIST(array_sbo_uint)) {
+    s += *item;
+  }
+  assert (s == 100 * 99 / 2);
+  array_sbo_uint_pop_at(&s, v, 49);
+  assert (s == 49);
+  array_sbo_uint_push_at(v, 49, 49);
+  for(unsigned int i = 0; i < 100; i++)
+    assert (*array_sbo_uint_cget(v, i) == i);
+
+  array_sbo_uint_init_set(v2, v);
+  assert (array_sbo_uint_equal_p(v, v2));
+  array_sbo_uint_set_at(v2, 0, 1000);
+  assert (!array_sbo_uint_equal_p(v, v2));
+
+  // Shrink back to the inline buffer
+  array_sbo_uint_resize(v, 3);
+  array_sbo_uint_reserve(v, 0);
+  assert (array_sbo_uint_capacity(v) == 4);
+  assert (array_sbo_uint_size(v) == 3);
+  assert (*array_sbo_uint_get(v, 2) == 2);
+
+  // Swap an inline array with an heap allocated one
+  array_sbo_uint_swap(v, v2);
+  assert (array_sbo_uint_size(v) == 100);
+  assert (array_sbo_uint_size(v2) == 3);
+  assert (*array_sbo_uint_get(v, 0) == 1000);
+  assert (*array_sbo_uint_get(v2, 1) == 1);
+  array_sbo_uint_splice(v2, v);
+  assert (array_sbo_uint_size(v2) == 103);
+  assert (array_sbo_uint_empty_p(v));
+  assert (*array_sbo_uint_get(v2, 3) == 1000);
+  array_sbo_uint_remove_v(v2, 3, 103);
+  assert (array_sbo_uint_size(v2) == 3);
+  array_sbo_uint_insert_v(v2, 0, 2);
+  assert (array_sbo_uint_size(v2) == 5);
+  assert (*array_sbo_uint_get(v2, 0) == 0);
+  assert (*array_sbo_uint_get(v2, 4) == 2);
+
+  array_sbo_uint_set(v, v2);
+  array_sbo_uint_special_stable_sort(v);
+  array_sbo_uint_it_t it;
+  array_sbo_uint_it(it, v);
+  assert (*array_sbo_uint_cref(it) == 0);
+  array_sbo_uint_it_last(it, v);
+  assert (*array_sbo_uint_cref(it) == 2);
+
+  array_sbo_uint_move(v2, v);
+  assert (array_sbo_uint_size(v2) == 5);
+  array_sbo_uint_clear(v2);
+}
+
+static void test_sbo_string(void)
+{
+  M_LET(s, STRING_OPLIST)
+  M_LET(v1, v2, ARRAY_SBO_OPLIST(array_sbo_string, STRING_OPLIST)) {
+    array_sbo_string_emplace_back(v1, "Hello");
+    array_sbo_string_emplace_back(v1, "World");
+    for(int i = 0; i < 10; i++) {
+      string_printf(s, "%d", i);
+      array_sbo_string_push_back(v1, s);
+    }
+    assert (array_sbo_string_size(v1) == 12);
+    string_set_str(s, "");
+    array_sbo_string_get_str(s, v1, false);
+    assert (string_equal_str_p(s, "[\"Hello\",\"World\",\"0\",\"1\",\"2\",\"3\",\"4\",\"5\",\"6\",\"7\",\"8\",\"9\"]"));
+    const char *sp;
+    bool b = array_sbo_string_parse_str(v2, string_get_cstr(s), &sp);
+    assert (b);
+    assert (*sp == 0);
+    assert (array_sbo_string_equal_p(v1, v2));
+    array_sbo_string_pop_back(&s, v1);
+    assert (string_equal_str_p(s, "9"));
+    array_sbo_string_reset(v1);
+    array_sbo_string_push_back(v1, s);
+    array_sbo_string_reserve(v1, 0);
+    assert (array_sbo_string_capacity(v1) == 2);
+    assert (string_equal_str_p(*array_sbo_string_front(v1), "9"));
+  }
+
+  M_LET( (v, 1.0, 2.0, 3.0, 4.0), ArraySboDouble) {
+    assert (array_sbo_double_size(v) == 4);
+    assert (*array_sbo_double_get(v, 3) == 4.0);
+  }
+  assert (array_sbo_double_empty_p(g_array_sbo));
+  array_sbo_double_push_back(g_array_sbo, 1.0);
+  assert (array_sbo_double_capacity(g_array_sbo) == 3);
+  array_sbo_double_clear(g_array_sbo);
+}
+
+static void test_static(void)
+{
+  array_static_uint_t v, v2;
+  array_static_uint_init(v);
+  assert (array_static_uint_empty_p(v));
+  assert (array_static_uint_capacity(v) == 8);
+  for(unsigned int i = 0; i < 8; i++) {
+    bool b = array_static_uint_push_back(v, 7 - i);
+    assert (b);
+  }
+  assert (array_static_uint_full_p(v));
+  // No more room: the array is left untouched
+  assert (!array_static_uint_push_back(v, 100));
+  assert (array_static_uint_push_back_raw(v) == NULL);
+  assert (array_static_uint_push_new(v) == NULL);
+  assert (!array_static_uint_push_at(v, 0, 100));
+  assert (!array_static_uint_resize(v, 9));
+  assert (!array_static_uint_reserve(v, 9));
+  assert (array_static_uint_reserve(v, 8));
+  assert (array_static_uint_safe_get(v, 8) == NULL);
+  assert (array_static_uint_size(v) == 8);
+  assert (*array_static_uint_back(v) == 0);
+
+  unsigned int s;
+  array_static_uint_pop_at(&s, v, 0);
+  assert (s == 7);
+  assert (array_static_uint_push_at(v, 0, 7));
+  array_static_uint_special_stable_sort(v);
+  for(unsigned int i = 0; i < 8; i++)
+    assert (*array_static_uint_cget(v, i) == i);
+
+  array_static_uint_init_set(v2, v);
+  assert (array_static_uint_equal_p(v, v2));
+  assert (array_static_uint_hash(v) == array_static_uint_hash(v2));
+  array_static_uint_set_at(v2, 0, 1000);
+  assert (!array_static_uint_equal_p(v, v2));
+  // Both arrays are full: nothing can be spliced
+  assert (!array_static_uint_splice(v2, v));
+  assert (array_static_uint_resize(v2, 3));
+  array_static_uint_remove_v(v, 2, 7);
+  assert (array_static_uint_size(v) == 3);
+  assert (*array_static_uint_get(v, 2) == 7);
+  assert (array_static_uint_splice(v2, v));
+  assert (array_static_uint_size(v2) == 6);
+  assert (array_static_uint_empty_p(v));
+  assert (*array_static_uint_get(v2, 0) == 1000);
+  assert (*array_static_uint_get(v2, 5) == 7);
+
+  array_static_uint_swap(v, v2);
+  assert (array_static_uint_size(v) == 6);
+  assert (array_static_uint_empty_p(v2));
+  assert (*array_static_uint_get(v, 4) == 1);
+  unsigned int *p = array_static_uint_safe_get(v, 7);
+  assert (p != NULL && *p == 0);
+  assert (array_static_uint_size(v) == 8);
+
+  array_static_uint_it_t it;
+  array_static_uint_it(it, v);
+  assert (*array_static_uint_cref(it) == 1000);
+  array_static_uint_it_last(it, v);
+  assert (*array_static_uint_cref(it) == 0);
+  array_static_uint_move(v2, v);
+  assert (array_static_uint_size(v2) == 8);
+  array_static_uint_clear(v2);
+}
+
+static void test_static_generic(void)
+{
+  // Generic code cannot overflow a static array through its oplist
+  assert (!M_TEST_METHOD_P(PUSH, STATIC_ARRAY_OPLIST(array_static_uint)));
+  assert (!M_TEST_METHOD_P(PUSH_MOVE, STATIC_ARRAY_OPLIST(array_static_uint)));
+  assert (!M_TEST_METHOD_P(IT_INSERT, STATIC_ARRAY_OPLIST(array_static_uint)));
+  assert (!M_TEST_METHOD_P(SAFE_GET_KEY, STATIC_ARRAY_OPLIST(array_static_uint)));
+  assert (M_TEST_DISABLED_METHOD_P(INIT_WITH, STATIC_ARRAY_OPLIST(array_static_uint)));
+  assert (M_TEST_METHOD_P(PUSH, ARRAY_OPLIST(array_uint)));
+
+  M_LET(v, STATIC_ARRAY_OPLIST(array_static_uint)) {
+    for(unsigned int i = 0; i < 8; i++) {
+      assert (array_static_uint_push_back(v, (i * 5) % 8));
+    }
+    algo_static_uint_sort(v);
+    assert (algo_static_uint_sort_p(v));
+    assert (algo_static_uint_count(v, 3) == 1);
+    assert (array_static_uint_size(v) == 8);
+  }
+}
+
+static void test_static_string(void)
+{
+  string_t s;
+  string_init(s);
+  M_LET(v1, v2, STATIC_ARRAY_OPLIST(array_static_string, STRING_OPLIST)) {
+    assert (array_static_string_emplace_back(v1, "Hello"));
+    assert (array_static_string_emplace_back(v1, "World"));
+    string_set_str(s, "!");
+    assert (array_static_string_push_back(v1, s));
+    assert (array_static_string_push_move(v1, &s));
+    string_init_set_str(s, "Full");
+    assert (!array_static_string_push_back(v1, s));
+    assert (!array_static_string_push_move(v1, &s));
+    assert (array_static_string_size(v1) == 4);
+
+    array_static_string_get_str(s, v1, false);
+    assert (string_equal_str_p(s, "[\"Hello\",\"World\",\"!\",\"!\"]"));
+    const char *sp;
+    bool b = array_static_string_parse_str(v2, string_get_cstr(s), &sp);
+    assert (b);
+    assert (*sp == 0);
+    assert (array_static_string_equal_p(v1, v2));
+    // Too many elements for the array
+    b = array_static_string_parse_str(v2, "[\"a\",\"b\",\"c\",\"d\",\"e\"]", &sp);
+    assert (!b);
+    assert (array_static_string_size(v2) == 4);
+    array_static_string_pop_back(&s, v1);
+    assert (string_equal_str_p(s, "!"));
+    array_static_string_set(v2, v1);
+    assert (array_static_string_size(v2) == 3);
+    assert (string_equal_str_p(*array_static_string_front(v2), "Hello"));
+  }
+  string_clear(s);
+}
+
+
 // Test support of M*LIB for C++ class
 #if defined(__cplusplus)
 
@@ -639,6 +935,12 @@ int main(void)
   test_d();
   test_str();
   test_double();
+  test_image();
+  test_sbo();
+  test_sbo_string();
+  test_static();
+  test_static_generic();
+  test_static_string();
   test_cplusplus();
   testobj_final_check();
   exit(0);
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "coverage.h"
+#include "m-array.h"
+#include "m-bchain.h"
+
+#if M_USE_BCHAIN_IOVEC
+#include <unistd.h>
+#endif
+
+ARRAY_DEF(array_bchain, bchain_t)
+
+#define CHUNK M_USE_BCHAIN_CHUNK_SIZE
+
+// Check that the chain contains the bytes (start + i) % 251 for i in [0, n[
+static void check_content(const bchain_t b, unsigned start, size_t n)
+{
+  assert(bchain_size(b) == n);
+  uint8_t *tmp = (uint8_t *) malloc(n + 1);
+  assert(tmp != NULL);
+  bchain_peek_bytes(b, n, tmp);
+  for(size_t i = 0; i < n; i++) {
+    assert(tmp[i] == (uint8_t) ((start + i) % 251));
+  }
+  free(tmp);
+}
+
+static void fill(uint8_t *buf, unsigned start, size_t n)
+{
+  for(size_t i = 0; i < n; i++) {
+    buf[i] = (uint8_t) ((start + i) % 251);
+  }
+}
+
+static void test_basic(void)
+{
+  static uint8_t buf[3*CHUNK];
+  fill(buf, 0, sizeof buf);
+
+  bchain_t b;
+  bchain_init(b);
+  assert(bchain_empty_p(b));
+  assert(bchain_size(b) == 0);
+  assert(bchain_segment_count(b) == 0);
+
+  bchain_push_back(b, 0);
+  bchain_push_back_bytes(b, 10, buf+1);
+  check_content(b, 0, 11);
+  assert(bchain_segment_count(b) == 1);
+  bchain_push_back_bytes(b, 2*CHUNK, buf+11);
+  check_content(b, 0, 2*CHUNK+11);
+  assert(bchain_segment_count(b) == 3);
+
+  uint8_t tmp[CHUNK+5];
+  bchain_pop_front_bytes(5, tmp, b);
+  assert(memcmp(tmp, buf, 5) == 0);
+  check_content(b, 5, 2*CHUNK+6);
+  bchain_pop_front_bytes(CHUNK, tmp, b);
+  assert(memcmp(tmp, buf+5, CHUNK) == 0);
+  check_content(b, CHUNK+5, CHUNK+6);
+  assert(bchain_segment_count(b) == 2);
+  bchain_consume(b, CHUNK+6);
+  assert(bchain_empty_p(b));
+  assert(bchain_segment_count(b) == 0);
+
+  // Reuse the spare chunk
+  bchain_push_back_bytes(b, 100, buf);
+  check_content(b, 0, 100);
+  bchain_reset(b);
+  assert(bchain_empty_p(b));
+  bchain_push_back_bytes(b, 0, NULL);
+  assert(bchain_empty_p(b));
+
+  // Streaming: push and consume small messages
+  unsigned start = 0;
+  for(unsigned i = 0; i < 1000; i++) {
+    bchain_push_back_bytes(b, 100, buf + (i * 100) % 251);
+    if (i % 2) {
+      bchain_consume(b, 150);
+      start += 150;
+    }
+  }
+  check_content(b, start % 251, 100000 - start);
+
+  bchain_t c, d;
+  bchain_init(c);
+  bchain_push_back_bytes(c, 10, buf);
+  assert(!bchain_equal_p(b, c));
+  bchain_swap(b, c);
+  check_content(b, 0, 10);
+  check_content(c, start % 251, 100000 - start);
+  bchain_init_move(d, c);
+  check_content(d, start % 251, 100000 - start);
+  bchain_init(c);
+  bchain_move(b, d);
+  check_content(b, start % 251, 100000 - start);
+  bchain_clear(c);
+  bchain_clear(b);
+}
+
+static void test_share(void)
+{
+  static uint8_t buf[3*CHUNK];
+  fill(buf, 0, sizeof buf);
+
+  bchain_t a, b;
+  bchain_init(a);
+  bchain_push_back_bytes(a, CHUNK+10, buf);
+  bchain_init_set(b, a);
+  assert(bchain_equal_p(a, b));
+  // Both chains share the chunks: appending doesn't modify the other one
+  bchain_push_back_bytes(a, 20, buf + CHUNK+10);
+  bchain_push_back_bytes(b, 5, buf);
+  check_content(a, 0, CHUNK+30);
+  assert(bchain_size(b) == CHUNK+15);
+  assert(!bchain_equal_p(a, b));
+  bchain_consume(b, CHUNK+10);
+  check_content(b, 0, 5);
+  check_content(a, 0, CHUNK+30);
+  bchain_set(b, a);
+  assert(bchain_equal_p(a, b));
+  bchain_set(b, b);
+  assert(bchain_equal_p(a, b));
+
+  // Same content, different segmentation
+  bchain_reset(b);
+  bchain_push_back_bytes(b, 7, buf);
+  bchain_t c;
+  bchain_init(c);
+  bchain_push_back_bytes(c, CHUNK+23, buf+7);
+  bchain_splice_back(b, c);
+  assert(bchain_empty_p(c));
+  check_content(b, 0, CHUNK+30);
+  assert(bchain_equal_p(a, b));
+  assert(bchain_equal_p(b, a));
+
+  // Partial splice: the segment in the middle is shared
+  bchain_splice_back_bytes(c, b, 100);
+  check_content(c, 0, 100);
+  check_content(b, 100, CHUNK-70);
+  bchain_splice_back_bytes(c, b, CHUNK-70);
+  assert(bchain_empty_p(b));
+  check_content(c, 0, CHUNK+30);
+  assert(bchain_equal_p(a, c));
+  bchain_push_back_bytes(c, 5, buf + CHUNK+30);
+  check_content(c, 0, CHUNK+35);
+  check_content(a, 0, CHUNK+30);
+
+  bchain_clear(a);
+  bchain_clear(b);
+  bchain_clear(c);
+}
+
+static void test_array(void)
+{
+  uint8_t buf[100];
+  fill(buf, 0, sizeof buf);
+  array_bchain_t t;
+  array_bchain_init(t);
+  bchain_t b;
+  bchain_init(b);
+  bchain_push_back_bytes(b, sizeof buf, buf);
+  for(int i = 0; i < 100; i++) {
+    array_bchain_push_back(t, b);
+  }
+  for(int i = 0; i < 100; i++) {
+    assert(bchain_equal_p(*array_bchain_get(t, (size_t) i), b));
+  }
+  array_bchain_clear(t);
+  bchain_clear(b);
+}
+
+#if M_USE_BCHAIN_IOVEC
+static void test_iovec(void)
+{
+  static uint8_t buf[3*CHUNK];
+  fill(buf, 0, sizeof buf);
+  int fd[2];
+  if (pipe(fd) != 0) abort();
+
+  bchain_t b;
+  bchain_init(b);
+  bchain_push_back_bytes(b, CHUNK+10, buf);
+  struct iovec iov[4];
+  size_t n = bchain_get_iovec(b, 4, iov);
+  assert(n == 2);
+  ssize_t w = writev(fd[1], iov, (int) n);
+  assert(w == CHUNK+10);
+  bchain_consume(b, (size_t) w);
+  assert(bchain_empty_p(b));
+
+  // Read it back in a chain which already has some bytes
+  bchain_push_back_bytes(b, 7, buf + 1);
+  n = bchain_reserve_iovec(b, CHUNK+10, 4, iov);
+  assert(n == 2);
+  assert(iov[0].iov_len == CHUNK-7);
+  ssize_t r = readv(fd[0], iov, (int) n);
+  assert(r == CHUNK+10);
+  bchain_commit(b, (size_t) r);
+  assert(bchain_size(b) == CHUNK+17);
+  uint8_t tmp[CHUNK+17];
+  bchain_pop_front_bytes(7, tmp, b);
+  check_content(b, 0, CHUNK+10);
+
+  // Limited number of iovec
+  n = bchain_get_iovec(b, 1, iov);
+  assert(n == 1);
+  n = bchain_reserve_iovec(b, 3*CHUNK, 2, iov);
+  assert(n == 2);
+  bchain_commit(b, 0);
+  check_content(b, 0, CHUNK+10);
+
+  close(fd[0]);
+  close(fd[1]);
+  bchain_clear(b);
+}
+#endif
+
+int main(void)
+{
+  test_basic();
+  test_share();
+  test_array();
+#if M_USE_BCHAIN_IOVEC
+  test_iovec();
+#endif
+  exit(0);
+}
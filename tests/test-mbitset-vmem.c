@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+// Test the large arrays allocator with a small threshold
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#define M_USE_VMEM 1
+#define M_USE_VMEM_THRESHOLD 4096
+#include "test-obj.h"
+#include "coverage.h"
+#include "m-bitset.h"
+#include "m-array.h"
+
+ARRAY_DEF(array_big, uint32_t, M_OPEXTEND(M_BASIC_OPLIST, REALLOC(M_VMEM_REALLOC), FREE(M_VMEM_FREE)))
+
+static void test_vmem(void)
+{
+  // Grow a bitset from the standard allocator to the large arrays one
+  M_LET(set, bitset_t) {
+    for(size_t i = 0; i < 1000000; i++) {
+      bitset_push_back(set, (i % 3) == 0);
+    }
+    for(size_t i = 0; i < 1000000; i+= 999) {
+      assert (bitset_get(set, i) == ((i % 3) == 0));
+    }
+    // And back
+    bitset_resize(set, 100);
+    bitset_reserve(set, 0);
+    for(size_t i = 0; i < 100; i++) {
+      assert (bitset_get(set, i) == ((i % 3) == 0));
+    }
+    bitset_reserve(set, 0);
+  }
+
+  M_LET(a, b, ARRAY_OPLIST(array_big, M_OPEXTEND(M_BASIC_OPLIST, REALLOC(M_VMEM_REALLOC), FREE(M_VMEM_FREE)))) {
+    for(uint32_t i = 0; i < 1000000; i++) {
+      array_big_push_back(a, i);
+    }
+    for(uint32_t i = 0; i < 1000000; i++) {
+      assert (*array_big_cget(a, i) == i);
+    }
+    array_big_set(b, a);
+    array_big_resize(a, 10);
+    array_big_reserve(a, 0);
+    assert (*array_big_cget(a, 9) == 9);
+    array_big_reserve(b, 0);
+    assert (*array_big_cget(b, 999999) == 999999);
+  }
+}
+
+int main(void)
+{
+  test_vmem();
+  exit(0);
+}
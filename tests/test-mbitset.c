@@ -445,6 +445,34 @@ static void test_resize(void)
   }
 }
 
+static void test_image(void)
+{
+  M_LET(set, bitset_t) {
+    for(size_t s = 0; s < 200; s+= 13) {
+      bitset_resize(set, s);
+      for(size_t i = 0; i < s; i+= 3)
+        bitset_set_at(set, i, true);
+      size_t n = bitset_image_size(set);
+      char *image = (char *) malloc(n);
+      assert (image != NULL);
+      assert (bitset_to_image(image, n, set) == n);
+      bitset_t view;
+      assert (bitset_view_from_image(view, image, n) == true);
+      assert (bitset_equal_p(view, set));
+      assert (bitset_popcount(view) == (s+2)/3);
+      if (s % 64 != 0) {
+        // A bit set after the end of the bitset is rejected
+        uint64_t *limb = (uint64_t *) (void *) (image + M_CORE_IMAGE_ALIGN);
+        limb[(s-1)/64] |= UINT64_C(1) << 63;
+        assert (bitset_view_from_image(view, image, n) == false);
+      }
+      image[0] = 0;
+      assert (bitset_view_from_image(view, image, n) == false);
+      free(image);
+    }
+  }
+}
+
 int main(void)
 {
   test1();
@@ -454,5 +482,6 @@ int main(void)
   test_let();
   test_clz();
   test_resize();
+  test_image();
   exit(0);
 }
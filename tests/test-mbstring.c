@@ -314,6 +314,136 @@ static void test_io(void)
     bstring_clear(b);
 }
 
+static void test_find(void)
+{
+    bstring_t b;
+    bstring_init(b);
+
+    assert(bstring_find_byte(b, 1, 0) == M_BSTRING_FAILURE);
+    assert(bstring_find_bytes(b, 1, "a", 0) == M_BSTRING_FAILURE);
+    assert(bstring_find_any_of(b, 2, "ab", 0) == M_BSTRING_FAILURE);
+    assert(bstring_count_byte(b, 0) == 0);
+
+    for(unsigned i = 0; i < 1000; i++) {
+        bstring_push_back(b, (uint8_t) (i % 100));
+    }
+    assert(bstring_find_byte(b, 0, 0) == 0);
+    assert(bstring_find_byte(b, 0, 1) == 100);
+    assert(bstring_find_byte(b, 99, 0) == 99);
+    assert(bstring_find_byte(b, 99, 900) == 999);
+    assert(bstring_find_byte(b, 100, 0) == M_BSTRING_FAILURE);
+    assert(bstring_find_byte(b, 1, 1000) == M_BSTRING_FAILURE);
+    for(unsigned c = 0; c < 256; c++) {
+        assert(bstring_count_byte(b, (uint8_t) c) == (c < 100 ? 10 : 0));
+    }
+
+    const uint8_t pat1[] = { 10, 11, 12 };
+    const uint8_t pat2[] = { 10, 12 };
+    const uint8_t pat3[] = { 98, 99, 0, 1 };
+    assert(bstring_find_bytes(b, sizeof pat1, pat1, 0) == 10);
+    assert(bstring_find_bytes(b, sizeof pat1, pat1, 11) == 110);
+    assert(bstring_find_bytes(b, sizeof pat2, pat2, 0) == M_BSTRING_FAILURE);
+    assert(bstring_find_bytes(b, sizeof pat3, pat3, 0) == 98);
+    assert(bstring_find_bytes(b, sizeof pat3, pat3, 897) == 898);
+    assert(bstring_find_bytes(b, sizeof pat3, pat3, 899) == M_BSTRING_FAILURE);
+    assert(bstring_find_bytes(b, 0, pat3, 5) == 5);
+
+    const uint8_t set1[] = { 200, 50, 40 };
+    const uint8_t set2[] = { 255, 128 };
+    assert(bstring_find_any_of(b, sizeof set1, set1, 0) == 40);
+    assert(bstring_find_any_of(b, sizeof set1, set1, 41) == 50);
+    assert(bstring_find_any_of(b, sizeof set1, set1, 951) == M_BSTRING_FAILURE);
+    assert(bstring_find_any_of(b, 1, set1+1, 0) == 50);
+    assert(bstring_find_any_of(b, sizeof set2, set2, 0) == M_BSTRING_FAILURE);
+    assert(bstring_find_any_of(b, 0, set2, 0) == M_BSTRING_FAILURE);
+    const uint8_t set3[] = { 99, 98, 97, 250 };
+    const uint8_t set4[] = { 77, 78, 79, 80, 81, 82 };
+    assert(bstring_find_any_of(b, sizeof set3, set3, 0) == 97);
+    assert(bstring_find_any_of(b, sizeof set3, set3, 3) == 97);
+    assert(bstring_find_any_of(b, sizeof set3, set3, 996) == 997);
+    assert(bstring_find_any_of(b, sizeof set4, set4, 0) == 77);
+    assert(bstring_find_any_of(b, sizeof set4, set4, 983) == M_BSTRING_FAILURE);
+
+    // Search after a pop front (offset not null)
+    uint8_t tmp[3];
+    bstring_pop_front_bytes(sizeof tmp, tmp, b);
+    assert(bstring_find_byte(b, 0, 0) == 97);
+    assert(bstring_find_bytes(b, sizeof pat1, pat1, 0) == 7);
+    assert(bstring_count_byte(b, 1) == 9);
+    assert(bstring_count_byte(b, 3) == 10);
+
+    bstring_clear(b);
+}
+
+static void test_cursor(void)
+{
+    const uint8_t tab[] = {
+        0x01,
+        0x02, 0x01, 0x04, 0x03, 0x02, 0x01,
+        0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+        0x01, 0x02, 0x01, 0x02, 0x03, 0x04,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x00, 0x7F, 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+        0x00, 0x01, 0x02, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+        'A', 'B', 'C',
+        0x80, 0x80
+    };
+    bstring_t b;
+    bstring_init(b);
+    bstring_push_back_bytes(b, sizeof tab, tab);
+
+    bstring_cursor_t c;
+    bstring_cursor_init(c, b);
+    assert(bstring_cursor_pos(c) == 0);
+    assert(bstring_cursor_remaining(c) == sizeof tab);
+    assert(!bstring_cursor_end_p(c));
+
+    uint8_t  u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+    int64_t  s64;
+    const uint8_t *p;
+    assert(bstring_cursor_get_u8(c, &u8) && u8 == 1);
+    assert(bstring_cursor_get_le16(c, &u16) && u16 == 0x0102);
+    assert(bstring_cursor_get_le32(c, &u32) && u32 == 0x01020304);
+    assert(bstring_cursor_get_le64(c, &u64) && u64 == UINT64_C(0x0102030405060708));
+    assert(bstring_cursor_get_be16(c, &u16) && u16 == 0x0102);
+    assert(bstring_cursor_get_be32(c, &u32) && u32 == 0x01020304);
+    assert(bstring_cursor_get_be64(c, &u64) && u64 == UINT64_C(0x0102030405060708));
+    assert(bstring_cursor_get_varint(c, &u64) && u64 == 0);
+    assert(bstring_cursor_get_varint(c, &u64) && u64 == 127);
+    assert(bstring_cursor_get_varint(c, &u64) && u64 == 300);
+    assert(bstring_cursor_get_varint(c, &u64) && u64 == UINT64_MAX);
+    assert(bstring_cursor_get_svarint(c, &s64) && s64 == 0);
+    assert(bstring_cursor_get_svarint(c, &s64) && s64 == -1);
+    assert(bstring_cursor_get_svarint(c, &s64) && s64 == 1);
+    assert(bstring_cursor_get_svarint(c, &s64) && s64 == -2);
+    assert(bstring_cursor_get_svarint(c, &s64) && s64 == INT64_MIN);
+    assert(bstring_cursor_get_bytes(c, 3, &p) && memcmp(p, "ABC", 3) == 0);
+    // Truncated varint: the cursor doesn't move
+    size_t pos = bstring_cursor_pos(c);
+    assert(!bstring_cursor_get_varint(c, &u64));
+    assert(bstring_cursor_pos(c) == pos);
+    assert(!bstring_cursor_get_le32(c, &u32));
+    assert(!bstring_cursor_get_bytes(c, 3, &p));
+    assert(bstring_cursor_remaining(c) == 2);
+    assert(bstring_cursor_skip(c, 2));
+    assert(bstring_cursor_end_p(c));
+    assert(!bstring_cursor_get_u8(c, &u8));
+    assert(!bstring_cursor_skip(c, 1));
+
+    // Varint too big for 64 bits
+    const uint8_t big[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02 };
+    bstring_reset(b);
+    bstring_push_back_bytes(b, sizeof big, big);
+    bstring_cursor_init(c, b);
+    assert(!bstring_cursor_get_varint(c, &u64));
+    assert(bstring_cursor_pos(c) == 0);
+
+    bstring_clear(b);
+}
+
 int main(void)
 {
     test0();
@@ -322,5 +452,7 @@ int main(void)
     test3();
     test4();
     test_io();
+    test_find();
+    test_cursor();
     exit(0);
 }
@@ -766,6 +766,72 @@ static void f_ts2(ts *x)
   assert(y.c == 3);
 }
 
+static void test_fast_conv(void)
+{
+  char buf[M_CORE_FMT_FLOAT_SIZE];
+  char *e;
+  assert (m_core_fmt_uj(buf, 0) == 1 && strcmp(buf, "0") == 0);
+  assert (m_core_fmt_uj(buf, 1234567) == 7 && strcmp(buf, "1234567") == 0);
+  assert (m_core_fmt_uj(buf, ULLONG_MAX) == 20 && strcmp(buf, "18446744073709551615") == 0);
+  assert (m_core_fmt_sj(buf, -42) == 3 && strcmp(buf, "-42") == 0);
+  assert (m_core_fmt_sj(buf, LLONG_MIN) == 20 && strcmp(buf, "-9223372036854775808") == 0);
+
+  assert (m_core_strtoll(" -1742", &e, 10) == -1742 && *e == 0);
+  assert (m_core_strtoll("+17x", &e, 10) == 17 && *e == 'x');
+  assert (m_core_strtoll("-9223372036854775808", &e, 10) == LLONG_MIN && *e == 0);
+  assert (m_core_strtoll("99999999999999999999", &e, 10) == LLONG_MAX && *e == 0);
+  assert (m_core_strtoll("z", &e, 10) == 0 && *e == 'z');
+  assert (m_core_strtoll("ff", &e, 16) == 255 && *e == 0);
+  assert (m_core_strtoull("18446744073709551615", &e, 10) == ULLONG_MAX && *e == 0);
+  assert (m_core_strtoull("12 ", &e, 10) == 12 && *e == ' ');
+
+#if M_USE_STDIO
+  assert (m_core_fmt_double(buf, 0.0) == 1 && strcmp(buf, "0") == 0);
+  assert (m_core_fmt_double(buf, 0.1) == 3 && strcmp(buf, "0.1") == 0);
+  assert (m_core_fmt_double(buf, -123.456) == 8 && strcmp(buf, "-123.456") == 0);
+  assert (m_core_fmt_double(buf, 1e20) == 5 && strcmp(buf, "1e+20") == 0);
+  assert (m_core_fmt_double(buf, 0.30000000000000004) == 19 && strcmp(buf, "0.30000000000000004") == 0);
+  assert (m_core_fmt_float(buf, 0.1f) == 3 && strcmp(buf, "0.1") == 0);
+  assert (m_core_fmt_float(buf, 3.25f) == 4 && strcmp(buf, "3.25") == 0);
+  assert (m_core_fmt_float(buf, 1e-10f) == 5 && strcmp(buf, "1e-10") == 0);
+  assert (m_core_fmt_double(buf, 1e15) == 5 && strcmp(buf, "1e+15") == 0);
+  assert (m_core_fmt_double(buf, -1.5e10) == 8 && strcmp(buf, "-1.5e+10") == 0);
+  assert (m_core_fmt_double(buf, 1500.0) == 4 && strcmp(buf, "1500") == 0);
+  assert (m_core_fmt_double(buf, 1e-5) == 5 && strcmp(buf, "1e-05") == 0);
+  assert (m_core_fmt_double(buf, 5e-324) == 6 && strcmp(buf, "5e-324") == 0);
+  assert (m_core_fmt_double(buf, 1.5e-310) == 8 && strcmp(buf, "1.5e-310") == 0);
+  assert (m_core_fmt_float(buf, 1e7f) == 5 && strcmp(buf, "1e+07") == 0);
+  assert (m_core_fmt_float(buf, 1e-45f) == 5 && strcmp(buf, "1e-45") == 0);
+#endif
+
+  assert (m_core_strtod("0.1", &e) == 0.1 && *e == 0);
+  assert (m_core_strtod(" -1.5e3,", &e) == -1500.0 && *e == ',');
+  assert (m_core_strtod("2e", &e) == 2.0 && *e == 'e');
+  assert (m_core_strtod("0x10", &e) == 16.0 && *e == 0);
+  assert (m_core_strtod("1e300", &e) == 1e300 && *e == 0);
+  assert (m_core_strtod("1.7976931348623157e308", &e) == 1.7976931348623157e308 && *e == 0);
+  assert (m_core_strtod("x", &e) == 0.0 && *e == 'x');
+  assert (m_core_strtof("0.1", &e) == 0.1f && *e == 0);
+  assert (m_core_strtof("-3.25e2", &e) == -325.0f && *e == 0);
+
+  // Round trip of random values
+  for(int i = 0; i < 100000; i++) {
+    unsigned long long r = ((unsigned long long) rand() << 40) ^ ((unsigned long long) rand() << 20) ^ (unsigned long long) rand();
+    double d = (double) (r % 100000000) / m_core_pow10((unsigned) (r % 12));
+#if M_USE_STDIO
+    m_core_fmt_double(buf, d);
+    assert (strtod(buf, NULL) == d);
+    assert (m_core_strtod(buf, NULL) == d);
+    float f = (float) d;
+    m_core_fmt_float(buf, f);
+    assert (strtof(buf, NULL) == f);
+    assert (m_core_strtof(buf, NULL) == f);
+#endif
+    m_core_fmt_sj(buf, (long long) r);
+    assert (m_core_strtoll(buf, NULL, 10) == (long long) r);
+  }
+}
+
 static void test_move_default(void)
 {
   int o, p;
@@ -1013,6 +1079,7 @@ int main(void)
   test_reduce();
   test_as_type();
   test_parse_standard_c_type();
+  test_fast_conv();
   test_move_default();
   test_builtin();
   test_str_hash();
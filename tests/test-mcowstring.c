@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "coverage.h"
+#include "m-array.h"
+#include "m-dict.h"
+#include "m-buffer.h"
+#include "m-thread.h"
+#include "m-cowstring.h"
+
+ARRAY_DEF(array_cow, m_cowstring_t)
+#define M_OPL_array_cow_t() ARRAY_OPLIST(array_cow, M_COWSTRING_OPLIST)
+DICT_DEF2(dict_cow, m_cowstring_t, int)
+#define M_OPL_dict_cow_t() DICT_OPLIST(dict_cow, M_COWSTRING_OPLIST, M_BASIC_OPLIST)
+DICT_OA_DEF2(dict_oa_cow, m_cowstring_t, M_COWSTRING_OPLIST, int, M_BASIC_OPLIST)
+QUEUE_MPMC_DEF(queue_cow, m_cowstring_t, BUFFER_QUEUE, M_COWSTRING_OPLIST)
+
+#define PAYLOAD_SIZE 2048
+#define NB_THREADS 4
+#define NB_MESSAGES 10000
+
+static void test_basic(void)
+{
+  m_cowstring_t s, s2;
+  m_cowstring_init(s);
+  assert( m_cowstring_empty_p(s));
+  assert( m_cowstring_size(s) == 0);
+  assert( m_cowstring_equal_cstr_p(s, ""));
+  m_cowstring_cat_cstr(s, "Hello");
+  assert( m_cowstring_equal_cstr_p(s, "Hello"));
+  m_cowstring_push_back(s, ' ');
+  m_cowstring_cat_cstr(s, "world, this is a long string");
+  assert( !m_cowstring_empty_p(s));
+  assert( m_cowstring_size(s) == 34);
+  assert( m_cowstring_equal_cstr_p(s, "Hello world, this is a long string"));
+  assert( m_cowstring_get_char(s, 4) == 'o');
+  m_cowstring_set_char(s, 0, 'h');
+  assert( m_cowstring_cmp_cstr(s, "hello world, this is a long string") == 0);
+  assert( m_cowstring_cmp_cstr(s, "hello") > 0);
+
+  // Set from its own characters
+  m_cowstring_set_cstrn(s, m_cowstring_get_cstr(s) + 6, 5);
+  assert( m_cowstring_equal_cstr_p(s, "world"));
+  m_cowstring_cat(s, s);
+  assert( m_cowstring_equal_cstr_p(s, "worldworld"));
+  m_cowstring_cat(s, s);
+  assert( m_cowstring_equal_cstr_p(s, "worldworldworldworld"));
+  m_cowstring_set_cstrn(s, m_cowstring_get_cstr(s) + 2, 17);
+  assert( m_cowstring_equal_cstr_p(s, "rldworldworldworl"));
+
+  m_cowstring_init_set_cstr(s2, "rldworldworldworl");
+  assert( m_cowstring_equal_p(s, s2));
+  assert( m_cowstring_cmp(s, s2) == 0);
+  assert( m_cowstring_hash(s) == m_cowstring_hash(s2));
+  m_cowstring_push_back(s2, 'd');
+  assert( !m_cowstring_equal_p(s, s2));
+  assert( m_cowstring_cmp(s, s2) < 0);
+  m_cowstring_swap(s, s2);
+  assert( m_cowstring_equal_cstr_p(s, "rldworldworldworld"));
+  m_cowstring_set_cstr(s, "short");
+  assert( m_cowstring_equal_cstr_p(s, "short"));
+  assert( m_string_view_equal_cstr_p(m_cowstring_get_view(s), "short"));
+
+  m_string_t str;
+  m_string_init_set_cstr(str, "short");
+  assert( m_cowstring_hash(s) == m_string_hash(str));
+  m_string_cat_cstr(str, " and now longer than the embedded buffer");
+  m_cowstring_set_string(s, str);
+  m_string_reset(str);
+  m_cowstring_get_string(str, s);
+  assert( m_string_equal_cstr_p(str, "short and now longer than the embedded buffer"));
+  assert( m_cowstring_hash(s) == m_string_hash(str));
+  m_string_clear(str);
+
+  m_cowstring_reset(s);
+  assert( m_cowstring_empty_p(s));
+  m_cowstring_clear(s);
+  m_cowstring_clear(s2);
+}
+
+static void test_cow(void)
+{
+  m_cowstring_t s, s2, s3;
+  char payload[PAYLOAD_SIZE+1];
+  for(int i = 0; i < PAYLOAD_SIZE; i++) {
+    payload[i] = (char) ('a' + i % 26);
+  }
+  payload[PAYLOAD_SIZE] = 0;
+
+  m_cowstring_init_set_cstr(s, payload);
+  // Copies share the characters
+  m_cowstring_init_set(s2, s);
+  m_cowstring_init(s3);
+  m_cowstring_set(s3, s2);
+  assert( m_cowstring_get_cstr(s) == m_cowstring_get_cstr(s2));
+  assert( m_cowstring_get_cstr(s) == m_cowstring_get_cstr(s3));
+  assert( m_cowstring_equal_p(s, s3));
+
+  // A modification gives a private copy to the modified string only
+  m_cowstring_set_char(s2, 0, '!');
+  assert( m_cowstring_get_cstr(s) != m_cowstring_get_cstr(s2));
+  assert( m_cowstring_get_cstr(s) == m_cowstring_get_cstr(s3));
+  assert( m_cowstring_equal_cstr_p(s, payload));
+  assert( m_cowstring_get_char(s2, 0) == '!');
+  assert( !m_cowstring_equal_p(s, s2));
+  // Not shared anymore: modified in place
+  const char *p = m_cowstring_get_cstr(s2);
+  m_cowstring_set_char(s2, 1, '?');
+  assert( m_cowstring_get_cstr(s2) == p);
+
+  m_cowstring_cat_cstr(s3, "END");
+  assert( m_cowstring_equal_cstr_p(s, payload));
+  assert( m_cowstring_size(s3) == PAYLOAD_SIZE + 3);
+  assert( strcmp(m_cowstring_get_cstr(s3) + PAYLOAD_SIZE, "END") == 0);
+  // Some room is reserved for the next concatenations
+  p = m_cowstring_get_cstr(s3);
+  m_cowstring_cat_cstr(s3, "END");
+  assert( m_cowstring_get_cstr(s3) == p);
+
+  // Setting a shared string doesn't modify the other
+  m_cowstring_set(s2, s);
+  m_cowstring_set_cstrn(s2, payload, PAYLOAD_SIZE/2);
+  assert( m_cowstring_equal_cstr_p(s, payload));
+  assert( m_cowstring_size(s2) == PAYLOAD_SIZE/2);
+
+  m_cowstring_move(s2, s3);
+  m_cowstring_init_move(s3, s);
+  assert( m_cowstring_equal_cstr_p(s3, payload));
+  assert( m_cowstring_size(s2) == PAYLOAD_SIZE + 6);
+  m_cowstring_clear(s2);
+  m_cowstring_clear(s3);
+}
+
+static void test_oplist(void)
+{
+  M_LET( (s, ("Hello, \"world\"")), s2, COWSTRING_OPLIST)
+  M_LET(a, M_OPL_array_cow_t())
+  M_LET(d, M_OPL_dict_cow_t())
+  M_LET(str, STRING_OPLIST) {
+    for(int i = 0; i < 100; i++) {
+      m_cowstring_set_cstr(s2, "This is the value number ");
+      m_cowstring_push_back(s2, (char) ('0' + i % 10));
+      array_cow_push_back(a, s2);
+      // The element of the array shares the characters of the value
+      assert( m_cowstring_get_cstr(*array_cow_back(a)) == m_cowstring_get_cstr(s2));
+      dict_cow_set_at(d, s2, i);
+    }
+    assert( array_cow_size(a) == 100);
+    assert( dict_cow_size(d) == 10);
+    assert( *dict_cow_get(d, s2) == 99);
+    assert( m_cowstring_equal_p(*array_cow_get(a, 9), *array_cow_get(a, 19)));
+
+    m_cowstring_get_str(str, s, false);
+    assert( m_string_equal_cstr_p(str, "\"Hello, \\\"world\\\"\""));
+    const char *end;
+    bool b = m_cowstring_parse_str(s2, m_string_get_cstr(str), &end);
+    assert( b && *end == 0);
+    assert( m_cowstring_equal_p(s, s2));
+
+    FILE *f = m_core_fopen ("a-mcowstring.dat", "wt");
+    if (!f) abort();
+    m_cowstring_out_str(f, s);
+    fclose (f);
+    f = m_core_fopen ("a-mcowstring.dat", "rt");
+    if (!f) abort();
+    m_cowstring_reset(s2);
+    b = m_cowstring_in_str (s2, f);
+    assert (b == true);
+    assert (m_cowstring_equal_p (s, s2));
+    fclose(f);
+  }
+
+  dict_oa_cow_t h;
+  dict_oa_cow_init(h);
+  M_LET(s, COWSTRING_OPLIST) {
+    for(int i = 0; i < 1000; i++) {
+      m_cowstring_set_cstr(s, "This is a key stored in an open addressing dictionary ");
+      m_cowstring_push_back(s, (char) ('A' + i % 50));
+      dict_oa_cow_set_at(h, s, i);
+    }
+    assert( dict_oa_cow_size(h) == 50);
+    m_cowstring_set_cstr(s, "This is a key stored in an open addressing dictionary A");
+    assert( *dict_oa_cow_get(h, s) == 950);
+    dict_oa_cow_erase(h, s);
+    assert( dict_oa_cow_get(h, s) == NULL);
+  }
+  dict_oa_cow_clear(h);
+}
+
+static queue_cow_t g_queue;
+
+static void producer(void *arg)
+{
+  const m_cowstring_srcptr payload = (m_cowstring_srcptr) arg;
+  for(int i = 0; i < NB_MESSAGES; i++) {
+    while (!queue_cow_push(g_queue, payload)) {
+      m_thread_yield();
+    }
+  }
+}
+
+static void consumer(void *arg)
+{
+  const m_cowstring_srcptr payload = (m_cowstring_srcptr) arg;
+  m_cowstring_t s;
+  m_cowstring_init(s);
+  for(int i = 0; i < NB_MESSAGES; i++) {
+    while (!queue_cow_pop(&s, g_queue)) {
+      m_thread_yield();
+    }
+    assert( m_cowstring_equal_p(s, payload));
+    // Modify the private copy
+    m_cowstring_set_char(s, 0, 'X');
+    assert( m_cowstring_get_char(payload, 0) == 'a');
+  }
+  m_cowstring_clear(s);
+}
+
+static void test_queue(void)
+{
+  m_thread_t idx_p[NB_THREADS];
+  m_thread_t idx_c[NB_THREADS];
+  m_cowstring_t payload;
+
+  m_cowstring_init(payload);
+  for(int i = 0; i < PAYLOAD_SIZE; i++) {
+    m_cowstring_push_back(payload, (char) ('a' + i % 26));
+  }
+  queue_cow_init(g_queue, 64);
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_create(idx_p[i], producer, (void*) payload);
+    m_thread_create(idx_c[i], consumer, (void*) payload);
+  }
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_join(idx_p[i]);
+    m_thread_join(idx_c[i]);
+  }
+  assert( queue_cow_empty_p(g_queue));
+  queue_cow_clear(g_queue);
+  m_cowstring_clear(payload);
+}
+
+int main(void)
+{
+  test_basic();
+  test_cow();
+  test_oplist();
+  test_queue();
+  exit(0);
+}
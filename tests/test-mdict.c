@@ -37,7 +37,7 @@ DICT_OA_DEF2(dict_oa_int, int, M_OPEXTEND(M_BASIC_OPLIST, OOR_EQUAL(oor_equal_p)
 END_COVERAGE
 
 DICT_SET_DEF(dict_setstr, string_t, STRING_OPLIST)
-DICT_DEF2(dict_int, int, M_BASIC_OPLIST, int, M_BASIC_OPLIST)
+DICT_DEF2(dict_int, int, M_ARITH_OPLIST, int, M_ARITH_OPLIST)
 DICT_DEF2(dict_mpz, string_t, STRING_OPLIST, testobj_t, TESTOBJ_OPLIST)
 
 BOUNDED_STRING_DEF(symbol, 15)
@@ -53,6 +53,9 @@ DICT_SET_DEF_AS(dictas_setstr, DictStr, DictStrIt, string_t, STRING_OPLIST)
 DICT_OA_DEF2_AS(dictas_oa_bstr, DictOAStr, DictOAStrIt, DictOAStrItRef, string_t, STRING_OPLIST, int, M_BASIC_OPLIST)
 DICT_OASET_DEF_AS(dictas_oa_setstr, DictOASStr, DictOASStrIt, string_t, STRING_OPLIST)
 
+STATIC_DICT_OA_DEF2(dict_static_int, int, M_OPEXTEND(M_BASIC_OPLIST, OOR_EQUAL(oor_equal_p), OOR_SET(API_2(oor_set))), int, M_BASIC_OPLIST, 64)
+STATIC_DICT_OA_DEF2(dict_static_str, string_t, STRING_OPLIST, string_t, STRING_OPLIST, 16)
+
 
 /* Helper structure */
 ARRAY_DEF(array_string, string_t, STRING_OPLIST)
@@ -613,6 +616,100 @@ static void test_oa(void)
   dict_oa_int_clear(d);
 }
 
+static void test_static(void)
+{
+  dict_static_int_t d, d2;
+  dict_oa_int_t ref;
+  dict_static_int_init(d);
+  dict_oa_int_init(ref);
+  assert (dict_static_int_empty_p(d));
+  const size_t capacity = dict_static_int_capacity(d);
+  assert (capacity > 32 && capacity < 64);
+
+  // Fill the dictionary up to its capacity
+  for(int i = 0; dict_static_int_size(d) < capacity; i++) {
+    bool b = dict_static_int_set_at(d, i * 5, i);
+    assert (b);
+    dict_oa_int_set_at(ref, i * 5, i);
+  }
+  assert (dict_static_int_full_p(d));
+  // The dictionary is full: a new key can't be added but an existing one can be updated
+  assert (!dict_static_int_set_at(d, -10, 0));
+  assert (dict_static_int_safe_get(d, -10) == NULL);
+  assert (dict_static_int_set_at(d, 0, 100));
+  dict_oa_int_set_at(ref, 0, 100);
+  assert (*dict_static_int_safe_get(d, 0) == 100);
+  assert (dict_static_int_size(d) == capacity);
+
+  // Random erase / insert (checked against the dynamic dictionary)
+  unsigned int seed = 1;
+  for(int n = 0; n < 10000; n++) {
+    seed = seed * 1103515245 + 12345;
+    int k = (int) ((seed >> 16) % 256);
+    if ((seed >> 8) & 1) {
+      bool b1 = dict_static_int_erase(d, k);
+      bool b2 = dict_oa_int_erase(ref, k);
+      assert (b1 == b2);
+    } else if (!dict_static_int_full_p(d)) {
+      assert (dict_static_int_set_at(d, k, n));
+      dict_oa_int_set_at(ref, k, n);
+    }
+    assert (dict_static_int_size(d) == dict_oa_int_size(ref));
+  }
+  for(int k = 0; k < 256; k++) {
+    int *p1 = dict_static_int_get(d, k);
+    int *p2 = dict_oa_int_get(ref, k);
+    assert ((p1 == NULL) == (p2 == NULL));
+    assert (p1 == NULL || *p1 == *p2);
+  }
+  size_t count = 0;
+  for M_EACH(item, d, STATIC_DICT_OA_OPLIST(dict_static_int)) {
+    assert (*dict_oa_int_get(ref, item->key) == item->value);
+    count++;
+  }
+  assert (count == dict_static_int_size(d));
+
+  dict_static_int_init_set(d2, d);
+  assert (dict_static_int_equal_p(d, d2));
+  dict_static_int_reset(d);
+  assert (dict_static_int_empty_p(d));
+  assert (!dict_static_int_equal_p(d, d2));
+  dict_static_int_swap(d, d2);
+  assert (dict_static_int_size(d) == count);
+  assert (dict_static_int_empty_p(d2));
+  dict_static_int_move(d2, d);
+  assert (dict_static_int_size(d2) == count);
+  dict_static_int_clear(d2);
+  dict_oa_int_clear(ref);
+
+  // Generic code cannot overflow a static dictionary through its oplist
+  assert (!M_TEST_METHOD_P(SET_KEY, STATIC_DICT_OA_OPLIST(dict_static_int)));
+  assert (!M_TEST_METHOD_P(SAFE_GET_KEY, STATIC_DICT_OA_OPLIST(dict_static_int)));
+  assert (M_TEST_DISABLED_METHOD_P(INIT_WITH, STATIC_DICT_OA_OPLIST(dict_static_int)));
+  assert (M_TEST_METHOD_P(GET_KEY, STATIC_DICT_OA_OPLIST(dict_static_int)));
+
+  M_LET(s, STRING_OPLIST)
+  M_LET(e1, e2, STATIC_DICT_OA_OPLIST(dict_static_str, STRING_OPLIST, STRING_OPLIST)) {
+    for(int i = 0; i < 20; i++) {
+      string_printf(s, "%d", i);
+      dict_static_str_set_at(e1, s, s);
+    }
+    assert (dict_static_str_size(e1) == dict_static_str_capacity(e1));
+    string_set_str(s, "3");
+    assert (dict_static_str_erase(e1, s));
+    assert (!dict_static_str_erase(e1, s));
+    dict_static_str_get_str(s, e1, false);
+    const char *sp;
+    bool b = dict_static_str_parse_str(e2, string_get_cstr(s), &sp);
+    assert (b);
+    assert (*sp == 0);
+    assert (dict_static_str_equal_p(e1, e2));
+    // Too many items for the dictionary
+    b = dict_static_str_parse_str(e2, "{\"a\":\"0\",\"b\":\"1\",\"c\":\"2\",\"d\":\"3\",\"e\":\"4\",\"f\":\"5\",\"g\":\"6\",\"h\":\"7\",\"i\":\"8\",\"j\":\"9\",\"k\":\"10\",\"l\":\"11\",\"m\":\"12\"}", &sp);
+    assert (!b);
+  }
+}
+
 static void test_init_oa(void)
 {
   M_LET(d1, d2, DICT_OPLIST(dict_oa_int, M_BASIC_OPLIST, M_BASIC_OPLIST)){
@@ -887,6 +984,90 @@ static void test_emplace (void)
   dict_mpz_clear(d);
 }
 
+static void test_image(void)
+{
+  dict_int_t d, view;
+  dict_int_init(d);
+  for(int i = 0; i < 1000; i++)
+    dict_int_set_at(d, i, 2*i);
+  for(int i = 0; i < 1000; i+= 7)
+    dict_int_erase(d, i);
+  size_t n = dict_int_image_size(d);
+  char *image = (char *) malloc(n);
+  assert (image != NULL);
+  assert (dict_int_to_image(image, n/2, d) == 0);
+  assert (dict_int_to_image(image, n, d) == n);
+  assert (dict_int_view_from_image(view, image, n) == true);
+  assert (dict_int_size(view) == dict_int_size(d));
+  for(int i = 0; i < 1000; i++) {
+    int *p = dict_int_get(view, i);
+    if (i % 7 == 0) {
+      assert (p == NULL);
+    } else {
+      assert (p != NULL && *p == 2*i);
+    }
+  }
+  assert (dict_int_equal_p(view, d));
+  assert (dict_int_view_from_image(view, image, n-1) == false);
+  image[8] ^= 1;
+  assert (dict_int_view_from_image(view, image, n) == false);
+  image[8] ^= 1;
+  // An image written with another hash seed is rejected
+  image[M_CORE_IMAGE_ALIGN] ^= 1;
+  assert (dict_int_view_from_image(view, image, n) == false);
+  image[M_CORE_IMAGE_ALIGN] ^= 1;
+  assert (dict_int_view_from_image(view, image, n) == true);
+  free(image);
+  dict_int_clear(d);
+}
+
+static void test_view(void)
+{
+  dict_str_t d;
+  dict_oa_bstr_t d2;
+  dict_setstr_t set;
+  const char line[] = "key1,key22,,unknown,key1";
+  string_view_t field[8];
+
+  dict_str_init(d);
+  dict_oa_bstr_init(d2);
+  dict_setstr_init(set);
+  for(int i = 0; i < 100; i++) {
+    string_t key;
+    string_init_printf(key, "key%d", i);
+    dict_str_set_at(d, key, STRING_CTE("value"));
+    dict_oa_bstr_set_at(d2, key, i);
+    dict_setstr_push(set, key);
+    string_clear(key);
+  }
+  // Lookup the unaligned views of a line without creating any string
+  size_t n = string_view_split(field, 8, string_view_str(line), ',');
+  assert (n == 5);
+  assert (dict_str_get_view(d, field[0]) != NULL);
+  assert (dict_str_get_view(d, field[1]) != NULL);
+  assert (dict_str_get_view(d, field[2]) == NULL);
+  assert (dict_str_get_view(d, field[3]) == NULL);
+  assert (string_equal_str_p(*dict_str_get_view(d, field[4]), "value"));
+  assert (*dict_oa_bstr_get_view(d2, field[0]) == 1);
+  assert (*dict_oa_bstr_get_view(d2, field[1]) == 22);
+  assert (dict_oa_bstr_get_view(d2, field[2]) == NULL);
+  assert (dict_oa_bstr_get_view(d2, field[3]) == NULL);
+  assert (dict_setstr_get_view(set, field[1]) != NULL);
+  assert (dict_setstr_get_view(set, field[3]) == NULL);
+  for(int i = 0; i < 100; i += 2) {
+    string_t key;
+    string_init_printf(key, "key%d", i);
+    dict_oa_bstr_erase(d2, key);
+    string_clear(key);
+  }
+  assert (*dict_oa_bstr_get_view(d2, field[0]) == 1);
+  assert (dict_oa_bstr_get_view(d2, field[1]) == NULL);
+
+  dict_setstr_clear(set);
+  dict_oa_bstr_clear(d2);
+  dict_str_clear(d);
+}
+
 static void test_coverage(void)
 {
   // Call of the utilities functions, so that they do not impact the coverage
@@ -929,11 +1110,14 @@ int main(void)
   test_equal();
   test_emplace();
   test_oa();
+  test_static();
   test_init_oa();
   test_it_oa();
   test_oa_str1();
   test_oa_str2();
   test_reserve_bug();
+  test_view();
+  test_image();
   testobj_final_check();
   test_coverage();
   exit(0);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "coverage.h"
+#include "m-array.h"
+#include "m-dict.h"
+#include "m-intern.h"
+
+ARRAY_DEF(array_intern, m_intern_t)
+DICT_DEF2(dict_intern, m_intern_t, int)
+
+#define NB_THREADS 4
+#define NB_WORDS 1000
+
+static void test_pool(void)
+{
+  m_intern_pool_t pool;
+  m_intern_pool_init(pool);
+  assert( m_intern_pool_size(pool) == 0);
+  assert( m_intern_pool_find_str(pool, "hello") == NULL);
+
+  m_intern_t h1 = m_intern_pool_intern_str(pool, "hello");
+  assert( m_intern_pool_size(pool) == 1);
+  assert( strcmp(m_intern_cstr(h1), "hello") == 0);
+  assert( m_intern_size(h1) == 5);
+  assert( m_intern_hash(h1) == m_core_hash("hello", 5));
+  assert( m_intern_pool_find_str(pool, "hello") == h1);
+  assert( m_intern_pool_find_str(pool, "world") == NULL);
+
+  m_intern_t h2 = m_intern_pool_intern_n(pool, "hello world", 5);
+  assert( m_intern_equal_p(h1, h2));
+  assert( m_intern_pool_size(pool) == 1);
+
+  m_string_t s;
+  m_string_init_set_cstr(s, "world");
+  m_intern_t h3 = m_intern_pool_intern(pool, s);
+  assert( !m_intern_equal_p(h1, h3));
+  assert( m_intern_cmp(h1, h3) < 0);
+  assert( m_intern_cmp(h3, h1) > 0);
+  assert( m_intern_cmp(h3, h3) == 0);
+  assert( m_intern_pool_size(pool) == 2);
+  m_string_clear(s);
+
+  m_intern_t h4 = m_intern_pool_intern_str(pool, "");
+  assert( m_intern_size(h4) == 0);
+  assert( m_intern_cstr(h4)[0] == 0);
+  assert( m_intern_pool_intern_n(pool, NULL, 0) == h4);
+
+  // Force the growth of the table and the allocation of several blocks
+  char buffer[32];
+  m_intern_t tab[NB_WORDS];
+  for(int i = 0; i < NB_WORDS; i++) {
+    sprintf(buffer, "word-%d", i);
+    tab[i] = m_intern_pool_intern_str(pool, buffer);
+  }
+  assert( m_intern_pool_size(pool) == 3 + NB_WORDS);
+  for(int i = 0; i < NB_WORDS; i++) {
+    sprintf(buffer, "word-%d", i);
+    assert( m_intern_pool_intern_str(pool, buffer) == tab[i]);
+    assert( strcmp(m_intern_cstr(tab[i]), buffer) == 0);
+  }
+  assert( m_intern_pool_find_str(pool, "hello") == h1);
+
+  // A string bigger than a block
+  char *big = (char*) malloc(M_USE_INTERN_BLOCK_SIZE * 2);
+  assert(big != NULL);
+  memset(big, 'x', M_USE_INTERN_BLOCK_SIZE * 2 - 1);
+  big[M_USE_INTERN_BLOCK_SIZE * 2 - 1] = 0;
+  m_intern_t hb = m_intern_pool_intern_str(pool, big);
+  assert( m_intern_size(hb) == M_USE_INTERN_BLOCK_SIZE * 2 - 1);
+  assert( strcmp(m_intern_cstr(hb), big) == 0);
+  assert( m_intern_pool_intern_str(pool, big) == hb);
+  m_intern_t h5 = m_intern_pool_intern_str(pool, "after");
+  assert( strcmp(m_intern_cstr(h5), "after") == 0);
+  free(big);
+
+  // Strings with embedded null characters
+  m_intern_t n1 = m_intern_pool_intern_n(pool, "a\0b", 3);
+  m_intern_t n2 = m_intern_pool_intern_n(pool, "a\0c", 3);
+  m_intern_t n3 = m_intern_pool_intern_n(pool, "a", 1);
+  assert( !m_intern_equal_p(n1, n2));
+  assert( m_intern_cmp(n1, n2) < 0);
+  assert( m_intern_cmp(n2, n1) > 0);
+  assert( m_intern_cmp(n3, n1) < 0);
+  assert( m_intern_cmp(n1, n3) > 0);
+  assert( m_intern_cmp(h4, n3) < 0);
+  assert( m_intern_cmp(n3, h4) > 0);
+
+  m_intern_pool_clear(pool);
+}
+
+static void test_container(void)
+{
+  m_intern_pool_t pool;
+  m_intern_pool_init(pool);
+
+  array_intern_t a;
+  array_intern_init(a);
+  const char *words[] = { "one", "two", "one", "three", "two", "one" };
+  for(size_t i = 0; i < sizeof words / sizeof words[0]; i++) {
+    array_intern_push_back(a, m_intern_pool_intern_str(pool, words[i]));
+  }
+  assert( array_intern_size(a) == 6);
+  assert( m_intern_pool_size(pool) == 3);
+  assert( *array_intern_get(a, 0) == *array_intern_get(a, 2));
+
+  dict_intern_t d;
+  dict_intern_init(d);
+  for(size_t i = 0; i < array_intern_size(a); i++) {
+    m_intern_t item = *array_intern_get(a, i);
+    int *p = dict_intern_get(d, item);
+    if (p == NULL) {
+      dict_intern_set_at(d, item, 1);
+    } else {
+      (*p)++;
+    }
+  }
+  assert( dict_intern_size(d) == 3);
+  assert( *dict_intern_get(d, m_intern_pool_intern_str(pool, "one")) == 3);
+  assert( *dict_intern_get(d, m_intern_pool_intern_str(pool, "two")) == 2);
+  assert( *dict_intern_get(d, m_intern_pool_intern_str(pool, "three")) == 1);
+  assert( m_intern_pool_size(pool) == 3);
+
+  assert( M_CALL_CMP(M_INTERN_OPLIST, *array_intern_get(a, 0), *array_intern_get(a, 1)) < 0);
+  assert( M_CALL_HASH(M_INTERN_OPLIST, *array_intern_get(a, 0)) == m_core_hash("one", 3));
+  // An interned string is a pointer: it has no flat image
+  assert( !M_GET_PROPERTY(M_INTERN_OPLIST, FLAT));
+
+  dict_intern_clear(d);
+  array_intern_clear(a);
+  m_intern_pool_clear(pool);
+}
+
+static m_intern_shared_pool_t shared_pool;
+static m_intern_t shared_tab[NB_THREADS][NB_WORDS];
+
+static void conso(void *arg)
+{
+  m_intern_t *tab = (m_intern_t *) arg;
+  char buffer[32];
+  for(int i = 0; i < NB_WORDS; i++) {
+    sprintf(buffer, "shared-%d", i);
+    tab[i] = m_intern_shared_pool_intern_str(shared_pool, buffer);
+  }
+}
+
+static void test_shared(void)
+{
+  m_thread_t idx[NB_THREADS];
+  m_intern_shared_pool_init(shared_pool);
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_create(idx[i], conso, (void*) shared_tab[i]);
+  }
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_join(idx[i]);
+  }
+  assert( m_intern_shared_pool_size(shared_pool) == NB_WORDS);
+  for(int i = 0; i < NB_WORDS; i++) {
+    for(int j = 1; j < NB_THREADS; j++) {
+      assert( m_intern_equal_p(shared_tab[0][i], shared_tab[j][i]));
+    }
+  }
+  m_string_t s;
+  m_string_init_set_cstr(s, "shared-0");
+  assert( m_intern_shared_pool_intern(shared_pool, s) == shared_tab[0][0]);
+  assert( m_intern_shared_pool_intern_n(shared_pool, "shared-10", 8) == shared_tab[0][1]);
+  assert( m_intern_shared_pool_find_str(shared_pool, "shared-0") == shared_tab[0][0]);
+  assert( m_intern_shared_pool_find_str(shared_pool, "other") == NULL);
+  m_string_clear(s);
+  m_intern_shared_pool_clear(shared_pool);
+}
+
+int main(void)
+{
+  test_pool();
+  test_container();
+  test_shared();
+  testobj_final_check();
+  exit(0);
+}
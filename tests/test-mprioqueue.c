@@ -45,6 +45,9 @@ PRIOQUEUE_DEF(obj_pqueue, testobj_t, M_OPEXTEND(TESTOBJ_CMP_OPLIST, EQUAL(testob
 PRIOQUEUE_DEF_AS(PrioDouble, PrioDouble, PrioDoubleIt, double, double_OPLIST)
 #define M_OPL_PrioDouble() PRIOQUEUE_OPLIST(PrioDouble, double_OPLIST)
 
+STATIC_PRIOQUEUE_DEF(static_pqueue, int, 16)
+STATIC_PRIOQUEUE_DEF(static_obj_pqueue, testobj_t, 4, TESTOBJ_CMP_OPLIST)
+
 static void test1(void)
 {
   int x;
@@ -339,6 +342,56 @@ static void test_double(void)
   }
 }
 
+static void test_static(void)
+{
+  static_pqueue_t p, q;
+  static_pqueue_init(p);
+  assert (static_pqueue_empty_p(p));
+  assert (static_pqueue_capacity(p) == 16);
+  for(int i = 0; i < 16; i++) {
+    bool b = static_pqueue_push(p, (i * 7) % 16);
+    assert (b);
+  }
+  assert (static_pqueue_full_p(p));
+  // The priority queue is full: the element is not pushed
+  assert (!static_pqueue_push(p, -1));
+  assert (*static_pqueue_front(p) == 0);
+  assert (static_pqueue_erase(p, 5));
+  assert (!static_pqueue_full_p(p));
+  static_pqueue_update(p, 6, -1);
+  assert (static_pqueue_push(p, 100));
+  static_pqueue_init_set(q, p);
+  assert (static_pqueue_equal_p(p, q));
+  int x, ref = -1;
+  while (!static_pqueue_empty_p(p)) {
+    static_pqueue_pop(&x, p);
+    assert (x == ref);
+    ref = (ref == 4) ? 7 : (ref == 15) ? 100 : ref + 1;
+  }
+  assert (ref == 101);
+  static_pqueue_swap(p, q);
+  assert (static_pqueue_size(p) == 16);
+  assert (static_pqueue_empty_p(q));
+  static_pqueue_clear(p);
+  static_pqueue_clear(q);
+
+  M_LET(o, STATIC_PRIOQUEUE_OPLIST(static_obj_pqueue, TESTOBJ_CMP_OPLIST)) {
+    for(unsigned i = 0; i < 4; i++) {
+      assert (static_obj_pqueue_emplace_ui(o, 4 - i));
+    }
+    assert (!static_obj_pqueue_emplace_ui(o, 0));
+    testobj_t z;
+    testobj_init(z);
+    static_obj_pqueue_pop(&z, o);
+    assert (testobj_cmp_ui(z, 1) == 0);
+    testobj_clear(z);
+    assert (static_obj_pqueue_size(o) == 3);
+  }
+  // A push which may fail is not exported by the oplist
+  assert (!M_TEST_METHOD_P(PUSH, STATIC_PRIOQUEUE_OPLIST(static_pqueue)));
+  assert (M_TEST_DISABLED_METHOD_P(INIT_WITH, STATIC_PRIOQUEUE_OPLIST(static_pqueue)));
+}
+
 static void test_io(void)
 {
   PrioDouble q1, q2;
@@ -402,6 +455,7 @@ int main(void)
   test2();
   test_update();
   test_double();
+  test_static();
   test_it();
   test_io();
   test_coverage();
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "coverage.h"
+#include "m-array.h"
+#include "m-dict.h"
+#include "m-rope.h"
+#include "m-thread.h"
+
+ARRAY_DEF(array_rope, m_rope_t)
+#define M_OPL_array_rope_t() ARRAY_OPLIST(array_rope, M_ROPE_OPLIST)
+DICT_DEF2(dict_rope, m_rope_t, int)
+#define M_OPL_dict_rope_t() DICT_OPLIST(dict_rope, M_ROPE_OPLIST, M_BASIC_OPLIST)
+
+#define NB_EDITS 20000
+#define NB_THREADS 4
+
+static void test_basic(void)
+{
+  m_rope_t r, r2;
+  m_string_t s;
+
+  m_rope_init(r);
+  assert( m_rope_empty_p(r));
+  assert( m_rope_size(r) == 0);
+  assert( m_rope_equal_cstr_p(r, ""));
+  m_rope_cat_cstr(r, "Hello");
+  m_rope_cat_cstr(r, " world");
+  assert( !m_rope_empty_p(r));
+  assert( m_rope_size(r) == 11);
+  assert( m_rope_equal_cstr_p(r, "Hello world"));
+  assert( !m_rope_equal_cstr_p(r, "Hello worl"));
+  assert( !m_rope_equal_cstr_p(r, "Hello world!"));
+  assert( m_rope_get_char(r, 4) == 'o');
+  m_rope_insert_cstr(r, 5, ",");
+  assert( m_rope_equal_cstr_p(r, "Hello, world"));
+  m_rope_insert_cstr(r, 0, ">");
+  m_rope_insert_cstr(r, m_rope_size(r), "<");
+  assert( m_rope_equal_cstr_p(r, ">Hello, world<"));
+  m_rope_erase(r, 0, 1);
+  m_rope_erase(r, 5, 2);
+  m_rope_erase(r, 10, 100);
+  assert( m_rope_equal_cstr_p(r, "Helloworld"));
+  m_rope_replace_at(r, 0, 5, "Bye ");
+  assert( m_rope_equal_cstr_p(r, "Bye world"));
+
+  m_string_init(s);
+  m_rope_flatten(s, r);
+  assert( m_string_equal_cstr_p(s, "Bye world"));
+  assert( m_rope_equal_string_p(r, s));
+
+  // Copies share all their nodes, and are independent
+  m_rope_init_set(r2, r);
+  assert( m_rope_equal_p(r, r2));
+  assert( m_rope_cmp(r, r2) == 0);
+  assert( m_rope_hash(r) == m_rope_hash(r2));
+  m_rope_cat(r2, r);
+  assert( m_rope_equal_cstr_p(r2, "Bye worldBye world"));
+  assert( m_rope_equal_cstr_p(r, "Bye world"));
+  assert( !m_rope_equal_p(r, r2));
+  assert( m_rope_cmp(r, r2) < 0);
+  assert( m_rope_cmp(r2, r) > 0);
+  m_rope_cat(r2, r2);
+  assert( m_rope_equal_cstr_p(r2, "Bye worldBye worldBye worldBye world"));
+  m_rope_set_n(r, r2, 4, 9);
+  assert( m_rope_equal_cstr_p(r, "worldBye "));
+  m_rope_mid(r, 5, 100);
+  assert( m_rope_equal_cstr_p(r, "Bye "));
+  m_rope_insert(r2, 3, r);
+  assert( m_rope_equal_cstr_p(r2, "ByeBye  worldBye worldBye worldBye world"));
+  m_rope_set(r, r2);
+  assert( m_rope_equal_p(r, r2));
+  m_rope_set_cstr(r, "World");
+  m_rope_set_string(r2, s);
+  assert( m_rope_equal_cstr_p(r2, "Bye world"));
+  assert( m_rope_cmp(r, r2) > 0);
+  m_rope_swap(r, r2);
+  assert( m_rope_equal_cstr_p(r, "Bye world"));
+  m_rope_move(r, r2);
+  assert( m_rope_equal_cstr_p(r, "World"));
+  m_rope_init_move(r2, r);
+  m_rope_init_move_string(r, s);
+  assert( m_rope_equal_cstr_p(r, "Bye world"));
+  assert( m_rope_equal_cstr_p(r2, "World"));
+  m_rope_reset(r);
+  assert( m_rope_empty_p(r));
+  m_rope_clear(r);
+  m_rope_clear(r2);
+}
+
+/* Edit randomly a rope and a string in the same way and compare them */
+static void test_random(void)
+{
+  m_rope_t r, old;
+  m_string_t s, s_old, tmp;
+  char buffer[64];
+
+  m_rope_init(r);
+  m_rope_init(old);
+  m_string_init(s);
+  m_string_init(s_old);
+  m_string_init(tmp);
+  srand(42);
+  for(int i = 0; i < NB_EDITS; i++) {
+    size_t size = m_string_size(s);
+    size_t pos = size == 0 ? 0 : (size_t) rand() % (size + 1);
+    size_t len = (size_t) rand() % 40;
+    switch (rand() % 6) {
+    case 0:
+    case 1:
+    case 2:
+      for(size_t j = 0; j < len; j++) {
+        buffer[j] = (char) ('a' + rand() % 26);
+      }
+      buffer[len] = 0;
+      m_rope_insert_cstr(r, pos, buffer);
+      m_string_replace_at(s, pos, 0, buffer);
+      break;
+    case 3:
+      len = M_MIN(len, size - pos);
+      m_rope_erase(r, pos, len);
+      m_string_replace_at(s, pos, len, "");
+      break;
+    case 4:
+      // Keep a copy which shall not be modified by the following edits
+      m_rope_set(old, r);
+      m_string_set(s_old, s);
+      break;
+    default:
+      m_rope_cat_cstr(r, "END");
+      m_string_cat_cstr(s, "END");
+      break;
+    }
+    if ((i % 1024) == 0) {
+      m_rope_flatten(tmp, r);
+      assert( m_string_equal_p(tmp, s));
+      m_rope_flatten(tmp, old);
+      assert( m_string_equal_p(tmp, s_old));
+    }
+    assert( m_rope_size(r) == m_string_size(s));
+  }
+  assert( m_rope_equal_string_p(r, s));
+  assert( m_rope_equal_string_p(old, s_old));
+  for(size_t i = 0; i < m_string_size(s); i += 97) {
+    assert( m_rope_get_char(r, i) == m_string_get_char(s, i));
+  }
+  // Compare a substring with the string
+  m_rope_set_n(old, r, 100, 5000);
+  m_string_set_n(s_old, s, 100, 5000);
+  assert( m_rope_equal_string_p(old, s_old));
+  m_rope_t r2;
+  m_rope_init_set_string(r2, s_old);
+  assert( m_rope_equal_p(old, r2));
+  assert( m_rope_hash(old) == m_rope_hash(r2));
+  m_rope_clear(r2);
+
+  m_rope_clear(r);
+  m_rope_clear(old);
+  m_string_clear(s);
+  m_string_clear(s_old);
+  m_string_clear(tmp);
+}
+
+static void test_it(void)
+{
+  m_string_t s;
+  m_rope_t r;
+  m_string_it_t its;
+  m_rope_it_t itr, itr2;
+
+  m_string_init(s);
+  for(int i = 0; i < 1000; i++) {
+    m_string_cat_cstr(s, i % 3 == 0 ? "\xE2\x82\xAC" : i % 3 == 1 ? "x" : "\xC3\xA9");
+  }
+  m_rope_init_set_string(r, s);
+  // Split the rope in the middle of code points:
+  // inserting nothing keeps big leaves separated
+  m_rope_insert_cstr(r, 1001, "");
+  m_rope_insert_cstr(r, 2, "");
+  assert( m_rope_equal_string_p(r, s));
+
+  size_t n = 0;
+  m_string_it(its, s);
+  for(m_rope_it(itr, r); !m_rope_end_p(itr); m_rope_next(itr)) {
+    assert( !m_string_end_p(its));
+    assert( m_rope_it_get_pos(itr) == m_string_it_get_pos(its));
+    assert( *m_rope_cref(itr) == m_string_get_cref(its));
+    m_string_next(its);
+    n++;
+  }
+  assert( m_string_end_p(its));
+  assert( n == 1000);
+  m_rope_it_end(itr2, r);
+  assert( m_rope_it_equal_p(itr, itr2));
+  assert( m_rope_it_get_pos(itr2) == m_rope_size(r));
+  m_rope_it_pos(itr, r, 996);
+  assert( m_rope_it_get_pos(itr) == 996);
+  assert( m_rope_get_cref(itr) == 0x20AC);
+  m_rope_it_set(itr2, itr);
+  assert( m_rope_it_equal_p(itr, itr2));
+  m_rope_next(itr);
+  assert( !m_rope_it_equal_p(itr, itr2));
+  assert( m_rope_get_cref(itr) == 'x');
+
+  // Generic iteration through the oplist
+  n = 0;
+  for M_EACH(c, r, M_ROPE_OPLIST) {
+    n += *c == 'x';
+  }
+  assert( n == 333);
+
+  m_rope_clear(r);
+  m_string_clear(s);
+}
+
+static void test_oplist(void)
+{
+  M_LET(r, r2, ROPE_OPLIST)
+  M_LET(a, M_OPL_array_rope_t())
+  M_LET(d, M_OPL_dict_rope_t())
+  M_LET(str, STRING_OPLIST) {
+    m_rope_set_cstr(r, "Hello");
+    m_rope_set_cstr(r2, "World");
+    array_rope_push_back(a, r);
+    array_rope_push_back(a, r2);
+    dict_rope_set_at(d, r, 1);
+    dict_rope_set_at(d, r2, 2);
+    m_rope_cat_cstr(r, ", World");
+    assert( dict_rope_get(d, r) == NULL);
+    m_rope_set_n(r, r, 7, 5);
+    assert( *dict_rope_get(d, r) == 2);
+    array_rope_get_str(str, a, false);
+    assert( m_string_equal_cstr_p(str, "[\"Hello\",\"World\"]"));
+    m_rope_cat_cstr(r, "\n\"");
+    m_rope_get_str(str, r, false);
+    assert( m_string_equal_cstr_p(str, "\"World\\n\\\"\""));
+
+    FILE *f = m_core_fopen("a-mrope.dat", "wt");
+    if (!f) abort();
+    m_rope_out_str(f, r);
+    fputc(' ', f);
+    m_rope_fputs(f, r2);
+    fclose(f);
+    f = m_core_fopen("a-mrope.dat", "rt");
+    if (!f) abort();
+    bool b = m_rope_in_str(r2, f);
+    assert( b == true);
+    assert( m_rope_equal_p(r, r2));
+    fclose(f);
+  }
+}
+
+static void thread_edit(void *arg)
+{
+  const m_rope_srcptr base = (m_rope_srcptr) arg;
+  m_rope_t r;
+  m_rope_init(r);
+  for(int i = 0; i < NB_EDITS / 10; i++) {
+    // Each copy shares the nodes of the base rope with the other threads
+    m_rope_set(r, base);
+    m_rope_insert_cstr(r, (size_t) i, "thread");
+    m_rope_erase(r, 0, 3);
+    assert( m_rope_size(r) == m_rope_size(base) + 3);
+    m_rope_mid(r, 100, 200);
+  }
+  m_rope_clear(r);
+}
+
+static void test_thread(void)
+{
+  m_thread_t idx[NB_THREADS];
+  m_rope_t base;
+  m_rope_init(base);
+  for(int i = 0; i < 100; i++) {
+    m_rope_cat_cstr(base, "0123456789abcdefghijklmnopqrstuvwxyz");
+  }
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_create(idx[i], thread_edit, (void*) base);
+  }
+  for(int i = 0; i < NB_THREADS; i++) {
+    m_thread_join(idx[i]);
+  }
+  assert( m_rope_size(base) == 3600);
+  assert( m_rope_get_char(base, 3599) == 'z');
+  m_rope_clear(base);
+}
+
+int main(void)
+{
+  test_basic();
+  test_random();
+  test_it();
+  test_oplist();
+  test_thread();
+  testobj_final_check();
+  exit(0);
+}
@@ -36,6 +36,12 @@
 ARRAY_DEF(a2, int)
 #define M_OPL_a2_t() ARRAY_OPLIST(a2, M_BASIC_OPLIST)
 
+ARRAY_DEF(ad, double)
+#define M_OPL_ad_t() ARRAY_OPLIST(ad, M_BASIC_OPLIST)
+
+ARRAY_DEF(au, unsigned short)
+#define M_OPL_au_t() ARRAY_OPLIST(au, M_BASIC_OPLIST)
+
 LIST_DEF(l2, int)
 #define M_OPL_l2_t() LIST_OPLIST(l2, M_BASIC_OPLIST)
 
@@ -159,10 +165,339 @@ static void test_out_fill(void)
   my2_clear(el2);
 }
 
+static void fill_my2(my2_t el)
+{
+  el->activated = true;
+  el->data->vala = 145788;
+  el->data->valb = -0.1f;
+  el->data->valc = false;
+  string_set_str(el->data->vald, "This is a string test.");
+  for(int i = 0; i < 1000; i++)
+    a2_push_back(el->data->vale, i * i - 50);
+  v2_set_is_int(el->data->valf, 12356789);
+  l2_push_back(el->data->valg, 1345);
+  l2_push_back(el->data->valg, 46543);
+  d2_set_at(el->data->valh, STRING_CTE("Paul"), 1);
+  d2_set_at(el->data->valh, STRING_CTE("Smith"), 2);
+  el->data->vall = 3.25;
+  el->data->valm = -17.5L;
+}
+
+static void test_buffer(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  my2_t e1, e2;
+  bstring_t b;
+  my2_init(e1);
+  my2_init(e2);
+  bstring_init(b);
+  fill_my2(e2);
+
+  m_serial_bin_buffer_write_init(out, b);
+  ret = my2_out_serial(out, e2);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  size_t size = bstring_size(b);
+  assert (size > 4000);
+
+  m_serial_bin_buffer_read_init(in, bstring_view(b, 0, size), size);
+  ret = my2_in_serial(e1, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (m_serial_bin_buffer_read_pos(in) == size);
+  m_serial_bin_buffer_read_clear(in);
+  assert (my2_equal_p (e1, e2));
+
+  // Same format than the FILE serializer
+  FILE *f = m_core_fopen ("a-mbin.dat", "wb");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_bin_write_t) {
+    ret = my2_out_serial(serial, e2);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  bstring_t b2;
+  bstring_init(b2);
+  f = m_core_fopen ("a-mbin.dat", "rb");
+  if (!f) abort();
+  bool success = bstring_fread(b2, f, size);
+  assert (success);
+  fclose(f);
+  // (Don't compare the bytes: the padding of a long double is not defined)
+  assert (bstring_size(b2) == size);
+  m_serial_bin_buffer_read_init(in, bstring_view(b2, 0, size), size);
+  ret = my2_in_serial(e1, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (my2_equal_p (e1, e2));
+  bstring_clear(b2);
+
+  // Append to the buffer: a second object follows the first one
+  my2_reset(e1);
+  M_LET( (serial, b), m_serial_bin_buffer_write_t) {
+    ret = my2_out_serial(serial, e1);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  M_LET( (serial, bstring_view(b, 0, bstring_size(b)), bstring_size(b)), m_serial_bin_buffer_read_t) {
+    ret = my2_in_serial(e1, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (my2_equal_p (e1, e2));
+    ret = my2_in_serial(e1, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (m_serial_bin_buffer_read_pos(serial) == bstring_size(b));
+    assert (e1->activated == false);
+  }
+
+  // A truncated buffer is detected
+  for(size_t n = 0; n < size; n += 1 + n / 8) {
+    m_serial_bin_buffer_read_init(in, bstring_view(b, 0, size), n);
+    ret = my2_in_serial(e1, in);
+    assert (ret == M_SERIAL_FAIL);
+    assert (m_serial_bin_buffer_read_pos(in) <= n);
+    m_serial_bin_buffer_read_clear(in);
+  }
+
+  // Long string (non compact size)
+  string_reset(e2->data->vald);
+  for(int i = 0; i < 1000; i++)
+    string_cat_str(e2->data->vald, "0123456789");
+  bstring_reset(b);
+  m_serial_bin_buffer_write_init(out, b);
+  ret = my2_out_serial(out, e2);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  ret = my2_in_serial(e1, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (my2_equal_p (e1, e2));
+
+  bstring_clear(b);
+  my2_clear(e1);
+  my2_clear(e2);
+}
+
+static void test_raw_array(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  m_serial_write_interface_t no_raw_write;
+  m_serial_read_interface_t  no_raw_read;
+  ad_t d1, d2;
+  au_t u1, u2;
+  bstring_t b, b2;
+  ad_init(d1);
+  ad_init(d2);
+  au_init(u1);
+  au_init(u2);
+  bstring_init(b);
+  bstring_init(b2);
+
+  // The basic types are serialized as a whole
+  assert (M_SERIAL_RAW_KIND(M_BASIC_OPLIST, int) == M_SERIAL_RAW_SINT);
+  assert (M_SERIAL_RAW_KIND(M_BASIC_OPLIST, unsigned short) == M_SERIAL_RAW_UINT);
+  assert (M_SERIAL_RAW_KIND(M_BASIC_OPLIST, double) == M_SERIAL_RAW_FLOAT);
+  assert (M_SERIAL_RAW_KIND(M_BASIC_OPLIST, bool) == M_SERIAL_RAW_NONE);
+  assert (M_SERIAL_RAW_KIND(STRING_OPLIST, string_t) == M_SERIAL_RAW_NONE);
+
+  for(int i = 0; i < 1000; i++) {
+    ad_push_back(d1, i / 3.0);
+    au_push_back(u1, (unsigned short) (65535 - i));
+  }
+
+  // Same bytes with and without the raw array service
+  m_serial_bin_buffer_write_init(out, b);
+  ret = ad_out_serial(out, d1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_out_serial(out, u1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  assert (bstring_size(b) == 2 * sizeof (size_t) + 1000 * (sizeof (double) + sizeof (unsigned short)));
+
+  m_serial_bin_buffer_write_init(out, b2);
+  no_raw_write = *out->m_interface;
+  no_raw_write.write_raw_array = NULL;
+  out->m_interface = &no_raw_write;
+  ret = ad_out_serial(out, d1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_out_serial(out, u1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  assert (bstring_equal_p(b, b2));
+
+  // And they can be read back with and without the raw array service
+  m_serial_bin_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  ret = ad_in_serial(d2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_in_serial(u2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (m_serial_bin_buffer_read_pos(in) == bstring_size(b));
+  assert (ad_equal_p(d1, d2));
+  assert (au_equal_p(u1, u2));
+
+  m_serial_bin_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  no_raw_read = *in->m_interface;
+  no_raw_read.read_raw_array = NULL;
+  in->m_interface = &no_raw_read;
+  ret = ad_in_serial(d2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_in_serial(u2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (ad_equal_p(d1, d2));
+  assert (au_equal_p(u1, u2));
+
+  // A truncated array is detected
+  m_serial_bin_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), sizeof (size_t) + 999 * sizeof (double));
+  ret = ad_in_serial(d2, in);
+  assert (ret == M_SERIAL_FAIL);
+  assert (ad_empty_p(d2));
+
+  // The FILE serializer uses the same format
+  FILE *f = m_core_fopen ("a-mbin.dat", "wb");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_bin_write_t) {
+    ret = ad_out_serial(serial, d1);
+    assert (ret == M_SERIAL_OK_DONE);
+    ret = au_out_serial(serial, u1);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  f = m_core_fopen ("a-mbin.dat", "rb");
+  if (!f) abort();
+  bool success = bstring_fread(b2, f, bstring_size(b) + 1);
+  assert (!success);
+  assert (bstring_equal_p(b, b2));
+  rewind(f);
+  M_LET( (serial, f), m_serial_bin_read_t) {
+    ret = ad_in_serial(d2, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+    ret = au_in_serial(u2, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  assert (ad_equal_p(d1, d2));
+  assert (au_equal_p(u1, u2));
+
+  bstring_clear(b);
+  bstring_clear(b2);
+  ad_clear(d1);
+  ad_clear(d2);
+  au_clear(u1);
+  au_clear(u2);
+}
+
+static void test_feed(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  my2_t e1, e2, e3;
+  bstring_t b;
+  unsigned char chunk[1000];
+  my2_init(e1);
+  my2_init(e2);
+  my2_init(e3);
+  bstring_init(b);
+  fill_my2(e2);
+  e3->activated = true;
+  e3->data->vala = -12;
+
+  // Two objects in the same stream
+  m_serial_bin_buffer_write_init(out, b);
+  ret = my2_out_serial(out, e2);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = my2_out_serial(out, e3);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  const size_t size = bstring_size(b);
+  const unsigned char *data = bstring_view(b, 0, size);
+
+  // Nothing fed
+  m_serial_bin_feed_init(in);
+  ret = m_serial_bin_feed_commit(in, my2_in_serial(e1, in));
+  assert (ret == M_SERIAL_FAIL_RETRY);
+  assert (m_serial_bin_feed_missing(in) > 0);
+  m_serial_bin_feed_clear(in);
+
+  // The whole stream in one chunk: parsed in place
+  m_serial_bin_feed_init(in);
+  m_serial_bin_feed(in, data, size);
+  ret = m_serial_bin_feed_commit(in, my2_in_serial(e1, in));
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (my2_equal_p (e1, e2));
+  ret = m_serial_bin_feed_commit(in, my2_in_serial(e1, in));
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (my2_equal_p (e1, e3));
+  ret = m_serial_bin_feed_commit(in, my2_in_serial(e1, in));
+  assert (ret == M_SERIAL_FAIL_RETRY);
+  m_serial_bin_feed_clear(in);
+
+  // The stream split in chunks of different sizes
+  for(size_t step = 1; step < sizeof chunk; step = step * 3 + 1) {
+    size_t pos = 0;
+    int num = 0;
+    m_serial_bin_feed_init(in);
+    while (pos < size) {
+      size_t n = M_MIN(step, size - pos);
+      memcpy(chunk, &data[pos], n);
+      m_serial_bin_feed(in, chunk, n);
+      pos += n;
+      while (m_serial_bin_feed_missing(in) == 0) {
+        ret = m_serial_bin_feed_commit(in, my2_in_serial(e1, in));
+        if (ret == M_SERIAL_FAIL_RETRY) {
+          break;
+        }
+        assert (ret == M_SERIAL_OK_DONE);
+        assert (my2_equal_p (e1, num == 0 ? e2 : e3));
+        num++;
+      }
+      // The chunk is no longer used by the reader
+      memset(chunk, 0xA5, sizeof chunk);
+    }
+    assert (num == 2);
+    m_serial_bin_feed_clear(in);
+  }
+
+  // Invalid data are not waited for
+  v2_t v;
+  v2_init(v);
+  v2_set_is_int(v, 17);
+  bstring_reset(b);
+  m_serial_bin_buffer_write_init(out, b);
+  ret = v2_out_serial(out, v);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  int id = 100;
+  memcpy(chunk, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  memcpy(chunk, &id, sizeof id);
+  m_serial_bin_feed_init(in);
+  m_serial_bin_feed(in, chunk, 2);
+  ret = m_serial_bin_feed_commit(in, v2_in_serial(v, in));
+  assert (ret == M_SERIAL_FAIL_RETRY);
+  m_serial_bin_feed(in, chunk + 2, bstring_size(b) - 2);
+  ret = m_serial_bin_feed_commit(in, v2_in_serial(v, in));
+  assert (ret == M_SERIAL_FAIL);
+  m_serial_bin_feed_clear(in);
+  v2_clear(v);
+
+  M_LET(serial, m_serial_bin_feed_t) {
+    m_serial_bin_feed(serial, data, 1);
+    ret = m_serial_bin_feed_commit(serial, my2_in_serial(e1, serial));
+    assert (ret == M_SERIAL_FAIL_RETRY);
+  }
+
+  bstring_clear(b);
+  my2_clear(e1);
+  my2_clear(e2);
+  my2_clear(e3);
+}
+
 int main(void)
 {
   test_out_empty();
   test_out_fill();
+  test_buffer();
+  test_raw_array();
+  test_feed();
   exit(0);    
 }
 
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "m-tuple.h"
+#include "m-array.h"
+#include "coverage.h"
+
+#include "m-serial-frame.h"
+
+// Serial BIN is not supported for standard types if not C11
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L  
+
+ARRAY_DEF(a2, int)
+#define M_OPL_a2_t() ARRAY_OPLIST(a2, M_BASIC_OPLIST)
+
+TUPLE_DEF2(rec,
+           (id, int),
+           (name, string_t),
+           (data, a2_t) )
+#define M_OPL_rec_t() TUPLE_OPLIST(rec, M_BASIC_OPLIST, STRING_OPLIST, M_OPL_a2_t())
+
+#define NUM_RECORDS 100
+
+static void test_crc(void)
+{
+  assert (m_serial_frame_crc32c(0, "", 0) == 0);
+  assert (m_serial_frame_crc32c(0, "123456789", 9) == 0xE3069283U);
+  assert (m_serial_frame_crc32c(m_serial_frame_crc32c(0, "1234", 4), "56789", 5) == 0xE3069283U);
+  static const char text[] = "The quick brown fox jumps over the lazy dog";
+  assert (m_serial_frame_crc32c(0, text, strlen(text)) == 0x22620404U);
+}
+
+static void fill_record(rec_t r, int i)
+{
+  rec_set_id(r, i);
+  string_printf(r->name, "record-%d", i);
+  a2_reset(r->data);
+  for(int j = 0; j < i; j++)
+    a2_push_back(r->data, j * i);
+}
+
+// Write a framed file of NUM_RECORDS records
+static long write_file(const char filename[])
+{
+  m_serial_return_code_t ret;
+  m_serial_write_t out;
+  m_serial_frame_write_t frame;
+  rec_t r;
+  rec_init(r);
+
+  FILE *f = m_core_fopen(filename, "wb");
+  if (!f) abort();
+  bool b = m_serial_frame_write_header(f, 3);
+  assert (b);
+  m_serial_frame_write_init(frame, f);
+  for(int i = 0; i < NUM_RECORDS; i++) {
+    fill_record(r, i);
+    m_serial_frame_write_start(frame, out);
+    ret = rec_out_serial(out, r);
+    assert (ret == M_SERIAL_OK_DONE);
+    b = m_serial_frame_write_end(frame);
+    assert (b);
+  }
+  m_serial_frame_write_clear(frame);
+  long size = ftell(f);
+  fclose(f);
+  rec_clear(r);
+  return size;
+}
+
+// Read the records of a framed file and return the number of valid records
+static int read_file(const char filename[], m_serial_return_code_t expected)
+{
+  m_serial_return_code_t ret;
+  m_serial_read_t in;
+  m_serial_frame_read_t frame;
+  rec_t r, ref;
+  rec_init(r);
+  rec_init(ref);
+  int n = 0;
+
+  FILE *f = m_core_fopen(filename, "rb");
+  if (!f) abort();
+  uint32_t version = 0;
+  bool b = m_serial_frame_read_header(f, &version);
+  assert (b);
+  assert (version == 3);
+  m_serial_frame_read_init(frame, f);
+  while ((ret = m_serial_frame_read_next(frame, in)) == M_SERIAL_OK_CONTINUE) {
+    ret = rec_in_serial(r, in);
+    assert (ret == M_SERIAL_OK_DONE);
+    // The whole payload is parsed
+    assert (m_serial_bin_buffer_read_pos(in) == in->data[1].s);
+    fill_record(ref, n);
+    assert (rec_equal_p(r, ref));
+    n++;
+  }
+  assert (ret == expected);
+  m_serial_frame_read_clear(frame);
+  fclose(f);
+  rec_clear(r);
+  rec_clear(ref);
+  return n;
+}
+
+// Copy the first 'size' bytes of a file, changing the byte at 'pos'
+static void copy_file(const char dst[], const char src[], long size, long pos)
+{
+  FILE *in = m_core_fopen(src, "rb");
+  FILE *out = m_core_fopen(dst, "wb");
+  if (!in || !out) abort();
+  for(long i = 0; i < size; i++) {
+    int c = fgetc(in);
+    assert (c != EOF);
+    fputc(i == pos ? c ^ 0x10 : c, out);
+  }
+  fclose(in);
+  fclose(out);
+}
+
+static void test_frame(void)
+{
+  long size = write_file("a-mframe.dat");
+  int n = read_file("a-mframe.dat", M_SERIAL_OK_DONE);
+  assert (n == NUM_RECORDS);
+
+  // Scan of a valid file
+  size_t count;
+  FILE *f = m_core_fopen("a-mframe.dat", "rb");
+  if (!f) abort();
+  uint32_t version;
+  bool b = m_serial_frame_read_header(f, &version);
+  assert (b);
+  long pos = m_serial_frame_scan(f, &count);
+  assert (pos == size);
+  assert (count == NUM_RECORDS);
+  fclose(f);
+
+  // Torn tail: the last record is incomplete
+  copy_file("a-mframe2.dat", "a-mframe.dat", size - 5, -1);
+  n = read_file("a-mframe2.dat", M_SERIAL_FAIL);
+  assert (n == NUM_RECORDS - 1);
+  f = m_core_fopen("a-mframe2.dat", "r+b");
+  if (!f) abort();
+  b = m_serial_frame_read_header(f, &version);
+  assert (b);
+  pos = m_serial_frame_scan(f, &count);
+  assert (count == NUM_RECORDS - 1);
+  assert (pos > 0 && pos < size - 5);
+  // Write the missing record after the last valid one
+  M_LET(r, rec_t) {
+    m_serial_write_t out;
+    m_serial_frame_write_t frame;
+    fill_record(r, NUM_RECORDS - 1);
+    m_serial_frame_write_init(frame, f);
+    m_serial_frame_write_start(frame, out);
+    m_serial_return_code_t ret = rec_out_serial(out, r);
+    assert (ret == M_SERIAL_OK_DONE);
+    b = m_serial_frame_write_end(frame);
+    assert (b);
+    m_serial_frame_write_clear(frame);
+  }
+  assert (ftell(f) == size);
+  fclose(f);
+  n = read_file("a-mframe2.dat", M_SERIAL_OK_DONE);
+  assert (n == NUM_RECORDS);
+
+  // Torn header of the last record
+  copy_file("a-mframe2.dat", "a-mframe.dat", pos + 7, -1);
+  n = read_file("a-mframe2.dat", M_SERIAL_FAIL);
+  assert (n == NUM_RECORDS - 1);
+
+  // Corrupted payload in the middle of the file
+  copy_file("a-mframe2.dat", "a-mframe.dat", size, size / 2);
+  n = read_file("a-mframe2.dat", M_SERIAL_FAIL);
+  assert (n > 0 && n < NUM_RECORDS);
+  f = m_core_fopen("a-mframe2.dat", "rb");
+  if (!f) abort();
+  b = m_serial_frame_read_header(f, &version);
+  assert (b);
+  pos = m_serial_frame_scan(f, &count);
+  assert (count == (size_t) n);
+  assert (pos < size / 2);
+  fclose(f);
+
+  // Corrupted size of the first record
+  copy_file("a-mframe2.dat", "a-mframe.dat", size, M_SER1AL_FRAME_HEADER_SIZE + 1);
+  n = read_file("a-mframe2.dat", M_SERIAL_FAIL);
+  assert (n == 0);
+
+  // Not a framed file
+  copy_file("a-mframe2.dat", "a-mframe.dat", size, 2);
+  f = m_core_fopen("a-mframe2.dat", "rb");
+  if (!f) abort();
+  b = m_serial_frame_read_header(f, &version);
+  assert (!b);
+  fclose(f);
+}
+
+int main(void)
+{
+  test_crc();
+  test_frame();
+  exit(0);
+}
+
+#else
+int main(void)
+{
+  exit(0);    
+}
+#endif
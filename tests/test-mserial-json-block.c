@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+// Use a small block to test the refill of the FILE reader
+#define M_USE_SERIAL_JSON_BLOCK_SIZE 256
+#include "test-obj.h"
+#include "m-tuple.h"
+#include "m-array.h"
+#include "coverage.h"
+
+#include "m-serial-json.h"
+
+// Serial json is not supported for standard types if not C11
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+
+ARRAY_DEF(a2, int)
+#define M_OPL_a2_t() ARRAY_OPLIST(a2, M_BASIC_OPLIST)
+
+TUPLE_DEF2(my,
+           (vala, int),
+           (vald, string_t),
+           (vale, a2_t) )
+#define M_OPL_my_t() TUPLE_OPLIST(my, M_BASIC_OPLIST, STRING_OPLIST, M_OPL_a2_t() )
+
+TUPLE_DEF2(my2,
+           (activated, bool),
+           (data, my_t, M_OPL_my_t() ) )
+
+static void test_in_file_block(void)
+{
+  m_serial_return_code_t ret;
+  my2_t el1, el2;
+  a2_t a;
+  my2_init(el1);
+  my2_init(el2);
+  a2_init(a);
+
+  // Tokens across the blocks, longer than a block, and after many spaces
+  FILE *f = m_core_fopen("a-mjson.dat", "wt");
+  if (!f) abort();
+  fprintf(f, "{ \"activated\":%*s true, \"data\": { \"vala\": 000", 1000, "");
+  for(int i = 0; i < 500; i++)
+    fputc('0', f);
+  fprintf(f, "1742, \"vald\": \"");
+  for(int i = 0; i < 1000; i++)
+    fprintf(f, "\\\"0123456789");
+  fprintf(f, "\", \"vale\": [");
+  for(int i = 0; i < 1000; i++)
+    fprintf(f, "%s%d", i == 0 ? "" : ", ", i - 500);
+  fprintf(f, "] } }\n[1, 2, 3]");
+  fclose(f);
+
+  f = m_core_fopen ("a-mjson.dat", "rt");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_json_read_t) {
+    ret = my2_in_serial(el1, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  // The characters read ahead are given back to the FILE
+  M_LET( (serial, f), m_serial_json_read_t) {
+    ret = a2_in_serial(a, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  assert (el1->activated == true);
+  assert (el1->data->vala == 1742);
+  assert (string_size(el1->data->vald) == 11000);
+  assert (string_start_with_str_p(el1->data->vald, "\"0123456789\"0"));
+  assert (a2_size(el1->data->vale) == 1000);
+  assert (*a2_get(el1->data->vale, 999) == 499);
+  assert (a2_size(a) == 3);
+  assert (*a2_get(a, 2) == 3);
+
+  // Same result than the string reader
+  string_t s;
+  string_init(s);
+  f = m_core_fopen ("a-mjson.dat", "rt");
+  if (!f) abort();
+  bool b = string_fgets(s, f, STRING_READ_FILE);
+  assert (b);
+  fclose(f);
+  M_LET( (serial, string_get_cstr(s)), m_serial_str_json_read_t) {
+    ret = my2_in_serial(el2, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  assert (my2_equal_p(el1, el2));
+
+  // A truncated stream is detected
+  f = m_core_fopen("a-mjson.dat", "wt");
+  if (!f) abort();
+  fprintf(f, "%.*s", (int) (string_size(s) - 20), string_get_cstr(s));
+  fclose(f);
+  f = m_core_fopen ("a-mjson.dat", "rt");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_json_read_t) {
+    ret = my2_in_serial(el2, serial);
+    assert (ret == M_SERIAL_FAIL);
+  }
+  fclose(f);
+
+  string_clear(s);
+  a2_clear(a);
+  my2_clear(el1);
+  my2_clear(el2);
+}
+
+int main(void)
+{
+  test_in_file_block();
+  exit(0);
+}
+
+#else
+int main(void)
+{
+  exit(0);
+}
+#endif
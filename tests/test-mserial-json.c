@@ -36,6 +36,12 @@
 ARRAY_DEF(a2, int)
 #define M_OPL_a2_t() ARRAY_OPLIST(a2, M_BASIC_OPLIST)
 
+ARRAY_DEF(af, float)
+#define M_OPL_af_t() ARRAY_OPLIST(af, M_BASIC_OPLIST)
+
+ARRAY_DEF(au, unsigned long long)
+#define M_OPL_au_t() ARRAY_OPLIST(au, M_BASIC_OPLIST)
+
 ARRAY_DEF(l2, int)
 #define M_OPL_l2_t() ARRAY_OPLIST(l2, M_BASIC_OPLIST)
 
@@ -88,7 +94,7 @@ static void test_out_empty(void)
 
   f = m_core_fopen ("a-mjson.dat", "rt");
   if (!f) abort();
-  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":0,\"valb\":0.000000,\"valc\":false,\"vald\":\"\",\"vale\":[],\"valf\":{},\"valg\":[],\"valh\":{},\"vali\":0}";
+  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":0,\"valb\":0,\"valc\":false,\"vald\":\"\",\"vale\":[],\"valf\":{},\"valg\":[],\"valh\":{},\"vali\":0}";
   char get[sizeof expected];
   char *unused = fgets (get, sizeof expected , f);
   assert (unused != NULL && strcmp(get, expected) == 0);
@@ -152,8 +158,8 @@ static void test_out_fill(void)
 
   f = m_core_fopen ("a-mjson.dat", "rt");
   if (!f) abort();
-  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.300000,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"steeve\":-4,\"jane\":3},\"vali\":3}}";
-  static const char expected2[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.300000,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"jane\":3,\"steeve\":-4},\"vali\":3}}";
+  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.3,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"steeve\":-4,\"jane\":3},\"vali\":3}}";
+  static const char expected2[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.3,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"jane\":3,\"steeve\":-4},\"vali\":3}}";
   char get[sizeof expected];
   char *unused2 = fgets (get, sizeof expected , f);
   assert(unused2 != NULL);
@@ -192,7 +198,7 @@ static void test_out_str_empty(void)
   assert (ret == M_SERIAL_OK_DONE);
   m_serial_str_json_write_clear(out);
 
-  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":0,\"valb\":0.000000,\"valc\":false,\"vald\":\"\",\"vale\":[],\"valf\":{},\"valg\":[],\"valh\":{},\"vali\":0}";
+  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":0,\"valb\":0,\"valc\":false,\"vald\":\"\",\"vale\":[],\"valf\":{},\"valg\":[],\"valh\":{},\"vali\":0}";
   assert (string_equal_str_p(f, expected) == 0);
   
   m_serial_str_json_read_init(in, string_get_cstr(f) );
@@ -246,8 +252,8 @@ static void test_out_str_fill(void)
   m_serial_str_json_write_clear(out);
 
   // In function of the precise hashing (different between 64 bits & 32 bits), both strings are possible: 
-  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.300000,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"steeve\":-4,\"jane\":3},\"vali\":3}}";
-  static const char expected2[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.300000,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"jane\":3,\"steeve\":-4},\"vali\":3}}";
+  static const char expected[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.3,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"steeve\":-4,\"jane\":3},\"vali\":3}}";
+  static const char expected2[] = "{ \"activated\":false,\"data\":{ \"vala\":1742,\"valb\":-2.3,\"valc\":true,\"vald\":\"This is a test\",\"vale\":[1,2,3],\"valf\":{\"is_bool\":true},\"valg\":[1,2,3,4,5,6],\"valh\":{\"jane\":3,\"steeve\":-4},\"vali\":3}}";
   assert(string_equal_str_p(f, expected) || string_equal_str_p(f, expected2) );
   
   m_serial_str_json_read_init(in, string_get_cstr(f) );
@@ -619,9 +625,11 @@ static void test_out_str_error(void)
           " \"vald\": \"This is a test\",\n"
           "\"vali\": 3,"
           "    \"valc\": true   } }");
+  // An unknown field (even longer than an identifier) is skipped
   m_serial_str_json_read_init(in, string_get_cstr(s));
   ret = my2_in_serial(el, in);
-  assert (ret == M_SERIAL_FAIL);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (el->data->vala == 1742);
   m_serial_str_json_read_clear(in);
 
   string_set_str(s, 
@@ -682,6 +690,257 @@ static void test_out_str_error(void)
   string_clear(s);
 }
 
+static void test_raw_array(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  m_serial_write_interface_t no_raw;
+  af_t f1, f2;
+  au_t u1, u2;
+  string_t s1, s2;
+  af_init(f1);
+  af_init(f2);
+  au_init(u1);
+  au_init(u2);
+  string_init(s1);
+  string_init(s2);
+
+  for(int i = 0; i < 500; i++) {
+    af_push_back(f1, (float) i / 4.0f - 17.0f);
+    au_push_back(u1, 1ULL << (i % 64));
+  }
+
+  // Same output with and without the raw array service
+  m_serial_str_json_write_init(out, s1);
+  ret = af_out_serial(out, f1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_out_serial(out, u1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_str_json_write_clear(out);
+  assert (string_start_with_str_p(s1, "[-17,-16.75,-16.5,"));
+
+  m_serial_str_json_write_init(out, s2);
+  no_raw = *out->m_interface;
+  no_raw.write_raw_array = NULL;
+  out->m_interface = &no_raw;
+  ret = af_out_serial(out, f1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_out_serial(out, u1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_str_json_write_clear(out);
+  assert (string_equal_p(s1, s2));
+
+  // Including the FILE serializer, which flushes its buffer several times
+  FILE *f = m_core_fopen("a-mjson.dat", "wt");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_json_write_t) {
+    ret = af_out_serial(serial, f1);
+    assert (ret == M_SERIAL_OK_DONE);
+    ret = au_out_serial(serial, u1);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  f = m_core_fopen("a-mjson.dat", "rt");
+  if (!f) abort();
+  bool b = string_fgets(s2, f, STRING_READ_FILE);
+  assert (b);
+  fclose(f);
+  assert (string_equal_p(s1, s2));
+
+  // And read back
+  m_serial_str_json_read_init(in, string_get_cstr(s1));
+  ret = af_in_serial(f2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = au_in_serial(u2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  const char *end = m_serial_str_json_read_clear(in);
+  assert (*end == 0);
+  assert (af_equal_p(f1, f2));
+  assert (au_equal_p(u1, u2));
+
+  af_clear(f1);
+  af_clear(f2);
+  au_clear(u1);
+  au_clear(u2);
+  string_clear(s1);
+  string_clear(s2);
+}
+
+static void test_skip_unknown(void)
+{
+  m_serial_return_code_t ret;
+  my2_t el1, el2;
+  v2_t v;
+  my2_init(el1);
+  my2_init(el2);
+  v2_init(v);
+
+  // Unknown fields of any kind are skipped, in any order
+  // (a key with escaped characters is always unknown)
+  static const char str[] =
+    "{ \"version\": 2, \"data\": { \"vala\": 17, \"extra\": { \"a\": [1, {\"b\": \"}]\\\"\" }, [], {}],"
+    " \"c\": null, \"d\": -1.5e+3 }, \"valc\": true, \"vald\": \"x\", \"tags\": [\"u\", true, false],"
+    " \"vali\": 2 }, \"name\": \"{[\", \"activated\": true, \"empty\": {},"
+    " \"a\\\"b\": 1, \"\\\\\": [2], \"activ\\u0061ted\": false }";
+  M_LET( (serial, str), m_serial_str_json_read_t) {
+    ret = my2_in_serial(el1, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (*m_serial_str_json_read_clear(serial) == 0);
+  }
+  assert (el1->activated == true);
+  assert (el1->data->vala == 17);
+  assert (el1->data->valc == true);
+  assert (string_equal_str_p(el1->data->vald, "x"));
+  assert (el1->data->vali == 2);
+
+  // Same result with the FILE reader, with an unknown value longer than a block
+  FILE *f = m_core_fopen("a-mjson.dat", "wt");
+  if (!f) abort();
+  fprintf(f, "{ \"unknown\": [");
+  for(int i = 0; i < 1000; i++)
+    fprintf(f, "%s{ \"k\": [%d, \"\\\"%d\"] }", i == 0 ? "" : ", ", i, i);
+  fprintf(f, "], \"data\": { \"vala\": 17, \"valc\": true, \"vald\": \"x\", \"vali\": 2 },"
+          " \"activated\": true }");
+  fclose(f);
+  f = m_core_fopen ("a-mjson.dat", "rt");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_json_read_t) {
+    ret = my2_in_serial(el2, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  assert (my2_equal_p(el1, el2));
+
+  // Badly formed unknown values are detected
+  static const char *const bad[] = {
+    "{ \"unknown\": [1, 2 }, \"activated\": true }",
+    "{ \"unknown\": { \"a\": 1 ], \"activated\": true }",
+    "{ \"unknown\": \"abc, \"activated\": true }",
+    "{ \"unknown\": ( 1 ), \"activated\": true }",
+    "{ \"unknown\": [[[1, 2], \"activated\": true }",
+    "{ \"unknown\": , \"activated\": true }",
+    "{ , \"unknown\": 1, \"activated\": true }",
+    "{ \"unknown\": 1, \"activated\": true ",
+    "{ \"a\\\"b: 1, \"activated\": true }",
+    "{ \"a\\"
+  };
+  for(size_t i = 0; i < sizeof bad / sizeof bad[0]; i++) {
+    M_LET( (serial, bad[i]), m_serial_str_json_read_t) {
+      ret = my2_in_serial(el2, serial);
+      assert (ret == M_SERIAL_FAIL);
+    }
+  }
+
+  // A variant cannot store an unknown field
+  M_LET( (serial, "{ \"is_float\": 1.0 }"), m_serial_str_json_read_t) {
+    ret = v2_in_serial(v, serial);
+    assert (ret == M_SERIAL_FAIL);
+  }
+  M_LET( (serial, "{ \"is_bool\" : true }"), m_serial_str_json_read_t) {
+    ret = v2_in_serial(v, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (*v2_get_is_bool(v) == true);
+  }
+
+  v2_clear(v);
+  my2_clear(el1);
+  my2_clear(el2);
+}
+
+/* Sink which appends the JSON stream to a string */
+typedef struct {
+  string_t out;
+  size_t   calls;
+  size_t   vectored;
+  size_t   max_buffer;
+  size_t   max_calls;
+} sink_t;
+
+static bool sink(void *data, const m_serial_json_iovec_t iov[], size_t n)
+{
+  sink_t *s = (sink_t *) data;
+  assert (n == 1 || n == 2);
+  if (s->calls == s->max_calls) return false;
+  s->calls++;
+  s->vectored += (n == 2);
+  s->max_buffer = M_MAX(s->max_buffer, iov[0].size);
+  for(size_t i = 0; i < n; i++)
+    string_cat_printf(s->out, "%.*s", (int) iov[i].size, iov[i].ptr);
+  return true;
+}
+
+static void test_sink(void)
+{
+  m_serial_return_code_t ret;
+  my2_t el;
+  string_t ref;
+  sink_t s;
+  my2_init(el);
+  string_init(ref);
+  string_init(s.out);
+
+  my2_set_activated(el, true);
+  for(int i = 0; i < 10000; i++) {
+    a2_push_back(el->data->vale, i * 7);
+    l2_push_back(el->data->valg, -i);
+  }
+  for(int i = 0; i < 1000; i++) {
+    string_printf(el->data->vald, "key-%d", i);
+    d2_set_at(el->data->valh, el->data->vald, i);
+  }
+  // Long string without character to escape
+  string_reset(el->data->vald);
+  for(int i = 0; i < 100; i++)
+    string_cat_str(el->data->vald, "0123456789");
+  v2_set_is_int(el->data->valf, 42);
+
+  M_LET( (serial, ref), m_serial_str_json_write_t) {
+    ret = my2_out_serial(serial, el);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+
+  // Same JSON stream with a bounded buffer
+  s.calls = s.vectored = s.max_buffer = 0;
+  s.max_calls = SIZE_MAX;
+  M_LET( (serial, sink, &s, 256), m_serial_json_sink_write_t) {
+    ret = my2_out_serial(serial, el);
+    assert (ret == M_SERIAL_OK_DONE);
+    ret = m_serial_json_sink_write_flush(serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  assert (string_equal_p(s.out, ref));
+  assert (s.calls > string_size(ref) / 512);
+  assert (s.max_buffer < 256 + 64);
+  assert (s.vectored == 1);
+
+  // The remaining stream is given to the sink when clearing
+  string_reset(s.out);
+  s.calls = 0;
+  M_LET( (serial, sink, &s, 1000000), m_serial_json_sink_write_t) {
+    ret = my2_out_serial(serial, el);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  assert (string_equal_p(s.out, ref));
+  assert (s.calls == 1);
+
+  // A failure of the sink is reported
+  string_reset(s.out);
+  s.calls = 0;
+  s.max_calls = 3;
+  M_LET( (serial, sink, &s, 256), m_serial_json_sink_write_t) {
+    ret = my2_out_serial(serial, el);
+    assert (ret == M_SERIAL_FAIL);
+    ret = m_serial_json_sink_write_flush(serial);
+    assert (ret == M_SERIAL_FAIL);
+  }
+  assert (s.calls == 3);
+
+  string_clear(s.out);
+  string_clear(ref);
+  my2_clear(el);
+}
+
 int main(void)
 {
   test_out_empty();
@@ -690,6 +949,9 @@ int main(void)
   test_out_str_empty();
   test_out_str_fill();
   test_out_str_error();
+  test_raw_array();
+  test_skip_unknown();
+  test_sink();
   exit(0);    
 }
 
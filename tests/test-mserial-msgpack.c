@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "m-tuple.h"
+#include "m-array.h"
+#include "m-variant.h"
+#include "m-list.h"
+#include "m-dict.h"
+#include "coverage.h"
+
+#include "m-serial-msgpack.h"
+
+// Serial MessagePack is not supported for standard types if not C11
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L  
+
+ARRAY_DEF(a2, int)
+#define M_OPL_a2_t() ARRAY_OPLIST(a2, M_BASIC_OPLIST)
+
+ARRAY_DEF(ad, double)
+#define M_OPL_ad_t() ARRAY_OPLIST(ad, M_BASIC_OPLIST)
+
+ARRAY_DEF(ai, long long)
+#define M_OPL_ai_t() ARRAY_OPLIST(ai, M_BASIC_OPLIST)
+
+LIST_DEF(l2, int)
+#define M_OPL_l2_t() LIST_OPLIST(l2, M_BASIC_OPLIST)
+
+DICT_DEF2(d2, string_t, STRING_OPLIST, int, M_BASIC_OPLIST )
+#define M_OPL_d2_t() DICT_OPLIST(d2, STRING_OPLIST, M_BASIC_OPLIST)
+
+VARIANT_DEF2(v2,
+             (is_int, int),
+             (is_bool, bool) )
+#define M_OPL_v2_t() VARIANT_OPLIST(v2, M_BASIC_OPLIST, M_BASIC_OPLIST)
+            
+TUPLE_DEF2(my,
+           (vala, int),
+           (valb, float),
+           (valc, bool),
+           (vald, string_t),
+           (vale, a2_t),
+           (valf, v2_t),
+           (valg, l2_t),
+           (valh, d2_t),
+           (vali, unsigned char),
+           (valj, short),
+           (valk, long long),
+           (vall, double),
+           (valm, long double)
+           )
+#define M_OPL_my_t() TUPLE_OPLIST(my, \
+          M_BASIC_OPLIST, \
+          M_BASIC_OPLIST, \
+          M_BOOL_OPLIST, \
+          STRING_OPLIST, \
+          M_OPL_a2_t(), \
+          M_OPL_v2_t(), \
+          M_OPL_l2_t(), \
+          M_OPL_d2_t(), \
+          M_BASIC_OPLIST, \
+          M_BASIC_OPLIST, \
+          M_BASIC_OPLIST, \
+          M_BASIC_OPLIST, \
+          M_BASIC_OPLIST )
+
+TUPLE_DEF2(my2,
+           (activated, bool),
+           (data, my_t, M_OPL_my_t() ) )
+
+TUPLE_DEF2(pt,
+           (x, int),
+           (y, unsigned short) )
+
+static void fill_my2(my2_t el)
+{
+  el->activated = true;
+  el->data->vala = 145788;
+  el->data->valb = -0.1f;
+  el->data->valc = false;
+  string_set_str(el->data->vald, "This is a string test.");
+  for(int i = 0; i < 1000; i++)
+    a2_push_back(el->data->vale, i * i - 50);
+  v2_set_is_int(el->data->valf, 12356789);
+  l2_push_back(el->data->valg, 1345);
+  l2_push_back(el->data->valg, 46543);
+  d2_set_at(el->data->valh, STRING_CTE("Paul"), 1);
+  d2_set_at(el->data->valh, STRING_CTE("Smith"), 2);
+  el->data->vali = 255;
+  el->data->valj = -300;
+  el->data->valk = -123456789012LL;
+  el->data->vall = 3.25;
+  el->data->valm = -17.5L;
+}
+
+static void test_out_empty(void)
+{
+  m_serial_return_code_t ret;
+  my2_t el1, el2;
+  my2_init(el1);
+  my2_init(el2);
+  
+  FILE *f = m_core_fopen ("a-mmsgpack.dat", "wb");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_msgpack_write_t) {
+    ret = my2_out_serial(serial, el1);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+
+  f = m_core_fopen ("a-mmsgpack.dat", "rb");
+  if (!f) abort();
+  M_LET( (serial, f), m_serial_msgpack_read_t) {
+    ret = my2_in_serial(el2, serial);
+    assert (ret == M_SERIAL_OK_DONE);
+  }
+  fclose(f);
+  
+  assert (my2_equal_p (el1, el2));
+
+  my2_clear(el1);
+  my2_clear(el2);
+}
+
+static void test_out_fill(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  my2_t el1, el2;
+  bstring_t b, b2;
+  my2_init(el1);
+  my2_init(el2);
+  bstring_init(b);
+  bstring_init(b2);
+  fill_my2(el2);
+
+  FILE *f = m_core_fopen ("a-mmsgpack.dat", "wb");
+  if (!f) abort();
+  m_serial_msgpack_write_init(out, f);
+  ret = my2_out_serial(out, el2);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_msgpack_write_clear(out);
+  fclose(f);
+
+  f = m_core_fopen ("a-mmsgpack.dat", "rb");
+  if (!f) abort();
+  m_serial_msgpack_read_init(in, f);
+  ret = my2_in_serial(el1, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_msgpack_read_clear(in);
+  assert (my2_equal_p (el1, el2));
+
+  // Same bytes in memory than in the FILE
+  m_serial_msgpack_buffer_write_init(out, b);
+  ret = my2_out_serial(out, el2);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_msgpack_buffer_write_clear(out);
+  rewind(f);
+  bool success = bstring_fread(b2, f, bstring_size(b) + 1);
+  assert (!success);
+  fclose(f);
+  assert (bstring_equal_p(b, b2));
+
+  my2_reset(el1);
+  m_serial_msgpack_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  ret = my2_in_serial(el1, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (m_serial_msgpack_buffer_read_pos(in) == bstring_size(b));
+  m_serial_msgpack_buffer_read_clear(in);
+  assert (my2_equal_p (el1, el2));
+
+  // A truncated buffer is detected
+  const size_t size = bstring_size(b);
+  for(size_t n = 0; n < size; n += 1 + n / 8) {
+    m_serial_msgpack_buffer_read_init(in, bstring_view(b, 0, size), n);
+    ret = my2_in_serial(el1, in);
+    assert (ret == M_SERIAL_FAIL);
+    assert (m_serial_msgpack_buffer_read_pos(in) <= n);
+    m_serial_msgpack_buffer_read_clear(in);
+  }
+
+  bstring_clear(b);
+  bstring_clear(b2);
+  my2_clear(el1);
+  my2_clear(el2);
+}
+
+static bool check_bytes(const bstring_t b, size_t n, const unsigned char *expected)
+{
+  return bstring_size(b) == n && memcmp(bstring_view(b, 0, n), expected, n) == 0;
+}
+
+static void test_format(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  bstring_t b;
+  a2_t a;
+  v2_t v;
+  pt_t p;
+  bstring_init(b);
+  a2_init(a);
+  v2_init(v);
+  pt_init(p);
+
+  // Smallest encoding of integers, big endian
+  static const int tab[] = { 0, 127, 128, 300, 70000, -1, -32, -33, -200, -40000, -70000 };
+  for(size_t i = 0; i < sizeof tab / sizeof tab[0]; i++)
+    a2_push_back(a, tab[i]);
+  static const unsigned char a_bytes[] = { 0x9b, 0x00, 0x7f, 0xcc, 0x80, 0xcd, 0x01, 0x2c,
+    0xce, 0x00, 0x01, 0x11, 0x70, 0xff, 0xe0, 0xd0, 0xdf, 0xd1, 0xff, 0x38,
+    0xd2, 0xff, 0xff, 0x63, 0xc0, 0xd2, 0xff, 0xfe, 0xee, 0x90 };
+  m_serial_msgpack_buffer_write_init(out, b);
+  ret = a2_out_serial(out, a);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (check_bytes(b, sizeof a_bytes, a_bytes));
+
+  // A tuple is a map of its field names
+  pt_emplace(p, 1, 2);
+  bstring_reset(b);
+  ret = pt_out_serial(out, p);
+  assert (ret == M_SERIAL_OK_DONE);
+  static const unsigned char p_bytes[] = { 0x82, 0xa1, 'x', 0x01, 0xa1, 'y', 0x02 };
+  assert (check_bytes(b, sizeof p_bytes, p_bytes));
+
+  // A variant is a map of one field name, or nil
+  v2_set_is_bool(v, true);
+  bstring_reset(b);
+  ret = v2_out_serial(out, v);
+  assert (ret == M_SERIAL_OK_DONE);
+  static const unsigned char v_bytes[] = { 0x81, 0xa7, 'i', 's', '_', 'b', 'o', 'o', 'l', 0xc3 };
+  assert (check_bytes(b, sizeof v_bytes, v_bytes));
+  v2_reset(v);
+  bstring_reset(b);
+  ret = v2_out_serial(out, v);
+  assert (ret == M_SERIAL_OK_DONE);
+  static const unsigned char nil_bytes[] = { 0xc0 };
+  assert (check_bytes(b, sizeof nil_bytes, nil_bytes));
+
+  // Floats are IEEE 754 big endian
+  bstring_reset(b);
+  ret = out->m_interface->write_float(out, 1.5, sizeof (double));
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = out->m_interface->write_float(out, -2.0f, sizeof (float));
+  assert (ret == M_SERIAL_OK_DONE);
+  static const unsigned char f_bytes[] = { 0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xca, 0xc0, 0, 0, 0 };
+  assert (check_bytes(b, sizeof f_bytes, f_bytes));
+  m_serial_msgpack_buffer_write_clear(out);
+
+  // Long strings
+  string_t s1, s2;
+  string_init(s1);
+  string_init(s2);
+  for(int i = 0; i < 100; i++) {
+    string_cat_str(s1, "0123456789");
+    bstring_reset(b);
+    m_serial_msgpack_buffer_write_init(out, b);
+    ret = string_out_serial(out, s1);
+    assert (ret == M_SERIAL_OK_DONE);
+    m_serial_msgpack_buffer_write_clear(out);
+    const size_t len = string_size(s1);
+    assert (bstring_get_byte(b, 0) == (len < 32 ? 0xa0 + len : len < 256 ? 0xd9 : 0xda));
+    m_serial_msgpack_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+    ret = string_in_serial(s2, in);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (string_equal_p(s1, s2));
+  }
+  string_clear(s1);
+  string_clear(s2);
+
+  // Messages from other implementations: fields in any order,
+  // integers with a non minimal encoding
+  static const unsigned char p2_bytes[] = { 0x82, 0xd9, 0x01, 'y', 0xcd, 0x00, 0x05, 0xa1, 'x', 0xd3,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd };
+  m_serial_msgpack_buffer_read_init(in, p2_bytes, sizeof p2_bytes);
+  ret = pt_in_serial(p, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (p->x == -3 && p->y == 5);
+  // Out of range integer
+  static const unsigned char p3_bytes[] = { 0x81, 0xa1, 'y', 0xce, 0x00, 0x01, 0x00, 0x00 };
+  m_serial_msgpack_buffer_read_init(in, p3_bytes, sizeof p3_bytes);
+  ret = pt_in_serial(p, in);
+  assert (ret == M_SERIAL_FAIL);
+  // Unknown field
+  static const unsigned char p4_bytes[] = { 0x81, 0xa1, 'z', 0x01 };
+  m_serial_msgpack_buffer_read_init(in, p4_bytes, sizeof p4_bytes);
+  ret = pt_in_serial(p, in);
+  assert (ret == M_SERIAL_FAIL);
+  // Wrong type
+  static const unsigned char p5_bytes[] = { 0x81, 0xa1, 'x', 0xc3 };
+  m_serial_msgpack_buffer_read_init(in, p5_bytes, sizeof p5_bytes);
+  ret = pt_in_serial(p, in);
+  assert (ret == M_SERIAL_FAIL);
+  // Integer read as a float
+  static const unsigned char d_bytes[] = { 0x92, 0x05, 0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0 };
+  ad_t d;
+  ad_init(d);
+  m_serial_msgpack_buffer_read_init(in, d_bytes, sizeof d_bytes);
+  ret = ad_in_serial(d, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (ad_size(d) == 2 && *ad_get(d, 0) == 5.0 && *ad_get(d, 1) == 1.5);
+  ad_clear(d);
+
+  pt_clear(p);
+  v2_clear(v);
+  a2_clear(a);
+  bstring_clear(b);
+}
+
+static void test_raw_array(void)
+{
+  m_serial_read_t  in;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+  m_serial_write_interface_t no_raw_write;
+  ad_t d1, d2;
+  ai_t i1, i2;
+  bstring_t b, b2;
+  ad_init(d1);
+  ad_init(d2);
+  ai_init(i1);
+  ai_init(i2);
+  bstring_init(b);
+  bstring_init(b2);
+
+  for(int i = 0; i < 1000; i++) {
+    ad_push_back(d1, i / 3.0);
+    ai_push_back(i1, (long long) i * i * i * i * (i % 2 ? -1 : 1));
+  }
+
+  // Same bytes with and without the raw array service
+  m_serial_msgpack_buffer_write_init(out, b);
+  ret = ad_out_serial(out, d1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = ai_out_serial(out, i1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_msgpack_buffer_write_clear(out);
+
+  m_serial_msgpack_buffer_write_init(out, b2);
+  no_raw_write = *out->m_interface;
+  no_raw_write.write_raw_array = NULL;
+  out->m_interface = &no_raw_write;
+  ret = ad_out_serial(out, d1);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = ai_out_serial(out, i1);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_msgpack_buffer_write_clear(out);
+  assert (bstring_equal_p(b, b2));
+
+  m_serial_msgpack_buffer_read_init(in, bstring_view(b, 0, bstring_size(b)), bstring_size(b));
+  ret = ad_in_serial(d2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = ai_in_serial(i2, in);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (m_serial_msgpack_buffer_read_pos(in) == bstring_size(b));
+  assert (ad_equal_p(d1, d2));
+  assert (ai_equal_p(i1, i2));
+
+  bstring_clear(b);
+  bstring_clear(b2);
+  ad_clear(d1);
+  ad_clear(d2);
+  ai_clear(i1);
+  ai_clear(i2);
+}
+
+int main(void)
+{
+  test_out_empty();
+  test_out_fill();
+  test_format();
+  test_raw_array();
+  exit(0);    
+}
+
+#else
+int main(void)
+{
+  exit(0);    
+}
+#endif
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "m-array.h"
+#include "m-dict.h"
+#include "coverage.h"
+
+#include "m-serial-par.h"
+
+// Serial is not supported for standard types if not C11
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+
+ARRAY_DEF(ai, int)
+#define M_OPL_ai_t() ARRAY_OPLIST(ai, M_BASIC_OPLIST)
+
+ARRAY_DEF(as, string_t)
+#define M_OPL_as_t() ARRAY_OPLIST(as, STRING_OPLIST)
+
+DICT_DEF2(ds, string_t, STRING_OPLIST, int, M_BASIC_OPLIST)
+#define M_OPL_ds_t() DICT_OPLIST(ds, STRING_OPLIST, M_BASIC_OPLIST)
+
+DICT_SET_DEF(dset, int)
+#define M_OPL_dset_t() DICT_SET_OPLIST(dset, M_BASIC_OPLIST)
+
+START_COVERAGE
+SERIAL_PAR_DEF(par_ai, ai_t)
+SERIAL_PAR_DEF(par_as, as_t)
+SERIAL_PAR_DEF(par_ds, ds_t)
+SERIAL_PAR_DEF(par_dset, dset_t)
+END_COVERAGE
+
+static worker_t w_g;
+
+// Check that the body of the record is the sequential BIN serialization
+static void check_bin_body(const bstring_t par, const bstring_t seq)
+{
+  assert (bstring_size(par) > bstring_size(seq));
+  assert (memcmp(bstring_view(par, 0, bstring_size(seq)),
+                 bstring_view(seq, 0, bstring_size(seq)), bstring_size(seq)) == 0);
+}
+
+static void test_array(void)
+{
+  as_t a, a2;
+  string_t s;
+  bstring_t b, ref;
+  m_serial_write_t out;
+  m_serial_return_code_t ret;
+
+  as_init(a);
+  as_init(a2);
+  string_init(s);
+  bstring_init(b);
+  bstring_init(ref);
+  for(int i = 0; i < 10000; i++) {
+    string_printf(s, "string %d", i);
+    as_push_back(a, s);
+  }
+
+  ret = par_as_out_serial_bin(b, a, w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_init(out, ref);
+  ret = as_out_serial(out, a);
+  assert (ret == M_SERIAL_OK_DONE);
+  m_serial_bin_buffer_write_clear(out);
+  check_bin_body(b, ref);
+
+  ret = par_as_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (as_equal_p(a, a2));
+
+  // The record can also be read sequentially
+  M_LET( (in, bstring_view(b, 0, bstring_size(b)), bstring_size(b)), m_serial_bin_buffer_read_t) {
+    ret = as_in_serial(a2, in);
+    assert (ret == M_SERIAL_OK_DONE);
+    assert (as_equal_p(a, a2));
+  }
+
+  // Truncated or corrupted records are rejected
+  ret = par_as_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b) - 1, w_g);
+  assert (ret == M_SERIAL_FAIL);
+  assert (as_empty_p(a2));
+  bstring_set_byte(b, bstring_size(ref) + 3, 0xFF);
+  ret = par_as_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g);
+  assert (ret == M_SERIAL_FAIL);
+  assert (as_empty_p(a2));
+
+  // JSON output is the same as the sequential one
+  M_LET(j, jref, string_t) {
+    ret = par_as_out_serial_json(j, a, w_g);
+    assert (ret == M_SERIAL_OK_DONE);
+    M_LET( (o, jref), m_serial_str_json_write_t) {
+      ret = as_out_serial(o, a);
+      assert (ret == M_SERIAL_OK_DONE);
+    }
+    assert (string_equal_p(j, jref));
+  }
+
+  bstring_clear(b);
+  bstring_clear(ref);
+  string_clear(s);
+  as_clear(a);
+  as_clear(a2);
+}
+
+static void test_empty(void)
+{
+  M_LET(a, a2, ai_t)
+    M_LET(b, bstring_t)
+    M_LET(j, string_t) {
+    ai_push_back(a2, 17);
+    assert (par_ai_out_serial_bin(b, a, w_g) == M_SERIAL_OK_DONE);
+    assert (par_ai_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g) == M_SERIAL_OK_DONE);
+    assert (ai_empty_p(a2));
+    assert (par_ai_out_serial_json(j, a, w_g) == M_SERIAL_OK_DONE);
+    assert (string_equal_str_p(j, "[]"));
+    for(int i = 0; i < 1000; i++) {
+      ai_push_back(a, i * i);
+    }
+    bstring_reset(b);
+    assert (par_ai_out_serial_bin(b, a, w_g) == M_SERIAL_OK_DONE);
+    assert (par_ai_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g) == M_SERIAL_OK_DONE);
+    assert (ai_equal_p(a, a2));
+  }
+}
+
+static void test_dict(void)
+{
+  ds_t d, d2;
+  dset_t set, set2;
+  string_t s;
+  bstring_t b;
+  m_serial_return_code_t ret;
+
+  ds_init(d);
+  ds_init(d2);
+  dset_init(set);
+  dset_init(set2);
+  string_init(s);
+  bstring_init(b);
+  for(int i = 0; i < 5000; i++) {
+    string_printf(s, "key %d", i);
+    ds_set_at(d, s, i);
+    dset_push(set, 3 * i);
+  }
+
+  ret = par_ds_out_serial_bin(b, d, w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = par_ds_in_serial_bin(d2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (ds_equal_p(d, d2));
+  ret = par_ds_in_serial_bin(d2, bstring_view(b, 1, bstring_size(b) - 1), bstring_size(b) - 1, w_g);
+  assert (ret == M_SERIAL_FAIL);
+  assert (ds_empty_p(d2));
+
+  bstring_reset(b);
+  ret = par_dset_out_serial_bin(b, set, w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  ret = par_dset_in_serial_bin(set2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g);
+  assert (ret == M_SERIAL_OK_DONE);
+  assert (dset_equal_p(set, set2));
+
+  M_LET(j, jref, string_t) {
+    ret = par_ds_out_serial_json(j, d, w_g);
+    assert (ret == M_SERIAL_OK_DONE);
+    M_LET( (o, jref), m_serial_str_json_write_t) {
+      ret = ds_out_serial(o, d);
+      assert (ret == M_SERIAL_OK_DONE);
+    }
+    assert (string_equal_p(j, jref));
+  }
+
+  bstring_clear(b);
+  string_clear(s);
+  ds_clear(d);
+  ds_clear(d2);
+  dset_clear(set);
+  dset_clear(set2);
+}
+
+// Overwrite the size_t at 'offset' of the byte string
+static void set_size(bstring_t b, size_t offset, size_t x)
+{
+  uint8_t tmp[sizeof x];
+  memcpy(tmp, &x, sizeof x);
+  for(size_t i = 0; i < sizeof x; i++) {
+    bstring_set_byte(b, offset + i, tmp[i]);
+  }
+}
+
+static void test_corrupted(void)
+{
+  M_LET(a, a2, ai_t)
+  M_LET(b, bstring_t) {
+    for(int i = 0; i < 10; i++) {
+      ai_push_back(a, i);
+    }
+    assert (par_ai_out_serial_bin(b, a, w_g) == M_SERIAL_OK_DONE);
+    // One chunk: the footer is one entry (offset, count) and the trailer
+    const size_t data_size = bstring_size(b) - 16 - 24;
+    assert (par_ai_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g) == M_SERIAL_OK_DONE);
+    // A huge number of elements is rejected before creating them
+    const size_t huge = SIZE_MAX / 4;
+    set_size(b, 0, huge);
+    set_size(b, data_size + 8, huge);
+    assert (par_ai_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g) == M_SERIAL_FAIL);
+    assert (ai_empty_p(a2));
+    // A number of elements bigger than the record is rejected too
+    set_size(b, 0, data_size);
+    set_size(b, data_size + 8, data_size);
+    assert (par_ai_in_serial_bin(a2, bstring_view(b, 0, bstring_size(b)), bstring_size(b), w_g) == M_SERIAL_FAIL);
+    assert (ai_empty_p(a2));
+  }
+}
+
+int main(void)
+{
+  worker_init(w_g, 0, 0, NULL);
+  test_empty();
+  test_array();
+  test_dict();
+  test_corrupted();
+  worker_clear(w_g);
+  exit(0);
+}
+
+#else
+int main(void)
+{
+  exit(0);
+}
+#endif
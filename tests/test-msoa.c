@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2017-2026, Patrick Pelissier
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * + Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * + Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "test-obj.h"
+#include "m-string.h"
+#include "m-soa.h"
+#include "coverage.h"
+
+START_COVERAGE
+SOA_ARRAY_DEF(particle,
+              (x, float),
+              (y, float),
+              (mass, double),
+              (id, unsigned))
+END_COVERAGE
+#define M_OPL_particle_t() SOA_ARRAY_OPLIST(particle)
+
+SOA_ARRAY_DEF_AS(record, Record, RecordIt,
+                 (name, string_t),
+                 (obj, testobj_t, TESTOBJ_OPLIST),
+                 (value, int))
+#define M_OPL_Record() SOA_ARRAY_OPLIST(record)
+
+static void test_basic(void)
+{
+  particle_t p;
+  particle_init(p);
+  assert (particle_empty_p(p));
+  for(unsigned i = 0; i < 100; i++) {
+    particle_push_back(p, (float) i, (float) (2*i), 0.5 * i, i);
+  }
+  assert (particle_size(p) == 100);
+  assert (particle_capacity(p) >= 100);
+  assert (!particle_empty_p(p));
+
+  // Pass over a single column
+  float *x = particle_get_x_ptr(p);
+  const float *y = particle_cget_y_ptr(p);
+  for(size_t i = 0; i < particle_size(p); i++) {
+    x[i] += y[i];
+  }
+  for(unsigned i = 0; i < 100; i++) {
+    assert (*particle_cget_at_x(p, i) == (float) (3*i));
+    assert (*particle_cget_at_id(p, i) == i);
+  }
+
+  // Row iterator
+  double s = 0;
+  unsigned n = 0;
+  particle_it_t it;
+  for(particle_it(it, p); !particle_end_p(it); particle_next(it)) {
+    assert (*particle_cref_id(it) == particle_it_index(it));
+    s += *particle_cref_mass(it);
+    *particle_ref_y(it) = 0;
+    n++;
+  }
+  assert (n == 100);
+  assert (s == 0.5 * 99 * 100 / 2);
+  assert (*particle_get_at_y(p, 42) == 0);
+  particle_it_last(it, p);
+  assert (particle_last_p(it));
+  assert (*particle_cref_id(it) == 99);
+
+  particle_pop_at(p, 10);
+  assert (particle_size(p) == 99);
+  assert (*particle_cget_at_id(p, 10) == 11);
+  particle_push_at(p, 10, 1.0f, 2.0f, 3.0, 10);
+  assert (*particle_cget_at_id(p, 10) == 10);
+  assert (*particle_cget_at_id(p, 11) == 11);
+  assert (particle_erase(p, 99));
+  assert (!particle_erase(p, 99));
+  particle_pop_back(p);
+  assert (particle_size(p) == 98);
+  particle_set_at(p, 0, 5.0f, 6.0f, 7.0, 8);
+  assert (*particle_cget_at_mass(p, 0) == 7.0);
+
+  particle_t q;
+  particle_init_set(q, p);
+  assert (particle_size(q) == 98);
+  assert (*particle_cget_at_id(q, 97) == 97);
+  particle_resize(q, 10);
+  assert (particle_size(q) == 10);
+  particle_reserve(q, 0);
+  assert (particle_capacity(q) == 10);
+  particle_resize(q, 20);
+  assert (*particle_cget_at_id(q, 19) == 0);
+  particle_swap(p, q);
+  assert (particle_size(p) == 20);
+  particle_move(q, p);
+  assert (particle_size(q) == 20);
+  particle_reset(q);
+  assert (particle_empty_p(q));
+  particle_reserve(q, 0);
+  assert (particle_capacity(q) == 0);
+  particle_clear(q);
+}
+
+static void test_obj(void)
+{
+  M_LET(str, string_t)
+  M_LET(o, TESTOBJ_OPLIST)
+  M_LET(r, Record) {
+    for(int i = 0; i < 50; i++) {
+      string_printf(str, "%d", i);
+      testobj_set_ui(o, (unsigned) i);
+      record_push_back(r, str, o, i);
+    }
+    M_LET(r2, Record) {
+      record_set(r2, r);
+      assert (record_size(r2) == 50);
+      assert (string_equal_str_p(*record_cget_at_name(r2, 49), "49"));
+      assert (testobj_cmp_ui(*record_cget_at_obj(r2, 10), 10) == 0);
+      record_pop_at(r2, 0);
+      assert (string_equal_str_p(*record_cget_at_name(r2, 0), "1"));
+      RecordIt it;
+      int i = 1;
+      for(record_it(it, r2); !record_end_p(it); record_next(it), i++) {
+        assert (*record_cref_value(it) == i);
+      }
+      assert (i == 50);
+    }
+  }
+}
+
+int main(void)
+{
+  test_basic();
+  test_obj();
+  testobj_final_check();
+  exit(0);
+}
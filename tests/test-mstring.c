@@ -21,13 +21,28 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+// For pipe and fdopen
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #define M_USE_ADDITIONAL_CHECKS 1
 #include "test-obj.h"
 #include "coverage.h"
 #include "m-string.h"
 
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define HAVE_PIPE 1
+#include <unistd.h>
+#else
+#define HAVE_PIPE 0
+#endif
+
 BOUNDED_STRING_DEF(string16, 16)
 
+STRING_SWITCH_DEF(command, "get", "set", "del", "gets", "", "exit", "g",
+                  "a_very_long_command_name_which_doesnt_fit_in_the_bitmask_of_lengths",
+                  "set")
+
 static void test_utf8_basic(void)
 {
   string_t s;
@@ -104,6 +119,376 @@ static void test_utf8_basic(void)
   string_clear(s);
 }
 
+static void test_utf8_bulk(void)
+{
+  string_t s, s2;
+  string_init(s);
+  string_init(s2);
+  // Mixed stream with long ASCII runs and code points of all sizes
+  const string_unicode_t tab[] = { 'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', 0xE9, 'a', 0x20AC,
+                                   'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 0x1F600, 'k', 0x10FFFF, 0x7FF, 0x800 };
+  const size_t n = sizeof tab / sizeof tab[0];
+  bool b = string_set_utf32(s, tab, n);
+  assert (b);
+  assert (string_utf8_p(s));
+  assert (string_length_u(s) == n);
+  assert (m_utf8_length(string_get_cstr(s), string_size(s)) == m_str1ng_utf8_length(string_get_cstr(s)));
+  int i = 0;
+  string_it_t it;
+  for(string_it(it, s) ; !string_end_p(it); string_next(it), i++) {
+    assert (string_get_cref(it) == tab[i]);
+  }
+
+  // Decode to UTF32
+  string_unicode_t u32[64];
+  assert (string_get_utf32(u32, 64, s) == n);
+  assert (memcmp(u32, tab, sizeof tab) == 0);
+  assert (string_get_utf32(u32, n - 1, s) == SIZE_MAX);
+
+  // Decode to UTF16 and back
+  uint16_t u16[64];
+  size_t n16 = string_get_utf16(u16, 64, s);
+  assert (n16 == n + 2);
+  assert (u16[23] == 0xD83D && u16[24] == 0xDE00);
+  b = string_set_utf16(s2, u16, n16);
+  assert (b);
+  assert (string_equal_p(s, s2));
+  assert (string_get_utf16(u16, n16 - 1, s) == SIZE_MAX);
+
+  // Invalid inputs let the string unmodified
+  const string_unicode_t bad32[] = { 'a', 0xD800 };
+  assert (!string_cat_utf32(s2, bad32, 2));
+  const string_unicode_t null32[] = { 'a', 0 };
+  assert (!string_cat_utf32(s2, null32, 2));
+  const uint16_t bad16[] = { 'a', 0xDC00, 'b' };
+  assert (!string_cat_utf16(s2, bad16, 3));
+  const uint16_t trunc16[] = { 'a', 0xD800 };
+  assert (!string_cat_utf16(s2, trunc16, 2));
+  assert (string_equal_p(s, s2));
+
+  // Invalid UTF8 streams
+  assert (m_utf8_valid_p("abcdefghijklmnop\xC3\xA9", 18));
+  assert (!m_utf8_valid_p("abcdefghijklmnop\xC3", 17));
+  assert (!m_utf8_valid_p("abcdefgh\xC3zbcdefgh", 17));
+  assert (!m_utf8_valid_p("\xED\xA0\x80", 3));
+  assert (!m_utf8_valid_p("\xF4\x90\x80\x80", 4));
+  assert (!m_utf8_valid_p("\xFF", 1));
+  assert (m_utf8_to_utf32(u32, 64, "abcdefgh\xC3zbcdefgh", 17) == SIZE_MAX);
+  assert (m_utf8_to_utf16(u16, 64, "abcdefghijklmnop\xE2\x82", 18) == SIZE_MAX);
+  assert (m_utf8_length("abcdefghijklmnop\xE2\x82\xAC", 19) == 17);
+
+  // Compare with the generic functions over a large buffer
+  string_reset(s);
+  for(string_unicode_t u = 1; u < 0x10FFFF; u += 17) {
+    if (u >= 0xD800 && u <= 0xDFFF) continue;
+    string_push_u(s, u);
+    if ((u % 7) == 0)
+      string_cat_str(s, "0123456789");
+  }
+  assert (string_utf8_p(s));
+  assert (string_length_u(s) == m_str1ng_utf8_length(string_get_cstr(s)));
+  size_t len = string_length_u(s);
+  string_unicode_t *big32 = (string_unicode_t *) malloc(len * sizeof *big32);
+  uint16_t *big16 = (uint16_t *) malloc(string_size(s) * sizeof *big16);
+  assert (big32 != NULL && big16 != NULL);
+  assert (string_get_utf32(big32, len, s) == len);
+  i = 0;
+  for(string_it(it, s) ; !string_end_p(it); string_next(it), i++) {
+    assert (string_get_cref(it) == big32[i]);
+  }
+  assert (string_set_utf32(s2, big32, len));
+  assert (string_equal_p(s, s2));
+  n16 = string_get_utf16(big16, string_size(s), s);
+  assert (n16 != SIZE_MAX);
+  assert (string_set_utf16(s2, big16, n16));
+  assert (string_equal_p(s, s2));
+  free(big32);
+  free(big16);
+
+  string_clear(s);
+  string_clear(s2);
+}
+
+static void test_search_compiled(void)
+{
+  string_t s, s2;
+  string_searcher_t se;
+  size_t pos[8], idx[8], k;
+
+  string_init_set_str(s, "Hello world, the world is wide");
+  string_searcher_init_str(se, "world");
+  assert (string_searcher_size(se) == 1);
+  assert (string_searcher_pattern_size(se, 0) == 5);
+  assert (string_search_compiled(s, se) == 6);
+  assert (string_search_compiled(s, se, 7) == 17);
+  assert (string_search_compiled(s, se, 18, &k) == STRING_FAILURE);
+  assert (string_find_all(s, se, 8, pos, NULL) == 2);
+  assert (pos[0] == 6 && pos[1] == 17);
+  string_searcher_clear(se);
+
+  string_init_set_str(s2, "d");
+  string_searcher_init(se, s2);
+  assert (string_search_compiled(s, se) == 10);
+  assert (string_search_compiled(s, se, 11) == 21);
+  assert (string_find_all(s, se, 0, NULL, NULL) == 3);
+  string_searcher_clear(se);
+
+  // Compare with the standard search on random texts
+  for(int n = 0; n < 100; n++) {
+    string_reset(s);
+    for(int i = 0; i < 200; i++) {
+      string_push_back(s, (char) ('a' + rand() % 3));
+    }
+    char pattern[5];
+    int plen = 1 + n % 4;
+    for(int i = 0; i < plen; i++) {
+      pattern[i] = (char) ('a' + rand() % 3);
+    }
+    pattern[plen] = 0;
+    string_searcher_init_str(se, pattern);
+    for(size_t start = 0; start <= string_size(s); start += 7) {
+      assert (string_search_compiled(s, se, start) == string_search_str(s, pattern, start));
+    }
+    string_searcher_clear(se);
+  }
+
+  // Multiple patterns: leftmost then longest match
+  const char *const patterns[] = { "he", "she", "his", "hers", "bcd", "abcde", "c" };
+  const char *const repl[] = { "1", "22", "", "4444", "X", "YY", "-" };
+  string_searcher_init_multi(se, 7, patterns);
+  assert (string_searcher_size(se) == 7);
+  assert (string_searcher_pattern_size(se, 3) == 4);
+  string_set_str(s, "ushers");
+  assert (string_search_compiled(s, se, 0, &k) == 1 && k == 1);
+  assert (string_search_compiled(s, se, 2, &k) == 2 && k == 3);
+  string_set_str(s, "xabcdx abcdef bcx");
+  assert (string_search_compiled(s, se, 0, &k) == 2 && k == 4);
+  assert (string_search_compiled(s, se, 3, &k) == 3 && k == 6);
+  assert (string_find_all(s, se, 8, pos, idx) == 3);
+  assert (pos[0] == 2 && idx[0] == 4);
+  assert (pos[1] == 7 && idx[1] == 5);
+  assert (pos[2] == 15 && idx[2] == 6);
+  assert (string_find_all(s, se, 2, pos, idx) == 3);
+  string_replace_all_multi(s, se, repl);
+  assert (string_equal_str_p(s, "xaXx YYf b-x"));
+  string_set_str(s, "she said his hershey was here");
+  string_replace_all_multi(s, se, repl);
+  assert (string_equal_str_p(s, "22 said  44441y was 1re"));
+  string_set_str(s, "nothing");
+  string_replace_all_multi(s, se, repl);
+  assert (string_equal_str_p(s, "nothing"));
+  string_set_str(s, "");
+  assert (string_search_compiled(s, se) == STRING_FAILURE);
+  string_searcher_clear(se);
+
+  // Compare with a naive leftmost longest search on random texts
+  const char *const abc[] = { "ab", "abc", "b", "cab", "bcab", "aa", "ca" };
+  string_searcher_init_multi(se, 7, abc);
+  for(int n = 0; n < 100; n++) {
+    string_reset(s);
+    for(int i = 0; i < 100; i++) {
+      string_push_back(s, (char) ('a' + rand() % 3));
+    }
+    size_t start = (size_t) (rand() % 100);
+    size_t ref = STRING_FAILURE, ref_k = 0;
+    for(size_t i = start; i < string_size(s) && ref == STRING_FAILURE; i++) {
+      for(size_t j = 0; j < 7; j++) {
+        if (strncmp(string_get_cstr(s) + i, abc[j], strlen(abc[j])) == 0
+            && (ref == STRING_FAILURE || strlen(abc[j]) > strlen(abc[ref_k]))) {
+          ref = i;
+          ref_k = j;
+        }
+      }
+    }
+    assert (string_search_compiled(s, se, start, &k) == ref);
+    assert (ref == STRING_FAILURE || k == ref_k);
+  }
+  string_searcher_clear(se);
+
+  string_clear(s);
+  string_clear(s2);
+}
+
+static void test_view(void)
+{
+  string_t s, s2;
+  string_view_t v, tab[4];
+  string_tokenize_t it;
+  size_t n;
+
+  string_init_set_str(s, "  Hello, world  \n");
+  v = string_get_view(s);
+  assert (string_view_size(v) == string_size(s));
+  assert (string_view_data(v) == string_get_cstr(s));
+  assert (string_equal_view_p(s, v));
+  assert (string_view_hash(v) == string_hash(s));
+  v = string_view_strim(v);
+  assert (string_view_equal_str_p(v, "Hello, world"));
+  assert (!string_view_equal_str_p(v, "Hello, worl"));
+  assert (!string_view_equal_str_p(v, "Hello, world!"));
+  assert (string_view_get_char(v, 1) == 'e');
+  assert (string_view_equal_str_p(string_view_mid(v, 7, 100), "world"));
+  assert (string_view_equal_str_p(string_view_mid(v, 0, 5), "Hello"));
+  assert (string_view_empty_p(string_view_mid(v, 12, 5)));
+  assert (string_view_equal_str_p(string_view_strim(v, "Hd"), "ello, worl"));
+  assert (string_view_empty_p(string_view_strim(string_view_str(" \t "))));
+  assert (string_view_cmp(v, string_view_str("Hello")) > 0);
+  assert (string_view_cmp(string_view_str("Hello"), v) < 0);
+  assert (string_view_cmp(v, string_view_strn("Hello, world!", 12)) == 0);
+  assert (string_view_cmp(v, string_view_str("Hellp")) < 0);
+  assert (string_view_equal_p(v, string_view_strn("Hello, world!", 12)));
+  // The hash of a view is the hash of the equivalent string whatever its alignment
+  for(size_t i = 0; i < 12; i++) {
+    string_init_set_view(s2, string_view_mid(v, i, 100));
+    assert (string_view_hash(string_view_mid(v, i, 100)) == string_hash(s2));
+    string_clear(s2);
+  }
+
+  string_init(s2);
+  string_set_view(s2, v);
+  assert (string_equal_str_p(s2, "Hello, world"));
+  string_cat_view(s2, string_view_strn("!!!", 1));
+  assert (string_equal_str_p(s2, "Hello, world!"));
+  string_set_view(s2, string_view_mid(string_get_view(s2), 7, 5));
+  assert (string_equal_str_p(s2, "world"));
+  string_view_get_str(s2, string_view_strn("a\"b\n", 4), false);
+  assert (string_equal_str_p(s2, "\"a\\\"b\\n\""));
+  string_view_get_str(s2, v, true);
+  assert (string_equal_str_p(s2, "\"a\\\"b\\n\"\"Hello, world\""));
+
+  string_set_str(s, "a,bb,,ccc,");
+  n = string_split_view(tab, 4, s, ',');
+  assert (n == 5);
+  assert (string_view_equal_str_p(tab[0], "a"));
+  assert (string_view_equal_str_p(tab[1], "bb"));
+  assert (string_view_empty_p(tab[2]));
+  assert (string_view_equal_str_p(tab[3], "ccc"));
+  n = string_view_split(tab, 4, string_view_str(""), ',');
+  assert (n == 1 && string_view_empty_p(tab[0]));
+  n = string_view_split(tab, 0, string_view_str("x;y"), ';');
+  assert (n == 2);
+
+  const char *const expected[] = { "The", "quick", "brown", "fox" };
+  string_set_str(s, " ,The quick,, brown fox ,");
+  n = 0;
+  for(string_tokenize(it, string_get_view(s), " ,"); !string_tokenize_end_p(it); string_tokenize_next(it)) {
+    assert (n < 4);
+    assert (string_view_equal_str_p(*string_tokenize_cref(it), expected[n]));
+    n++;
+  }
+  assert (n == 4);
+  string_tokenize(it, string_view_str(" , "), " ,");
+  assert (string_tokenize_end_p(it));
+
+  string_clear(s);
+  string_clear(s2);
+}
+
+static void test_reader(void)
+{
+  string_t s;
+  string_reader_t r;
+  string_view_t v;
+  size_t n;
+
+  FILE *f = m_core_fopen("a-mstring.dat", "wb");
+  if (!f) abort();
+  fputs("Hello\nWorld\r\n\n  two  words \nlast", f);
+  fclose(f);
+
+  string_init(s);
+  f = m_core_fopen("a-mstring.dat", "rb");
+  if (!f) abort();
+  string_reader_init(r, f);
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_equal_str_p(v, "Hello"));
+  assert (string_reader_tell(r) == 6);
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_equal_str_p(v, "World"));
+  assert (string_reader_get_line(&v, r, STRING_READ_LINE));
+  assert (string_view_equal_str_p(v, "\n"));
+  assert (string_reader_get_word(&v, r, " \n"));
+  assert (string_view_equal_str_p(v, "two"));
+  assert (string_reader_tell(r) == 19);
+  assert (string_reader_get_word(&v, r, " \n"));
+  assert (string_view_equal_str_p(v, "words"));
+  assert (string_reader_fgets(s, r, STRING_READ_LINE));
+  assert (string_equal_str_p(s, " \n"));
+  assert (string_reader_fgets(s, r, STRING_READ_PURE_LINE));
+  assert (string_equal_str_p(s, "last"));
+  assert (!string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (!string_reader_get_word(&v, r, " "));
+  assert (!string_reader_fgets(s, r, STRING_READ_FILE));
+  assert (string_empty_p(s));
+  assert (string_reader_tell(r) == 32);
+  string_reader_clear(r);
+  fclose(f);
+
+  // Lines bigger than the buffer of the reader, words crossing its blocks
+  f = m_core_fopen("a-mstring.dat", "wb");
+  if (!f) abort();
+  for(int i = 0; i < 100000; i++) {
+    fprintf(f, "%d ", i);
+  }
+  fputs("\r\nEND\n", f);
+  fclose(f);
+  f = m_core_fopen("a-mstring.dat", "rb");
+  if (!f) abort();
+  string_reader_init(r, f);
+  n = 0;
+  while (string_reader_get_word(&v, r, " ")) {
+    string_set_view(s, v);
+    if (n < 100000) {
+      assert (atoi(string_get_cstr(s)) == (int) n);
+    }
+    n++;
+  }
+  assert (n == 100001);
+  string_reader_clear(r);
+  rewind(f);
+  string_reader_init(r, f);
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_size(v) == 588890);
+  assert (string_view_equal_p(string_view_mid(v, 0, 6), string_view_str("0 1 2 ")));
+  assert (string_view_get_char(v, string_view_size(v) - 1) == ' ');
+  assert (string_reader_fgets(s, r, STRING_READ_FILE));
+  assert (string_equal_str_p(s, "END\n"));
+  string_reader_clear(r);
+  fclose(f);
+  string_clear(s);
+}
+
+#if HAVE_PIPE
+// A line available in a pipe is provided without waiting for more characters
+static void test_reader_pipe(void)
+{
+  string_reader_t r;
+  string_view_t v;
+  int fd[2];
+  if (pipe(fd) != 0) abort();
+  FILE *f = fdopen(fd[0], "r");
+  if (!f) abort();
+
+  string_reader_init(r, f);
+  ssize_t w = write(fd[1], "first\nsec", 9);
+  assert (w == 9);
+  // The write end is still opened: this blocks if the reader waits for a block
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_equal_str_p(v, "first"));
+  w = write(fd[1], "ond\nlast", 8);
+  assert (w == 8);
+  close(fd[1]);
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_equal_str_p(v, "second"));
+  assert (string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_view_equal_str_p(v, "last"));
+  assert (!string_reader_get_line(&v, r, STRING_READ_PURE_LINE));
+  assert (string_reader_tell(r) == 17);
+  string_reader_clear(r);
+  fclose(f);
+}
+#endif
+
 static void test_utf8_it(void)
 {
   string_t s;
@@ -1075,14 +1460,93 @@ static void test_parse_standard_c_type(void)
   }
 }
 
+static void test_cat_number(void)
+{
+  M_LET(s, string_t) {
+    string_cat_si(s, -42);
+    string_cat_ui(s, 17U);
+    string_cat_sj(s, LLONG_MIN);
+    string_cat_uj(s, ULLONG_MAX);
+    assert (string_equal_str_p(s, "-4217-922337203685477580818446744073709551615"));
+    string_reset(s);
+    string_cat_double(s, 0.1);
+    string_push_back(s, ' ');
+    string_cat_double(s, -1e300);
+    string_push_back(s, ' ');
+    string_cat_float(s, 2.75f);
+    string_push_back(s, ' ');
+    string_cat_double(s, 1.0/3.0);
+    assert (string_equal_str_p(s, "0.1 -1e+300 2.75 0.3333333333333333"));
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    // The default GET_STR method of the C types uses the same conversions
+    double d = 0.3;
+    M_CALL_GET_STR(M_BASIC_OPLIST, s, d, false);
+    assert (string_equal_str_p(s, "0.3"));
+    int i = -7;
+    M_CALL_GET_STR(M_BASIC_OPLIST, s, i, true);
+    assert (string_equal_str_p(s, "0.3-7"));
+    char c = 'C';
+    M_CALL_GET_STR(M_BASIC_OPLIST, s, c, true);
+    assert (string_equal_str_p(s, "0.3-7C"));
+    float f = 1.5f;
+    M_CALL_GET_STR(M_BASIC_OPLIST, s, f, false);
+    assert (string_equal_str_p(s, "1.5"));
+#endif
+  }
+}
+
+static void test_switch(void)
+{
+  assert(command_cstr("get") == 0);
+  assert(command_cstr("set") == 1);
+  assert(command_cstr("del") == 2);
+  assert(command_cstr("gets") == 3);
+  assert(command_cstr("") == 4);
+  assert(command_cstr("exit") == 5);
+  assert(command_cstr("g") == 6);
+  assert(command_cstr("a_very_long_command_name_which_doesnt_fit_in_the_bitmask_of_lengths") == 7);
+  assert(command_cstr("a_very_long_command_name_which_doesnt_fit_in_the_bitmask_of_length") == -1);
+  assert(command_cstr("a_very_long_command_name_which_doesnt_fit_in_the_bitmask_of_lengthz") == -1);
+  assert(command_cstr("got") == -1);
+  assert(command_cstr("Get") == -1);
+  assert(command_cstr("gett") == -1);
+  assert(command_cstr("quit") == -1);
+  assert(command_cstr("getset") == -1);
+  assert(command_strn("getset", 3) == 0);
+  assert(command_strn("getset", 0) == 4);
+  assert(command_strn(NULL, 0) == 4);
+
+  string_t s;
+  string_init_set_str(s, "exit");
+  assert(command_string(s) == 5);
+  string_set_str(s, "del");
+  assert(command_string(s) == 2);
+  string_cat_str(s, "ete");
+  assert(command_string(s) == -1);
+  string_set_str(s, "x set y");
+  assert(command_view(string_view_mid(string_get_view(s), 2, 3)) == 1);
+  assert(command_view(string_view_str("x")) == -1);
+  string_clear(s);
+}
+
 int main(void)
 {
   test0();
   test_rounding();
   test_M_LET();
   test_parse_standard_c_type();
+  test_cat_number();
+  test_switch();
   test_utf8_basic();
   test_utf8_it();
+  test_utf8_bulk();
+  test_search_compiled();
+  test_view();
+  test_reader();
+#if HAVE_PIPE
+  test_reader_pipe();
+#endif
   test_int();
   test_bounded1();
   test_bounded_io();
@@ -28,6 +28,16 @@ size_t fsize(const char str[])
   return m_str1ng_utf8_length(str);
 }
 
+bool fvalid(const char buf[], size_t size)
+{
+  return m_utf8_valid_p(buf, size);
+}
+
+size_t flength(const char buf[], size_t size)
+{
+  return m_utf8_length(buf, size);
+}
+
 void convert(string_t s, unsigned n)
 {
   m_string_set_ui(s, n);